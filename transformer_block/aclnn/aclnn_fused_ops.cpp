@@ -0,0 +1,207 @@
+#include "aclnn/aclnn_fused_ops.h"
+#include "aclnnop/aclnn_add.h"
+#include "aclnnop/aclnn_add_layer_norm.h"
+#include "aclnnop/aclnn_batch_matmul.h"
+#include "aclnnop/aclnn_fused_matmul.h"
+#include "aclnnop/aclnn_softmax.h"
+
+// 0: KEEP_DTYPE，按输入精度计算
+const int8_t CUBE_MATH_TYPE_KEEP_DTYPE = 0;
+
+// rhs的各维与lhs的最后几维一致
+static bool IsTrailingDims(const atb::Dims &lhs, const atb::Dims &rhs)
+{
+    if (rhs.dimNum == 0 || rhs.dimNum > lhs.dimNum)
+    {
+        return false;
+    }
+    for (uint64_t i = 0; i < rhs.dimNum; i++)
+    {
+        if (rhs.dims[i] != lhs.dims[lhs.dimNum - rhs.dimNum + i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+atb::Status AddLayerNormOpDef::InferShape(const Param &, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                          atb::SVector<atb::TensorDesc> &outTensorDesc)
+{
+    const atb::TensorDesc &x1 = inTensorDesc.at(0);
+    const atb::TensorDesc &gamma = inTensorDesc.at(2);
+    if (!IsTrailingDims(x1.shape, inTensorDesc.at(1).shape) || inTensorDesc.at(1).shape.dimNum != x1.shape.dimNum ||
+        !IsTrailingDims(x1.shape, gamma.shape) || !IsTrailingDims(x1.shape, inTensorDesc.at(3).shape))
+    {
+        LOG_ERROR("AddLayerNorm invalid input shape");
+        return atb::ERROR_INVALID_TENSOR_DIM;
+    }
+    outTensorDesc.at(0) = x1;
+    outTensorDesc.at(1) = x1;
+    outTensorDesc.at(1).dtype = ACL_FLOAT;
+    for (uint64_t i = x1.shape.dimNum - gamma.shape.dimNum; i < x1.shape.dimNum; i++)
+    {
+        outTensorDesc.at(1).shape.dims[i] = 1;
+    }
+    outTensorDesc.at(2) = outTensorDesc.at(1);
+    outTensorDesc.at(3) = x1;
+    return atb::NO_ERROR;
+}
+
+aclnnStatus AddLayerNormOpDef::GetWorkspaceSize(const Param &param, aclTensor *x1, aclTensor *x2, aclTensor *gamma,
+                                                aclTensor *beta, aclTensor *y, aclTensor *mean, aclTensor *rstd,
+                                                aclTensor *x, uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    return aclnnAddLayerNormGetWorkspaceSize(
+        x1, x2, gamma, beta, nullptr, param.epsilon, true, y, mean, rstd, x, workspaceSize, executor);
+}
+
+aclnnStatus AddLayerNormOpDef::Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor,
+                                      aclrtStream stream)
+{
+    return aclnnAddLayerNorm(workspace, workspaceSize, executor, stream);
+}
+
+atb::Status SoftmaxOpDef::InferShape(const Param &param, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                     atb::SVector<atb::TensorDesc> &outTensorDesc)
+{
+    int64_t dimNum = static_cast<int64_t>(inTensorDesc.at(0).shape.dimNum);
+    if (param.dim < -dimNum || param.dim >= dimNum)
+    {
+        LOG_ERROR("Softmax invalid dim " + std::to_string(param.dim));
+        return atb::ERROR_INVALID_PARAM;
+    }
+    outTensorDesc.at(0) = inTensorDesc.at(0);
+    return atb::NO_ERROR;
+}
+
+aclnnStatus SoftmaxOpDef::GetWorkspaceSize(const Param &param, aclTensor *x, aclTensor *y, uint64_t *workspaceSize,
+                                           aclOpExecutor **executor)
+{
+    return aclnnSoftmaxGetWorkspaceSize(x, param.dim, y, workspaceSize, executor);
+}
+
+aclnnStatus SoftmaxOpDef::Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    return aclnnSoftmax(workspace, workspaceSize, executor, stream);
+}
+
+// 输入x [..., k], weight [k, n], bias [n]（前面可以有大小为1的维），输出[..., n]
+static atb::Status InferMatmulBiasShape(const std::string &opName, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                        atb::SVector<atb::TensorDesc> &outTensorDesc)
+{
+    const atb::TensorDesc &x = inTensorDesc.at(0);
+    const atb::TensorDesc &weight = inTensorDesc.at(1);
+    const atb::TensorDesc &bias = inTensorDesc.at(2);
+    if (x.shape.dimNum < 2 || weight.shape.dimNum != 2 || x.shape.dims[x.shape.dimNum - 1] != weight.shape.dims[0] ||
+        bias.shape.dimNum == 0 || atb::Utils::GetTensorNumel(bias) != static_cast<uint64_t>(weight.shape.dims[1]) ||
+        bias.shape.dims[bias.shape.dimNum - 1] != weight.shape.dims[1])
+    {
+        LOG_ERROR(opName + " invalid input shape");
+        return atb::ERROR_INVALID_TENSOR_DIM;
+    }
+    outTensorDesc.at(0) = x;
+    outTensorDesc.at(0).shape.dims[x.shape.dimNum - 1] = weight.shape.dims[1];
+    return atb::NO_ERROR;
+}
+
+atb::Status MatmulGeluOpDef::InferShape(const Param &, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                        atb::SVector<atb::TensorDesc> &outTensorDesc)
+{
+    return InferMatmulBiasShape("MatmulGelu", inTensorDesc, outTensorDesc);
+}
+
+aclnnStatus MatmulGeluOpDef::GetWorkspaceSize(const Param &param, aclTensor *x, aclTensor *weight, aclTensor *bias,
+                                              aclTensor *y, uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    const char *fusedOpType = param.geluApproximate == 1 ? "gelu_tanh" : "gelu_erf";
+    return aclnnFusedMatmulGetWorkspaceSize(
+        x, weight, bias, nullptr, fusedOpType, CUBE_MATH_TYPE_KEEP_DTYPE, y, workspaceSize, executor);
+}
+
+aclnnStatus MatmulGeluOpDef::Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor,
+                                    aclrtStream stream)
+{
+    return aclnnFusedMatmul(workspace, workspaceSize, executor, stream);
+}
+
+atb::Status MatmulBiasOpDef::InferShape(const Param &, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                        atb::SVector<atb::TensorDesc> &outTensorDesc)
+{
+    return InferMatmulBiasShape("MatmulBias", inTensorDesc, outTensorDesc);
+}
+
+aclnnStatus MatmulBiasOpDef::GetWorkspaceSize(const Param &, aclTensor *x, aclTensor *weight, aclTensor *bias,
+                                              aclTensor *y, uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    // fusedOpType为空时只做matmul + bias
+    return aclnnFusedMatmulGetWorkspaceSize(
+        x, weight, bias, nullptr, "", CUBE_MATH_TYPE_KEEP_DTYPE, y, workspaceSize, executor);
+}
+
+aclnnStatus MatmulBiasOpDef::Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor,
+                                    aclrtStream stream)
+{
+    return aclnnFusedMatmul(workspace, workspaceSize, executor, stream);
+}
+
+atb::Status BiasAddOpDef::InferShape(const Param &, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                     atb::SVector<atb::TensorDesc> &outTensorDesc)
+{
+    if (!IsTrailingDims(inTensorDesc.at(0).shape, inTensorDesc.at(1).shape))
+    {
+        LOG_ERROR("BiasAdd invalid bias shape");
+        return atb::ERROR_INVALID_TENSOR_DIM;
+    }
+    outTensorDesc.at(0) = inTensorDesc.at(0);
+    return atb::NO_ERROR;
+}
+
+aclnnStatus BiasAddOpDef::GetWorkspaceSize(const Param &param, aclTensor *x, aclTensor *bias, aclTensor *y,
+                                           uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    // executor创建时已读取alpha的值，aclScalar不需要在执行期间保留
+    float alpha = param.alpha;
+    aclScalar *alphaScalar = aclCreateScalar(&alpha, ACL_FLOAT);
+    auto ret = aclnnAddGetWorkspaceSize(x, bias, alphaScalar, y, workspaceSize, executor);
+    aclDestroyScalar(alphaScalar);
+    return ret;
+}
+
+aclnnStatus BiasAddOpDef::Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    return aclnnAdd(workspace, workspaceSize, executor, stream);
+}
+
+atb::Status BatchMatmulOpDef::InferShape(const Param &, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                         atb::SVector<atb::TensorDesc> &outTensorDesc)
+{
+    const atb::TensorDesc &x = inTensorDesc.at(0);
+    const atb::TensorDesc &y = inTensorDesc.at(1);
+    uint64_t dimNum = x.shape.dimNum;
+    bool valid = dimNum >= 2 && y.shape.dimNum == dimNum && x.shape.dims[dimNum - 1] == y.shape.dims[dimNum - 2];
+    for (uint64_t i = 0; valid && i + 2 < dimNum; i++)
+    {
+        valid = x.shape.dims[i] == y.shape.dims[i];
+    }
+    if (!valid)
+    {
+        LOG_ERROR("BatchMatmul invalid input shape");
+        return atb::ERROR_INVALID_TENSOR_DIM;
+    }
+    outTensorDesc.at(0) = x;
+    outTensorDesc.at(0).shape.dims[dimNum - 1] = y.shape.dims[dimNum - 1];
+    return atb::NO_ERROR;
+}
+
+aclnnStatus BatchMatmulOpDef::GetWorkspaceSize(const Param &, aclTensor *x, aclTensor *y, aclTensor *out,
+                                               uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    return aclnnBatchMatMulGetWorkspaceSize(x, y, out, CUBE_MATH_TYPE_KEEP_DTYPE, workspaceSize, executor);
+}
+
+aclnnStatus BatchMatmulOpDef::Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor,
+                                     aclrtStream stream)
+{
+    return aclnnBatchMatMul(workspace, workspaceSize, executor, stream);
+}
@@ -0,0 +1,115 @@
+#ifndef ACLNN_FUSED_OPS_H
+#define ACLNN_FUSED_OPS_H
+
+#include "aclnn/aclnn_op_adapter.h"
+
+// 通过AclnnOperation接入的aclnn算子（以融合算子为主），可以直接作为atb图节点
+
+// 输入：x1, x2, gamma, beta；输出：y, mean, rstd, x
+// x = x1 + x2，y = LayerNorm(x)，归一化的维度为gamma的维度；mean/rstd为float，归一化的维度大小为1
+// 残差相加与LayerNorm合并为一个kernel，x可作为下一次残差连接的输入
+struct AddLayerNormOpDef
+{
+    struct Param
+    {
+        double epsilon = 1e-5;
+    };
+    static constexpr uint32_t IN_NUM = 4;
+    static constexpr uint32_t OUT_NUM = 4;
+    static atb::Status InferShape(const Param &param, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                  atb::SVector<atb::TensorDesc> &outTensorDesc);
+    static aclnnStatus GetWorkspaceSize(const Param &param, aclTensor *x1, aclTensor *x2, aclTensor *gamma,
+                                        aclTensor *beta, aclTensor *y, aclTensor *mean, aclTensor *rstd, aclTensor *x,
+                                        uint64_t *workspaceSize, aclOpExecutor **executor);
+    static aclnnStatus Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+};
+
+// 输入：x；输出：y，沿dim做softmax
+struct SoftmaxOpDef
+{
+    struct Param
+    {
+        int64_t dim = -1;
+    };
+    static constexpr uint32_t IN_NUM = 1;
+    static constexpr uint32_t OUT_NUM = 1;
+    static atb::Status InferShape(const Param &param, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                  atb::SVector<atb::TensorDesc> &outTensorDesc);
+    static aclnnStatus GetWorkspaceSize(const Param &param, aclTensor *x, aclTensor *y, uint64_t *workspaceSize,
+                                        aclOpExecutor **executor);
+    static aclnnStatus Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+};
+
+// 输入：x [..., k], weight [k, n], bias [n]；输出：y [..., n]
+// y = Gelu(x @ weight + bias)，Gelu在matmul的输出上直接计算，不再单独读写一次中间结果
+struct MatmulGeluOpDef
+{
+    struct Param
+    {
+        int64_t geluApproximate = 0; // 0: erf，1: tanh近似
+    };
+    static constexpr uint32_t IN_NUM = 3;
+    static constexpr uint32_t OUT_NUM = 1;
+    static atb::Status InferShape(const Param &param, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                  atb::SVector<atb::TensorDesc> &outTensorDesc);
+    static aclnnStatus GetWorkspaceSize(const Param &param, aclTensor *x, aclTensor *weight, aclTensor *bias,
+                                        aclTensor *y, uint64_t *workspaceSize, aclOpExecutor **executor);
+    static aclnnStatus Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+};
+
+// 输入：x [..., k], weight [k, n], bias [n]或[1, n]；输出：y [..., n]
+// y = x @ weight + bias，与atb Linear（hasBias）计算相同，作为Linear的另一种实现
+struct MatmulBiasOpDef
+{
+    struct Param
+    {
+    };
+    static constexpr uint32_t IN_NUM = 3;
+    static constexpr uint32_t OUT_NUM = 1;
+    static atb::Status InferShape(const Param &param, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                  atb::SVector<atb::TensorDesc> &outTensorDesc);
+    static aclnnStatus GetWorkspaceSize(const Param &param, aclTensor *x, aclTensor *weight, aclTensor *bias,
+                                        aclTensor *y, uint64_t *workspaceSize, aclOpExecutor **executor);
+    static aclnnStatus Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+};
+
+// 输入：x [..., n], bias [n]；输出：y = x + alpha * bias
+struct BiasAddOpDef
+{
+    struct Param
+    {
+        float alpha = 1.0f;
+    };
+    static constexpr uint32_t IN_NUM = 2;
+    static constexpr uint32_t OUT_NUM = 1;
+    static atb::Status InferShape(const Param &param, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                  atb::SVector<atb::TensorDesc> &outTensorDesc);
+    static aclnnStatus GetWorkspaceSize(const Param &param, aclTensor *x, aclTensor *bias, aclTensor *y,
+                                        uint64_t *workspaceSize, aclOpExecutor **executor);
+    static aclnnStatus Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+};
+
+// 输入：x [..., m, k], y [..., k, n]；输出：out [..., m, n]，batch维需一致
+// 输入可以是SetInTensorView设置的切片/转置view，例如从QKV输出中直接取出的各head的Q和转置后的K
+struct BatchMatmulOpDef
+{
+    struct Param
+    {
+    };
+    static constexpr uint32_t IN_NUM = 2;
+    static constexpr uint32_t OUT_NUM = 1;
+    static atb::Status InferShape(const Param &param, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                  atb::SVector<atb::TensorDesc> &outTensorDesc);
+    static aclnnStatus GetWorkspaceSize(const Param &param, aclTensor *x, aclTensor *y, aclTensor *out,
+                                        uint64_t *workspaceSize, aclOpExecutor **executor);
+    static aclnnStatus Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+};
+
+using AddLayerNormOperation = AclnnOperation<AddLayerNormOpDef>;
+using SoftmaxOperation = AclnnOperation<SoftmaxOpDef>;
+using MatmulGeluOperation = AclnnOperation<MatmulGeluOpDef>;
+using MatmulBiasOperation = AclnnOperation<MatmulBiasOpDef>;
+using BiasAddOperation = AclnnOperation<BiasAddOpDef>;
+using BatchMatmulOperation = AclnnOperation<BatchMatmulOpDef>;
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef ACLNN_OP_ADAPTER_H
+#define ACLNN_OP_ADAPTER_H
+
+#include <array>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "aclnn/aclnn_operation_base.h"
+#include "utils/log.h"
+#include "utils/metrics.h"
+
+// aclnn算子的通用接入：新增算子只需要定义一个OpDef，不再逐个算子手写tensor创建和workspace/执行代码
+// struct XxxOpDef
+// {
+//     struct Param {...};                       // 算子参数，构造AclnnOperation时传入
+//     static constexpr uint32_t IN_NUM = 2;     // 输入个数
+//     static constexpr uint32_t OUT_NUM = 1;    // 输出个数
+//     // 形状规则
+//     static atb::Status InferShape(const Param &param, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+//                                   atb::SVector<atb::TensorDesc> &outTensorDesc);
+//     // 依次传入IN_NUM个输入和OUT_NUM个输出的aclTensor，个数与IN_NUM + OUT_NUM不一致时编译失败
+//     static aclnnStatus GetWorkspaceSize(const Param &param, aclTensor *x, aclTensor *other, aclTensor *out,
+//                                         uint64_t *workspaceSize, aclOpExecutor **executor);
+//     static aclnnStatus Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor,
+//                               aclrtStream stream);
+// };
+// 输入输出默认按连续内存创建aclTensor，第i个输入/输出在executor中的序号为i
+// SetInTensorView后该输入按view读取传入tensor的数据：形状推导和aclTensor使用view的shape/strides/offset，不拷贝数据
+// executor设置为可复用：输入输出的desc与上一次Setup相同时直接复用aclTensor和executor，Execute只刷新数据地址
+namespace aclnn_adapter
+{
+template <size_t>
+using TensorArg = aclTensor *;
+
+template <typename OpDef, size_t... I>
+constexpr bool IsWorkspaceSizeInvocable(std::index_sequence<I...>)
+{
+    return std::is_invocable_r_v<aclnnStatus, decltype(&OpDef::GetWorkspaceSize), const typename OpDef::Param &,
+                                 TensorArg<I>..., uint64_t *, aclOpExecutor **>;
+}
+
+inline bool IsSameDesc(const atb::TensorDesc &lhs, const atb::TensorDesc &rhs)
+{
+    if (lhs.dtype != rhs.dtype || lhs.format != rhs.format || lhs.shape.dimNum != rhs.shape.dimNum)
+    {
+        return false;
+    }
+    for (uint64_t i = 0; i < lhs.shape.dimNum; i++)
+    {
+        if (lhs.shape.dims[i] != rhs.shape.dims[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// executor复用的命中/未命中计数，所有AclnnOperation共用
+inline void RecordExecutorCache(bool hit)
+{
+    if (!GetMetrics().IsEnabled())
+    {
+        return;
+    }
+    static Counter &hits = GetMetrics().GetCounter("aclnn_executor_cache_hits_total",
+                                                   "Setup calls that reused the aclnn executor");
+    static Counter &misses = GetMetrics().GetCounter("aclnn_executor_cache_misses_total",
+                                                     "Setup calls that rebuilt aclTensor and executor");
+    (hit ? hits : misses).Add();
+}
+} // namespace aclnn_adapter
+
+template <typename OpDef>
+class AclnnOperation : public AclnnBaseOperation
+{
+public:
+    using Param = typename OpDef::Param;
+    static constexpr uint32_t IN_NUM = OpDef::IN_NUM;
+    static constexpr uint32_t OUT_NUM = OpDef::OUT_NUM;
+    static_assert(IN_NUM > 0 && OUT_NUM > 0, "aclnn op needs at least one input and one output");
+    static_assert(aclnn_adapter::IsWorkspaceSizeInvocable<OpDef>(std::make_index_sequence<IN_NUM + OUT_NUM>()),
+                  "OpDef::GetWorkspaceSize must take Param, IN_NUM + OUT_NUM aclTensor*, workspaceSize and executor");
+
+    AclnnOperation(const std::string &name, Param param = Param()) : AclnnBaseOperation(name), param_(param)
+    {
+    }
+
+    ~AclnnOperation() override
+    {
+        DestroyAclnnResource();
+    }
+
+    atb::Status InferShape(const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                           atb::SVector<atb::TensorDesc> &outTensorDesc) const override
+    {
+        atb::SVector<atb::TensorDesc> viewDesc = inTensorDesc;
+        for (uint32_t i = 0; i < IN_NUM && i < viewDesc.size(); ++i)
+        {
+            if (hasInView_[i])
+            {
+                viewDesc[i].shape = inViews_[i].shape;
+            }
+        }
+        return OpDef::InferShape(param_, viewDesc, outTensorDesc);
+    }
+
+    // 第index个输入改为按view读取，传入的tensor作为storage；需在Setup前设置
+    void SetInTensorView(uint32_t index, const TensorView &view)
+    {
+        if (index >= IN_NUM)
+        {
+            LOG_ERROR(opName_ + " SetInTensorView invalid index " + std::to_string(index));
+            return;
+        }
+        inViews_[index] = view;
+        hasInView_[index] = true;
+        viewChanged_ = true;
+    }
+
+    uint32_t GetInputNum() const override
+    {
+        return IN_NUM;
+    }
+
+    uint32_t GetOutputNum() const override
+    {
+        return OUT_NUM;
+    }
+
+    atb::Status CreateAclnnVariantPack(const atb::VariantPack &variantPack) override
+    {
+        if (variantPack.inTensors.size() != IN_NUM || variantPack.outTensors.size() != OUT_NUM)
+        {
+            LOG_ERROR(opName_ + " variantPack tensor num mismatch");
+            return atb::ERROR_INVALID_PARAM;
+        }
+        reuseExecutor_ = aclExecutor_ != nullptr && !viewChanged_ && IsSameVariantPackDesc(variantPack);
+        aclnn_adapter::RecordExecutorCache(reuseExecutor_);
+        if (reuseExecutor_)
+        {
+            return atb::NO_ERROR;
+        }
+        DestroyAclnnResource();
+        viewChanged_ = false;
+        aclInTensors_.resize(IN_NUM);
+        for (uint32_t i = 0; i < IN_NUM; ++i)
+        {
+            const atb::Tensor &inTensor = variantPack.inTensors.at(i);
+            if (hasInView_[i] && !IsViewInStorage(inViews_[i], atb::Utils::GetTensorNumel(inTensor.desc)))
+            {
+                LOG_ERROR(opName_ + " InTensor view index " + std::to_string(i) + " out of storage");
+                return atb::ERROR_INVALID_TENSOR_DIM;
+            }
+            aclInTensors_[i] = hasInView_[i] ? CreateAclnnTensorFromView(inTensor, inViews_[i], static_cast<int>(i))
+                                             : CreateContiguousAclnnTensor(inTensor, static_cast<int>(i));
+            if (aclInTensors_[i]->tensor == nullptr)
+            {
+                LOG_ERROR(opName_ + " InTensor aclCreateTensor index " + std::to_string(i) + " fail");
+                return atb::ERROR_INTERNAL_ERROR;
+            }
+        }
+        aclOutTensors_.resize(OUT_NUM);
+        for (uint32_t i = 0; i < OUT_NUM; ++i)
+        {
+            aclOutTensors_[i] = CreateContiguousAclnnTensor(variantPack.outTensors.at(i), static_cast<int>(i));
+            if (aclOutTensors_[i]->tensor == nullptr)
+            {
+                LOG_ERROR(opName_ + " outTensor aclCreateTensor index " + std::to_string(i) + " fail");
+                return atb::ERROR_INTERNAL_ERROR;
+            }
+        }
+        return atb::NO_ERROR;
+    }
+
+    atb::Status SetAclnnWorkspaceExecutor() override
+    {
+        if (reuseExecutor_)
+        {
+            return atb::NO_ERROR;
+        }
+        auto ret = CallGetWorkspaceSize(std::make_index_sequence<IN_NUM + OUT_NUM>());
+        if (ret != 0)
+        {
+            LOG_ERROR(opName_ + " GetWorkspaceSize failed, ret: " + std::to_string(ret));
+            aclExecutor_ = nullptr;
+            return ret;
+        }
+        ret = aclSetAclOpExecutorRepeatable(aclExecutor_);
+        if (ret != 0)
+        {
+            LOG_ERROR(opName_ + " aclSetAclOpExecutorRepeatable failed, ret: " + std::to_string(ret));
+            // 不可重复执行的executor在下一次Launch后即失效，不能留给desc相同的Setup复用
+            aclDestroyAclOpExecutor(aclExecutor_);
+            aclExecutor_ = nullptr;
+            return ret;
+        }
+        executorBuildCount_++;
+        LOG_INFO(opName_ + " SetAclnnWorkspaceExecutor end, workspaceSize_: " + std::to_string(workspaceSize_));
+        return atb::NO_ERROR;
+    }
+
+    atb::Status ExecuteAclnnOp(uint8_t *workspace, aclrtStream &stream) override
+    {
+        auto ret = OpDef::Launch(workspace, workspaceSize_, aclExecutor_, stream);
+        if (ret != 0)
+        {
+            LOG_ERROR(opName_ + " Launch failed, ret: " + std::to_string(ret));
+        }
+        return ret;
+    }
+
+    // 创建aclTensor和executor的次数，desc不变的重复Setup不计入
+    uint64_t GetExecutorBuildCount() const
+    {
+        return executorBuildCount_;
+    }
+
+private:
+    template <size_t... I>
+    aclnnStatus CallGetWorkspaceSize(std::index_sequence<I...>)
+    {
+        std::array<aclTensor *, IN_NUM + OUT_NUM> tensors = {};
+        for (uint32_t i = 0; i < IN_NUM + OUT_NUM; ++i)
+        {
+            tensors[i] = i < IN_NUM ? aclInTensors_[i]->tensor : aclOutTensors_[i - IN_NUM]->tensor;
+        }
+        return OpDef::GetWorkspaceSize(param_, std::get<I>(tensors)..., &workspaceSize_, &aclExecutor_);
+    }
+
+    bool IsSameVariantPackDesc(const atb::VariantPack &variantPack) const
+    {
+        for (uint32_t i = 0; i < IN_NUM; ++i)
+        {
+            if (!aclnn_adapter::IsSameDesc(aclInTensors_[i]->atbTensor.desc, variantPack.inTensors.at(i).desc))
+            {
+                return false;
+            }
+        }
+        for (uint32_t i = 0; i < OUT_NUM; ++i)
+        {
+            if (!aclnn_adapter::IsSameDesc(aclOutTensors_[i]->atbTensor.desc, variantPack.outTensors.at(i).desc))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void DestroyAclnnResource()
+    {
+        if (aclExecutor_ != nullptr)
+        {
+            aclDestroyAclOpExecutor(aclExecutor_);
+            aclExecutor_ = nullptr;
+        }
+        // 创建中途失败时后面的元素为空
+        for (auto &aclnnTensor : aclInTensors_)
+        {
+            if (aclnnTensor != nullptr)
+            {
+                aclDestroyTensor(aclnnTensor->tensor);
+            }
+        }
+        for (auto &aclnnTensor : aclOutTensors_)
+        {
+            if (aclnnTensor != nullptr)
+            {
+                aclDestroyTensor(aclnnTensor->tensor);
+            }
+        }
+        aclInTensors_.clear();
+        aclOutTensors_.clear();
+    }
+
+    Param param_;
+    std::array<TensorView, IN_NUM> inViews_;
+    std::array<bool, IN_NUM> hasInView_ = {};
+    bool viewChanged_ = false;
+    bool reuseExecutor_ = false;
+    uint64_t executorBuildCount_ = 0;
+};
+
+#endif
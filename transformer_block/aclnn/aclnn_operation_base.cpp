@@ -10,6 +10,33 @@ AclnnBaseOperation::~AclnnBaseOperation()
     aclExecutor_ = nullptr;
 }
 
+std::shared_ptr<AclnnTensor> CreateContiguousAclnnTensor(const atb::Tensor &atbTensor, int tensorIdx)
+{
+    return CreateAclnnTensorFromView(atbTensor, ContiguousView(atbTensor.desc.shape), tensorIdx);
+}
+
+std::shared_ptr<AclnnTensor> CreateAclnnTensorFromView(const atb::Tensor &atbTensor, const TensorView &view,
+                                                       int tensorIdx)
+{
+    auto aclnnTensor = std::make_shared<AclnnTensor>();
+    aclnnTensor->tensorIdx = tensorIdx;
+    aclnnTensor->needUpdateTensorDataPtr = true;
+    aclnnTensor->atbTensor = atbTensor;
+    aclnnTensor->strides = view.strides;
+    aclnnTensor->offset = view.offset;
+    // viewDims/strides/offset描述逻辑tensor，storageDims为atbTensor的形状，数据地址仍为storage起始地址
+    aclnnTensor->tensor = aclCreateTensor(view.shape.dims,
+                                          view.shape.dimNum,
+                                          atbTensor.desc.dtype,
+                                          aclnnTensor->strides.data(),
+                                          view.offset,
+                                          atbTensor.desc.format,
+                                          atbTensor.desc.shape.dims,
+                                          atbTensor.desc.shape.dimNum,
+                                          atbTensor.deviceData);
+    return aclnnTensor;
+}
+
 std::string AclnnBaseOperation::GetName() const
 {
     return opName_;
@@ -7,6 +7,7 @@
 #include <atb/types.h>
 #include <atb/utils.h>
 #include "atb/infer_op_params.h"
+#include "aclnn/aclnn_tensor_view.h"
 
 // 对atb::tensor的一层封装
 struct AclnnTensor
@@ -17,8 +18,16 @@ public:
     int tensorIdx = -1; // aclTensor在aclExecutor中的index
     bool needUpdateTensorDataPtr = false;
     atb::SVector<int64_t> strides = {};
+    int64_t offset = 0; // 相对atbTensor.deviceData的元素偏移
 };
 
+// 按atbTensor的desc创建连续内存的aclTensor，tensorIdx为在aclnn接口中的输入/输出序号
+std::shared_ptr<AclnnTensor> CreateContiguousAclnnTensor(const atb::Tensor &atbTensor, int tensorIdx);
+
+// 以atbTensor为storage创建view对应的aclTensor，不拷贝数据；调用方需保证view在storage范围内
+std::shared_ptr<AclnnTensor> CreateAclnnTensorFromView(const atb::Tensor &atbTensor, const TensorView &view,
+                                                       int tensorIdx);
+
 // 保持与atb的算子的统一接口调用
 // aclnn算子接入atb
 // 1. 继承atb::Operation
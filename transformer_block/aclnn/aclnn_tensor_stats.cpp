@@ -0,0 +1,296 @@
+#include "aclnn/aclnn_tensor_stats.h"
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <atb/utils.h>
+#include "aclnnop/aclnn_amax.h"
+#include "aclnnop/aclnn_amin.h"
+#include "aclnnop/aclnn_mean.h"
+#include "aclnnop/aclnn_mul.h"
+#include "aclnnop/aclnn_ne_tensor.h"
+#include "aclnnop/aclnn_reduce_sum.h"
+#include "utils/log.h"
+#include "utils/tensor_convert.h"
+
+namespace {
+// 结果缓冲区中每个标量占一个8字节槽位
+enum StatsSlot : uint64_t
+{
+    SLOT_MIN = 0,
+    SLOT_MAX,
+    SLOT_MEAN,
+    SLOT_SUM,
+    SLOT_CHECKSUM,
+    SLOT_NAN_COUNT,
+    SLOT_NUM
+};
+constexpr uint64_t SLOT_BYTES = 8;
+constexpr uint64_t RESULT_BYTES = SLOT_NUM * SLOT_BYTES;
+
+using GetWorkspaceFunc = std::function<aclnnStatus(uint64_t *, aclOpExecutor **)>;
+using LaunchFunc = aclnnStatus (*)(void *, uint64_t, aclOpExecutor *, aclrtStream);
+
+struct PendingOp
+{
+    const char *name;
+    LaunchFunc launch;
+    aclOpExecutor *executor;
+    uint64_t workspaceSize;
+};
+
+// 创建的aclTensor在析构时统一销毁，需保证此时stream上的计算已完成
+class AclTensorList
+{
+public:
+    ~AclTensorList()
+    {
+        for (auto *tensor : tensors_)
+        {
+            aclDestroyTensor(tensor);
+        }
+    }
+
+    aclTensor *Create(const std::vector<int64_t> &dims, aclDataType dtype, void *data)
+    {
+        std::vector<int64_t> strides(dims.size(), 1);
+        for (int64_t i = static_cast<int64_t>(dims.size()) - 2; i >= 0; i--)
+        {
+            strides[i] = dims[i + 1] * strides[i + 1];
+        }
+        aclTensor *tensor = aclCreateTensor(dims.data(), dims.size(), dtype, strides.data(), 0, ACL_FORMAT_ND,
+                                            dims.data(), dims.size(), data);
+        tensors_.push_back(tensor);
+        return tensor;
+    }
+
+private:
+    std::vector<aclTensor *> tensors_;
+};
+
+void *SlotAddr(void *buffer, StatsSlot slot)
+{
+    return static_cast<uint8_t *>(buffer) + slot * SLOT_BYTES;
+}
+} // namespace
+
+std::string TensorStatsToString(const TensorStats &stats)
+{
+    return "count " + std::to_string(stats.count) + ", min " + std::to_string(stats.min) + ", max " +
+           std::to_string(stats.max) + ", mean " + std::to_string(stats.mean) + ", sum " + std::to_string(stats.sum) +
+           ", checksum " + std::to_string(stats.checksum) + ", nan " + std::to_string(stats.nanCount);
+}
+
+TensorStatsCollector::~TensorStatsCollector()
+{
+    FreeResource();
+}
+
+void TensorStatsCollector::FreeResource()
+{
+    for (void **buffer : {&resultBuffer_, &checksumWeights_, &productBuffer_, &maskBuffer_, &workspace_})
+    {
+        if (*buffer != nullptr)
+        {
+            aclrtFree(*buffer);
+            *buffer = nullptr;
+        }
+    }
+    resultCapacity_ = 0;
+    checksumWeightsCapacity_ = 0;
+    productCapacity_ = 0;
+    maskCapacity_ = 0;
+    workspaceCapacity_ = 0;
+}
+
+atb::Status TensorStatsCollector::EnsureBuffer(void *&buffer, uint64_t &capacity, uint64_t size)
+{
+    if (size <= capacity && buffer != nullptr)
+    {
+        return atb::NO_ERROR;
+    }
+    if (buffer != nullptr)
+    {
+        aclrtFree(buffer);
+        buffer = nullptr;
+        capacity = 0;
+    }
+    int ret = aclrtMalloc(&buffer, std::max<uint64_t>(size, 1), ACL_MEM_MALLOC_HUGE_FIRST);
+    if (ret != ACL_SUCCESS)
+    {
+        LOG_ERROR("tensor stats aclrtMalloc " + std::to_string(size) + " bytes fail, error: " + std::to_string(ret));
+        return atb::ERROR_RT_FAIL;
+    }
+    capacity = size;
+    return atb::NO_ERROR;
+}
+
+atb::Status TensorStatsCollector::EnsureChecksumWeights(int64_t count)
+{
+    uint64_t size = count * sizeof(float);
+    if (size <= checksumWeightsCapacity_ && checksumWeights_ != nullptr)
+    {
+        return atb::NO_ERROR;
+    }
+    atb::Status status = EnsureBuffer(checksumWeights_, checksumWeightsCapacity_, size);
+    if (status != atb::NO_ERROR)
+    {
+        return status;
+    }
+    std::vector<float> weights(count);
+    for (int64_t i = 0; i < count; i++)
+    {
+        weights[i] = static_cast<float>(i % TENSOR_CHECKSUM_PERIOD + 1);
+    }
+    int ret = aclrtMemcpy(checksumWeights_, size, weights.data(), size, ACL_MEMCPY_HOST_TO_DEVICE);
+    if (ret != ACL_SUCCESS)
+    {
+        LOG_ERROR("tensor stats aclrtMemcpy H2D fail, error: " + std::to_string(ret));
+        // 权重未写入，下次调用时重新上传
+        checksumWeightsCapacity_ = 0;
+        return atb::ERROR_RT_FAIL;
+    }
+    return atb::NO_ERROR;
+}
+
+atb::Status TensorStatsCollector::Compute(const atb::Tensor &tensor, aclrtStream stream, TensorStats &stats)
+{
+    aclDataType dtype = tensor.desc.dtype;
+    if (!IsConvertibleDtype(dtype) || tensor.deviceData == nullptr)
+    {
+        LOG_ERROR("tensor stats unsupported tensor, dtype: " + std::to_string(static_cast<int>(dtype)));
+        return atb::ERROR_INVALID_PARAM;
+    }
+    int64_t count = atb::Utils::GetTensorNumel(tensor);
+    atb::Status status = EnsureBuffer(resultBuffer_, resultCapacity_, RESULT_BYTES);
+    if (status == atb::NO_ERROR)
+    {
+        status = EnsureChecksumWeights(count);
+    }
+    if (status == atb::NO_ERROR)
+    {
+        status = EnsureBuffer(productBuffer_, productCapacity_, count * sizeof(float));
+    }
+    if (status == atb::NO_ERROR)
+    {
+        status = EnsureBuffer(maskBuffer_, maskCapacity_, count);
+    }
+    if (status != atb::NO_ERROR)
+    {
+        return status;
+    }
+
+    // 全部维度都参与规约，keepDim后输出为与输入同秩的单元素tensor
+    std::vector<int64_t> dims(tensor.desc.shape.dims, tensor.desc.shape.dims + tensor.desc.shape.dimNum);
+    std::vector<int64_t> axes(dims.size());
+    for (size_t i = 0; i < axes.size(); i++)
+    {
+        axes[i] = static_cast<int64_t>(i);
+    }
+    std::vector<int64_t> scalarDims(dims.size(), 1);
+    AclTensorList tensors;
+    aclTensor *input = tensors.Create(dims, dtype, tensor.deviceData);
+    aclTensor *minOut = tensors.Create(scalarDims, dtype, SlotAddr(resultBuffer_, SLOT_MIN));
+    aclTensor *maxOut = tensors.Create(scalarDims, dtype, SlotAddr(resultBuffer_, SLOT_MAX));
+    aclTensor *meanOut = tensors.Create(scalarDims, ACL_FLOAT, SlotAddr(resultBuffer_, SLOT_MEAN));
+    aclTensor *sumOut = tensors.Create(scalarDims, ACL_FLOAT, SlotAddr(resultBuffer_, SLOT_SUM));
+    aclTensor *weights = tensors.Create(dims, ACL_FLOAT, checksumWeights_);
+    aclTensor *product = tensors.Create(dims, ACL_FLOAT, productBuffer_);
+    aclTensor *checksumOut = tensors.Create(scalarDims, ACL_FLOAT, SlotAddr(resultBuffer_, SLOT_CHECKSUM));
+    aclTensor *mask = tensors.Create(dims, ACL_BOOL, maskBuffer_);
+    aclTensor *nanCountOut = tensors.Create(scalarDims, ACL_FLOAT, SlotAddr(resultBuffer_, SLOT_NAN_COUNT));
+    aclIntArray *axisArray = aclCreateIntArray(axes.data(), axes.size());
+
+    std::vector<std::pair<PendingOp, GetWorkspaceFunc>> ops = {
+        {{"Amin", aclnnAmin, nullptr, 0},
+         [&](uint64_t *size, aclOpExecutor **executor)
+         { return aclnnAminGetWorkspaceSize(input, axisArray, true, minOut, size, executor); }},
+        {{"Amax", aclnnAmax, nullptr, 0},
+         [&](uint64_t *size, aclOpExecutor **executor)
+         { return aclnnAmaxGetWorkspaceSize(input, axisArray, true, maxOut, size, executor); }},
+        {{"Mean", aclnnMean, nullptr, 0},
+         [&](uint64_t *size, aclOpExecutor **executor)
+         { return aclnnMeanGetWorkspaceSize(input, axisArray, true, ACL_FLOAT, meanOut, size, executor); }},
+        {{"ReduceSum", aclnnReduceSum, nullptr, 0},
+         [&](uint64_t *size, aclOpExecutor **executor)
+         { return aclnnReduceSumGetWorkspaceSize(input, axisArray, true, ACL_FLOAT, sumOut, size, executor); }},
+        {{"Mul", aclnnMul, nullptr, 0},
+         [&](uint64_t *size, aclOpExecutor **executor)
+         { return aclnnMulGetWorkspaceSize(input, weights, product, size, executor); }},
+        {{"ReduceSum", aclnnReduceSum, nullptr, 0},
+         [&](uint64_t *size, aclOpExecutor **executor)
+         { return aclnnReduceSumGetWorkspaceSize(product, axisArray, true, ACL_FLOAT, checksumOut, size, executor); }},
+        {{"NeTensor", aclnnNeTensor, nullptr, 0},
+         [&](uint64_t *size, aclOpExecutor **executor)
+         { return aclnnNeTensorGetWorkspaceSize(input, input, mask, size, executor); }},
+        {{"ReduceSum", aclnnReduceSum, nullptr, 0},
+         [&](uint64_t *size, aclOpExecutor **executor)
+         { return aclnnReduceSumGetWorkspaceSize(mask, axisArray, true, ACL_FLOAT, nanCountOut, size, executor); }},
+    };
+
+    // 先创建全部executor并取最大workspace，避免已下发的算子还在使用时重新分配workspace
+    uint64_t maxWorkspaceSize = 0;
+    size_t created = 0;
+    for (; created < ops.size(); created++)
+    {
+        PendingOp &op = ops[created].first;
+        int ret = ops[created].second(&op.workspaceSize, &op.executor);
+        if (ret != 0)
+        {
+            LOG_ERROR(std::string("tensor stats call aclnn") + op.name + "GetWorkspaceSize fail, error: " +
+                      std::to_string(ret));
+            status = atb::ERROR_CANN_ERROR;
+            break;
+        }
+        maxWorkspaceSize = std::max(maxWorkspaceSize, op.workspaceSize);
+    }
+    if (status == atb::NO_ERROR)
+    {
+        status = EnsureBuffer(workspace_, workspaceCapacity_, maxWorkspaceSize);
+    }
+    size_t launched = 0;
+    for (; status == atb::NO_ERROR && launched < ops.size(); launched++)
+    {
+        PendingOp &op = ops[launched].first;
+        int ret = op.launch(workspace_, op.workspaceSize, op.executor, stream);
+        if (ret != 0)
+        {
+            LOG_ERROR(std::string("tensor stats call aclnn") + op.name + " fail, error: " + std::to_string(ret));
+            status = atb::ERROR_CANN_ERROR;
+        }
+    }
+    // 未下发的executor需手动销毁，已下发的由aclnn释放
+    for (size_t i = launched; i < created; i++)
+    {
+        aclDestroyAclOpExecutor(ops[i].first.executor);
+    }
+
+    int ret = aclrtSynchronizeStream(stream);
+    aclDestroyIntArray(axisArray);
+    if (status != atb::NO_ERROR)
+    {
+        return status;
+    }
+    if (ret != ACL_SUCCESS)
+    {
+        LOG_ERROR("tensor stats aclrtSynchronizeStream fail, error: " + std::to_string(ret));
+        return atb::ERROR_RT_FAIL;
+    }
+
+    uint8_t hostResult[RESULT_BYTES] = {};
+    ret = aclrtMemcpy(hostResult, RESULT_BYTES, resultBuffer_, RESULT_BYTES, ACL_MEMCPY_DEVICE_TO_HOST);
+    if (ret != ACL_SUCCESS)
+    {
+        LOG_ERROR("tensor stats aclrtMemcpy D2H fail, error: " + std::to_string(ret));
+        return atb::ERROR_RT_FAIL;
+    }
+    float nanCount = 0;
+    stats.count = count;
+    ConvertToFloat(hostResult + SLOT_MIN * SLOT_BYTES, dtype, &stats.min, 1);
+    ConvertToFloat(hostResult + SLOT_MAX * SLOT_BYTES, dtype, &stats.max, 1);
+    ConvertToFloat(hostResult + SLOT_MEAN * SLOT_BYTES, ACL_FLOAT, &stats.mean, 1);
+    ConvertToFloat(hostResult + SLOT_SUM * SLOT_BYTES, ACL_FLOAT, &stats.sum, 1);
+    ConvertToFloat(hostResult + SLOT_CHECKSUM * SLOT_BYTES, ACL_FLOAT, &stats.checksum, 1);
+    ConvertToFloat(hostResult + SLOT_NAN_COUNT * SLOT_BYTES, ACL_FLOAT, &nanCount, 1);
+    stats.nanCount = static_cast<int64_t>(nanCount);
+    return atb::NO_ERROR;
+}
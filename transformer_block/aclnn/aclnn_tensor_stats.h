@@ -0,0 +1,65 @@
+#ifndef ACLNN_TENSOR_STATS_H
+#define ACLNN_TENSOR_STATS_H
+
+#include <string>
+#include <acl/acl.h>
+#include <aclnn/acl_meta.h>
+#include <atb/types.h>
+
+// 校验和的位置权重周期：第i个元素的权重为i % TENSOR_CHECKSUM_PERIOD + 1
+// 取素数使交换两个元素的位置也能改变校验和，除非两者相距周期的整数倍
+constexpr int64_t TENSOR_CHECKSUM_PERIOD = 1021;
+
+// 整个tensor的统计量，min/max/mean/sum/checksum中任一输入为nan时结果为nan
+struct TensorStats
+{
+    int64_t count = 0;
+    float min = 0;
+    float max = 0;
+    float mean = 0;
+    float sum = 0;      // 全部元素的fp32和
+    float checksum = 0; // 按行主序位置加权的fp32和，元素的值或位置变化都会改变结果
+    int64_t nanCount = 0;
+};
+
+// 格式化为一行日志
+std::string TensorStatsToString(const TensorStats &stats);
+
+// 在device上用aclnn规约算子计算统计量，只把几个标量拷回host
+// 1. Amax/Amin/Mean/ReduceSum沿全部维度规约，结果写入同一块device缓冲区的不同槽位
+// 2. Mul乘以device上缓存的位置权重，再ReduceSum得到校验和
+// 3. NeTensor(x, x)得到nan掩码，再ReduceSum得到nan个数
+// 4. 同步stream后一次D2H拷贝全部槽位
+// device缓冲区按需增长并在多次调用间复用，同一实例不能被多个线程同时使用
+class TensorStatsCollector
+{
+public:
+    TensorStatsCollector() = default;
+    ~TensorStatsCollector();
+    TensorStatsCollector(const TensorStatsCollector &) = delete;
+    TensorStatsCollector &operator=(const TensorStatsCollector &) = delete;
+
+    // tensor支持ACL_FLOAT、ACL_FLOAT16和ACL_BF16，需位于stream所在device上
+    atb::Status Compute(const atb::Tensor &tensor, aclrtStream stream, TensorStats &stats);
+
+    // 释放device缓冲区，需在分配时的device上调用，析构时也会调用
+    void FreeResource();
+
+private:
+    atb::Status EnsureBuffer(void *&buffer, uint64_t &capacity, uint64_t size);
+    // 位置权重只与下标有关，缓冲区增长时重新上传，较短的tensor使用其前缀
+    atb::Status EnsureChecksumWeights(int64_t count);
+
+    void *resultBuffer_ = nullptr;
+    uint64_t resultCapacity_ = 0;
+    void *checksumWeights_ = nullptr;
+    uint64_t checksumWeightsCapacity_ = 0;
+    void *productBuffer_ = nullptr;
+    uint64_t productCapacity_ = 0;
+    void *maskBuffer_ = nullptr;
+    uint64_t maskCapacity_ = 0;
+    void *workspace_ = nullptr;
+    uint64_t workspaceCapacity_ = 0;
+};
+
+#endif
@@ -0,0 +1,143 @@
+#include "aclnn/aclnn_tensor_view.h"
+#include <string>
+#include <utility>
+#include "utils/log.h"
+
+// atb::Dims最多8维
+const uint64_t MAX_VIEW_DIM_NUM = 8;
+
+TensorView ContiguousView(const atb::Dims &shape)
+{
+    TensorView view;
+    view.shape = shape;
+    view.strides.resize(shape.dimNum, 1);
+    for (int64_t i = static_cast<int64_t>(shape.dimNum) - 2; i >= 0; i--)
+    {
+        view.strides[i] = shape.dims[i + 1] * view.strides[i + 1];
+    }
+    return view;
+}
+
+TensorView NarrowView(const TensorView &view, uint64_t dim, int64_t start, int64_t length)
+{
+    if (dim >= view.shape.dimNum || start < 0 || length <= 0 || start + length > view.shape.dims[dim])
+    {
+        LOG_ERROR("NarrowView invalid dim " + std::to_string(dim) + " range [" + std::to_string(start) + ", " +
+                  std::to_string(start + length) + ")");
+        return TensorView();
+    }
+    TensorView result = view;
+    result.shape.dims[dim] = length;
+    result.offset += start * view.strides[dim];
+    return result;
+}
+
+TensorView SplitDimView(const TensorView &view, uint64_t dim, const std::vector<int64_t> &sizes)
+{
+    int64_t product = 1;
+    for (int64_t size : sizes)
+    {
+        product *= size;
+    }
+    if (dim >= view.shape.dimNum || sizes.empty() || view.shape.dimNum + sizes.size() - 1 > MAX_VIEW_DIM_NUM ||
+        product != view.shape.dims[dim])
+    {
+        LOG_ERROR("SplitDimView invalid dim " + std::to_string(dim));
+        return TensorView();
+    }
+    TensorView result;
+    result.offset = view.offset;
+    for (uint64_t i = 0; i < view.shape.dimNum; i++)
+    {
+        if (i != dim)
+        {
+            result.shape.dims[result.shape.dimNum++] = view.shape.dims[i];
+            result.strides.push_back(view.strides[i]);
+            continue;
+        }
+        // 拆出的各维中最后一维沿用原步长，前面的依次乘以后面各维的大小
+        int64_t stride = view.strides[i] * product;
+        for (int64_t size : sizes)
+        {
+            stride /= size;
+            result.shape.dims[result.shape.dimNum++] = size;
+            result.strides.push_back(stride);
+        }
+    }
+    return result;
+}
+
+TensorView PermuteView(const TensorView &view, const std::vector<uint64_t> &order)
+{
+    std::vector<bool> used(view.shape.dimNum, false);
+    bool valid = order.size() == view.shape.dimNum;
+    for (uint64_t i = 0; valid && i < order.size(); i++)
+    {
+        valid = order[i] < view.shape.dimNum && !used[order[i]];
+        used[order[i] < view.shape.dimNum ? order[i] : 0] = true;
+    }
+    if (!valid)
+    {
+        LOG_ERROR("PermuteView invalid order for " + std::to_string(view.shape.dimNum) + " dims");
+        return TensorView();
+    }
+    TensorView result = view;
+    for (uint64_t i = 0; i < order.size(); i++)
+    {
+        result.shape.dims[i] = view.shape.dims[order[i]];
+        result.strides[i] = view.strides[order[i]];
+    }
+    return result;
+}
+
+TensorView TransposeView(const TensorView &view, uint64_t dim0, uint64_t dim1)
+{
+    std::vector<uint64_t> order(view.shape.dimNum);
+    for (uint64_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    if (dim0 >= order.size() || dim1 >= order.size())
+    {
+        LOG_ERROR("TransposeView invalid dims " + std::to_string(dim0) + ", " + std::to_string(dim1));
+        return TensorView();
+    }
+    std::swap(order[dim0], order[dim1]);
+    return PermuteView(view, order);
+}
+
+bool IsViewInStorage(const TensorView &view, int64_t storageNumel)
+{
+    if (view.shape.dimNum == 0 || view.strides.size() != view.shape.dimNum || view.offset < 0)
+    {
+        return false;
+    }
+    int64_t last = view.offset;
+    for (uint64_t i = 0; i < view.shape.dimNum; i++)
+    {
+        if (view.shape.dims[i] <= 0 || view.strides[i] < 0)
+        {
+            return false;
+        }
+        last += (view.shape.dims[i] - 1) * view.strides[i];
+    }
+    return last < storageNumel;
+}
+
+bool IsContiguousView(const TensorView &view)
+{
+    TensorView contiguous = ContiguousView(view.shape);
+    if (view.offset != 0 || view.strides.size() != contiguous.strides.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < view.strides.size(); i++)
+    {
+        // 大小为1的维不影响布局
+        if (view.shape.dims[i] != 1 && view.strides[i] != contiguous.strides[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,40 @@
+#ifndef ACLNN_TENSOR_VIEW_H
+#define ACLNN_TENSOR_VIEW_H
+
+#include <vector>
+#include <atb/types.h>
+
+// 已有device内存上的逻辑tensor：shape + strides + offset，均以元素为单位
+// 切片、转置、拆分head只修改view，不拷贝数据；通过AclnnOperation::SetInTensorView传给aclnn算子，
+// 由aclCreateTensor的stride/offset/storage shape参数描述
+struct TensorView
+{
+    atb::Dims shape;
+    atb::SVector<int64_t> strides;
+    int64_t offset = 0;
+};
+
+// 参数非法时以下函数输出错误日志并返回dimNum为0的view，IsViewInStorage对其返回false
+
+// 连续内存上的view
+TensorView ContiguousView(const atb::Dims &shape);
+
+// dim维只保留[start, start + length)
+TensorView NarrowView(const TensorView &view, uint64_t dim, int64_t start, int64_t length);
+
+// 把dim维拆成sizes中的多维，sizes的乘积需等于该维大小，例如[B, S, 768]的第2维拆成{12, 64}得到[B, S, 12, 64]
+TensorView SplitDimView(const TensorView &view, uint64_t dim, const std::vector<int64_t> &sizes);
+
+// 按order重排各维，新的第i维为原来的第order[i]维
+TensorView PermuteView(const TensorView &view, const std::vector<uint64_t> &order);
+
+// 交换两维
+TensorView TransposeView(const TensorView &view, uint64_t dim0, uint64_t dim1);
+
+// view访问的元素都在storage的[0, storageNumel)内
+bool IsViewInStorage(const TensorView &view, int64_t storageNumel);
+
+// 与ContiguousView(view.shape)的布局相同
+bool IsContiguousView(const TensorView &view);
+
+#endif
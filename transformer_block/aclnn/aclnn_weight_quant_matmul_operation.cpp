@@ -0,0 +1,97 @@
+#include "aclnn_weight_quant_matmul_operation.h"
+#include "acl/acl.h"
+#include "aclnnop/aclnn_weight_quant_batch_matmul_v2.h"
+#include "utils/log.h"
+#include "utils/utils.h"
+
+// aclnnWeightQuantBatchMatmulV2的输入下标，可选输入为空时也占用下标
+const int ACLNN_X_INDEX = 0;
+const int ACLNN_WEIGHT_INDEX = 1;
+const int ACLNN_ANTIQUANT_SCALE_INDEX = 2;
+const int ACLNN_BIAS_INDEX = 6;
+
+WeightQuantMatmulOperation::WeightQuantMatmulOperation(const std::string &name, AclnnWeightQuantMatmulParam param)
+    : AclnnBaseOperation(name), param_(param)
+{
+}
+
+atb::Status WeightQuantMatmulOperation::InferShape(
+    const atb::SVector<atb::TensorDesc> &inTensorDesc, atb::SVector<atb::TensorDesc> &outTensorDesc) const
+{
+    LOG_INFO(opName_ + " InferShape start");
+    const atb::TensorDesc &x = inTensorDesc.at(0);
+    const atb::TensorDesc &weight = inTensorDesc.at(1);
+    if (x.shape.dimNum < 2 || weight.shape.dimNum != 2 || x.shape.dims[x.shape.dimNum - 1] != weight.shape.dims[0])
+    {
+        LOG_ERROR(opName_ + " invalid input shape");
+        return atb::ERROR_INVALID_TENSOR_DIM;
+    }
+    outTensorDesc.at(0) = x;
+    outTensorDesc.at(0).shape.dims[x.shape.dimNum - 1] = weight.shape.dims[1];
+    LOG_INFO(opName_ + " InferShape end");
+    return atb::NO_ERROR;
+}
+
+uint32_t WeightQuantMatmulOperation::GetInputNum() const
+{
+    return param_.hasBias ? 4 : 3; // x, weight, antiquantScale, [bias]
+}
+
+uint32_t WeightQuantMatmulOperation::GetOutputNum() const
+{
+    return 1;
+}
+
+atb::Status WeightQuantMatmulOperation::CreateAclnnVariantPack(const atb::VariantPack &variantPack)
+{
+    LOG_INFO(opName_ + " CreateAclnnVariantPack start");
+    const int inTensorIdx[] = {ACLNN_X_INDEX, ACLNN_WEIGHT_INDEX, ACLNN_ANTIQUANT_SCALE_INDEX, ACLNN_BIAS_INDEX};
+    aclInTensors_.resize(GetInputNum());
+    for (size_t i = 0; i < aclInTensors_.size(); ++i)
+    {
+        aclInTensors_[i] = CreateContiguousAclnnTensor(variantPack.inTensors.at(i), inTensorIdx[i]);
+        if (aclInTensors_[i]->tensor == nullptr)
+        {
+            LOG_ERROR(opName_ + " InTensor aclCreateTensor index " + std::to_string(i) + " fail");
+            return atb::ERROR_INTERNAL_ERROR;
+        }
+    }
+    aclOutTensors_.resize(GetOutputNum());
+    aclOutTensors_[0] = CreateContiguousAclnnTensor(variantPack.outTensors.at(0), 0);
+    if (aclOutTensors_[0]->tensor == nullptr)
+    {
+        LOG_ERROR(opName_ + " outTensor aclCreateTensor fail");
+        return atb::ERROR_INTERNAL_ERROR;
+    }
+    LOG_INFO(opName_ + " CreateAclnnVariantPack end");
+    return atb::NO_ERROR;
+}
+
+atb::Status WeightQuantMatmulOperation::SetAclnnWorkspaceExecutor()
+{
+    LOG_INFO(opName_ + " SetAclnnWorkspaceExecutor start");
+    auto ret = aclnnWeightQuantBatchMatmulV2GetWorkspaceSize(
+        aclInTensors_.at(0)->tensor,                                       // x
+        aclInTensors_.at(1)->tensor,                                       // weight
+        aclInTensors_.at(2)->tensor,                                       // antiquantScale
+        nullptr,                                                           // antiquantOffset，对称量化不需要
+        nullptr,                                                           // quantScale
+        nullptr,                                                           // quantOffset
+        param_.hasBias ? aclInTensors_.at(3)->tensor : nullptr,            // bias
+        0,                                                                 // antiquantGroupSize，0表示per-channel
+        aclOutTensors_.at(0)->tensor,                                      // y
+        &workspaceSize_,
+        &aclExecutor_);
+    CHECK_RET(ret, opName_ + " aclnnWeightQuantBatchMatmulV2GetWorkspaceSize failed, ret: " + std::to_string(ret));
+    LOG_INFO(opName_ + " SetAclnnWorkspaceExecutor end, workspaceSize_: " + std::to_string(workspaceSize_));
+    return ret;
+}
+
+atb::Status WeightQuantMatmulOperation::ExecuteAclnnOp(uint8_t *workspace, aclrtStream &stream)
+{
+    LOG_INFO(opName_ + " ExecuteAclnnOp start");
+    auto ret = aclnnWeightQuantBatchMatmulV2(workspace, workspaceSize_, aclExecutor_, stream);
+    CHECK_RET(ret, opName_ + " aclnnWeightQuantBatchMatmulV2 failed, ret: " + std::to_string(ret));
+    LOG_INFO(opName_ + " ExecuteAclnnOp end");
+    return ret;
+}
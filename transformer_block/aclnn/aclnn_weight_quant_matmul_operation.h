@@ -0,0 +1,30 @@
+#ifndef ACLNN_WEIGHT_QUANT_MATMUL_OPERATION_H
+#define ACLNN_WEIGHT_QUANT_MATMUL_OPERATION_H
+
+#include "aclnn/aclnn_operation_base.h"
+
+struct AclnnWeightQuantMatmulParam
+{
+    bool hasBias = true;
+};
+
+// W8A16 Linear：y = x @ (weight * antiquantScale) + bias
+// 输入依次为x(fp16 [..., k])、weight(int8 [k, n])、antiquantScale(fp16 [n])、bias(fp16 [1, n])
+class WeightQuantMatmulOperation : public AclnnBaseOperation
+{
+public:
+    WeightQuantMatmulOperation(const std::string &name, AclnnWeightQuantMatmulParam param);
+    atb::Status InferShape(
+        const atb::SVector<atb::TensorDesc> &inTensorDesc, atb::SVector<atb::TensorDesc> &outTensorDesc) const override;
+    uint32_t GetInputNum() const override;
+    uint32_t GetOutputNum() const override;
+
+    atb::Status CreateAclnnVariantPack(const atb::VariantPack &variantPack) override;
+    atb::Status SetAclnnWorkspaceExecutor() override;
+    atb::Status ExecuteAclnnOp(uint8_t *workspace, aclrtStream &stream) override;
+
+private:
+    AclnnWeightQuantMatmulParam param_;
+};
+
+#endif
@@ -1,8 +1,137 @@
 #include "atb/atb_graph_op.h"
+#include "atb/atb_graph_layer_norm.h"
+#include "aclnn/aclnn_fused_ops.h"
+#include "aclnn/aclnn_weight_quant_matmul_operation.h"
 #include "utils/utils.h"
 
-atb::Status CreateGraphOperationLN(atb::Operation **operation)
+static void CreateLayerNormNode(atb::Node &layerNode, uint32_t inX, uint32_t inGamma, uint32_t inBeta, uint32_t out)
 {
+    atb::infer::LayerNormParam layerNormParam;
+    const int32_t BEGIN_NORM_AXIS = 2;
+    layerNormParam.layerType = atb::infer::LayerNormParam::LayerNormType::LAYER_NORM_NORM;
+    layerNormParam.normParam.beginNormAxis = BEGIN_NORM_AXIS;
+    auto status = atb::CreateOperation(layerNormParam, &layerNode.operation);
+    CHECK_RET(status, "layerNormParam CreateOperation failed. status: " + std::to_string(status));
+    layerNode.inTensorIds = {inX, inGamma, inBeta};
+    layerNode.outTensorIds = {out};
+}
+
+// W8A16：LayerNorm -> WeightQuantBatchMatmulV2(aclnn)
+static atb::Status CreateGraphOperationLNW8A16(atb::Operation **operation)
+{
+    atb::GraphParam opGraph;
+    opGraph.inTensorNum = 6;
+    opGraph.outTensorNum = 1;
+    opGraph.internalTensorNum = 1;
+    opGraph.nodes.resize(2);
+
+    enum InTensorId
+    {
+        IN_TENSOR_X = 0,
+        IN_TENSOR_GAMMA,
+        IN_TENSOR_BETA,
+        IN_TENSOR_MATMUL_WEIGHT,
+        IN_TENSOR_MATMUL_BIAS,
+        IN_TENSOR_MATMUL_SCALE,
+        OUT_TENSOR_LN_MATMUL,
+        OUT_TENSOR_LN,
+    };
+
+    CreateLayerNormNode(opGraph.nodes.at(0), IN_TENSOR_X, IN_TENSOR_GAMMA, IN_TENSOR_BETA, OUT_TENSOR_LN);
+
+    // aclnn算子继承atb::Operation，可以直接作为图节点
+    atb::Node &matmulNode = opGraph.nodes.at(1);
+    matmulNode.operation = new WeightQuantMatmulOperation("WeightQuantMatmul", AclnnWeightQuantMatmulParam());
+    matmulNode.inTensorIds = {OUT_TENSOR_LN, IN_TENSOR_MATMUL_WEIGHT, IN_TENSOR_MATMUL_SCALE, IN_TENSOR_MATMUL_BIAS};
+    matmulNode.outTensorIds = {OUT_TENSOR_LN_MATMUL};
+
+    auto status = atb::CreateOperation(opGraph, operation);
+    CHECK_RET(status, "GraphParam CreateOperation failed. status: " + std::to_string(status));
+    LOG_ERROR("完成创建(layerNorm + W8A16 linear)的图");
+    return atb::NO_ERROR;
+}
+
+// W8A8：LayerNorm -> 激活per-tensor量化 -> per-channel量化Linear，int32累加后按deqScale输出fp16
+static atb::Status CreateGraphOperationLNW8A8(atb::Operation **operation)
+{
+    atb::GraphParam opGraph;
+    opGraph.inTensorNum = 8;
+    opGraph.outTensorNum = 1;
+    opGraph.internalTensorNum = 2;
+    opGraph.nodes.resize(3);
+
+    enum InTensorId
+    {
+        IN_TENSOR_X = 0,
+        IN_TENSOR_GAMMA,
+        IN_TENSOR_BETA,
+        IN_TENSOR_MATMUL_WEIGHT,
+        IN_TENSOR_MATMUL_BIAS,
+        IN_TENSOR_MATMUL_SCALE,
+        IN_TENSOR_INPUT_SCALE,
+        IN_TENSOR_INPUT_OFFSET,
+        OUT_TENSOR_LN_MATMUL,
+        OUT_TENSOR_LN,
+        OUT_TENSOR_LN_QUANT,
+    };
+
+    CreateLayerNormNode(opGraph.nodes.at(0), IN_TENSOR_X, IN_TENSOR_GAMMA, IN_TENSOR_BETA, OUT_TENSOR_LN);
+
+    atb::Node &quantNode = opGraph.nodes.at(1);
+    atb::infer::ElewiseParam quantParam;
+    quantParam.elewiseType = atb::infer::ElewiseParam::ElewiseType::ELEWISE_QUANT_PER_CHANNEL;
+    auto status = atb::CreateOperation(quantParam, &quantNode.operation);
+    CHECK_RET(status, "quantParam CreateOperation failed. status: " + std::to_string(status));
+    quantNode.inTensorIds = {OUT_TENSOR_LN, IN_TENSOR_INPUT_SCALE, IN_TENSOR_INPUT_OFFSET};
+    quantNode.outTensorIds = {OUT_TENSOR_LN_QUANT};
+
+    atb::Node &matmulNode = opGraph.nodes.at(2);
+    atb::infer::LinearParam param;
+    param.transposeA = false;
+    param.transposeB = false;
+    param.hasBias = true;
+    param.outDataType = aclDataType::ACL_FLOAT16;
+    param.enAccum = false;
+    param.matmulType = atb::infer::LinearParam::MatmulType::MATMUL_UNDEFINED;
+    param.quantMode = atb::infer::LinearParam::QuantMode::PER_CHANNEL;
+    status = atb::CreateOperation(param, &matmulNode.operation);
+    CHECK_RET(status, "matmulParam CreateOperation failed. status: " + std::to_string(status));
+    matmulNode.inTensorIds = {OUT_TENSOR_LN_QUANT, IN_TENSOR_MATMUL_WEIGHT, IN_TENSOR_MATMUL_BIAS,
+                              IN_TENSOR_MATMUL_SCALE};
+    matmulNode.outTensorIds = {OUT_TENSOR_LN_MATMUL};
+
+    status = atb::CreateOperation(opGraph, operation);
+    CHECK_RET(status, "GraphParam CreateOperation failed. status: " + std::to_string(status));
+    LOG_ERROR("完成创建(layerNorm + W8A8 linear)的图");
+    return atb::NO_ERROR;
+}
+
+const char *LinearKernelToString(LinearKernel kernel)
+{
+    return kernel == LinearKernel::ACLNN_MATMUL ? "aclnn_matmul" : "atb_linear";
+}
+
+bool ParseLinearKernel(const std::string &text, LinearKernel &kernel)
+{
+    for (LinearKernel candidate : {LinearKernel::ATB_LINEAR, LinearKernel::ACLNN_MATMUL}) {
+        if (text == LinearKernelToString(candidate)) {
+            kernel = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+atb::Status CreateGraphOperationLN(atb::Operation **operation, LinearQuantType quantType, bool transposeB,
+                                   LinearKernel linearKernel)
+{
+    if (quantType == LinearQuantType::W8A16) {
+        return CreateGraphOperationLNW8A16(operation);
+    }
+    if (quantType == LinearQuantType::W8A8) {
+        return CreateGraphOperationLNW8A8(operation);
+    }
+
     // 构图流程
     // 图算子的输入a,b,c,d
     // 计算公式：(a+b) + (c+d)
@@ -21,8 +150,8 @@ atb::Status CreateGraphOperationLN(atb::Operation **operation)
         IN_TENSOR_BETA,
         IN_TENSOR_MATMUL_WEIGHT,
         IN_TENSOR_MATMUL_BIAS,
-        OUT_TENSOR_LN,
-        OUT_TENSOR_LN_MATMUL,
+        OUT_TENSOR_LN_MATMUL, // 图的输出tensor
+        OUT_TENSOR_LN,        // 中间tensor，id需排在输出之后
     };
 
     size_t nodeId = 0;
@@ -39,19 +168,23 @@ atb::Status CreateGraphOperationLN(atb::Operation **operation)
     layerNode.inTensorIds = {IN_TENSOR_X,IN_TENSOR_GAMMA,IN_TENSOR_BETA};
     layerNode.outTensorIds = {OUT_TENSOR_LN};
 
-    // 创建node:(a+b)
-    // atb用来创建operation,operation可以组成graph
-    atb::infer::LinearParam param;
-    param.transposeA = false;
-    param.transposeB = false;
-    param.hasBias = true;
-    param.outDataType = aclDataType::ACL_DT_UNDEFINED;
-    param.enAccum = false;
-    param.matmulType = atb::infer::LinearParam::MatmulType::MATMUL_UNDEFINED;
-    param.quantMode = atb::infer::LinearParam::QuantMode::QUANT_UNDEFINED;
-    // 创建operation需要两个参数，参数和operation二级指针
-    status = atb::CreateOperation(param, &matmulNode.operation); // 每个node需要配置单算子对象实例
-    CHECK_RET(status, "matmulParam CreateOperation failed. status: " + std::to_string(status));
+    if (linearKernel == LinearKernel::ACLNN_MATMUL && !transposeB) {
+        matmulNode.operation = new MatmulBiasOperation("MatmulBias");
+    } else {
+        // 创建node:(a+b)
+        // atb用来创建operation,operation可以组成graph
+        atb::infer::LinearParam param;
+        param.transposeA = false;
+        param.transposeB = transposeB;
+        param.hasBias = true;
+        param.outDataType = aclDataType::ACL_DT_UNDEFINED;
+        param.enAccum = false;
+        param.matmulType = atb::infer::LinearParam::MatmulType::MATMUL_UNDEFINED;
+        param.quantMode = atb::infer::LinearParam::QuantMode::QUANT_UNDEFINED;
+        // 创建operation需要两个参数，参数和operation二级指针
+        status = atb::CreateOperation(param, &matmulNode.operation); // 每个node需要配置单算子对象实例
+        CHECK_RET(status, "matmulParam CreateOperation failed. status: " + std::to_string(status));
+    }
     matmulNode.inTensorIds = {OUT_TENSOR_LN, IN_TENSOR_MATMUL_WEIGHT, IN_TENSOR_MATMUL_BIAS}; // 每个node需要配置输入的tensor id
     matmulNode.outTensorIds = {OUT_TENSOR_LN_MATMUL}; // 每个node需要配置输出的tensor id
 
@@ -1,6 +1,7 @@
 #ifndef ATB_GRAPH_OP_H_LAYER_NORM
 #define ATB_GRAPH_OP_H_LAYER_NORM
 
+#include <string>
 #include <acl/acl.h>
 #include <atb/atb_infer.h>
 #include <atb/types.h>
@@ -10,6 +11,29 @@
 // 在构造图参数时，有两个点需要重点关注。一是Tensor的ID，ATB图接口中把Tensor分为三种类型，输入、输出和中间Tensor，顾名思义，输入输出Tensor是整图的输入输出Tensor，
 // 中间tensor则是在整图内的Tensor。构图时的TensorID从小到大应保证//为输入Tensor、输出Tensor、中间Tensor的顺序，且每一种Tensor的个数要与参数中设置的一致。
 // 二是要注意排布Node的顺序，用户需要根据计算图的拓扑结构把计算图变成一个有序队列，同时还要保证tensor与节点之间的关系和计算图保持一致。
-atb::Status CreateGraphOperationLN(atb::Operation **operation);
+// Linear的权重量化方式
+enum class LinearQuantType
+{
+    FP16 = 0, // 输入x, gamma, beta, weight(fp16), bias(fp16)
+    W8A16,    // 输入x, gamma, beta, weight(int8), bias(fp16), antiquantScale(fp16 [n])
+    W8A8,     // 输入x, gamma, beta, weight(int8), bias(int32), deqScale(float [1, n]), inputScale(fp16 [1]), inputOffset(int8 [1])
+};
+
+// FP16 Linear的实现，由KernelTuner按形状选择
+enum class LinearKernel
+{
+    ATB_LINEAR = 0, // atb LinearParam
+    ACLNN_MATMUL,   // aclnn FusedMatmul（matmul + bias），只支持ND的[k, n]权重
+};
+
+// KernelTuner中的实现名
+const char *LinearKernelToString(LinearKernel kernel);
+bool ParseLinearKernel(const std::string &text, LinearKernel &kernel);
+
+// LayerNorm + Linear图，quantType决定Linear的实现和图的输入
+// transposeB只用于FP16，为true时weight为预先转置的[n, k]；FRACTAL_NZ权重由weight的TensorDesc声明，图不需要改变
+// linearKernel只用于FP16，transposeB时始终使用ATB_LINEAR
+atb::Status CreateGraphOperationLN(atb::Operation **operation, LinearQuantType quantType = LinearQuantType::FP16,
+                                   bool transposeB = false, LinearKernel linearKernel = LinearKernel::ATB_LINEAR);
 
 #endif
\ No newline at end of file
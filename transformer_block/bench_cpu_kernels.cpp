@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "reference/cpu_kernels.h"
+#include "utils/dtype_convert.h"
+#include "utils/log.h"
+#include "utils/tensor_convert.h"
+
+// 参考kernel基准：以标量实现（朴素循环）为基线，逐个指令集测量耗时、加速比和与基线的最大误差
+// 形状取ViT-B/16的一层：197个token，hidden 768，MLP 3072
+// 另外对比fp16/bf16批量转换与逐元素标量转换的耗时，并校验两者结果逐位一致
+constexpr int64_t TOKENS = 197;
+constexpr int64_t HIDDEN = 768;
+constexpr int64_t MLP_HIDDEN = 3072;
+constexpr int REPEAT_COUNT = 5;
+constexpr float LAYER_NORM_EPSILON = 1e-5f;
+constexpr int64_t CONVERT_COUNT = 16 * 1024 * 1024 + 7; // 带尾部的大张量
+
+std::vector<float> RandomVector(int64_t count, float range, uint32_t seed)
+{
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> dist(-range, range);
+    std::vector<float> result(count);
+    for (auto &value : result) {
+        value = dist(engine);
+    }
+    return result;
+}
+
+// 取多次执行中的最小耗时（毫秒）
+double MeasureMs(const std::function<void()> &func)
+{
+    double best = 0;
+    for (int i = 0; i < REPEAT_COUNT; i++) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = i == 0 ? elapsed.count() : std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+double MaxAbsDiff(const std::vector<float> &a, const std::vector<float> &b)
+{
+    double result = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        result = std::max(result, static_cast<double>(std::fabs(a[i] - b[i])));
+    }
+    return result;
+}
+
+// 在每个支持的指令集上运行同一个kernel，flops为0时不输出GFLOP/s
+void BenchKernel(const std::string &name, double flops, std::vector<float> &output,
+                 const std::function<void()> &func)
+{
+    std::vector<float> baseline;
+    double baselineMs = 0;
+    for (int isa = static_cast<int>(CpuIsa::SCALAR); isa <= static_cast<int>(GetSupportedCpuIsa()); isa++) {
+        SetCpuIsa(static_cast<CpuIsa>(isa));
+        double ms = MeasureMs(func);
+        std::string line = name + " " + GetCpuIsaName(static_cast<CpuIsa>(isa)) + ": " + std::to_string(ms) + " ms";
+        if (flops > 0) {
+            line += ", " + std::to_string(flops / ms / 1e6) + " GFLOP/s";
+        }
+        if (isa == static_cast<int>(CpuIsa::SCALAR)) {
+            baseline = output;
+            baselineMs = ms;
+        } else {
+            line += ", speedup " + std::to_string(baselineMs / ms) + "x, max abs diff " +
+                    std::to_string(MaxAbsDiff(baseline, output));
+        }
+        LOG_ERROR(line);
+    }
+    SetCpuIsa(GetSupportedCpuIsa());
+}
+
+// 逐元素标量转换为基线，批量转换结果需与之逐位一致
+template <typename SrcT, typename DstT, typename ScalarFunc, typename BulkFunc>
+bool BenchConvert(const std::string &name, const std::vector<SrcT> &src, ScalarFunc scalar, BulkFunc bulk)
+{
+    std::vector<DstT> expected(src.size());
+    std::vector<DstT> actual(src.size());
+    double scalarMs = MeasureMs([&]() {
+        for (size_t i = 0; i < src.size(); i++) {
+            expected[i] = scalar(src[i]);
+        }
+    });
+    double bulkMs = MeasureMs([&]() { bulk(src.data(), actual.data(), static_cast<int64_t>(src.size())); });
+    // 按位比较，nan也需一致
+    bool same = std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(DstT)) == 0;
+    LOG_ERROR(name + ": scalar " + std::to_string(scalarMs) + " ms, bulk " + std::to_string(bulkMs) + " ms, speedup " +
+              std::to_string(scalarMs / bulkMs) + "x, " + (same ? "bit exact" : "MISMATCH"));
+    return same;
+}
+
+bool BenchConversions()
+{
+    LOG_ERROR(std::string("tensor convert isa: ") + GetTensorConvertIsaName());
+    // 覆盖fp16的非规格化数、溢出、舍入边界以及inf/nan
+    std::vector<float> floats = RandomVector(CONVERT_COUNT, 70000.0f, 6);
+    std::vector<float> small = RandomVector(CONVERT_COUNT / 4, 1e-4f, 7);
+    std::copy(small.begin(), small.end(), floats.begin());
+    floats[0] = INFINITY;
+    floats[1] = -INFINITY;
+    floats[2] = NAN;
+    floats[3] = 65520.0f;
+    floats[4] = 2.0f;
+    std::vector<uint16_t> halfs(CONVERT_COUNT);
+    for (int64_t i = 0; i < CONVERT_COUNT; i++) {
+        halfs[i] = static_cast<uint16_t>(i * 40503u);
+    }
+
+    bool passed = BenchConvert<float, uint16_t>("float->fp16", floats, FloatToFp16, ConvertFloatToFp16);
+    passed = BenchConvert<uint16_t, float>("fp16->float", halfs, Fp16ToFloat, ConvertFp16ToFloat) && passed;
+    passed = BenchConvert<float, uint16_t>("float->bf16", floats, FloatToBf16, ConvertFloatToBf16) && passed;
+    passed = BenchConvert<uint16_t, float>("bf16->float", halfs, Bf16ToFloat, ConvertBf16ToFloat) && passed;
+    return passed;
+}
+
+int main()
+{
+    LOG_ERROR(std::string("supported isa: ") + GetCpuIsaName(GetSupportedCpuIsa()));
+
+    std::vector<float> x = RandomVector(TOKENS * HIDDEN, 2.0f, 1);
+    std::vector<float> gamma = RandomVector(HIDDEN, 1.0f, 2);
+    std::vector<float> beta = RandomVector(HIDDEN, 1.0f, 3);
+    std::vector<float> normed(TOKENS * HIDDEN);
+    BenchKernel("layernorm [197, 768]", 0, normed, [&]() {
+        CpuLayerNorm(x.data(), gamma.data(), beta.data(), normed.data(), TOKENS, HIDDEN, LAYER_NORM_EPSILON);
+    });
+
+    std::vector<float> weight = RandomVector(HIDDEN * MLP_HIDDEN, 0.05f, 4);
+    std::vector<float> bias = RandomVector(MLP_HIDDEN, 0.05f, 5);
+    std::vector<float> hidden(TOKENS * MLP_HIDDEN);
+    double linearFlops = 2.0 * TOKENS * HIDDEN * MLP_HIDDEN;
+    BenchKernel("linear [197, 768] x [768, 3072]", linearFlops, hidden, [&]() {
+        CpuLinear(x.data(), weight.data(), bias.data(), hidden.data(), TOKENS, HIDDEN, MLP_HIDDEN, false);
+    });
+    BenchKernel("linear transposeB [197, 768] x [3072, 768]", linearFlops, hidden, [&]() {
+        CpuLinear(x.data(), weight.data(), bias.data(), hidden.data(), TOKENS, HIDDEN, MLP_HIDDEN, true);
+    });
+
+    std::vector<float> activated(TOKENS * MLP_HIDDEN);
+    BenchKernel("gelu erf [197, 3072]", 0, activated,
+                [&]() { CpuGelu(hidden.data(), activated.data(), TOKENS * MLP_HIDDEN, 0); });
+    BenchKernel("gelu tanh [197, 3072]", 0, activated,
+                [&]() { CpuGelu(hidden.data(), activated.data(), TOKENS * MLP_HIDDEN, 1); });
+
+    return BenchConversions() ? 0 : 1;
+}
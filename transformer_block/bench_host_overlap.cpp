@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "memory/memory_utils.h"
+#include "model/model.h"
+#include "model/model2.h"
+#include "utils/arg_parse.h"
+#include "utils/metrics.h"
+#include "utils/tensor_io.h"
+#include "utils/utils.h"
+
+// host准备与device执行重叠的基准：同一模型分别在执行线程上串行准备和下发节点（serial），
+// 以及由准备线程提前准备节点、执行线程只下发（pipelined），输出每次Execute的耗时和device在节点之间等待host的空闲时间
+//   cold  每次新建模型，第一次执行该形状，aclnn算子的Setup需要创建executor
+//   warm  同一模型预热后重复执行
+// 仿真后端的kernel在CPU上计算，比NPU慢约两个数量级，host开销按同样比例默认模拟为每次Setup 20000us、
+// 每次下发kernel 2000us，可用SIM_SETUP_LATENCY_US、SIM_LAUNCH_LATENCY_US覆盖
+// 准备线程只能把节点i的下发与节点i+1的准备重叠，空闲时间最多减少各节点的下发耗时
+// 两种方式的输出不一致时返回1
+// 用法见USAGE，参数无效时输出用法并返回1
+constexpr size_t POOL_SIZE = 104857600; // Alloceted memory 100 MiB.
+constexpr const char *USAGE = "usage: bench_host_overlap [--model model|model2] [--cold N>0] [--iters N>0]";
+constexpr uint32_t WARMUP_COUNT = 2;
+
+struct OverlapConfig
+{
+    std::string model = "model";
+    uint32_t cold = 5;
+    uint32_t iters = 20;
+};
+
+// 多次Execute的累计
+struct OverlapStats
+{
+    double executeMs = 0;
+    double idleMs = 0;
+    uint32_t count = 0;
+};
+
+static bool ParseArgs(int argc, char **argv, OverlapConfig &config)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            LOG_ERROR("missing value for " + arg);
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--model") {
+            config.model = value;
+        } else if (arg == "--cold") {
+            if (!ParseUint32Arg(arg, value, config.cold)) {
+                return false;
+            }
+        } else if (arg == "--iters") {
+            if (!ParseUint32Arg(arg, value, config.iters)) {
+                return false;
+            }
+        } else {
+            LOG_ERROR("unknown argument " + arg);
+            return false;
+        }
+    }
+    if (config.model != "model" && config.model != "model2") {
+        LOG_ERROR("unknown model " + config.model);
+        return false;
+    }
+    if (config.cold == 0 || config.iters == 0) {
+        LOG_ERROR("--cold and --iters must be positive");
+        return false;
+    }
+    return true;
+}
+
+// 新建模型，预热warmup次后计时执行iters次，空闲时间取自NodeMetrics记录的model_device_idle_seconds
+template <typename ModelT>
+static bool RunModel(const std::string &label, bool pipelined, uint32_t warmup, uint32_t iters, OverlapStats &stats,
+                     std::vector<float> &output)
+{
+    LatencyHistogram &idle =
+        GetMetrics().GetHistogram("model_device_idle_seconds",
+                                  "Device idle time between consecutive nodes of one model Execute",
+                                  "model=\"" + label + "\"");
+    ModelT model;
+    model.InitResource(0);
+    if (!model.SetHostPipeline(pipelined)) {
+        model.FreeResource();
+        return false;
+    }
+    model.CreateModelGraph();
+    model.CreateModelInput();
+    model.CreateModelOutput();
+    for (uint32_t i = 0; i < warmup; i++) {
+        model.Execute();
+    }
+
+    HistogramSnapshot before = idle.Snapshot();
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iters; i++) {
+        model.Execute();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    HistogramSnapshot after = idle.Snapshot();
+    stats.executeMs += elapsed.count();
+    stats.idleMs += (after.sumNs - before.sumNs) / 1e6;
+    stats.count += iters;
+    output = DownloadTensor(model.model_outTensors_.at(0));
+    model.FreeResource();
+    return true;
+}
+
+template <typename ModelT>
+static bool RunBench(const OverlapConfig &config, const std::string &label)
+{
+    const char *phases[] = {"cold", "warm"};
+    OverlapStats results[2][2]; // [phase][pipelined]
+    std::vector<float> outputs[2];
+    for (int pipelined = 0; pipelined < 2; pipelined++) {
+        for (uint32_t i = 0; i < config.cold; i++) {
+            if (!RunModel<ModelT>(label, pipelined != 0, 0, 1, results[0][pipelined], outputs[pipelined])) {
+                return false;
+            }
+        }
+        if (!RunModel<ModelT>(label, pipelined != 0, WARMUP_COUNT, config.iters, results[1][pipelined],
+                              outputs[pipelined])) {
+            return false;
+        }
+    }
+
+    for (int phase = 0; phase < 2; phase++) {
+        const OverlapStats &serial = results[phase][0];
+        const OverlapStats &pipelined = results[phase][1];
+        for (int mode = 0; mode < 2; mode++) {
+            const OverlapStats &stats = results[phase][mode];
+            LOG_ERROR(label + " " + phases[phase] + " " + (mode == 0 ? "serial" : "pipelined") + ": execute " +
+                      std::to_string(stats.executeMs / stats.count) + " ms, device idle " +
+                      std::to_string(stats.idleMs / stats.count) + " ms per Execute");
+        }
+        LOG_ERROR(label + " " + phases[phase] + " device idle " + std::to_string(serial.idleMs / serial.count) +
+                  " ms -> " + std::to_string(pipelined.idleMs / pipelined.count) + " ms, execute " +
+                  std::to_string(serial.executeMs / serial.count) + " ms -> " +
+                  std::to_string(pipelined.executeMs / pipelined.count) + " ms");
+    }
+
+    bool passed = outputs[0].size() == outputs[1].size() && !outputs[0].empty();
+    double maxError = 0;
+    for (size_t i = 0; passed && i < outputs[0].size(); i++) {
+        maxError = std::max(maxError, static_cast<double>(std::fabs(outputs[0][i] - outputs[1][i])));
+    }
+    passed = passed && maxError == 0;
+    LOG_ERROR(label + " output serial vs pipelined: max abs error " + std::to_string(maxError));
+    return passed;
+}
+
+int main(int argc, char **argv)
+{
+    OverlapConfig config;
+    if (!ParseArgs(argc, argv, config)) {
+        LOG_ERROR(USAGE);
+        return 1;
+    }
+    // 只对仿真后端生效，已设置时不覆盖
+    setenv("SIM_SETUP_LATENCY_US", "20000", 0);
+    setenv("SIM_LAUNCH_LATENCY_US", "2000", 0);
+    LOG_ERROR(std::string("sim host latency: setup ") + std::getenv("SIM_SETUP_LATENCY_US") + " us, launch " +
+              std::getenv("SIM_LAUNCH_LATENCY_US") + " us");
+
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+    GetMemoryManager().CreateMemoryPool(POOL_SIZE);
+    GetMetrics().Enable();
+
+    bool passed = config.model == "model" ? RunBench<Model>(config, "Model") : RunBench<Model2>(config, "Model2");
+    aclFinalize();
+    LOG_ERROR(passed ? "host overlap check passed" : "host overlap check failed");
+    return passed ? 0 : 1;
+}
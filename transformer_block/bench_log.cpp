@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/log.h"
+
+// 多线程日志基准：同步（调用线程加锁写入并刷新）与异步（线程缓冲区 + 后台批量写入）两种模式下，
+// 每个线程连续调用LOG_ERROR，统计单次调用的平均/p99耗时和包含Flush在内的总吞吐
+// 日志只写入BENCH_LOG_FILE，结束后检查行数与写入条数一致，不一致时返回1
+// 另外在运行时级别为ERROR时，对比一次Model2::Execute中各LOG_INFO调用点先构造参数再判断级别（旧宏）与先判断级别的耗时
+constexpr int MESSAGES_PER_THREAD = 20000;
+constexpr int EXECUTE_REPEAT = 100000;
+constexpr int NODE_COUNT = 2;
+constexpr const char *BENCH_LOG_FILE = "bench_log.log";
+const std::vector<int> THREAD_COUNTS = {1, 2, 4, 8};
+
+struct BenchResult
+{
+    double meanNs = 0;
+    double p99Ns = 0;
+    double messagesPerSecond = 0;
+};
+
+BenchResult RunBench(int threadCount)
+{
+    std::vector<std::vector<double>> latencies(threadCount, std::vector<double>(MESSAGES_PER_THREAD));
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([t, &latencies]() {
+            for (int i = 0; i < MESSAGES_PER_THREAD; i++)
+            {
+                auto begin = std::chrono::steady_clock::now();
+                LOG_ERROR("bench thread " + std::to_string(t) + " message " + std::to_string(i) +
+                          ", node 3 execute done, workspace 1048576 bytes");
+                std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+                latencies[t][i] = elapsed.count();
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    AsyncLogWriter::GetInstance().Flush();
+    std::chrono::duration<double> total = std::chrono::steady_clock::now() - start;
+
+    std::vector<double> all;
+    for (const auto &values : latencies)
+    {
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    std::sort(all.begin(), all.end());
+    BenchResult result;
+    for (double value : all)
+    {
+        result.meanNs += value;
+    }
+    result.meanNs /= all.size();
+    result.p99Ns = all[all.size() * 99 / 100];
+    result.messagesPerSecond = all.size() / total.count();
+    return result;
+}
+
+// 旧宏的展开方式：先构造参数，再在log内部判断级别
+#define EAGER_LOG_INFO(...) GetLogger().log(LogLevel::INFO, __FILENAME__, __LINE__, "%s", ##__VA_ARGS__)
+
+// 与Model2::Execute、BuildNodeVariantPack、ExecuteNode和AclnnBaseOperation::Setup/Execute中的LOG_INFO参数相同
+#define EXECUTE_LOG_SITES(LOG_MACRO)                                                                       \
+    LOG_MACRO(modelName + " Execute start");                                                               \
+    for (int nodeId = 0; nodeId < NODE_COUNT; nodeId++)                                                    \
+    {                                                                                                      \
+        LOG_MACRO("buildNodeVariantPack nodes[" + std::to_string(nodeId) + "] start");                     \
+        LOG_MACRO("buildNodeVariantPack nodes[" + std::to_string(nodeId) + "] end");                       \
+        LOG_MACRO(opName + " setup start");                                                                \
+        LOG_MACRO(opName + " setup end");                                                                  \
+        LOG_MACRO("Get node[" + std::to_string(nodeId) + "] workspace size:" + std::to_string(workspace)); \
+        LOG_MACRO("Execute node[" + std::to_string(nodeId) + "] start");                                   \
+        LOG_MACRO(opName + " execute start");                                                              \
+        LOG_MACRO("Input workspaceSize " + std::to_string(workspace) + " localCache workspaceSize " +      \
+                  std::to_string(workspace));                                                              \
+        LOG_MACRO(opName + " execute start");                                                              \
+        LOG_MACRO("Execute node[" + std::to_string(nodeId) + "] end");                                     \
+    }                                                                                                      \
+    LOG_MACRO(modelName + " Execute end")
+
+void EagerExecuteLogs(const std::string &modelName, const std::string &opName, uint64_t workspace)
+{
+    EXECUTE_LOG_SITES(EAGER_LOG_INFO);
+}
+
+void LazyExecuteLogs(const std::string &modelName, const std::string &opName, uint64_t workspace)
+{
+    EXECUTE_LOG_SITES(LOG_INFO);
+}
+
+// 每次Execute中日志调用点的平均耗时（纳秒）
+double MeasureExecuteLogs(void (*func)(const std::string &, const std::string &, uint64_t))
+{
+    std::string modelName = "model2";
+    std::string opName = "Gelu";
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < EXECUTE_REPEAT; i++)
+    {
+        func(modelName, opName, static_cast<uint64_t>(i));
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / EXECUTE_REPEAT;
+}
+
+// 每行需以时间戳开头，用于检查记录没有丢失或交错
+bool CheckLogFile(int64_t expectedLines)
+{
+    std::ifstream file(BENCH_LOG_FILE);
+    std::string line;
+    int64_t lines = 0;
+    bool wellFormed = true;
+    while (std::getline(file, line))
+    {
+        lines++;
+        wellFormed = wellFormed && !line.empty() && line[0] == '[';
+    }
+    std::printf("log file lines: %ld, expected %ld, %s\n", static_cast<long>(lines),
+                static_cast<long>(expectedLines), wellFormed ? "well formed" : "MALFORMED");
+    return wellFormed && lines == expectedLines;
+}
+
+int main()
+{
+    GetLogger().setMinLogLevel(LogLevel::ERROR);
+    std::printf("LOG_MIN_LEVEL %d, per Execute log cost at ERROR: eager %.1f ns, lazy %.1f ns\n", LOG_MIN_LEVEL,
+                MeasureExecuteLogs(EagerExecuteLogs), MeasureExecuteLogs(LazyExecuteLogs));
+
+    AsyncLogWriter &writer = AsyncLogWriter::GetInstance();
+    writer.SetConsoleSink(false);
+    writer.ClearFileSinks();
+    std::remove(BENCH_LOG_FILE);
+    writer.AddFileSink(BENCH_LOG_FILE);
+
+    int64_t expectedLines = 0;
+    for (bool async : {false, true})
+    {
+        writer.SetAsync(async);
+        for (int threadCount : THREAD_COUNTS)
+        {
+            BenchResult result = RunBench(threadCount);
+            expectedLines += static_cast<int64_t>(threadCount) * MESSAGES_PER_THREAD;
+            std::printf("%s threads %d: mean %.0f ns, p99 %.0f ns, %.0f messages/s\n", async ? "async" : "sync ",
+                        threadCount, result.meanNs, result.p99Ns, result.messagesPerSecond);
+        }
+    }
+    std::printf("producer waits on full buffer: %lu\n", static_cast<unsigned long>(writer.GetFullWaitCount()));
+
+    writer.ClearFileSinks();
+    bool passed = CheckLogFile(expectedLines);
+    std::remove(BENCH_LOG_FILE);
+    return passed ? 0 : 1;
+}
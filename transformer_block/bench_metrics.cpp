@@ -0,0 +1,169 @@
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/log.h"
+#include "utils/metrics.h"
+
+// 指标打点开销基准：多线程下每次打点的平均耗时
+//   disabled  指标未开启，打点处只检查IsEnabled
+//   counter   Counter::Add
+//   histogram LatencyHistogram::RecordNs
+//   mutex     同样的桶结构，用一把互斥锁保护（对照）
+// 结束后检查各指标的计数与打点次数一致、分位数误差在桶宽内、输出桶按"观测值 <= le"计数，
+// 不一致时返回1，最后输出一段Prometheus文本
+constexpr int RECORDS_PER_THREAD = 2000000;
+const std::vector<int> THREAD_COUNTS = {1, 2, 4, 8};
+
+// 对照组：加锁的单份直方图
+class MutexHistogram
+{
+public:
+    MutexHistogram()
+        : buckets_(LatencyHistogram::BUCKET_COUNT, 0), exportBuckets_(LatencyHistogram::EXPORT_BUCKET_COUNT + 1, 0)
+    {
+    }
+
+    void RecordNs(uint64_t ns)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        buckets_[LatencyHistogram::BucketIndex(ns)]++;
+        exportBuckets_[LatencyHistogram::ExportBucketIndex(ns)]++;
+        sumNs_ += ns;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<uint64_t> buckets_;
+    std::vector<uint64_t> exportBuckets_;
+    uint64_t sumNs_ = 0;
+};
+
+// 打点的值取自一个简单的伪随机序列，覆盖1us~1ms
+static uint64_t SampleNs(uint64_t &state)
+{
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return 1000 + (state >> 33) % 1000000;
+}
+
+// 每次打点的平均耗时（纳秒）
+template <typename RecordFunc>
+double Measure(int threadCount, RecordFunc record)
+{
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([t, &record]() {
+            uint64_t state = static_cast<uint64_t>(t) + 1;
+            for (int i = 0; i < RECORDS_PER_THREAD; i++)
+            {
+                record(SampleNs(state));
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    // 各线程并行，按单个线程的打点次数折算
+    return elapsed.count() / RECORDS_PER_THREAD;
+}
+
+// 均匀分布1us~1ms的分位数与理论值比较，误差不超过桶宽（1/16）
+bool CheckPercentiles()
+{
+    LatencyHistogram histogram;
+    for (uint64_t ns = 1000; ns <= 1000000; ns++)
+    {
+        histogram.RecordNs(ns);
+    }
+    HistogramSnapshot snapshot = histogram.Snapshot();
+    bool passed = snapshot.count == 999001 && snapshot.maxNs == 1000000;
+    for (double ratio : {0.5, 0.9, 0.99, 0.999})
+    {
+        double expected = 1000 + ratio * 999000;
+        double actual = static_cast<double>(snapshot.PercentileNs(ratio));
+        double error = (actual - expected) / expected;
+        std::ostringstream percentile;
+        percentile << "p" << ratio * 100;
+        LOG_ERROR(percentile.str() + ": " + std::to_string(actual) + " ns, expected " + std::to_string(expected) +
+                  " ns, error " + std::to_string(error * 100) + "%");
+        passed = passed && error >= -0.001 && error <= 1.0 / LatencyHistogram::SUB_BUCKET_COUNT;
+    }
+    return passed;
+}
+
+// 内部桶[9728, 10240)ns跨过le=10us，9000~11000ns每个值记录一次，le=10us的桶恰好包含9000~10000ns
+bool CheckExportBuckets()
+{
+    LatencyHistogram histogram;
+    for (uint64_t ns = 9000; ns <= 11000; ns++)
+    {
+        histogram.RecordNs(ns);
+    }
+    histogram.RecordNs(LatencyHistogram::EXPORT_UPPER_NS[LatencyHistogram::EXPORT_BUCKET_COUNT - 1] + 1);
+    HistogramSnapshot snapshot = histogram.Snapshot();
+    uint64_t le10us = snapshot.exportBuckets[0];
+    uint64_t le25us = snapshot.exportBuckets[1];
+    uint64_t overflow = snapshot.exportBuckets[LatencyHistogram::EXPORT_BUCKET_COUNT];
+    LOG_ERROR("export buckets: le=10us " + std::to_string(le10us) + ", (10us, 25us] " + std::to_string(le25us) +
+              ", +Inf only " + std::to_string(overflow));
+    return le10us == 1001 && le25us == 1000 && overflow == 1;
+}
+
+int main()
+{
+    MetricsRegistry &metrics = GetMetrics();
+    bool passed = CheckPercentiles();
+    passed = CheckExportBuckets() && passed;
+    for (int threadCount : THREAD_COUNTS)
+    {
+        Counter &counter = metrics.GetCounter("bench_records_total", "Records of the bench",
+                                              "threads=\"" + std::to_string(threadCount) + "\"");
+        LatencyHistogram &histogram = metrics.GetHistogram("bench_record_seconds", "Recorded values of the bench",
+                                                           "threads=\"" + std::to_string(threadCount) + "\"");
+        MutexHistogram mutexHistogram;
+
+        metrics.Disable();
+        double disabledNs = Measure(threadCount, [&histogram, &metrics](uint64_t ns) {
+            if (metrics.IsEnabled())
+            {
+                histogram.RecordNs(ns);
+            }
+        });
+        metrics.Enable();
+        double counterNs = Measure(threadCount, [&counter](uint64_t) { counter.Add(); });
+        double histogramNs = Measure(threadCount, [&histogram](uint64_t ns) { histogram.RecordNs(ns); });
+        double mutexNs = Measure(threadCount, [&mutexHistogram](uint64_t ns) { mutexHistogram.RecordNs(ns); });
+        LOG_ERROR("threads " + std::to_string(threadCount) + ": disabled " + std::to_string(disabledNs) +
+                  " ns, counter " + std::to_string(counterNs) + " ns, histogram " + std::to_string(histogramNs) +
+                  " ns, mutex histogram " + std::to_string(mutexNs) + " ns");
+
+        uint64_t expectedRecords = static_cast<uint64_t>(threadCount) * RECORDS_PER_THREAD;
+        bool counted = counter.Value() == expectedRecords && histogram.Snapshot().count == expectedRecords;
+        if (!counted)
+        {
+            LOG_ERROR("threads " + std::to_string(threadCount) + ": count mismatch, counter " +
+                      std::to_string(counter.Value()) + ", histogram " + std::to_string(histogram.Snapshot().count) +
+                      ", expected " + std::to_string(expectedRecords));
+        }
+        passed = passed && counted;
+    }
+
+    // 输出最后一组的Prometheus文本
+    std::istringstream text(metrics.RenderPrometheus());
+    std::string line;
+    while (std::getline(text, line))
+    {
+        if (line[0] == '#' || line.find("threads=\"" + std::to_string(THREAD_COUNTS.back()) + "\"") != std::string::npos)
+        {
+            LOG_ERROR(line);
+        }
+    }
+    LOG_ERROR(passed ? "metrics check passed" : "metrics check failed");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "memory/memory_utils.h"
+#include "model/model.h"
+#include "model/model2.h"
+#include "runtime/kernel_tuner.h"
+#include "utils/arg_parse.h"
+#include "utils/utils.h"
+
+// 模型性能基准：多线程多device反复执行模型，输出延迟分位数、吞吐和内存池峰值的JSON
+// 用法见USAGE，参数无效时输出用法并返回1
+// --autotune tune时构图前对没有记录的形状计时选择实现并写入--tuning-cache，cached只读取已有选择
+// 内存池开关在编译时决定，bench_model使用内存池，bench_model_nopool定义了DISABLE_MEMPOOL
+constexpr size_t POOL_SIZE = 104857600; // Alloceted memory 100 MiB.
+constexpr const char *USAGE =
+    "usage: bench_model [--model model|model2] [--warmup N] [--iters N>0] [--batch N>0] [--threads N>0] "
+    "[--devices N] [--output path] [--autotune off|cached|tune] [--tuning-cache path]";
+
+struct BenchConfig
+{
+    std::string model = "model2";
+    uint32_t warmup = 3;
+    uint32_t iters = 20;
+    uint32_t batch = 1;
+    uint32_t threads = 1;
+    uint32_t devices = 0; // 0表示使用全部device
+    std::string output;
+    AutotuneMode autotune = AutotuneMode::OFF;
+    std::string tuningCache;
+};
+
+// 所有线程完成初始化和预热后同时开始计时
+class StartGate
+{
+public:
+    explicit StartGate(uint32_t count) : remaining_(count) {}
+
+    void ArriveAndWait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (--remaining_ == 0) {
+            start_ = std::chrono::steady_clock::now();
+            cv_.notify_all();
+            return;
+        }
+        cv_.wait(lock, [this] { return remaining_ == 0; });
+    }
+
+    std::chrono::steady_clock::time_point GetStartTime() const
+    {
+        return start_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint32_t remaining_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+static bool ParseArgs(int argc, char **argv, BenchConfig &config)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            LOG_ERROR("missing value for " + arg);
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--model") {
+            config.model = value;
+        } else if (arg == "--warmup") {
+            if (!ParseUint32Arg(arg, value, config.warmup)) {
+                return false;
+            }
+        } else if (arg == "--iters") {
+            if (!ParseUint32Arg(arg, value, config.iters)) {
+                return false;
+            }
+        } else if (arg == "--batch") {
+            if (!ParseUint32Arg(arg, value, config.batch)) {
+                return false;
+            }
+        } else if (arg == "--threads") {
+            if (!ParseUint32Arg(arg, value, config.threads)) {
+                return false;
+            }
+        } else if (arg == "--devices") {
+            if (!ParseUint32Arg(arg, value, config.devices)) {
+                return false;
+            }
+        } else if (arg == "--output") {
+            config.output = value;
+        } else if (arg == "--autotune") {
+            if (!ParseAutotuneMode(value, config.autotune)) {
+                LOG_ERROR("unknown autotune mode " + value);
+                return false;
+            }
+        } else if (arg == "--tuning-cache") {
+            config.tuningCache = value;
+        } else {
+            LOG_ERROR("unknown argument " + arg);
+            return false;
+        }
+    }
+    if (config.model != "model" && config.model != "model2") {
+        LOG_ERROR("unknown model " + config.model);
+        return false;
+    }
+    if (config.iters == 0 || config.batch == 0 || config.threads == 0) {
+        LOG_ERROR("--iters, --batch and --threads must be positive");
+        return false;
+    }
+    return true;
+}
+
+template <typename ModelT>
+static void RunWorker(const BenchConfig &config, uint32_t deviceId, StartGate &gate, std::vector<double> &latencies)
+{
+    ModelT model;
+    model.InitResource(deviceId);
+    model.SetBatchSize(config.batch);
+    model.CreateModelGraph();
+    model.CreateModelInput();
+    model.CreateModelOutput();
+    for (uint32_t i = 0; i < config.warmup; i++) {
+        model.Execute();
+    }
+
+    gate.ArriveAndWait();
+    for (uint32_t i = 0; i < config.iters; i++) {
+        auto start = std::chrono::steady_clock::now();
+        model.Execute();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        latencies.push_back(elapsed.count());
+    }
+    model.FreeResource();
+}
+
+static double Percentile(const std::vector<double> &sorted, double ratio)
+{
+    size_t rank = static_cast<size_t>(std::ceil(ratio * sorted.size()));
+    return sorted.at(rank == 0 ? 0 : rank - 1);
+}
+
+int main(int argc, char **argv)
+{
+    BenchConfig config;
+    if (!ParseArgs(argc, argv, config)) {
+        LOG_ERROR(USAGE);
+        return 1;
+    }
+
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+    GetMemoryManager().CreateMemoryPool(POOL_SIZE);
+    GetKernelTuner().SetMode(config.autotune);
+    if (!config.tuningCache.empty() && !GetKernelTuner().OpenCache(config.tuningCache)) {
+        return 1;
+    }
+
+    uint32_t deviceCount = 0;
+    ret = aclrtGetDeviceCount(&deviceCount);
+    CHECK_RET(ret, "aclrtGetDeviceCount failed. ret: " + std::to_string(ret));
+    CHECK_RET(deviceCount == 0, "no device available");
+    if (config.devices == 0 || config.devices > deviceCount) {
+        config.devices = deviceCount;
+    }
+    config.devices = std::min(config.devices, config.threads);
+
+    // 线程按轮询分配到device上，每个线程执行iters次
+    StartGate gate(config.threads);
+    std::vector<std::vector<double>> threadLatencies(config.threads);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < config.threads; i++) {
+        uint32_t deviceId = i % config.devices;
+        std::vector<double> &latencies = threadLatencies.at(i);
+        threads.emplace_back([&config, deviceId, &gate, &latencies] {
+            if (config.model == "model") {
+                RunWorker<Model>(config, deviceId, gate, latencies);
+            } else {
+                RunWorker<Model2>(config, deviceId, gate, latencies);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - gate.GetStartTime();
+
+    std::vector<double> latencies;
+    for (const auto &threadLatency : threadLatencies) {
+        latencies.insert(latencies.end(), threadLatency.begin(), threadLatency.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    double meanMs = 0;
+    for (double latency : latencies) {
+        meanMs += latency;
+    }
+    meanMs /= latencies.size();
+    double inferencesPerSecond = latencies.size() / wallTime.count();
+
+#ifdef DISABLE_MEMPOOL
+    bool useMemPool = false;
+#else
+    bool useMemPool = true;
+#endif
+    std::ostringstream json;
+    json << "{\"model\":\"" << config.model << "\",\"mempool\":" << (useMemPool ? "true" : "false")
+         << ",\"batch\":" << config.batch << ",\"threads\":" << config.threads << ",\"devices\":" << config.devices
+         << ",\"warmup\":" << config.warmup << ",\"iterations\":" << config.iters
+         << ",\"autotune\":\"" << AutotuneModeToString(config.autotune) << "\"";
+    json << ",\"latency_ms\":{\"mean\":" << meanMs << ",\"p50\":" << Percentile(latencies, 0.5)
+         << ",\"p90\":" << Percentile(latencies, 0.9) << ",\"p99\":" << Percentile(latencies, 0.99)
+         << ",\"max\":" << latencies.back() << "}";
+    json << ",\"throughput\":{\"inferences_per_s\":" << inferencesPerSecond
+         << ",\"samples_per_s\":" << inferencesPerSecond * config.batch << "}";
+    json << ",\"pool\":[";
+    for (uint32_t deviceId = 0; deviceId < config.devices; deviceId++) {
+        MemoryPoolStats stats = GetMemoryManager().GetMemoryPoolStats(deviceId);
+        json << (deviceId == 0 ? "" : ",") << "{\"device\":" << deviceId << ",\"pool_bytes\":" << stats.poolSize
+             << ",\"peak_used_bytes\":" << stats.peakUsedBytes << ",\"carved_bytes\":" << stats.carvedBytes << "}";
+    }
+    json << "]}";
+
+    // JSON单独占一行输出到标准输出，指定--output时同时写入文件
+    std::cout << json.str() << std::endl;
+    if (!config.output.empty()) {
+        std::ofstream file(config.output, std::ios::out | std::ios::trunc);
+        file << json.str() << std::endl;
+        if (!file) {
+            LOG_ERROR("Failed to write " + config.output);
+        }
+    }
+
+    aclFinalize();
+    return 0;
+}
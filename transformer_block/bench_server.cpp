@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "runtime/server_protocol.h"
+#include "runtime/shm_ring.h"
+#include "utils/log.h"
+#include "utils/tensor_convert.h"
+
+// 本地推理服务的客户端负载生成器：多个连接并发发送请求，统计端到端延迟，输出一行JSON
+// 用法：bench_server [--socket path] [--connections N] [--requests N] [--concurrency N] [--timeout-ms N]
+//                    [--output path]
+// 每个连接保持concurrency个未完成的请求（闭环），收到BUSY时退避后重发同一个请求，
+// 延迟从第一次发送算到收到OK；所有OK请求的输出与第一个OK输出逐字节比较
+using Clock = std::chrono::steady_clock;
+
+// 与模型默认输入相同的填充值
+constexpr float INPUT_FILL_VALUE = 2.0f;
+// 收到BUSY后重发前的等待时间
+constexpr auto BUSY_BACKOFF = std::chrono::microseconds(500);
+
+struct ClientConfig
+{
+    std::string socketPath = "/tmp/transformer_block.sock";
+    uint32_t connections = 1;
+    uint32_t requests = 16;   // 每个连接的请求数
+    uint32_t concurrency = 4; // 每个连接未完成的请求数，不超过服务端的slot数
+    uint32_t timeoutMs = 0;   // 0表示不超时
+    std::string output;
+};
+
+struct ConnectionResult
+{
+    bool connected = false;
+    std::vector<double> latencies; // OK请求的端到端延迟（ms）
+    std::vector<uint8_t> output;   // 第一个OK请求的输出
+    uint64_t busyRetries = 0;
+    uint64_t timeout = 0;
+    uint64_t draining = 0;
+    uint64_t invalid = 0;
+    uint64_t mismatch = 0;        // 输出与第一个OK输出不同的请求数
+};
+
+static bool ParseArgs(int argc, char **argv, ClientConfig &config)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            LOG_ERROR("missing value for " + arg);
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--socket") {
+            config.socketPath = value;
+        } else if (arg == "--connections") {
+            config.connections = std::stoul(value);
+        } else if (arg == "--requests") {
+            config.requests = std::stoul(value);
+        } else if (arg == "--concurrency") {
+            config.concurrency = std::stoul(value);
+        } else if (arg == "--timeout-ms") {
+            config.timeoutMs = std::stoul(value);
+        } else if (arg == "--output") {
+            config.output = value;
+        } else {
+            LOG_ERROR("unknown argument " + arg);
+            return false;
+        }
+    }
+    return config.connections > 0 && config.requests > 0 && config.concurrency > 0;
+}
+
+static int Connect(const std::string &socketPath)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        LOG_ERROR("connect " + socketPath + " failed, errno " + std::to_string(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+static void RunConnection(const ClientConfig &config, ConnectionResult &result)
+{
+    int fd = Connect(config.socketPath);
+    if (fd < 0) {
+        return;
+    }
+    HelloMessage hello;
+    int ringFd = -1;
+    ShmRing ring;
+    ssize_t received = RecvMessage(fd, &hello, sizeof(hello), &ringFd);
+    if (received != static_cast<ssize_t>(sizeof(hello)) || hello.type != ServerMessageType::HELLO ||
+        hello.version != SERVER_PROTOCOL_VERSION ||
+        !ring.Attach(ringFd, hello.slotCount, hello.inputBytes, hello.outputBytes)) {
+        LOG_ERROR("invalid hello from server");
+        close(fd);
+        return;
+    }
+    result.connected = true;
+
+    // 输入只写一次，之后的请求复用slot中的输入
+    aclDataType inputDtype = static_cast<aclDataType>(hello.inputDtype);
+    int64_t inputCount = static_cast<int64_t>(hello.inputBytes / GetConvertibleDtypeSize(inputDtype));
+    for (uint32_t slot = 0; slot < hello.slotCount; slot++) {
+        FillTyped(ring.GetInput(slot), inputDtype, INPUT_FILL_VALUE, inputCount);
+    }
+
+    std::vector<Clock::time_point> firstSendTime(hello.slotCount);
+    std::vector<uint64_t> slotRequestId(hello.slotCount);
+    uint64_t sent = 0;
+    uint64_t done = 0;
+    auto sendRequest = [&](uint32_t slot) {
+        RequestMessage request;
+        request.slot = slot;
+        request.requestId = slotRequestId[slot];
+        request.timeoutMs = config.timeoutMs;
+        return SendMessage(fd, &request, sizeof(request));
+    };
+    auto sendNext = [&](uint32_t slot) {
+        slotRequestId[slot] = sent++;
+        firstSendTime[slot] = Clock::now();
+        return sendRequest(slot);
+    };
+
+    uint32_t concurrency = std::min(config.concurrency, hello.slotCount);
+    bool lost = false;
+    for (uint32_t slot = 0; slot < concurrency && sent < config.requests && !lost; slot++) {
+        lost = !sendNext(slot);
+    }
+    bool draining = false;
+    while (done < sent && !lost) {
+        ResponseMessage response;
+        received = RecvMessage(fd, &response, sizeof(response));
+        if (received != static_cast<ssize_t>(sizeof(response)) || response.type != ServerMessageType::RESPONSE ||
+            response.slot >= hello.slotCount) {
+            LOG_ERROR("connection lost");
+            break;
+        }
+        uint32_t slot = response.slot;
+        if (response.status == RequestStatus::BUSY) {
+            // 背压：同一个请求稍后重发，延迟包含等待时间
+            result.busyRetries++;
+            std::this_thread::sleep_for(BUSY_BACKOFF);
+            lost = !sendRequest(slot);
+            continue;
+        }
+        done++;
+        if (response.status == RequestStatus::OK) {
+            std::chrono::duration<double, std::milli> latency = Clock::now() - firstSendTime[slot];
+            result.latencies.push_back(latency.count());
+            const uint8_t *output = static_cast<const uint8_t *>(ring.GetOutput(slot));
+            if (result.output.empty()) {
+                result.output.assign(output, output + hello.outputBytes);
+            } else if (std::memcmp(result.output.data(), output, hello.outputBytes) != 0) {
+                result.mismatch++;
+            }
+        } else if (response.status == RequestStatus::TIMEOUT) {
+            result.timeout++;
+        } else if (response.status == RequestStatus::DRAINING) {
+            result.draining++;
+            draining = true;
+        } else {
+            result.invalid++;
+        }
+        if (!draining && sent < config.requests) {
+            lost = !sendNext(slot);
+        }
+    }
+    close(fd);
+}
+
+static double Percentile(const std::vector<double> &sorted, double ratio)
+{
+    size_t rank = static_cast<size_t>(std::ceil(ratio * sorted.size()));
+    return sorted.at(rank == 0 ? 0 : rank - 1);
+}
+
+int main(int argc, char **argv)
+{
+    ClientConfig config;
+    if (!ParseArgs(argc, argv, config)) {
+        return 1;
+    }
+
+    std::vector<ConnectionResult> results(config.connections);
+    std::vector<std::thread> threads;
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < config.connections; i++) {
+        ConnectionResult &result = results.at(i);
+        threads.emplace_back([&config, &result] { RunConnection(config, result); });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> wallTime = Clock::now() - start;
+
+    // 不同连接的输出也应该一致
+    ConnectionResult total;
+    bool allConnected = true;
+    for (const auto &result : results) {
+        allConnected = allConnected && result.connected;
+        total.latencies.insert(total.latencies.end(), result.latencies.begin(), result.latencies.end());
+        total.busyRetries += result.busyRetries;
+        total.timeout += result.timeout;
+        total.draining += result.draining;
+        total.invalid += result.invalid;
+        total.mismatch += result.mismatch;
+        if (total.output.empty()) {
+            total.output = result.output;
+        } else if (!result.output.empty() && result.output != total.output) {
+            total.mismatch++;
+        }
+    }
+    std::vector<double> &latencies = total.latencies;
+    std::sort(latencies.begin(), latencies.end());
+    double meanMs = 0;
+    for (double latency : latencies) {
+        meanMs += latency;
+    }
+    meanMs = latencies.empty() ? 0 : meanMs / latencies.size();
+
+    std::ostringstream json;
+    json << "{\"connections\":" << config.connections << ",\"requests_per_connection\":" << config.requests
+         << ",\"concurrency\":" << config.concurrency << ",\"timeout_ms\":" << config.timeoutMs;
+    json << ",\"ok\":" << latencies.size() << ",\"busy_retries\":" << total.busyRetries
+         << ",\"timeout\":" << total.timeout << ",\"draining\":" << total.draining << ",\"invalid\":" << total.invalid
+         << ",\"output_mismatch\":" << total.mismatch;
+    if (!latencies.empty()) {
+        json << ",\"latency_ms\":{\"mean\":" << meanMs << ",\"p50\":" << Percentile(latencies, 0.5)
+             << ",\"p90\":" << Percentile(latencies, 0.9) << ",\"p99\":" << Percentile(latencies, 0.99)
+             << ",\"max\":" << latencies.back() << "}";
+    }
+    json << ",\"throughput\":{\"requests_per_s\":" << latencies.size() / wallTime.count() << "}}";
+
+    // JSON单独占一行输出到标准输出，指定--output时同时写入文件
+    std::cout << json.str() << std::endl;
+    if (!config.output.empty()) {
+        std::ofstream file(config.output, std::ios::out | std::ios::trunc);
+        file << json.str() << std::endl;
+        if (!file) {
+            LOG_ERROR("Failed to write " + config.output);
+        }
+    }
+    return allConnected && total.mismatch == 0 && total.invalid == 0 ? 0 : 1;
+}
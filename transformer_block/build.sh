@@ -1,5 +1,10 @@
-source /usr/local/Ascend/ascend-toolkit/set_env.sh
-source /usr/local/Ascend/nnal/atb/set_env.sh
+# 没有CANN toolkit时不设置环境变量，CMake会切换到sim/下的仿真后端
+if [ -f /usr/local/Ascend/ascend-toolkit/set_env.sh ]; then
+    source /usr/local/Ascend/ascend-toolkit/set_env.sh
+    source /usr/local/Ascend/nnal/atb/set_env.sh
+else
+    echo "INFO: CANN toolkit not found, building with the simulated backend"
+fi
 
 function compile_model() {
     mkdir -p build; 
@@ -1,5 +1,7 @@
 #include "model/model2.h"
+#include "aclnn/aclnn_tensor_stats.h"
 #include "memory/memory_utils.h"
+#include "memory/weight_store.h"
 #include <thread>
 #include "utils/utils.h"
 
@@ -20,8 +22,22 @@ void ModelExecute(uint32_t deviceId, Model2 &model)
     // 模型执行
     model.Execute();
 
+    // 打印同一device上共享权重和每个实例额外占用的device内存
+    LOG_ERROR("device " + std::to_string(deviceId) + " shared weight bytes: " +
+              std::to_string(GetWeightStore().GetResidentBytes()) + ", bytes per additional instance: " +
+              std::to_string(model.GetInstanceBytes()));
+
     // 打印输出Tensor的值
     PrintOutTensorValue(model.model_outTensors_.at(0));
+
+    // 在device上计算输出的统计量，只拷回几个标量
+    {
+        TensorStatsCollector statsCollector;
+        TensorStats stats;
+        if (statsCollector.Compute(model.model_outTensors_.at(0), model.GetStream(), stats) == atb::NO_ERROR) {
+            LOG_ERROR("out stats: " + TensorStatsToString(stats));
+        }
+    }
     LOG_ERROR("完成模型执行");
     // 资源释放
     model.FreeResource();
@@ -44,10 +60,16 @@ int main()
     // 创建模型图
     std::vector<Model2> modelArray(THREAD_SIZE);
 
+    // 模型数量超过device数量时，多个模型实例共享同一device上的权重
+    uint32_t deviceCount = 0;
+    ret = aclrtGetDeviceCount(&deviceCount);
+    CHECK_RET(ret, "aclrtGetDeviceCount failed. ret: " + std::to_string(ret));
+
     std::vector<std::thread> threadArray(THREAD_SIZE);
     for (size_t i = 0; i < THREAD_SIZE; i++) {
         Model2 &model = modelArray.at(i);
-        threadArray.at(i) = std::thread([i, &model]{ModelExecute(i, model);});
+        uint32_t deviceId = i % deviceCount;
+        threadArray.at(i) = std::thread([deviceId, &model]{ModelExecute(deviceId, model);});
         // lambda表达式 执行ModelExecute函数，传入[i,&model]
     }
     for (size_t i = 0; i < THREAD_SIZE; i++) {
@@ -0,0 +1,221 @@
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "memory/memory_utils.h"
+#include "model/model2.h"
+#include "runtime/kernel_tuner.h"
+#include "runtime/kernel_variants.h"
+#include "utils/metrics.h"
+#include "utils/tensor_io.h"
+#include "utils/test_check.h"
+#include "utils/utils.h"
+
+// 算子实现的自动选择
+// 1. 合成耗时：最快的候选输出超出容差时不被选中，选择写入缓存文件后重新读取仍然生效且不再计时，各mode下Choose的结果
+// 2. 仿真device：对linear、gelu、matmul_gelu的候选实现计时并写入缓存文件
+// 3. 缓存文件指定linear为aclnn_matmul时Model2构图使用aclnn实现，输出与atb Linear一致
+// 任一检查失败时返回1
+// 用法：test_autotune [--cache path]，默认在当前目录写autotune_cache.txt
+constexpr const char *DEFAULT_CACHE_PATH = "autotune_cache.txt";
+constexpr size_t POOL_SIZE = 104857600; // Alloceted memory 100 MiB.
+constexpr size_t SYNTHETIC_OUTPUT_SIZE = 64;
+constexpr int64_t MATMUL_GELU_TOKENS = 64;
+constexpr int64_t MATMUL_GELU_HIDDEN = 256;
+constexpr int64_t MATMUL_GELU_MLP_HIDDEN = 1024;
+
+// 合成的候选实现：固定的耗时加少量抖动，输出为参考值加固定偏差
+struct SyntheticCandidate
+{
+    std::string name;
+    double timeUs = 0;
+    float outputError = 0;
+    int runCount = 0;
+};
+
+static std::vector<TuneCandidate> MakeSyntheticCandidates(std::vector<SyntheticCandidate> &synthetic,
+                                                          std::mt19937 &engine)
+{
+    std::vector<TuneCandidate> candidates;
+    for (auto &item : synthetic) {
+        SyntheticCandidate *state = &item;
+        candidates.push_back({item.name,
+                              [state, &engine]() {
+                                  std::uniform_real_distribution<double> jitter(0.95, 1.05);
+                                  state->runCount++;
+                                  return state->timeUs * jitter(engine);
+                              },
+                              [state]() {
+                                  std::vector<float> output(SYNTHETIC_OUTPUT_SIZE);
+                                  for (size_t i = 0; i < output.size(); i++) {
+                                      output[i] = static_cast<float>(i) * 0.01f + state->outputError;
+                                  }
+                                  return output;
+                              }});
+    }
+    return candidates;
+}
+
+static bool RunSyntheticChecks(const std::string &cachePath)
+{
+    KernelTuner &tuner = GetKernelTuner();
+    std::remove(cachePath.c_str());
+    tuner.Reset();
+    tuner.SetMode(AutotuneMode::TUNE);
+    bool passed = Check(tuner.OpenCache(cachePath), "open missing cache file as empty cache");
+
+    // fast_wrong最快但输出超出容差，应选择fast
+    std::vector<SyntheticCandidate> synthetic = {
+        {"reference", 100.0, 0.0f}, {"fast", 60.0, 5e-4f}, {"fast_wrong", 30.0, 0.1f}};
+    std::mt19937 engine(0);
+    std::vector<TuneCandidate> candidates = MakeSyntheticCandidates(synthetic, engine);
+    std::string key = MakeTuneKey("synthetic", {4, 128}, "fp16");
+    passed = Check(tuner.NeedsTuning(key), "key needs tuning in TUNE mode") && passed;
+    TuneReport report = tuner.Tune(key, candidates);
+    for (const auto &result : report.candidates) {
+        LOG_ERROR("synthetic " + result.name + ": " + std::to_string(result.medianUs) + " us, max abs error " +
+                  std::to_string(result.maxAbsError) + (result.accepted ? "" : ", rejected"));
+    }
+    passed = Check(report.chosen == "fast" && !report.fromCache, "choose fastest candidate within tolerance, got " +
+                                                                      report.chosen) && passed;
+    passed = Check(report.candidates.size() == 3 && !report.candidates[2].accepted,
+                   "reject faster candidate out of tolerance") && passed;
+
+    // 重新读取缓存文件，记录仍然生效且不再计时
+    tuner.Reset();
+    passed = Check(tuner.OpenCache(cachePath), "reload cache file") && passed;
+    int runCount = synthetic[0].runCount + synthetic[1].runCount + synthetic[2].runCount;
+    report = tuner.Tune(key, candidates);
+    passed = Check(report.fromCache && report.chosen == "fast" &&
+                       runCount == synthetic[0].runCount + synthetic[1].runCount + synthetic[2].runCount,
+                   "reloaded cache answers without timing") && passed;
+    passed = Check(!tuner.NeedsTuning(key), "cached key does not need tuning") && passed;
+
+    tuner.SetMode(AutotuneMode::OFF);
+    passed = Check(tuner.Choose(key, "reference") == "reference", "OFF mode uses default") && passed;
+    tuner.SetMode(AutotuneMode::CACHED);
+    passed = Check(tuner.Choose(key, "reference") == "fast", "CACHED mode uses cached choice") && passed;
+    std::string missingKey = MakeTuneKey("synthetic", {8, 128}, "fp16");
+    passed = Check(tuner.Choose(missingKey, "reference") == "reference" && !tuner.NeedsTuning(missingKey),
+                   "CACHED mode falls back to default without tuning") && passed;
+
+    std::string badPath = cachePath + ".bad";
+    {
+        std::ofstream bad(badPath);
+        bad << "only_a_key\n";
+    }
+    passed = Check(!tuner.OpenCache(badPath), "reject malformed cache file") && passed;
+    std::remove(badPath.c_str());
+    tuner.Reset();
+    return passed;
+}
+
+static void LogReport(const std::string &key, const TuneReport &report)
+{
+    for (const auto &result : report.candidates) {
+        LOG_ERROR(key + " " + result.name + ": " + std::to_string(result.medianUs) + " us, max abs error " +
+                  std::to_string(result.maxAbsError) + (result.accepted ? "" : ", rejected"));
+    }
+    LOG_ERROR(key + " chose " + report.chosen + (report.fromCache ? " (cached)" : ""));
+}
+
+// 构图、执行一次并返回输出，以及构图中创建aclnn executor的次数
+static std::vector<float> RunModel2(uint64_t &aclnnBuilds)
+{
+    Counter &misses = GetMetrics().GetCounter("aclnn_executor_cache_misses_total",
+                                              "Setup calls that rebuilt aclTensor and executor");
+    uint64_t missesBefore = misses.Value();
+    Model2 model;
+    model.InitResource(0);
+    model.CreateModelGraph();
+    model.CreateModelInput();
+    model.CreateModelOutput();
+    model.Execute();
+    model.WaitFinish();
+    std::vector<float> output = DownloadTensor(model.model_outTensors_.at(0));
+    model.FreeResource();
+    aclnnBuilds = misses.Value() - missesBefore;
+    return output;
+}
+
+static bool RunDeviceChecks(const std::string &cachePath)
+{
+    KernelTuner &tuner = GetKernelTuner();
+    std::remove(cachePath.c_str());
+    tuner.SetMode(AutotuneMode::TUNE);
+    tuner.OpenCache(cachePath);
+
+    auto ret = aclrtSetDevice(0);
+    CHECK_RET(ret, "aclrtSetDevice failed. ret: " + std::to_string(ret));
+    atb::Context *context = nullptr;
+    ret = atb::CreateContext(&context);
+    CHECK_RET(ret, "ATB CreateContext failed. ret: " + std::to_string(ret));
+    aclrtStream stream = nullptr;
+    ret = aclrtCreateStream(&stream);
+    CHECK_RET(ret, "aclrtCreateStream failed. ret: " + std::to_string(ret));
+    context->SetExecuteStream(stream);
+    TuningDevice device = {context, stream};
+
+    // 与Model2/Model构图时的形状一致
+    std::vector<int64_t> modelDims = {1, 197, 768};
+    std::vector<int64_t> mlpDims = {1, MATMUL_GELU_TOKENS, MATMUL_GELU_HIDDEN};
+    LogReport(LinearTuneKey(modelDims, 2304), TuneLinearKernel(device, modelDims, 2304));
+    LogReport(GeluTuneKey(modelDims), TuneGeluKernel(device, modelDims));
+    LogReport(MatmulGeluTuneKey(mlpDims, MATMUL_GELU_MLP_HIDDEN),
+              TuneMatmulGeluKernel(device, mlpDims, MATMUL_GELU_MLP_HIDDEN));
+    aclrtDestroyStream(stream);
+    atb::DestroyContext(context);
+
+    TuningCache saved;
+    bool passed = Check(saved.Load(cachePath) && saved.Size() == 3, "tuning cache file has 3 entries");
+
+    // 构图使用缓存文件中的选择：指定linear为aclnn_matmul后，Model2中出现aclnn节点且输出与atb Linear一致
+    GetMetrics().Enable();
+    tuner.SetMode(AutotuneMode::OFF);
+    uint64_t atbBuilds = 0;
+    std::vector<float> atbOutput = RunModel2(atbBuilds);
+    std::string forcedPath = cachePath + ".forced";
+    {
+        std::ofstream forced(forcedPath);
+        forced << LinearTuneKey(modelDims, 2304) << " " << LinearKernelToString(LinearKernel::ACLNN_MATMUL) << " 0\n";
+    }
+    tuner.SetMode(AutotuneMode::CACHED);
+    passed = Check(tuner.OpenCache(forcedPath), "open forced cache file") && passed;
+    uint64_t aclnnBuilds = 0;
+    std::vector<float> aclnnOutput = RunModel2(aclnnBuilds);
+    std::remove(forcedPath.c_str());
+    passed = Check(atbBuilds == 0 && aclnnBuilds > 0, "Model2 builds aclnn linear from cache (aclnn executors: " +
+                                                          std::to_string(atbBuilds) + " -> " +
+                                                          std::to_string(aclnnBuilds) + ")") && passed;
+    double maxError = atbOutput.size() == aclnnOutput.size() ? 0 : 1e9;
+    for (size_t i = 0; i < atbOutput.size() && i < aclnnOutput.size(); i++) {
+        maxError = std::max(maxError, static_cast<double>(std::fabs(atbOutput[i] - aclnnOutput[i])));
+    }
+    passed = Check(maxError <= 1e-2, "aclnn linear output matches atb linear, max abs error " +
+                                         std::to_string(maxError)) && passed;
+    aclrtResetDevice(0);
+    return passed;
+}
+
+int main(int argc, char **argv)
+{
+    std::string cachePath = DEFAULT_CACHE_PATH;
+    if (argc == 3 && std::string(argv[1]) == "--cache") {
+        cachePath = argv[2];
+    } else if (argc != 1) {
+        LOG_ERROR("usage: test_autotune [--cache path]");
+        return 1;
+    }
+    bool passed = RunSyntheticChecks(cachePath + ".synthetic");
+    std::remove((cachePath + ".synthetic").c_str());
+
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+    GetMemoryManager().CreateMemoryPool(POOL_SIZE);
+    passed = RunDeviceChecks(cachePath) && passed;
+    aclFinalize();
+    LOG_ERROR(passed ? "autotune check passed, cache written to " + cachePath : "autotune check failed");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "runtime/request_dispatcher.h"
+#include "utils/log.h"
+#include "utils/test_check.h"
+
+// 用速度不同的仿真device验证路由策略，无需NPU
+// 两种策略下每个请求都恰好执行一次，各device完成数之和等于请求数；
+// 按预计完成时间路由时，速度越快的device完成的请求越多。任一检查失败时返回1
+constexpr size_t REQUEST_COUNT = 300;
+constexpr uint32_t CONCURRENCY_LIMIT = 2;
+constexpr double BASE_SERVICE_MS = 4.0;
+const std::vector<double> DEVICE_SPEEDS = {1.0, 0.5, 0.25};
+
+using Clock = std::chrono::steady_clock;
+using SimRequest = uint64_t;
+
+// 记录每个请求被执行的次数
+class RecordingReplica : public SimulatedReplica<SimRequest>
+{
+public:
+    RecordingReplica(uint32_t deviceId, double speed, std::vector<std::atomic<uint32_t>> &executeCounts)
+        : SimulatedReplica<SimRequest>(deviceId, speed, BASE_SERVICE_MS, CONCURRENCY_LIMIT),
+          executeCounts_(executeCounts)
+    {
+    }
+
+    void Execute(SimRequest request, std::function<void()> done) override
+    {
+        executeCounts_.at(request)++;
+        SimulatedReplica<SimRequest>::Execute(request, std::move(done));
+    }
+
+private:
+    std::vector<std::atomic<uint32_t>> &executeCounts_;
+};
+
+static bool RunPolicy(RoutePolicy policy, const std::string &policyName)
+{
+    std::vector<std::atomic<uint32_t>> executeCounts(REQUEST_COUNT);
+    std::vector<DeviceLoadStats> stats;
+    {
+        std::vector<std::shared_ptr<DeviceReplica<SimRequest>>> replicas;
+        for (uint32_t i = 0; i < DEVICE_SPEEDS.size(); i++) {
+            replicas.push_back(std::make_shared<RecordingReplica>(i, DEVICE_SPEEDS[i], executeCounts));
+        }
+        RequestDispatcher<SimRequest> dispatcher(policy, replicas, CONCURRENCY_LIMIT);
+
+        // 按固定间隔提交，间隔略小于全部device的总服务能力，使队列保持非空
+        auto start = Clock::now();
+        for (SimRequest i = 0; i < REQUEST_COUNT; i++) {
+            dispatcher.Submit(i);
+            std::this_thread::sleep_for(std::chrono::microseconds(900));
+        }
+        dispatcher.WaitIdle();
+        std::chrono::duration<double, std::milli> makespan = Clock::now() - start;
+        stats = dispatcher.GetStats();
+
+        LOG_ERROR(policyName + " makespan: " + std::to_string(makespan.count()) + " ms");
+        for (const auto &deviceStats : stats) {
+            LOG_ERROR(policyName + " device " + std::to_string(deviceStats.deviceId) + " completed " +
+                      std::to_string(deviceStats.completed) + ", service time " +
+                      std::to_string(deviceStats.serviceTimeMs) + " ms, utilization " +
+                      std::to_string(deviceStats.utilization));
+        }
+    }
+
+    size_t wrongCount = 0;
+    for (const auto &count : executeCounts) {
+        wrongCount += count.load() == 1 ? 0 : 1;
+    }
+    bool passed = Check(wrongCount == 0, policyName + " every request executed exactly once, wrong " +
+                                             std::to_string(wrongCount));
+    uint64_t completed = 0;
+    for (const auto &deviceStats : stats) {
+        completed += deviceStats.completed;
+    }
+    passed = Check(completed == REQUEST_COUNT, policyName + " completed " + std::to_string(completed) + " requests") &&
+             passed;
+    if (policy == RoutePolicy::ESTIMATED_COMPLETION) {
+        bool ordered = true;
+        for (size_t i = 1; i < stats.size(); i++) {
+            ordered = ordered && stats[i - 1].completed > stats[i].completed;
+        }
+        passed = Check(ordered, policyName + " faster devices complete more requests") && passed;
+    }
+    return passed;
+}
+
+int main()
+{
+    bool passed = RunPolicy(RoutePolicy::QUEUE_DEPTH, "queue_depth");
+    passed = RunPolicy(RoutePolicy::ESTIMATED_COMPLETION, "estimated_completion") && passed;
+    LOG_ERROR(passed ? "dispatcher check passed" : "dispatcher check failed");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,346 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "aclnn/aclnn_fused_ops.h"
+#include "aclnn/aclnn_gelu_operation.h"
+#include "aclnnop/aclnn_gelu.h"
+#include "reference/cpu_kernels.h"
+#include "reference/golden_compare.h"
+#include "utils/dtype_convert.h"
+#include "utils/tensor_io.h"
+#include "utils/utils.h"
+
+// 通过AclnnOperation接入的融合aclnn算子与atb算子混合组图：
+// AddLayerNorm(x, residual) -> MatmulGelu -> atb Linear(无bias) -> BiasAdd -> Softmax
+// 1. 图的输出与host参考实现（中间结果同样舍入到fp16）比较
+// 2. 多次执行后检查每个aclnn节点只创建过一次executor
+// 3. 对比手写的GeluOperation（每次Setup重建aclTensor和executor）与AclnnOperation的Setup + Execute耗时
+// 任一比较不一致时返回1
+constexpr int64_t TOKENS = 64;
+constexpr int64_t HIDDEN = 256;
+constexpr int64_t MLP_HIDDEN = 1024;
+constexpr float ACTIVATION_RANGE = 1.0f;
+constexpr float WEIGHT_RANGE = 0.1f;
+constexpr double LAYER_NORM_EPSILON = 1e-5;
+constexpr int REPEAT_COUNT = 200;
+
+enum TensorId : uint32_t
+{
+    IN_TENSOR_X = 0,
+    IN_TENSOR_RESIDUAL,
+    IN_TENSOR_GAMMA,
+    IN_TENSOR_BETA,
+    IN_TENSOR_W1,
+    IN_TENSOR_B1,
+    IN_TENSOR_W2,
+    IN_TENSOR_B2,
+    OUT_TENSOR_PROB,
+    OUT_TENSOR_SUM,
+    INTERNAL_TENSOR_LN,
+    INTERNAL_TENSOR_MEAN,
+    INTERNAL_TENSOR_RSTD,
+    INTERNAL_TENSOR_HIDDEN,
+    INTERNAL_TENSOR_PROJ,
+    INTERNAL_TENSOR_LOGITS,
+};
+constexpr uint32_t IN_TENSOR_NUM = 8;
+constexpr uint32_t OUT_TENSOR_NUM = 2;
+
+// 用于对比Setup开销的Gelu，与GeluOperation调用同一个aclnn接口
+struct GeluOpDef
+{
+    struct Param
+    {
+    };
+    static constexpr uint32_t IN_NUM = 1;
+    static constexpr uint32_t OUT_NUM = 1;
+    static atb::Status InferShape(const Param &, const atb::SVector<atb::TensorDesc> &inTensorDesc,
+                                  atb::SVector<atb::TensorDesc> &outTensorDesc)
+    {
+        outTensorDesc.at(0) = inTensorDesc.at(0);
+        return atb::NO_ERROR;
+    }
+    static aclnnStatus GetWorkspaceSize(const Param &, aclTensor *x, aclTensor *y, uint64_t *workspaceSize,
+                                        aclOpExecutor **executor)
+    {
+        return aclnnGeluGetWorkspaceSize(x, y, workspaceSize, executor);
+    }
+    static aclnnStatus Launch(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+    {
+        return aclnnGelu(workspace, workspaceSize, executor, stream);
+    }
+};
+
+struct FusedGraph
+{
+    atb::Operation *graph = nullptr;
+    AddLayerNormOperation *addLayerNorm = nullptr;
+    MatmulGeluOperation *matmulGelu = nullptr;
+    BiasAddOperation *biasAdd = nullptr;
+    SoftmaxOperation *softmax = nullptr;
+};
+
+FusedGraph CreateFusedGraph()
+{
+    FusedGraph result;
+    atb::GraphParam opGraph;
+    opGraph.name = "fused_ops_graph";
+    opGraph.inTensorNum = IN_TENSOR_NUM;
+    opGraph.outTensorNum = OUT_TENSOR_NUM;
+    opGraph.internalTensorNum = 6;
+    opGraph.nodes.resize(5);
+
+    result.addLayerNorm = new AddLayerNormOperation("AddLayerNorm", {LAYER_NORM_EPSILON});
+    opGraph.nodes.at(0).operation = result.addLayerNorm;
+    opGraph.nodes.at(0).inTensorIds = {IN_TENSOR_X, IN_TENSOR_RESIDUAL, IN_TENSOR_GAMMA, IN_TENSOR_BETA};
+    opGraph.nodes.at(0).outTensorIds = {INTERNAL_TENSOR_LN, INTERNAL_TENSOR_MEAN, INTERNAL_TENSOR_RSTD,
+                                        OUT_TENSOR_SUM};
+
+    result.matmulGelu = new MatmulGeluOperation("MatmulGelu");
+    opGraph.nodes.at(1).operation = result.matmulGelu;
+    opGraph.nodes.at(1).inTensorIds = {INTERNAL_TENSOR_LN, IN_TENSOR_W1, IN_TENSOR_B1};
+    opGraph.nodes.at(1).outTensorIds = {INTERNAL_TENSOR_HIDDEN};
+
+    atb::infer::LinearParam linearParam;
+    linearParam.transposeA = false;
+    linearParam.transposeB = false;
+    linearParam.hasBias = false;
+    auto status = atb::CreateOperation(linearParam, &opGraph.nodes.at(2).operation);
+    CHECK_RET(status, "linearParam CreateOperation failed. status: " + std::to_string(status));
+    opGraph.nodes.at(2).inTensorIds = {INTERNAL_TENSOR_HIDDEN, IN_TENSOR_W2};
+    opGraph.nodes.at(2).outTensorIds = {INTERNAL_TENSOR_PROJ};
+
+    result.biasAdd = new BiasAddOperation("BiasAdd");
+    opGraph.nodes.at(3).operation = result.biasAdd;
+    opGraph.nodes.at(3).inTensorIds = {INTERNAL_TENSOR_PROJ, IN_TENSOR_B2};
+    opGraph.nodes.at(3).outTensorIds = {INTERNAL_TENSOR_LOGITS};
+
+    result.softmax = new SoftmaxOperation("Softmax");
+    opGraph.nodes.at(4).operation = result.softmax;
+    opGraph.nodes.at(4).inTensorIds = {INTERNAL_TENSOR_LOGITS};
+    opGraph.nodes.at(4).outTensorIds = {OUT_TENSOR_PROB};
+
+    status = atb::CreateOperation(opGraph, &result.graph);
+    CHECK_RET(status, "GraphParam CreateOperation failed. status: " + std::to_string(status));
+    return result;
+}
+
+atb::TensorDesc Fp16Desc(const std::vector<int64_t> &dims)
+{
+    atb::TensorDesc desc;
+    desc.dtype = ACL_FLOAT16;
+    desc.format = ACL_FORMAT_ND;
+    desc.shape.dimNum = dims.size();
+    for (size_t i = 0; i < dims.size(); i++) {
+        desc.shape.dims[i] = dims[i];
+    }
+    return desc;
+}
+
+// 上传随机数据，返回舍入到fp16后的值
+std::vector<float> FillRandomTensor(atb::Tensor &tensor, std::mt19937 &engine, float low, float high)
+{
+    std::uniform_real_distribution<float> dist(low, high);
+    std::vector<float> hostData(atb::Utils::GetTensorNumel(tensor));
+    for (auto &value : hostData) {
+        value = dist(engine);
+    }
+    UploadTensor(tensor, hostData.data());
+    return DownloadTensor(tensor);
+}
+
+std::vector<uint16_t> ToFp16(const std::vector<float> &values)
+{
+    std::vector<uint16_t> result(values.size());
+    std::transform(values.begin(), values.end(), result.begin(), FloatToFp16);
+    return result;
+}
+
+void RoundToFp16(std::vector<float> &values)
+{
+    for (auto &value : values) {
+        value = Fp16ToFloat(FloatToFp16(value));
+    }
+}
+
+// host参考：返回{prob, sum}，每个节点的输出与device一样舍入到fp16
+std::vector<std::vector<float>> ReferenceForward(const std::vector<std::vector<float>> &inputs)
+{
+    std::vector<float> sum(TOKENS * HIDDEN);
+    for (size_t i = 0; i < sum.size(); i++) {
+        sum[i] = inputs[IN_TENSOR_X][i] + inputs[IN_TENSOR_RESIDUAL][i];
+    }
+    std::vector<float> normed(TOKENS * HIDDEN);
+    CpuLayerNorm(sum.data(), inputs[IN_TENSOR_GAMMA].data(), inputs[IN_TENSOR_BETA].data(), normed.data(), TOKENS,
+                 HIDDEN, static_cast<float>(LAYER_NORM_EPSILON));
+    RoundToFp16(sum);
+    RoundToFp16(normed);
+
+    std::vector<float> hidden(TOKENS * MLP_HIDDEN);
+    CpuLinear(normed.data(), inputs[IN_TENSOR_W1].data(), inputs[IN_TENSOR_B1].data(), hidden.data(), TOKENS, HIDDEN,
+              MLP_HIDDEN, false);
+    CpuGelu(hidden.data(), hidden.data(), TOKENS * MLP_HIDDEN, 0);
+    RoundToFp16(hidden);
+
+    std::vector<float> zeroBias(HIDDEN, 0.0f);
+    std::vector<float> logits(TOKENS * HIDDEN);
+    CpuLinear(hidden.data(), inputs[IN_TENSOR_W2].data(), zeroBias.data(), logits.data(), TOKENS, MLP_HIDDEN, HIDDEN,
+              false);
+    RoundToFp16(logits);
+    for (size_t i = 0; i < logits.size(); i++) {
+        logits[i] += inputs[IN_TENSOR_B2][i % HIDDEN];
+    }
+    RoundToFp16(logits);
+
+    std::vector<float> prob(TOKENS * HIDDEN);
+    for (int64_t row = 0; row < TOKENS; row++) {
+        const float *in = logits.data() + row * HIDDEN;
+        float maxValue = *std::max_element(in, in + HIDDEN);
+        double total = 0;
+        for (int64_t i = 0; i < HIDDEN; i++) {
+            total += std::exp(in[i] - maxValue);
+        }
+        for (int64_t i = 0; i < HIDDEN; i++) {
+            prob[row * HIDDEN + i] = static_cast<float>(std::exp(in[i] - maxValue) / total);
+        }
+    }
+    RoundToFp16(prob);
+    return {prob, sum};
+}
+
+// 每次执行（Setup + Execute）的host侧平均耗时（微秒）
+double MeasureSetupExecuteUs(atb::Operation *operation, const atb::VariantPack &variantPack, atb::Context *context,
+                             aclrtStream stream)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < REPEAT_COUNT; i++) {
+        uint64_t workspaceSize = 0;
+        operation->Setup(variantPack, workspaceSize, context);
+        operation->Execute(variantPack, nullptr, 0, context);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    aclrtSynchronizeStream(stream);
+    return elapsed.count() / REPEAT_COUNT;
+}
+
+int main()
+{
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+    ret = aclrtSetDevice(0);
+    CHECK_RET(ret, "aclrtSetDevice failed. ret: " + std::to_string(ret));
+    atb::Context *context = nullptr;
+    ret = atb::CreateContext(&context);
+    CHECK_RET(ret, "ATB CreateContext failed. ret: " + std::to_string(ret));
+    aclrtStream stream = nullptr;
+    ret = aclrtCreateStream(&stream);
+    CHECK_RET(ret, "aclrtCreateStream failed. ret: " + std::to_string(ret));
+    context->SetExecuteStream(stream);
+
+    FusedGraph fused = CreateFusedGraph();
+    std::vector<std::vector<int64_t>> inDims = {{1, TOKENS, HIDDEN}, {1, TOKENS, HIDDEN}, {HIDDEN}, {HIDDEN},
+                                                {HIDDEN, MLP_HIDDEN}, {MLP_HIDDEN}, {MLP_HIDDEN, HIDDEN}, {HIDDEN}};
+    atb::VariantPack variantPack;
+    atb::SVector<atb::TensorDesc> inDescs;
+    std::vector<std::vector<float>> hostInputs;
+    std::mt19937 engine(0);
+    for (uint32_t i = 0; i < IN_TENSOR_NUM; i++) {
+        atb::TensorDesc desc = Fp16Desc(inDims[i]);
+        atb::Tensor tensor;
+        CreateTensorFromDesc(tensor, desc);
+        bool isWeight = i == IN_TENSOR_W1 || i == IN_TENSOR_B1 || i == IN_TENSOR_W2 || i == IN_TENSOR_B2;
+        float range = isWeight ? WEIGHT_RANGE : ACTIVATION_RANGE;
+        float low = i == IN_TENSOR_GAMMA ? 0.5f : -range;
+        float high = i == IN_TENSOR_GAMMA ? 1.5f : range;
+        hostInputs.push_back(FillRandomTensor(tensor, engine, low, high));
+        variantPack.inTensors.push_back(tensor);
+        inDescs.push_back(desc);
+    }
+    atb::SVector<atb::TensorDesc> outDescs;
+    outDescs.resize(OUT_TENSOR_NUM);
+    ret = fused.graph->InferShape(inDescs, outDescs);
+    CHECK_RET(ret, "fused graph InferShape failed. ret: " + std::to_string(ret));
+    for (auto &desc : outDescs) {
+        atb::Tensor tensor;
+        CreateTensorFromDesc(tensor, desc);
+        variantPack.outTensors.push_back(tensor);
+    }
+
+    // 与Model2相同，每次执行前都调用Setup
+    uint64_t workspaceSize = 0;
+    void *workspace = nullptr;
+    auto runGraph = [&]() {
+        uint64_t newWorkspaceSize = 0;
+        auto status = fused.graph->Setup(variantPack, newWorkspaceSize, context);
+        CHECK_RET(status, "fused graph Setup failed. status: " + std::to_string(status));
+        if (newWorkspaceSize > workspaceSize) {
+            aclrtFree(workspace);
+            status = aclrtMalloc(&workspace, newWorkspaceSize, ACL_MEM_MALLOC_HUGE_FIRST);
+            CHECK_RET(status, "aclrtMalloc workspace failed. status: " + std::to_string(status));
+            workspaceSize = newWorkspaceSize;
+        }
+        status = fused.graph->Execute(variantPack, static_cast<uint8_t *>(workspace), workspaceSize, context);
+        CHECK_RET(status, "fused graph Execute failed. status: " + std::to_string(status));
+    };
+    runGraph();
+    ret = aclrtSynchronizeStream(stream);
+    CHECK_RET(ret, "aclrtSynchronizeStream failed. ret: " + std::to_string(ret));
+
+    std::vector<std::vector<float>> expected = ReferenceForward(hostInputs);
+    GoldenTolerance probTolerance;
+    probTolerance.absTol = 1e-6; // softmax的输出约为1/HIDDEN，使用绝对容差时比较没有意义
+    GoldenResult probResult = CompareFp16(ToFp16(expected[0]).data(),
+                                          ToFp16(DownloadTensor(variantPack.outTensors.at(0))).data(),
+                                          TOKENS * HIDDEN, probTolerance);
+    LogGoldenResult("softmax output", probResult);
+    GoldenResult sumResult = CompareFp16(ToFp16(expected[1]).data(),
+                                         ToFp16(DownloadTensor(variantPack.outTensors.at(1))).data(), TOKENS * HIDDEN,
+                                         GoldenTolerance());
+    LogGoldenResult("residual sum output", sumResult);
+    bool passed = probResult.passed && sumResult.passed;
+
+    // 重复执行，desc不变时aclnn节点复用第一次创建的executor
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < REPEAT_COUNT; i++) {
+        runGraph();
+    }
+    aclrtSynchronizeStream(stream);
+    std::chrono::duration<double, std::micro> graphUs = std::chrono::steady_clock::now() - start;
+    uint64_t buildCount = fused.addLayerNorm->GetExecutorBuildCount() + fused.matmulGelu->GetExecutorBuildCount() +
+                          fused.biasAdd->GetExecutorBuildCount() + fused.softmax->GetExecutorBuildCount();
+    bool reused = buildCount == 4;
+    LOG_ERROR("fused graph: " + std::to_string(graphUs.count() / REPEAT_COUNT) + " us per execute, " +
+              std::to_string(buildCount) + " executors built for 4 aclnn nodes in " +
+              std::to_string(REPEAT_COUNT + 1) + " executes" + (reused ? "" : ", REBUILT"));
+    passed = passed && reused;
+
+    // Setup开销：GeluOperation每次重建aclTensor和不可复用的executor，AclnnOperation只刷新地址
+    atb::VariantPack geluPack;
+    geluPack.inTensors.push_back(variantPack.inTensors.at(IN_TENSOR_X));
+    geluPack.outTensors.push_back(variantPack.outTensors.at(1));
+    GeluOperation handWritten("Gelu", AclnnGeluParam());
+    AclnnOperation<GeluOpDef> adapted("AdaptedGelu");
+    double handWrittenUs = MeasureSetupExecuteUs(&handWritten, geluPack, context, stream);
+    double adaptedUs = MeasureSetupExecuteUs(&adapted, geluPack, context, stream);
+    LOG_ERROR("gelu setup + execute: GeluOperation " + std::to_string(handWrittenUs) + " us, AclnnOperation " +
+              std::to_string(adaptedUs) + " us");
+
+    atb::DestroyOperation(fused.graph);
+    for (auto &tensor : variantPack.inTensors) {
+        aclrtFree(tensor.deviceData);
+    }
+    for (auto &tensor : variantPack.outTensors) {
+        aclrtFree(tensor.deviceData);
+    }
+    aclrtFree(workspace);
+    aclrtDestroyStream(stream);
+    atb::DestroyContext(context);
+    aclrtResetDevice(0);
+    aclFinalize();
+    LOG_ERROR(passed ? "fused ops check passed" : "fused ops check failed");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+#include <random>
+#include <string>
+#include <vector>
+#include "memory/memory_utils.h"
+#include "model/model.h"
+#include "model/model2.h"
+#include "reference/cpu_kernels.h"
+#include "reference/golden_compare.h"
+#include "utils/tensor_io.h"
+#include "utils/utils.h"
+
+// golden比对：把模型输入改写为随机数据后执行，输出与host参考kernel的结果比较，任一不一致时返回1
+// Model分别关闭和开启原地计算比较一次，Model2的三种权重布局分别比较一次
+constexpr float ACTIVATION_RANGE = 2.0f;
+constexpr float WEIGHT_RANGE = 0.05f;
+
+// 输入tensor按均匀分布填充随机数据，按dtype转换后上传
+void FillRandomTensor(atb::Tensor &tensor, std::mt19937 &engine, float range)
+{
+    std::uniform_real_distribution<float> dist(-range, range);
+    std::vector<float> hostData(atb::Utils::GetTensorNumel(tensor));
+    for (auto &value : hostData) {
+        value = dist(engine);
+    }
+    UploadTensor(tensor, hostData.data());
+}
+
+bool RunModelGolden(uint32_t deviceId, bool inPlace, const GoldenTolerance &tolerance)
+{
+    Model model("golden_model");
+    model.InitResource(deviceId);
+    model.SetInPlace(inPlace);
+    model.CreateModelGraph();
+    model.CreateModelInput();
+    model.CreateModelOutput();
+
+    std::mt19937 engine(0);
+    for (auto &tensor : model.model_inTensors_) {
+        FillRandomTensor(tensor, engine, ACTIVATION_RANGE);
+    }
+    model.Execute();
+    GoldenResult result = CheckModelGolden(model, tolerance);
+    std::string name = inPlace ? "model in-place" : "model";
+    LogGoldenResult(name, result);
+    LOG_ERROR(name + " internal tensor bytes: " + std::to_string(model.GetInternalTensorBytes()));
+    model.FreeResource();
+    return result.passed;
+}
+
+bool RunModel2Golden(uint32_t deviceId, WeightLayout layout, const std::string &name,
+                     const GoldenTolerance &tolerance)
+{
+    Model2 model("golden_" + name);
+    model.InitResource(deviceId);
+    model.SetWeightLayout(layout);
+    model.CreateModelGraph();
+    model.CreateModelInput();
+    model.CreateModelOutput();
+
+    // 权重由WeightStore共享，这里只有当前实例在使用，可以直接改写
+    std::mt19937 engine(static_cast<uint32_t>(layout));
+    for (size_t i = 0; i < model.model_inTensors_.size(); i++) {
+        bool isLinearWeight = i == Model2::IN_TENSOR_MATMUL_WEIGHT || i == Model2::IN_TENSOR_MATMUL_BIAS;
+        FillRandomTensor(model.model_inTensors_.at(i), engine, isLinearWeight ? WEIGHT_RANGE : ACTIVATION_RANGE);
+    }
+    model.Execute();
+    GoldenResult result = CheckModel2Golden(model, tolerance);
+    LogGoldenResult("model2 " + name, result);
+    model.FreeResource();
+    return result.passed;
+}
+
+int main()
+{
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+
+    // 创建内存池
+    size_t poolSize = 104857600; // Alloceted memory 100 MiB.
+    GetMemoryManager().CreateMemoryPool(poolSize);
+
+    LOG_ERROR(std::string("reference kernels use ") + GetCpuIsaName(GetCpuIsa()));
+    GoldenTolerance tolerance;
+    bool passed = RunModelGolden(0, false, tolerance);
+    passed = RunModelGolden(0, true, tolerance) && passed;
+    passed = RunModel2Golden(0, WeightLayout::ND, "ND", tolerance) && passed;
+    passed = RunModel2Golden(0, WeightLayout::ND_TRANSPOSED, "ND_TRANSPOSED", tolerance) && passed;
+    passed = RunModel2Golden(0, WeightLayout::FRACTAL_NZ, "FRACTAL_NZ", tolerance) && passed;
+
+    aclFinalize();
+    LOG_ERROR(passed ? "golden compare passed" : "golden compare failed");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include "memory/memory_utils.h"
+#include "model/model.h"
+#include "runtime/model_step_executor.h"
+#include "utils/tensor_io.h"
+#include "utils/test_check.h"
+#include "utils/utils.h"
+
+// 调度器在Model上按节点分步执行的检查
+// 三个Model实例各自上传不同的随机输入，先用Execute得到参考输出，清零输出后提交到单工作线程的优先级调度器：
+// BULK请求执行完第一个节点时提交INTERACTIVE和STANDARD请求，BULK请求在节点之间被抢占，
+// 完成顺序为INTERACTIVE、STANDARD、BULK，且每个模型的输出与参考输出一致。任一检查失败时返回1
+constexpr size_t POOL_SIZE = 104857600; // Alloceted memory 100 MiB.
+constexpr size_t MODEL_COUNT = 3;
+constexpr size_t BULK_MODEL = 0;
+constexpr uint32_t RANDOM_SEED = 2024;
+
+// 在BULK请求的第一个节点之后暂停，等待主线程提交其他请求；记录请求的完成顺序
+class GatedExecutor : public ModelStepExecutor<Model>
+{
+public:
+    explicit GatedExecutor(Model *gatedModel) : gatedModel_(gatedModel) {}
+
+    void RunStep(ModelStepRequest<Model> &request, uint32_t step) override
+    {
+        ModelStepExecutor<Model>::RunStep(request, step);
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (step + 1 == request.model->GetStepCount()) {
+            finishOrder_.push_back(request.model);
+        }
+        if (request.model == gatedModel_ && step == 0) {
+            reached_ = true;
+            cv_.notify_all();
+            cv_.wait(lock, [this] { return released_; });
+        }
+    }
+
+    void WaitReached()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return reached_; });
+    }
+
+    void Release()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        released_ = true;
+        cv_.notify_all();
+    }
+
+    std::vector<Model *> GetFinishOrder()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return finishOrder_;
+    }
+
+private:
+    Model *gatedModel_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool reached_ = false;
+    bool released_ = false;
+    std::vector<Model *> finishOrder_;
+};
+
+static void UploadRandomInputs(Model &model, std::mt19937 &engine)
+{
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    for (auto &tensor : model.model_inTensors_) {
+        std::vector<float> data(atb::Utils::GetTensorNumel(tensor.desc));
+        for (auto &item : data) {
+            item = value(engine);
+        }
+        UploadTensor(tensor, data.data());
+    }
+}
+
+int main()
+{
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+    GetMemoryManager().CreateMemoryPool(POOL_SIZE);
+
+    std::mt19937 engine(RANDOM_SEED);
+    std::vector<Model> models(MODEL_COUNT);
+    std::vector<std::vector<float>> references(MODEL_COUNT);
+    for (size_t i = 0; i < MODEL_COUNT; i++) {
+        Model &model = models[i];
+        model.InitResource(0);
+        model.CreateModelGraph();
+        model.CreateModelInput();
+        model.CreateModelOutput();
+        UploadRandomInputs(model, engine);
+        model.Execute();
+        references[i] = DownloadTensor(model.model_outTensors_.at(0));
+        atb::Tensor &output = model.model_outTensors_.at(0);
+        ret = aclrtMemset(output.deviceData, output.dataSize, 0, output.dataSize);
+        CHECK_RET(ret, "aclrtMemset failed. ret: " + std::to_string(ret));
+    }
+    bool passed = Check(references[0] != references[1], "models have distinct reference outputs");
+
+    auto executor = std::make_shared<GatedExecutor>(&models[BULK_MODEL]);
+    std::vector<ModelStepRequest<Model>> requests(MODEL_COUNT);
+    std::vector<std::future<ScheduleOutcome>> outcomes;
+    std::vector<PriorityClassStats> stats;
+    {
+        PriorityScheduler<ModelStepRequest<Model>> scheduler(SchedulerMode::PRIORITY_EDF, executor, 1);
+        const RequestPriority priorities[MODEL_COUNT] = {RequestPriority::BULK, RequestPriority::INTERACTIVE,
+                                                         RequestPriority::STANDARD};
+        for (size_t i = 0; i < MODEL_COUNT; i++) {
+            ModelStepRequest<Model> request;
+            request.model = &models[i];
+            request.deviceId = 0;
+            outcomes.push_back(scheduler.Submit(request, priorities[i], 1, models[i].GetStepCount(), 0));
+            if (i == BULK_MODEL) {
+                executor->WaitReached();
+            }
+        }
+        executor->Release();
+        scheduler.WaitIdle();
+        stats = scheduler.GetStats();
+    }
+
+    for (size_t i = 0; i < MODEL_COUNT; i++) {
+        passed = Check(outcomes[i].get() == ScheduleOutcome::COMPLETED, "request " + std::to_string(i) + " completed") &&
+                 passed;
+    }
+    uint64_t preempted = stats.at(static_cast<size_t>(RequestPriority::BULK)).preempted;
+    passed = Check(preempted == 1, "bulk request preempted at node boundary " + std::to_string(preempted) + " time(s)") &&
+             passed;
+    std::vector<Model *> expectedOrder = {&models[1], &models[2], &models[BULK_MODEL]};
+    passed = Check(executor->GetFinishOrder() == expectedOrder, "finish order interactive, standard, bulk") && passed;
+
+    for (size_t i = 0; i < MODEL_COUNT; i++) {
+        std::vector<float> output = DownloadTensor(models[i].model_outTensors_.at(0));
+        double maxError = output.size() == references[i].size() ? 0 : 1e9;
+        for (size_t j = 0; j < output.size() && j < references[i].size(); j++) {
+            maxError = std::max(maxError, static_cast<double>(std::fabs(output[j] - references[i][j])));
+        }
+        passed = Check(maxError == 0, "model " + std::to_string(i) + " stepped output matches Execute, max abs error " +
+                                          std::to_string(maxError)) &&
+                 passed;
+        models[i].FreeResource();
+    }
+    aclFinalize();
+    LOG_ERROR(passed ? "model scheduler check passed" : "model scheduler check failed");
+    return passed ? 0 : 1;
+}
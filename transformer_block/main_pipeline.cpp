@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include "memory/memory_utils.h"
+#include "runtime/acl_pipeline_backend.h"
+#include "runtime/pipeline_scheduler.h"
+#include "utils/tensor_io.h"
+#include "utils/test_check.h"
+#include "utils/utils.h"
+
+// 层间流水线：先用仿真后端对比切分方式，再用Model2在真实device上跑流水线
+// 仿真：按耗时切分的最大stage耗时不超过均匀切分，两种切分的makespan都小于串行估计；
+// ACL：各层权重不同，每个micro-batch输入不同的随机数据，流水线输出与在device 0上逐层串行执行的结果一致。
+// 任一检查失败时返回1
+constexpr size_t MICRO_BATCH_COUNT = 16;
+constexpr size_t SLOT_COUNT = 2;
+constexpr double SIM_TRANSFER_MS = 1.0;
+const std::vector<double> SIM_LAYER_TIMES_MS = {2, 2, 4, 4, 8, 2, 2, 6, 3, 3, 5, 1};
+
+constexpr size_t ACL_LAYER_COUNT = 4;
+constexpr size_t ACL_PROFILE_ITERATIONS = 2;
+constexpr size_t ACL_MICRO_BATCH_COUNT = 4;
+constexpr uint32_t RANDOM_SEED = 2024;
+
+void LogStages(const std::string &name, const std::vector<StageRange> &stages)
+{
+    for (size_t i = 0; i < stages.size(); i++) {
+        LOG_ERROR(name + " stage " + std::to_string(i) + " layers [" + std::to_string(stages[i].beginLayer) + ", " +
+                  std::to_string(stages[i].endLayer) + ") estimated " + std::to_string(stages[i].timeMs) + " ms");
+    }
+}
+
+void LogRun(const std::string &name, const PipelineRunStats &stats)
+{
+    LOG_ERROR(name + " makespan " + std::to_string(stats.makespanMs) + " ms, bubble ratio " +
+              std::to_string(stats.bubbleRatio));
+    for (size_t i = 0; i < stats.stages.size(); i++) {
+        LOG_ERROR(name + " stage " + std::to_string(i) + " compute " + std::to_string(stats.stages[i].computeMs) +
+                  " ms, transfer " + std::to_string(stats.stages[i].transferMs) + " ms, wait " +
+                  std::to_string(stats.stages[i].waitMs) + " ms");
+    }
+}
+
+double MaxStageTimeMs(const std::vector<StageRange> &stages)
+{
+    double maxMs = 0;
+    for (const auto &stage : stages) {
+        maxMs = std::max(maxMs, stage.timeMs);
+    }
+    return maxMs;
+}
+
+PipelineRunStats RunSimulated(const std::vector<StageRange> &stages)
+{
+    SimulatedPipelineBackend backend(SIM_LAYER_TIMES_MS, stages, SIM_TRANSFER_MS);
+    PipelineScheduler scheduler(backend, stages.size(), SLOT_COUNT);
+    scheduler.Start();
+    PipelineRunStats stats = scheduler.Run(MICRO_BATCH_COUNT);
+    scheduler.Stop();
+    return stats;
+}
+
+bool RunSimulatedComparison(size_t stageCount)
+{
+    double sequentialMs = std::accumulate(SIM_LAYER_TIMES_MS.begin(), SIM_LAYER_TIMES_MS.end(), 0.0) *
+                          MICRO_BATCH_COUNT;
+    LOG_ERROR("sim sequential estimate " + std::to_string(sequentialMs) + " ms");
+
+    auto even = PartitionStagesEvenly(SIM_LAYER_TIMES_MS, stageCount, SIM_TRANSFER_MS);
+    LogStages("sim even", even);
+    PipelineRunStats evenStats = RunSimulated(even);
+    LogRun("sim even", evenStats);
+
+    auto balanced = PartitionStages(SIM_LAYER_TIMES_MS, stageCount, SIM_TRANSFER_MS);
+    LogStages("sim balanced", balanced);
+    PipelineRunStats balancedStats = RunSimulated(balanced);
+    LogRun("sim balanced", balancedStats);
+
+    bool passed = Check(balanced.size() == stageCount && even.size() == stageCount,
+                        "sim partitions have " + std::to_string(stageCount) + " stages");
+    passed = Check(MaxStageTimeMs(balanced) <= MaxStageTimeMs(even),
+                   "sim balanced max stage " + std::to_string(MaxStageTimeMs(balanced)) + " ms <= even " +
+                       std::to_string(MaxStageTimeMs(even)) + " ms") &&
+             passed;
+    passed = Check(evenStats.makespanMs < sequentialMs && balancedStats.makespanMs < sequentialMs,
+                   "sim pipelined makespan below sequential estimate") &&
+             passed;
+    return passed;
+}
+
+std::vector<std::vector<float>> MakeRandomInputs(size_t count, size_t numel)
+{
+    std::mt19937 engine(RANDOM_SEED);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    std::vector<std::vector<float>> inputs(count, std::vector<float>(numel));
+    for (auto &input : inputs) {
+        for (auto &item : input) {
+            item = value(engine);
+        }
+    }
+    return inputs;
+}
+
+// 在device 0上逐层串行执行，层之间的激活传递方式与AclPipelineBackend一致：下一层消费上一层输出的前缀
+std::vector<std::vector<float>> RunSerialReference(const std::vector<std::vector<float>> &inputs)
+{
+    std::vector<std::unique_ptr<Model2>> layers;
+    for (size_t layer = 0; layer < ACL_LAYER_COUNT; layer++) {
+        auto model = std::make_unique<Model2>("reference_layer_" + std::to_string(layer));
+        model->InitResource(0);
+        model->SetWeightSeed(AclPipelineBackend::LayerWeightSeed(layer));
+        model->CreateModelGraph();
+        model->CreateModelInput();
+        model->CreateModelOutput();
+        layers.push_back(std::move(model));
+    }
+
+    std::vector<std::vector<float>> outputs;
+    for (const auto &input : inputs) {
+        UploadTensor(layers.front()->model_inTensors_.at(Model2::IN_TENSOR_X), input.data());
+        for (size_t i = 0; i < layers.size(); i++) {
+            layers[i]->Execute();
+            if (i + 1 < layers.size()) {
+                atb::Tensor &out = layers[i]->model_outTensors_.at(0);
+                atb::Tensor &x = layers[i + 1]->model_inTensors_.at(Model2::IN_TENSOR_X);
+                auto ret = aclrtMemcpy(x.deviceData, x.dataSize, out.deviceData, std::min(x.dataSize, out.dataSize),
+                                       ACL_MEMCPY_DEVICE_TO_DEVICE);
+                CHECK_RET(ret, "aclrtMemcpy D2D failed. ret: " + std::to_string(ret));
+            }
+        }
+        outputs.push_back(DownloadTensor(layers.back()->model_outTensors_.at(0)));
+    }
+    for (auto &layer : layers) {
+        layer->FreeResource();
+    }
+    return outputs;
+}
+
+bool RunAcl()
+{
+    uint32_t deviceCount = 0;
+    auto ret = aclrtGetDeviceCount(&deviceCount);
+    CHECK_RET(ret, "aclrtGetDeviceCount failed. ret: " + std::to_string(ret));
+
+    // 在device 0上实测每层耗时，再按device数切分stage
+    std::vector<double> layerTimesMs = AclPipelineBackend::MeasureLayerTimesMs(0, ACL_LAYER_COUNT,
+                                                                               ACL_PROFILE_ITERATIONS);
+    auto stages = PartitionStages(layerTimesMs, deviceCount);
+    LogStages("acl", stages);
+    std::vector<uint32_t> stageDeviceIds;
+    for (size_t i = 0; i < stages.size(); i++) {
+        stageDeviceIds.push_back(static_cast<uint32_t>(i));
+    }
+
+    // 输入元素数取自一个临时实例，与流水线第一层的IN_TENSOR_X一致
+    Model2 shape("shape_layer");
+    shape.InitResource(0);
+    shape.CreateModelGraph();
+    shape.CreateModelInput();
+    size_t numel = atb::Utils::GetTensorNumel(shape.model_inTensors_.at(Model2::IN_TENSOR_X).desc);
+    shape.FreeResource();
+    std::vector<std::vector<float>> inputs = MakeRandomInputs(ACL_MICRO_BATCH_COUNT, numel);
+    std::vector<std::vector<float>> references = RunSerialReference(inputs);
+
+    AclPipelineBackend backend(stageDeviceIds, stages, SLOT_COUNT);
+    backend.SetMicroBatchInputs(inputs);
+    PipelineScheduler scheduler(backend, stages.size(), SLOT_COUNT);
+    scheduler.Start();
+    double sequentialMs = std::accumulate(layerTimesMs.begin(), layerTimesMs.end(), 0.0);
+    LOG_ERROR("acl sequential estimate " + std::to_string(sequentialMs * ACL_MICRO_BATCH_COUNT) + " ms");
+    LogRun("acl", scheduler.Run(ACL_MICRO_BATCH_COUNT));
+    scheduler.Stop();
+
+    bool passed = Check(references[0] != references[1], "micro-batches have distinct reference outputs");
+    for (size_t i = 0; i < ACL_MICRO_BATCH_COUNT; i++) {
+        const std::vector<float> &output = backend.GetMicroBatchOutput(i);
+        double maxError = output.size() == references[i].size() ? 0 : 1e9;
+        for (size_t j = 0; j < output.size() && j < references[i].size(); j++) {
+            maxError = std::max(maxError, static_cast<double>(std::fabs(output[j] - references[i][j])));
+        }
+        passed = Check(maxError == 0, "acl micro-batch " + std::to_string(i) +
+                                          " pipelined output matches serial, max abs error " +
+                                          std::to_string(maxError)) &&
+                 passed;
+    }
+    return passed;
+}
+
+int main()
+{
+    bool passed = RunSimulatedComparison(3);
+
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+
+    // 创建内存池
+    size_t poolSize = 104857600; // Alloceted memory 100 MiB.
+    GetMemoryManager().CreateMemoryPool(poolSize);
+
+    passed = RunAcl() && passed;
+
+    aclFinalize();
+    LOG_ERROR(passed ? "pipeline check passed" : "pipeline check failed");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+#include <chrono>
+#include <string>
+#include "memory/memory_utils.h"
+#include "model/model2.h"
+#include "utils/profiler.h"
+#include "utils/utils.h"
+
+// 节点级性能分析：先测量关闭时打点的开销，再开启分析执行Model2，输出各节点统计和Chrome trace
+constexpr int DISABLED_SCOPE_COUNT = 10000000;
+constexpr int EXECUTE_COUNT = 5;
+const std::string TRACE_PATH = "model2_trace.json";
+
+void MeasureDisabledOverhead()
+{
+    GetProfiler().Disable();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < DISABLED_SCOPE_COUNT; i++) {
+        ProfileScope scope("Disabled", i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    LOG_ERROR("disabled profile scope cost " + std::to_string(elapsed.count() / DISABLED_SCOPE_COUNT) + " ns");
+}
+
+void RunProfiledModel(uint32_t deviceId)
+{
+    Model2 model("profiled");
+    model.InitResource(deviceId);
+    model.CreateModelGraph();
+    model.CreateModelInput();
+    model.CreateModelOutput();
+
+    // 首次执行包含workspace分配，单独预热后再开始记录
+    model.Execute();
+    GetProfiler().Enable();
+    for (int i = 0; i < EXECUTE_COUNT; i++) {
+        model.Execute();
+    }
+    GetProfiler().Disable();
+    model.FreeResource();
+
+    GetProfiler().LogSummary();
+    if (GetProfiler().WriteChromeTrace(TRACE_PATH)) {
+        LOG_ERROR("chrome trace written to " + TRACE_PATH);
+    }
+}
+
+int main()
+{
+    MeasureDisabledOverhead();
+
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+
+    // 创建内存池
+    size_t poolSize = 104857600; // Alloceted memory 100 MiB.
+    GetMemoryManager().CreateMemoryPool(poolSize);
+
+    RunProfiledModel(0);
+
+    aclFinalize();
+    LOG_ERROR("完成aclFinalize");
+    return 0;
+}
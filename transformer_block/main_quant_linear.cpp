@@ -0,0 +1,79 @@
+#include <chrono>
+#include <string>
+#include <vector>
+#include "memory/memory_utils.h"
+#include "memory/weight_store.h"
+#include "model/model2.h"
+#include "utils/tensor_io.h"
+#include "utils/utils.h"
+#include "utils/weight_quant.h"
+
+// 同一device上分别以FP16/W8A16/W8A8运行LayerNorm + Linear，比较量化输出与FP16输出的误差和权重占用
+constexpr int WARMUP_COUNT = 1;
+constexpr int EXECUTE_COUNT = 3;
+
+std::string QuantTypeName(LinearQuantType quantType)
+{
+    if (quantType == LinearQuantType::W8A16) {
+        return "W8A16";
+    }
+    if (quantType == LinearQuantType::W8A8) {
+        return "W8A8";
+    }
+    return "FP16";
+}
+
+std::vector<float> ReadOutput(const atb::Tensor &outTensor)
+{
+    return DownloadTensor(outTensor);
+}
+
+std::vector<float> RunModel(uint32_t deviceId, LinearQuantType quantType)
+{
+    Model2 model("quant_" + QuantTypeName(quantType));
+    model.InitResource(deviceId);
+    model.SetLinearQuantType(quantType);
+    model.CreateModelGraph();
+    model.CreateModelInput();
+    model.CreateModelOutput();
+    uint64_t weightBytes = GetWeightStore().GetResidentBytes();
+
+    for (int i = 0; i < WARMUP_COUNT; i++) {
+        model.Execute();
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < EXECUTE_COUNT; i++) {
+        model.Execute();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::vector<float> output = ReadOutput(model.model_outTensors_.at(0));
+    LOG_ERROR(QuantTypeName(quantType) + " resident weight bytes " + std::to_string(weightBytes) + ", latency " +
+              std::to_string(elapsed.count() / EXECUTE_COUNT) + " ms");
+    model.FreeResource();
+    return output;
+}
+
+int main()
+{
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+
+    // 创建内存池
+    size_t poolSize = 104857600; // Alloceted memory 100 MiB.
+    GetMemoryManager().CreateMemoryPool(poolSize);
+
+    std::vector<float> reference = RunModel(0, LinearQuantType::FP16);
+    for (LinearQuantType quantType : {LinearQuantType::W8A16, LinearQuantType::W8A8}) {
+        std::vector<float> output = RunModel(0, quantType);
+        QuantAccuracy accuracy = CompareOutputs(reference.data(), output.data(), reference.size());
+        LOG_ERROR(QuantTypeName(quantType) + " vs FP16: max abs error " + std::to_string(accuracy.maxAbsError) +
+                  ", mean abs error " + std::to_string(accuracy.meanAbsError) + ", cosine " +
+                  std::to_string(accuracy.cosineSimilarity));
+    }
+
+    aclFinalize();
+    LOG_ERROR("完成aclFinalize");
+    return 0;
+}
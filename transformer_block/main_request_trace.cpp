@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "runtime/request_trace.h"
+#include "utils/log.h"
+#include "utils/test_check.h"
+
+// 请求到达记录文件的读写检查，无需NPU
+// 打开记录文件、记录若干请求并等待一段时间后关闭：文件头的startUnixUs是Open时的墙上时间而不是Close时的，
+// recordCount为记录数，LoadTrace读回的记录与写入一致。任一检查失败时返回1
+// 用法：test_request_trace [path]，默认在当前目录写request_trace_test.bin
+constexpr const char *DEFAULT_TRACE_PATH = "request_trace_test.bin";
+constexpr uint32_t RECORD_COUNT = 3;
+constexpr int CLOSE_DELAY_MS = 50;
+
+static uint64_t NowUnixUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+int main(int argc, char **argv)
+{
+    std::string path = argc > 1 ? argv[1] : DEFAULT_TRACE_PATH;
+    uint64_t beforeOpenUs = NowUnixUs();
+    TraceRecorder recorder;
+    if (!Check(recorder.Open(path), "open trace file " + path)) {
+        return 1;
+    }
+    uint64_t afterOpenUs = NowUnixUs();
+    for (uint32_t i = 0; i < RECORD_COUNT; i++) {
+        recorder.Record(i + 1, 1, RequestPriority::STANDARD, 2, 10.0);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(CLOSE_DELAY_MS));
+    recorder.Close();
+
+    TraceFileHeader header;
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    bool passed = Check(file != nullptr && std::fread(&header, sizeof(header), 1, file) == 1, "read trace header");
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+    passed = Check(header.startUnixUs >= beforeOpenUs && header.startUnixUs <= afterOpenUs,
+                   "startUnixUs is the Open time (" + std::to_string(beforeOpenUs) + " <= " +
+                       std::to_string(header.startUnixUs) + " <= " + std::to_string(afterOpenUs) + ")") &&
+             passed;
+    passed = Check(header.recordCount == RECORD_COUNT, "recordCount rewritten on Close: " +
+                                                           std::to_string(header.recordCount)) &&
+             passed;
+
+    std::vector<TraceRecord> records;
+    passed = Check(LoadTrace(path, records) && records.size() == RECORD_COUNT, "load records") && passed;
+    for (uint32_t i = 0; i < records.size(); i++) {
+        passed = Check(records[i].shapeKey == i + 1 && records[i].stepCount == 2,
+                       "record " + std::to_string(i) + " round trip") &&
+                 passed;
+    }
+    std::remove(path.c_str());
+    LOG_ERROR(passed ? "request trace check passed" : "request trace check failed");
+    return passed ? 0 : 1;
+}
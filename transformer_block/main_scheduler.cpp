@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include "runtime/priority_scheduler.h"
+#include "utils/log.h"
+
+// 用仿真负载对比FIFO与优先级+EDF调度，无需NPU
+// 负载由三类请求混合：少量步数的短INTERACTIVE请求、中等的STANDARD请求和多步的BULK批量任务，
+// 各类按泊松过程到达，总负载接近工作线程的处理能力
+constexpr uint32_t WORKER_COUNT = 2;
+constexpr double WORKLOAD_DURATION_MS = 2000.0;
+constexpr uint32_t RANDOM_SEED = 2024;
+
+using Clock = std::chrono::steady_clock;
+
+// 一类请求的负载参数
+struct RequestClass
+{
+    std::string name;
+    RequestPriority priority;
+    uint64_t shapeKey;
+    uint32_t stepCount;
+    double stepMs;
+    double deadlineMs;
+    double meanIntervalMs; // 平均到达间隔
+};
+
+const std::vector<RequestClass> WORKLOAD = {
+    {"interactive", RequestPriority::INTERACTIVE, 1, 2, 0.5, 15.0, 5.0},
+    {"standard", RequestPriority::STANDARD, 2, 4, 1.0, 100.0, 10.0},
+    {"bulk", RequestPriority::BULK, 3, 16, 2.0, 400.0, 35.0},
+};
+
+struct SimRequest
+{
+    size_t index = 0;
+    uint32_t stepCount = 1;
+    double stepMs = 0;
+};
+
+struct Arrival
+{
+    double timeMs;
+    size_t classIndex;
+};
+
+// 记录每个请求最后一步完成的时刻
+class RecordingExecutor : public SimulatedStepExecutor<SimRequest>
+{
+public:
+    explicit RecordingExecutor(size_t requestCount) : finishTimes_(requestCount)
+    {
+    }
+
+    void RunStep(SimRequest &request, uint32_t step) override
+    {
+        SimulatedStepExecutor<SimRequest>::RunStep(request, step);
+        if (step + 1 == request.stepCount) {
+            finishTimes_.at(request.index) = Clock::now();
+        }
+    }
+
+    Clock::time_point GetFinishTime(size_t index) const
+    {
+        return finishTimes_.at(index);
+    }
+
+private:
+    std::vector<Clock::time_point> finishTimes_; // 每个下标只由执行该请求最后一步的线程写入
+};
+
+static std::vector<Arrival> GenerateArrivals()
+{
+    std::mt19937 generator(RANDOM_SEED);
+    std::vector<Arrival> arrivals;
+    for (size_t i = 0; i < WORKLOAD.size(); i++) {
+        std::exponential_distribution<double> interval(1.0 / WORKLOAD[i].meanIntervalMs);
+        for (double timeMs = interval(generator); timeMs < WORKLOAD_DURATION_MS; timeMs += interval(generator)) {
+            arrivals.push_back({timeMs, i});
+        }
+    }
+    std::sort(arrivals.begin(), arrivals.end(),
+              [](const Arrival &lhs, const Arrival &rhs) { return lhs.timeMs < rhs.timeMs; });
+    return arrivals;
+}
+
+static double Percentile(std::vector<double> sorted, double ratio)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    std::sort(sorted.begin(), sorted.end());
+    size_t rank = static_cast<size_t>(std::ceil(ratio * sorted.size()));
+    return sorted.at(rank == 0 ? 0 : rank - 1);
+}
+
+// 按相同的到达序列运行一种调度模式，返回INTERACTIVE请求的p99延迟
+static double RunMode(SchedulerMode mode, const std::string &modeName, const std::vector<Arrival> &arrivals)
+{
+    auto executor = std::make_shared<RecordingExecutor>(arrivals.size());
+    std::vector<Clock::time_point> submitTimes(arrivals.size());
+    std::vector<std::future<ScheduleOutcome>> outcomes;
+    std::vector<PriorityClassStats> stats;
+    {
+        PriorityScheduler<SimRequest> scheduler(mode, executor, WORKER_COUNT);
+        auto start = Clock::now();
+        for (size_t i = 0; i < arrivals.size(); i++) {
+            const RequestClass &requestClass = WORKLOAD[arrivals[i].classIndex];
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(
+                                                      std::chrono::duration<double, std::milli>(arrivals[i].timeMs)));
+            SimRequest request;
+            request.index = i;
+            request.stepCount = requestClass.stepCount;
+            request.stepMs = requestClass.stepMs;
+            submitTimes[i] = Clock::now();
+            outcomes.push_back(scheduler.Submit(request, requestClass.priority, requestClass.shapeKey,
+                                                requestClass.stepCount, requestClass.deadlineMs));
+        }
+        scheduler.WaitIdle();
+        stats = scheduler.GetStats();
+    }
+
+    // 延迟和超时按每类请求的截止时间从提交时刻统计
+    std::vector<std::vector<double>> latencies(WORKLOAD.size());
+    std::vector<uint64_t> missed(WORKLOAD.size(), 0);
+    for (size_t i = 0; i < arrivals.size(); i++) {
+        if (outcomes[i].get() != ScheduleOutcome::COMPLETED) {
+            continue;
+        }
+        size_t classIndex = arrivals[i].classIndex;
+        std::chrono::duration<double, std::milli> latency = executor->GetFinishTime(i) - submitTimes[i];
+        latencies[classIndex].push_back(latency.count());
+        if (latency.count() > WORKLOAD[classIndex].deadlineMs) {
+            missed[classIndex]++;
+        }
+    }
+    for (size_t i = 0; i < WORKLOAD.size(); i++) {
+        const PriorityClassStats &classStats = stats.at(static_cast<size_t>(WORKLOAD[i].priority));
+        LOG_ERROR(modeName + " " + WORKLOAD[i].name + ": submitted " + std::to_string(classStats.submitted) +
+                  ", rejected " + std::to_string(classStats.rejected) + ", completed " +
+                  std::to_string(classStats.completed) + ", deadline missed " + std::to_string(missed[i]) +
+                  ", preempted " + std::to_string(classStats.preempted) + ", p50 " +
+                  std::to_string(Percentile(latencies[i], 0.5)) + " ms, p99 " +
+                  std::to_string(Percentile(latencies[i], 0.99)) + " ms");
+    }
+    return Percentile(latencies[0], 0.99);
+}
+
+int main()
+{
+    std::vector<Arrival> arrivals = GenerateArrivals();
+    LOG_ERROR("workload: " + std::to_string(arrivals.size()) + " requests in " +
+              std::to_string(WORKLOAD_DURATION_MS) + " ms, " + std::to_string(WORKER_COUNT) + " workers");
+    double fifoP99 = RunMode(SchedulerMode::FIFO, "fifo", arrivals);
+    double priorityP99 = RunMode(SchedulerMode::PRIORITY_EDF, "priority_edf", arrivals);
+    if (priorityP99 >= fifoP99) {
+        LOG_ERROR("priority_edf did not reduce interactive p99 latency");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <csignal>
+#include <string>
+#include "memory/memory_utils.h"
+#include "runtime/inference_server.h"
+#include "utils/utils.h"
+
+// 本地推理服务：在Unix域socket上接收请求，输入输出经共享内存环传递，收到SIGINT/SIGTERM后排空退出
+// 用法：inference_server [--socket path] [--devices N] [--workers N] [--slots N] [--max-pending N]
+//                        [--max-connections N] [--trace path] [--metrics-port N] [--metrics-file path]
+//                        [--metrics-interval-ms N]
+// 客户端负载生成器见bench_server
+constexpr size_t POOL_SIZE = 104857600; // Alloceted memory 100 MiB.
+
+static InferenceServer *g_server = nullptr;
+
+static void HandleSignal(int signal)
+{
+    (void)signal;
+    if (g_server != nullptr) {
+        g_server->RequestDrain();
+    }
+}
+
+static bool ParseArgs(int argc, char **argv, ServerConfig &config, uint32_t &deviceNum)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            LOG_ERROR("missing value for " + arg);
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--socket") {
+            config.socketPath = value;
+        } else if (arg == "--devices") {
+            deviceNum = std::stoul(value);
+        } else if (arg == "--workers") {
+            config.workersPerDevice = std::stoul(value);
+        } else if (arg == "--slots") {
+            config.slotsPerConnection = std::stoul(value);
+        } else if (arg == "--max-pending") {
+            config.maxPending = std::stoul(value);
+        } else if (arg == "--max-connections") {
+            config.maxConnections = std::stoul(value);
+        } else if (arg == "--trace") {
+            config.tracePath = value;
+        } else if (arg == "--metrics-port") {
+            config.metricsPort = static_cast<uint16_t>(std::stoul(value));
+        } else if (arg == "--metrics-file") {
+            config.metricsFile = value;
+        } else if (arg == "--metrics-interval-ms") {
+            config.metricsIntervalMs = std::stoul(value);
+        } else {
+            LOG_ERROR("unknown argument " + arg);
+            return false;
+        }
+    }
+    return config.workersPerDevice > 0 && config.slotsPerConnection > 0 && config.maxPending > 0 &&
+           config.maxConnections > 0 && config.metricsIntervalMs > 0;
+}
+
+int main(int argc, char **argv)
+{
+    ServerConfig config;
+    uint32_t deviceNum = 0; // 0表示使用全部device
+    if (!ParseArgs(argc, argv, config, deviceNum)) {
+        return 1;
+    }
+
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+    GetMemoryManager().CreateMemoryPool(POOL_SIZE);
+
+    uint32_t deviceCount = 0;
+    ret = aclrtGetDeviceCount(&deviceCount);
+    CHECK_RET(ret, "aclrtGetDeviceCount failed. ret: " + std::to_string(ret));
+    if (deviceNum == 0 || deviceNum > deviceCount) {
+        deviceNum = deviceCount;
+    }
+    for (uint32_t i = 0; i < deviceNum; i++) {
+        config.deviceIds.push_back(i);
+    }
+
+    InferenceServer server(config);
+    g_server = &server;
+    struct sigaction action = {};
+    action.sa_handler = HandleSignal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    bool started = server.Run();
+    g_server = nullptr;
+    ServerStats stats = server.GetStats();
+    LOG_ERROR("connections " + std::to_string(stats.connections) + ", completed " + std::to_string(stats.completed) +
+              ", busy " + std::to_string(stats.busy) + ", timeout " + std::to_string(stats.timeout) + ", draining " +
+              std::to_string(stats.draining) + ", invalid " + std::to_string(stats.invalid) + ", dropped " +
+              std::to_string(stats.dropped));
+
+    aclFinalize();
+    return started ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "aclnn/aclnn_tensor_stats.h"
+#include "memory/memory_utils.h"
+#include "model/model2.h"
+#include "utils/tensor_io.h"
+#include "utils/utils.h"
+
+// 对Model2的输出[1,197,2304]：
+// 1. device侧统计量与全量回读后host计算的结果比较，并注入nan检查nan计数
+// 2. 区间/跨步回读与全量回读中对应的元素比较
+// 3. 对比全量回读、device统计和部分回读的耗时及拷贝字节数
+// 任一比较不一致时返回1
+constexpr float ACTIVATION_RANGE = 2.0f;
+constexpr float STATS_REL_TOLERANCE = 1e-3f;
+constexpr int REPEAT_COUNT = 50;
+constexpr int64_t PRINT_VALUE_COUNT = 11;
+
+TensorStats HostStats(const std::vector<float> &values)
+{
+    TensorStats stats;
+    stats.count = static_cast<int64_t>(values.size());
+    stats.min = INFINITY;
+    stats.max = -INFINITY;
+    double sum = 0;
+    double checksum = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        float value = values[i];
+        checksum += static_cast<double>(value) * static_cast<double>(i % TENSOR_CHECKSUM_PERIOD + 1);
+        if (std::isnan(value)) {
+            stats.nanCount++;
+        }
+        stats.min = std::isnan(value) || value < stats.min ? value : stats.min;
+        stats.max = std::isnan(value) || value > stats.max ? value : stats.max;
+        sum += value;
+    }
+    stats.sum = static_cast<float>(sum);
+    stats.checksum = static_cast<float>(checksum);
+    stats.mean = static_cast<float>(sum / values.size());
+    return stats;
+}
+
+bool NearlyEqual(float a, float b)
+{
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::isnan(a) && std::isnan(b);
+    }
+    return std::fabs(a - b) <= STATS_REL_TOLERANCE * std::fmax(1.0f, std::fabs(b));
+}
+
+bool CheckStats(const std::string &name, const TensorStats &actual, const TensorStats &expected)
+{
+    bool passed = actual.count == expected.count && actual.nanCount == expected.nanCount &&
+                  NearlyEqual(actual.min, expected.min) && NearlyEqual(actual.max, expected.max) &&
+                  NearlyEqual(actual.mean, expected.mean) && NearlyEqual(actual.sum, expected.sum) &&
+                  NearlyEqual(actual.checksum, expected.checksum);
+    LOG_ERROR(name + " device: " + TensorStatsToString(actual));
+    LOG_ERROR(name + " host:   " + TensorStatsToString(expected) + (passed ? "" : ", MISMATCH"));
+    return passed;
+}
+
+bool CheckReadback(const std::string &name, const std::vector<float> &actual, const std::vector<float> &full,
+                   int64_t offset, int64_t rowLength, int64_t rowStride, int64_t rowCount)
+{
+    bool passed = static_cast<int64_t>(actual.size()) == rowLength * rowCount;
+    for (int64_t row = 0; passed && row < rowCount; row++) {
+        for (int64_t i = 0; i < rowLength; i++) {
+            passed = passed && actual[row * rowLength + i] == full[offset + row * rowStride + i];
+        }
+    }
+    LOG_ERROR(name + ": " + std::to_string(actual.size()) + " values " + (passed ? "match" : "MISMATCH"));
+    return passed;
+}
+
+// 多次执行的平均耗时（微秒）
+double MeasureUs(const std::function<void()> &func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < REPEAT_COUNT; i++) {
+        func();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / REPEAT_COUNT;
+}
+
+int main()
+{
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+
+    // 创建内存池
+    size_t poolSize = 104857600; // Alloceted memory 100 MiB.
+    GetMemoryManager().CreateMemoryPool(poolSize);
+
+    Model2 model("tensor_stats_model");
+    model.InitResource(0);
+    model.CreateModelGraph();
+    model.CreateModelInput();
+    model.CreateModelOutput();
+    // 输入和LayerNorm参数改为随机数据，使输出各行不同、统计量有区分度
+    std::mt19937 engine(0);
+    std::uniform_real_distribution<float> dist(-ACTIVATION_RANGE, ACTIVATION_RANGE);
+    for (size_t index : {Model2::IN_TENSOR_X, Model2::IN_TENSOR_GAMMA, Model2::IN_TENSOR_BETA}) {
+        atb::Tensor &tensor = model.model_inTensors_.at(index);
+        std::vector<float> hostData(atb::Utils::GetTensorNumel(tensor));
+        for (auto &value : hostData) {
+            value = dist(engine);
+        }
+        UploadTensor(tensor, hostData.data());
+    }
+    model.Execute();
+
+    atb::Tensor &output = model.model_outTensors_.at(0);
+    int64_t numel = atb::Utils::GetTensorNumel(output);
+    int64_t cols = output.desc.shape.dims[output.desc.shape.dimNum - 1];
+    int64_t rows = numel / cols;
+    std::vector<float> full = DownloadTensor(output);
+
+    TensorStatsCollector collector;
+    TensorStats stats;
+    ret = collector.Compute(output, model.GetStream(), stats);
+    CHECK_RET(ret, "compute tensor stats failed. ret: " + std::to_string(ret));
+    bool passed = CheckStats("output", stats, HostStats(full));
+
+    // 区间、按列切片、每行采样一个元素
+    passed = CheckReadback("range [100, 150)", DownloadTensorRange(output, 100, 50), full, 100, 50, 50, 1) && passed;
+    passed = CheckReadback("columns [8, 24) of each row", DownloadTensorStrided(output, 8, 16, cols, rows), full, 8, 16,
+                           cols, rows) &&
+             passed;
+    passed = CheckReadback("column 5 of each row", DownloadTensorStrided(output, 5, 1, cols, rows), full, 5, 1, cols,
+                           rows) &&
+             passed;
+
+    // 交换两个不相等的元素，sum不变而校验和改变
+    std::vector<float> swapped = full;
+    size_t swapIndex = 1;
+    while (swapIndex < swapped.size() && swapped[swapIndex] == swapped[0]) {
+        swapIndex++;
+    }
+    std::swap(swapped[0], swapped[swapIndex]);
+    UploadTensor(output, swapped.data());
+    TensorStats swappedStats;
+    ret = collector.Compute(output, model.GetStream(), swappedStats);
+    CHECK_RET(ret, "compute tensor stats failed. ret: " + std::to_string(ret));
+    passed = CheckStats("output with swapped elements", swappedStats, HostStats(swapped)) && passed;
+    bool checksumChanged = swappedStats.checksum != stats.checksum;
+    LOG_ERROR(std::string("checksum after swapping elements 0 and ") + std::to_string(swapIndex) +
+              (checksumChanged ? " changed" : " UNCHANGED"));
+    passed = checksumChanged && passed;
+
+    // 改写输出注入nan，再次统计
+    std::vector<float> withNan = full;
+    for (int64_t index : {int64_t(0), numel / 2, numel - 1}) {
+        withNan[index] = NAN;
+    }
+    UploadTensor(output, withNan.data());
+    ret = collector.Compute(output, model.GetStream(), stats);
+    CHECK_RET(ret, "compute tensor stats failed. ret: " + std::to_string(ret));
+    passed = CheckStats("output with nan", stats, HostStats(withNan)) && passed;
+
+    // 耗时对比：全量回读、device统计、只回读打印所需的元素
+    size_t elementSize = output.dataSize / numel;
+    double fullUs = MeasureUs([&]() { DownloadTensor(output); });
+    double statsUs = MeasureUs([&]() { collector.Compute(output, model.GetStream(), stats); });
+    double rangeUs = MeasureUs([&]() { DownloadTensorRange(output, 0, PRINT_VALUE_COUNT); });
+    LOG_ERROR("full readback: " + std::to_string(fullUs) + " us, " + std::to_string(output.dataSize) + " bytes D2H");
+    LOG_ERROR("device stats: " + std::to_string(statsUs) + " us, 48 bytes D2H");
+    LOG_ERROR("range readback of " + std::to_string(PRINT_VALUE_COUNT) + " values: " + std::to_string(rangeUs) +
+              " us, " + std::to_string(PRINT_VALUE_COUNT * elementSize) + " bytes D2H");
+
+    collector.FreeResource();
+    model.FreeResource();
+    aclFinalize();
+    LOG_ERROR(passed ? "tensor stats check passed" : "tensor stats check failed");
+    return passed ? 0 : 1;
+}
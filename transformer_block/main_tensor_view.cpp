@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "aclnn/aclnn_fused_ops.h"
+#include "aclnn/aclnn_tensor_view.h"
+#include "reference/cpu_kernels.h"
+#include "reference/golden_compare.h"
+#include "utils/dtype_convert.h"
+#include "utils/tensor_io.h"
+#include "utils/utils.h"
+
+// QKV/head切分的零拷贝view：
+// atb Linear输出[B, 197, 2304]的QKV，Q/K/V和各head通过TensorView直接传给aclnn的BatchMatmul，不做拷贝
+// scores = Q @ K^T（K^T为转置view），prob = Softmax(scores)，context = prob @ V
+// 1. context与host参考实现（显式拷贝出各head后计算，中间结果舍入到fp16）比较
+// 2. 检查Q/K/V的aclTensor都以QKV的device内存为storage，只是offset/strides不同
+// 3. 超出storage的view在Setup时被拒绝
+// 任一检查不通过时返回1
+constexpr int64_t BATCH = 1;
+constexpr int64_t SEQ_LEN = 197;
+constexpr int64_t HIDDEN = 768;
+constexpr int64_t HEAD_NUM = 12;
+constexpr int64_t HEAD_DIM = HIDDEN / HEAD_NUM;
+constexpr float ACTIVATION_RANGE = 1.0f;
+constexpr float WEIGHT_RANGE = 0.05f;
+
+enum TensorId : uint32_t
+{
+    IN_TENSOR_X = 0,
+    IN_TENSOR_QKV_WEIGHT,
+    IN_TENSOR_QKV_BIAS,
+    OUT_TENSOR_CONTEXT,
+    INTERNAL_TENSOR_QKV,
+    INTERNAL_TENSOR_SCORES,
+    INTERNAL_TENSOR_PROB,
+};
+constexpr uint32_t IN_TENSOR_NUM = 3;
+
+// QKV [B, S, 3 * HIDDEN]中第index个（0: Q，1: K，2: V）的各head，形状为[B, HEAD_NUM, S, HEAD_DIM]
+TensorView QkvHeadView(const atb::Dims &qkvShape, int64_t index)
+{
+    TensorView view = NarrowView(ContiguousView(qkvShape), 2, index * HIDDEN, HIDDEN);
+    view = SplitDimView(view, 2, {HEAD_NUM, HEAD_DIM});
+    return PermuteView(view, {0, 2, 1, 3});
+}
+
+struct AttentionGraph
+{
+    atb::Operation *graph = nullptr;
+    BatchMatmulOperation *scores = nullptr;
+    BatchMatmulOperation *context = nullptr;
+};
+
+AttentionGraph CreateAttentionGraph(const atb::Dims &qkvShape)
+{
+    AttentionGraph result;
+    atb::GraphParam opGraph;
+    opGraph.name = "qkv_view_attention";
+    opGraph.inTensorNum = IN_TENSOR_NUM;
+    opGraph.outTensorNum = 1;
+    opGraph.internalTensorNum = 3;
+    opGraph.nodes.resize(4);
+
+    atb::infer::LinearParam linearParam;
+    linearParam.transposeA = false;
+    linearParam.transposeB = false;
+    linearParam.hasBias = true;
+    auto status = atb::CreateOperation(linearParam, &opGraph.nodes.at(0).operation);
+    CHECK_RET(status, "linearParam CreateOperation failed. status: " + std::to_string(status));
+    opGraph.nodes.at(0).inTensorIds = {IN_TENSOR_X, IN_TENSOR_QKV_WEIGHT, IN_TENSOR_QKV_BIAS};
+    opGraph.nodes.at(0).outTensorIds = {INTERNAL_TENSOR_QKV};
+
+    // 两个输入都连到同一个QKV tensor，由view取出Q和转置后的K
+    result.scores = new BatchMatmulOperation("ScoresBatchMatmul");
+    result.scores->SetInTensorView(0, QkvHeadView(qkvShape, 0));
+    result.scores->SetInTensorView(1, TransposeView(QkvHeadView(qkvShape, 1), 2, 3));
+    opGraph.nodes.at(1).operation = result.scores;
+    opGraph.nodes.at(1).inTensorIds = {INTERNAL_TENSOR_QKV, INTERNAL_TENSOR_QKV};
+    opGraph.nodes.at(1).outTensorIds = {INTERNAL_TENSOR_SCORES};
+
+    opGraph.nodes.at(2).operation = new SoftmaxOperation("Softmax");
+    opGraph.nodes.at(2).inTensorIds = {INTERNAL_TENSOR_SCORES};
+    opGraph.nodes.at(2).outTensorIds = {INTERNAL_TENSOR_PROB};
+
+    result.context = new BatchMatmulOperation("ContextBatchMatmul");
+    result.context->SetInTensorView(1, QkvHeadView(qkvShape, 2));
+    opGraph.nodes.at(3).operation = result.context;
+    opGraph.nodes.at(3).inTensorIds = {INTERNAL_TENSOR_PROB, INTERNAL_TENSOR_QKV};
+    opGraph.nodes.at(3).outTensorIds = {OUT_TENSOR_CONTEXT};
+
+    status = atb::CreateOperation(opGraph, &result.graph);
+    CHECK_RET(status, "GraphParam CreateOperation failed. status: " + std::to_string(status));
+    return result;
+}
+
+atb::TensorDesc Fp16Desc(const std::vector<int64_t> &dims)
+{
+    atb::TensorDesc desc;
+    desc.dtype = ACL_FLOAT16;
+    desc.format = ACL_FORMAT_ND;
+    desc.shape.dimNum = dims.size();
+    for (size_t i = 0; i < dims.size(); i++) {
+        desc.shape.dims[i] = dims[i];
+    }
+    return desc;
+}
+
+void RoundToFp16(std::vector<float> &values)
+{
+    for (auto &value : values) {
+        value = Fp16ToFloat(FloatToFp16(value));
+    }
+}
+
+// host参考：先把Q/K/V各head拷贝成连续的[HEAD_DIM]行，再逐head计算，结果为[B, HEAD_NUM, S, HEAD_DIM]
+std::vector<float> ReferenceAttention(const std::vector<float> &x, const std::vector<float> &weight,
+                                      const std::vector<float> &bias)
+{
+    std::vector<float> qkv(BATCH * SEQ_LEN * 3 * HIDDEN);
+    CpuLinear(x.data(), weight.data(), bias.data(), qkv.data(), BATCH * SEQ_LEN, HIDDEN, 3 * HIDDEN, false);
+    RoundToFp16(qkv);
+
+    std::vector<float> context(BATCH * HEAD_NUM * SEQ_LEN * HEAD_DIM);
+    std::vector<float> heads[3];
+    std::vector<float> scores(SEQ_LEN * SEQ_LEN);
+    for (int64_t b = 0; b < BATCH; b++) {
+        for (int64_t h = 0; h < HEAD_NUM; h++) {
+            for (int64_t index = 0; index < 3; index++) {
+                heads[index].resize(SEQ_LEN * HEAD_DIM);
+                for (int64_t s = 0; s < SEQ_LEN; s++) {
+                    const float *src = qkv.data() + (b * SEQ_LEN + s) * 3 * HIDDEN + index * HIDDEN + h * HEAD_DIM;
+                    std::copy(src, src + HEAD_DIM, heads[index].begin() + s * HEAD_DIM);
+                }
+            }
+            for (int64_t i = 0; i < SEQ_LEN; i++) {
+                for (int64_t j = 0; j < SEQ_LEN; j++) {
+                    float sum = 0;
+                    for (int64_t d = 0; d < HEAD_DIM; d++) {
+                        sum += heads[0][i * HEAD_DIM + d] * heads[1][j * HEAD_DIM + d];
+                    }
+                    scores[i * SEQ_LEN + j] = sum;
+                }
+            }
+            RoundToFp16(scores);
+            for (int64_t i = 0; i < SEQ_LEN; i++) {
+                float *row = scores.data() + i * SEQ_LEN;
+                float maxValue = *std::max_element(row, row + SEQ_LEN);
+                double total = 0;
+                for (int64_t j = 0; j < SEQ_LEN; j++) {
+                    total += std::exp(row[j] - maxValue);
+                }
+                for (int64_t j = 0; j < SEQ_LEN; j++) {
+                    row[j] = static_cast<float>(std::exp(row[j] - maxValue) / total);
+                }
+            }
+            RoundToFp16(scores);
+            float *out = context.data() + (b * HEAD_NUM + h) * SEQ_LEN * HEAD_DIM;
+            for (int64_t i = 0; i < SEQ_LEN; i++) {
+                for (int64_t d = 0; d < HEAD_DIM; d++) {
+                    float sum = 0;
+                    for (int64_t j = 0; j < SEQ_LEN; j++) {
+                        sum += scores[i * SEQ_LEN + j] * heads[2][j * HEAD_DIM + d];
+                    }
+                    out[i * HEAD_DIM + d] = sum;
+                }
+            }
+        }
+    }
+    RoundToFp16(context);
+    return context;
+}
+
+std::vector<uint16_t> ToFp16(const std::vector<float> &values)
+{
+    std::vector<uint16_t> result(values.size());
+    std::transform(values.begin(), values.end(), result.begin(), FloatToFp16);
+    return result;
+}
+
+// Q/K/V的aclTensor共用QKV的device内存，offset分别为0、HIDDEN、2 * HIDDEN
+bool CheckSharedStorage(const AttentionGraph &attention)
+{
+    const auto &q = attention.scores->aclInTensors_.at(0);
+    const auto &k = attention.scores->aclInTensors_.at(1);
+    const auto &v = attention.context->aclInTensors_.at(1);
+    bool shared = q->atbTensor.deviceData == k->atbTensor.deviceData &&
+                  q->atbTensor.deviceData == v->atbTensor.deviceData && q->offset == 0 && k->offset == HIDDEN &&
+                  v->offset == 2 * HIDDEN;
+    LOG_ERROR(std::string("q/k/v views share qkv storage: ") + (shared ? "yes" : "NO") + ", offsets " +
+              std::to_string(q->offset) + "/" + std::to_string(k->offset) + "/" + std::to_string(v->offset) +
+              ", k strides [" + std::to_string(k->strides[0]) + ", " + std::to_string(k->strides[1]) + ", " +
+              std::to_string(k->strides[2]) + ", " + std::to_string(k->strides[3]) + "]");
+    return shared;
+}
+
+// 超出storage的view在Setup时返回错误
+bool CheckOutOfStorageView(const atb::Tensor &qkv, atb::Context *context)
+{
+    BatchMatmulOperation operation("OutOfStorageBatchMatmul");
+    TensorView query = NarrowView(ContiguousView(qkv.desc.shape), 2, 0, HEAD_DIM);
+    TensorView shifted = TransposeView(query, 1, 2);
+    shifted.offset = 3 * HIDDEN; // 最后一行越界
+    operation.SetInTensorView(0, query);
+    operation.SetInTensorView(1, shifted);
+    atb::TensorDesc outputDesc = Fp16Desc({BATCH, SEQ_LEN, SEQ_LEN});
+    atb::Tensor output;
+    CreateTensorFromDesc(output, outputDesc);
+    atb::VariantPack variantPack;
+    variantPack.inTensors = {qkv, qkv};
+    variantPack.outTensors = {output};
+    uint64_t workspaceSize = 0;
+    bool rejected = operation.Setup(variantPack, workspaceSize, context) != atb::NO_ERROR;
+    aclrtFree(output.deviceData);
+    LOG_ERROR(std::string("out of storage view rejected: ") + (rejected ? "yes" : "NO"));
+    return rejected;
+}
+
+int main()
+{
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+    ret = aclrtSetDevice(0);
+    CHECK_RET(ret, "aclrtSetDevice failed. ret: " + std::to_string(ret));
+    atb::Context *context = nullptr;
+    ret = atb::CreateContext(&context);
+    CHECK_RET(ret, "ATB CreateContext failed. ret: " + std::to_string(ret));
+    aclrtStream stream = nullptr;
+    ret = aclrtCreateStream(&stream);
+    CHECK_RET(ret, "aclrtCreateStream failed. ret: " + std::to_string(ret));
+    context->SetExecuteStream(stream);
+
+    atb::TensorDesc qkvDesc = Fp16Desc({BATCH, SEQ_LEN, 3 * HIDDEN});
+    AttentionGraph attention = CreateAttentionGraph(qkvDesc.shape);
+
+    std::vector<std::vector<int64_t>> inDims = {{BATCH, SEQ_LEN, HIDDEN}, {HIDDEN, 3 * HIDDEN}, {3 * HIDDEN}};
+    atb::VariantPack variantPack;
+    atb::SVector<atb::TensorDesc> inDescs;
+    std::vector<std::vector<float>> hostInputs;
+    std::mt19937 engine(0);
+    for (uint32_t i = 0; i < IN_TENSOR_NUM; i++) {
+        atb::TensorDesc desc = Fp16Desc(inDims[i]);
+        atb::Tensor tensor;
+        CreateTensorFromDesc(tensor, desc);
+        float range = i == IN_TENSOR_X ? ACTIVATION_RANGE : WEIGHT_RANGE;
+        std::uniform_real_distribution<float> dist(-range, range);
+        std::vector<float> hostData(atb::Utils::GetTensorNumel(tensor));
+        for (auto &value : hostData) {
+            value = dist(engine);
+        }
+        UploadTensor(tensor, hostData.data());
+        hostInputs.push_back(DownloadTensor(tensor));
+        variantPack.inTensors.push_back(tensor);
+        inDescs.push_back(desc);
+    }
+    atb::SVector<atb::TensorDesc> outDescs;
+    outDescs.resize(1);
+    ret = attention.graph->InferShape(inDescs, outDescs);
+    CHECK_RET(ret, "attention graph InferShape failed. ret: " + std::to_string(ret));
+    atb::Tensor contextTensor;
+    CreateTensorFromDesc(contextTensor, outDescs.at(0));
+    variantPack.outTensors.push_back(contextTensor);
+
+    uint64_t workspaceSize = 0;
+    ret = attention.graph->Setup(variantPack, workspaceSize, context);
+    CHECK_RET(ret, "attention graph Setup failed. ret: " + std::to_string(ret));
+    void *workspace = nullptr;
+    ret = aclrtMalloc(&workspace, workspaceSize, ACL_MEM_MALLOC_HUGE_FIRST);
+    CHECK_RET(ret, "aclrtMalloc workspace failed. ret: " + std::to_string(ret));
+    ret = attention.graph->Execute(variantPack, static_cast<uint8_t *>(workspace), workspaceSize, context);
+    CHECK_RET(ret, "attention graph Execute failed. ret: " + std::to_string(ret));
+    ret = aclrtSynchronizeStream(stream);
+    CHECK_RET(ret, "aclrtSynchronizeStream failed. ret: " + std::to_string(ret));
+
+    std::vector<float> expected = ReferenceAttention(hostInputs[IN_TENSOR_X], hostInputs[IN_TENSOR_QKV_WEIGHT],
+                                                     hostInputs[IN_TENSOR_QKV_BIAS]);
+    GoldenResult result = CompareFp16(ToFp16(expected).data(), ToFp16(DownloadTensor(contextTensor)).data(),
+                                      static_cast<int64_t>(expected.size()), GoldenTolerance());
+    LogGoldenResult("attention context", result);
+    bool passed = result.passed;
+    passed = CheckSharedStorage(attention) && passed;
+
+    // 按拷贝实现时Q/K/V各需一块[B, HEAD_NUM, S, HEAD_DIM]的连续内存和一次拷贝kernel
+    uint64_t headBytes = BATCH * SEQ_LEN * HIDDEN * sizeof(uint16_t);
+    LOG_ERROR("graph workspace (qkv + scores + prob): " + std::to_string(workspaceSize) + " bytes, q/k/v head copies " +
+              "avoided: " + std::to_string(3 * headBytes) + " bytes and 3 copy kernels");
+
+    atb::Tensor qkvTensor;
+    CreateTensorFromDesc(qkvTensor, qkvDesc);
+    passed = CheckOutOfStorageView(qkvTensor, context) && passed;
+
+    atb::DestroyOperation(attention.graph);
+    for (auto &tensor : variantPack.inTensors) {
+        aclrtFree(tensor.deviceData);
+    }
+    aclrtFree(contextTensor.deviceData);
+    aclrtFree(qkvTensor.deviceData);
+    aclrtFree(workspace);
+    aclrtDestroyStream(stream);
+    atb::DestroyContext(context);
+    aclrtResetDevice(0);
+    aclFinalize();
+    LOG_ERROR(passed ? "tensor view check passed" : "tensor view check failed");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "memory/memory_utils.h"
+#include "model/model2.h"
+#include "utils/dtype_convert.h"
+#include "utils/utils.h"
+#include "utils/weight_layout.h"
+
+// Linear权重的存储布局：先校验host侧布局转换可逆，再分别以ND/转置/NZ权重运行模型，比较单次执行时延和输出
+constexpr int WARMUP_COUNT = 1;
+constexpr int EXECUTE_COUNT = 3;
+
+std::string LayoutName(WeightLayout layout)
+{
+    if (layout == WeightLayout::ND_TRANSPOSED) {
+        return "ND_TRANSPOSED";
+    }
+    if (layout == WeightLayout::FRACTAL_NZ) {
+        return "FRACTAL_NZ";
+    }
+    return "ND";
+}
+
+// 转换后再转回ND，与原始权重逐元素比较，尺寸包含不足一个分形的情况
+bool CheckRoundTrip(int64_t rows, int64_t cols)
+{
+    std::mt19937 engine(static_cast<uint32_t>(rows * cols));
+    std::uniform_int_distribution<uint32_t> dist(0, UINT16_MAX);
+    std::vector<uint16_t> src(rows * cols);
+    for (auto &value : src) {
+        value = static_cast<uint16_t>(dist(engine));
+    }
+
+    std::vector<uint16_t> nz(GetPreparedWeightNumel(rows, cols, WeightLayout::FRACTAL_NZ));
+    std::vector<uint16_t> restored(src.size());
+    PrepareWeight(src.data(), rows, cols, WeightLayout::FRACTAL_NZ, nz.data());
+    NzToNd(nz.data(), rows, cols, restored.data());
+    if (restored != src) {
+        LOG_ERROR("NZ round trip mismatch for [" + std::to_string(rows) + ", " + std::to_string(cols) + "]");
+        return false;
+    }
+
+    std::vector<uint16_t> transposed(src.size());
+    PrepareWeight(src.data(), rows, cols, WeightLayout::ND_TRANSPOSED, transposed.data());
+    TransposeMatrix(transposed.data(), cols, rows, restored.data());
+    if (restored != src) {
+        LOG_ERROR("transpose round trip mismatch for [" + std::to_string(rows) + ", " + std::to_string(cols) + "]");
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint16_t> RunModel(uint32_t deviceId, WeightLayout layout)
+{
+    Model2 model("layout_" + LayoutName(layout));
+    model.InitResource(deviceId);
+    model.SetWeightLayout(layout);
+    model.CreateModelGraph();
+    model.CreateModelInput();
+    model.CreateModelOutput();
+
+    for (int i = 0; i < WARMUP_COUNT; i++) {
+        model.Execute();
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < EXECUTE_COUNT; i++) {
+        model.Execute();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    LOG_ERROR(LayoutName(layout) + " latency per call " + std::to_string(elapsed.count() / EXECUTE_COUNT) + " ms");
+
+    const atb::Tensor &outTensor = model.model_outTensors_.at(0);
+    std::vector<uint16_t> output(outTensor.dataSize / sizeof(uint16_t));
+    auto ret = aclrtMemcpy(output.data(), outTensor.dataSize, outTensor.deviceData, outTensor.dataSize,
+                           ACL_MEMCPY_DEVICE_TO_HOST);
+    CHECK_RET(ret, "aclrtMemcpy failed. ret: " + std::to_string(ret));
+    model.FreeResource();
+    return output;
+}
+
+int main()
+{
+    for (const auto &dims : std::vector<std::pair<int64_t, int64_t>>{{768, 2304}, {37, 50}, {1, 17}}) {
+        if (!CheckRoundTrip(dims.first, dims.second)) {
+            return 1;
+        }
+    }
+    LOG_ERROR("weight layout round trip passed");
+
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+
+    // 创建内存池
+    size_t poolSize = 104857600; // Alloceted memory 100 MiB.
+    GetMemoryManager().CreateMemoryPool(poolSize);
+
+    std::vector<uint16_t> reference = RunModel(0, WeightLayout::ND);
+    for (WeightLayout layout : {WeightLayout::ND_TRANSPOSED, WeightLayout::FRACTAL_NZ}) {
+        std::vector<uint16_t> output = RunModel(0, layout);
+        float maxDiff = 0;
+        for (size_t i = 0; i < reference.size(); i++) {
+            maxDiff = std::max(maxDiff, std::abs(Fp16ToFloat(output[i]) - Fp16ToFloat(reference[i])));
+        }
+        LOG_ERROR(LayoutName(layout) + " vs ND max abs diff " + std::to_string(maxDiff));
+    }
+
+    aclFinalize();
+    LOG_ERROR("完成aclFinalize");
+    return 0;
+}
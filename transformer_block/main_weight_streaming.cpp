@@ -0,0 +1,89 @@
+#include <string>
+#include "memory/memory_utils.h"
+#include "model/model2.h"
+#include "runtime/weight_streamer.h"
+#include "utils/utils.h"
+
+// 逐层权重流式加载：先在host上推演不同配置的时间线，再用Model2在device上实测重叠比例
+constexpr size_t SIM_LAYER_COUNT = 12;
+constexpr double SIM_COMPUTE_MS = 4.0;
+constexpr double SIM_TRANSFER_MS = 3.0;
+constexpr size_t ACL_LAYER_COUNT = 6;
+const std::vector<StreamingConfig> CONFIGS = {{1, 0}, {2, 1}, {3, 2}, {2, 3}};
+
+std::string ConfigName(const StreamingConfig &config)
+{
+    return "ring " + std::to_string(config.ringSize) + " depth " + std::to_string(config.prefetchDepth);
+}
+
+void LogStats(const std::string &name, const StreamingStats &stats)
+{
+    LOG_ERROR(name + " total " + std::to_string(stats.totalMs) + " ms, compute " + std::to_string(stats.computeMs) +
+              " ms, transfer " + std::to_string(stats.transferMs) + " ms, overlap ratio " +
+              std::to_string(stats.overlapRatio));
+}
+
+void RunHostSimulation()
+{
+    std::vector<double> computeMs(SIM_LAYER_COUNT, SIM_COMPUTE_MS);
+    std::vector<double> transferMs(SIM_LAYER_COUNT, SIM_TRANSFER_MS);
+    for (const auto &config : CONFIGS) {
+        WeightPrefetchScheduler scheduler(SIM_LAYER_COUNT, config);
+        std::string error;
+        if (!scheduler.Validate(error)) {
+            LOG_ERROR("invalid prefetch plan for " + ConfigName(config) + ": " + error);
+            exit(1);
+        }
+        LogStats("host " + ConfigName(config) + " (effective depth " +
+                 std::to_string(scheduler.GetEffectiveDepth()) + ")",
+                 SimulateStreaming(scheduler, computeMs, transferMs));
+    }
+}
+
+void RunDevice(uint32_t deviceId)
+{
+    // 所有层共用同一个图，每层执行前把权重tensor绑定到对应的缓冲槽
+    Model2 model("streaming");
+    model.InitResource(deviceId);
+    model.CreateModelGraph();
+    model.EnableWeightStreaming();
+    model.CreateModelInput();
+    model.CreateModelOutput();
+    uint64_t layerBytes = model.GetStreamedWeightBytes();
+
+    for (const auto &config : CONFIGS) {
+        WeightStreamer streamer(config);
+        streamer.Init(ACL_LAYER_COUNT, layerBytes,
+                      [&model](size_t, void *hostData) { model.FillStreamedWeights(hostData); });
+        StreamingStats stats = streamer.Run(model.GetStream(), [&model](size_t, void *deviceWeights) {
+            model.BindWeightBuffer(deviceWeights);
+            model.Execute();
+        });
+        streamer.Free();
+        LogStats("device " + ConfigName(config), stats);
+    }
+    LOG_ERROR("device weight bytes per layer " + std::to_string(layerBytes) + ", fully resident " +
+              std::to_string(layerBytes * ACL_LAYER_COUNT));
+
+    PrintOutTensorValue(model.model_outTensors_.at(0));
+    model.FreeResource();
+}
+
+int main()
+{
+    RunHostSimulation();
+
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+
+    // 创建内存池
+    size_t poolSize = 104857600; // Alloceted memory 100 MiB.
+    GetMemoryManager().CreateMemoryPool(poolSize);
+
+    RunDevice(0);
+
+    aclFinalize();
+    LOG_ERROR("完成aclFinalize");
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include "model/model2.h"
+#include "memory/memory_utils.h"
+#include "runtime/device_worker_pool.h"
+#include "utils/tensor_convert.h"
+#include "utils/tensor_io.h"
+#include "utils/test_check.h"
+#include "utils/utils.h"
+
+// 负载测试：对比"每个请求创建-执行-销毁"、常驻工作线程池和绑定调用方缓冲区的常驻工作线程池的稳态吞吐
+// 每种模式下所有请求的输出都与在主线程上串行执行一次的参考输出比较，任一不一致或请求数不符时返回1
+constexpr size_t REQUEST_COUNT = 64;
+constexpr uint32_t WORKERS_PER_DEVICE = 2;
+
+using Clock = std::chrono::steady_clock;
+
+// 参考输出：在主线程上创建模型并串行执行一次
+std::vector<float> RunSerialReference(uint32_t deviceId)
+{
+    Model2 model;
+    model.InitResource(deviceId);
+    model.CreateModelGraph();
+    model.CreateModelInput();
+    model.CreateModelOutput();
+    model.Execute();
+    std::vector<float> reference = DownloadTensor(model.model_outTensors_.at(Model2::OUT_TENSOR_LN_MATMUL));
+    model.FreeResource();
+    return reference;
+}
+
+// 原有模式：每个请求一个线程，完成全部资源创建、执行和释放
+double RunCreateRunDestroy(const std::vector<uint32_t> &deviceIds, const std::vector<float> &reference,
+                           bool &matched)
+{
+    size_t concurrency = deviceIds.size() * WORKERS_PER_DEVICE;
+    size_t mismatched = 0;
+    auto start = Clock::now();
+    for (size_t submitted = 0; submitted < REQUEST_COUNT; submitted += concurrency) {
+        std::vector<Model2> modelArray(std::min(concurrency, REQUEST_COUNT - submitted));
+        std::vector<std::thread> threadArray(modelArray.size());
+        std::vector<char> results(modelArray.size(), 0);
+        for (size_t i = 0; i < modelArray.size(); i++) {
+            Model2 &model = modelArray.at(i);
+            uint32_t deviceId = deviceIds.at(i % deviceIds.size());
+            char &result = results.at(i);
+            threadArray.at(i) = std::thread([deviceId, &model, &reference, &result] {
+                model.InitResource(deviceId);
+                model.CreateModelGraph();
+                model.CreateModelInput();
+                model.CreateModelOutput();
+                model.Execute();
+                result = DownloadTensor(model.model_outTensors_.at(Model2::OUT_TENSOR_LN_MATMUL)) == reference;
+                model.FreeResource();
+            });
+        }
+        for (auto &thread : threadArray) {
+            thread.join();
+        }
+        mismatched += std::count(results.begin(), results.end(), 0);
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    matched = Check(mismatched == 0, "create-run-destroy outputs match reference, mismatched " +
+                                         std::to_string(mismatched) + " of " + std::to_string(REQUEST_COUNT));
+    return REQUEST_COUNT / elapsed.count();
+}
+
+// 常驻模式：工作线程启动后只执行Execute，统计稳态吞吐（不含启动时间）
+double RunWorkerPool(const std::vector<uint32_t> &deviceIds, const std::vector<float> &reference, bool &matched)
+{
+    DeviceWorkerPool<Model2> pool(deviceIds, WORKERS_PER_DEVICE);
+    pool.Start();
+
+    auto start = Clock::now();
+    std::vector<std::future<void>> futures;
+    std::vector<char> results(REQUEST_COUNT, 0);
+    for (size_t i = 0; i < REQUEST_COUNT; i++) {
+        char &result = results.at(i);
+        futures.push_back(pool.Submit(i % pool.GetDeviceCount(), [&reference, &result](Model2 &model) {
+            model.Execute();
+            result = DownloadTensor(model.model_outTensors_.at(Model2::OUT_TENSOR_LN_MATMUL)) == reference;
+        }));
+    }
+    for (auto &future : futures) {
+        future.get();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    pool.Stop();
+
+    uint64_t executed = 0;
+    for (const auto &stats : pool.GetStats()) {
+        LOG_ERROR("worker on device " + std::to_string(stats.deviceId) + " executed " +
+                  std::to_string(stats.executedCount) + " requests, stolen " + std::to_string(stats.stolenCount));
+        executed += stats.executedCount;
+    }
+    size_t mismatched = std::count(results.begin(), results.end(), 0);
+    matched = Check(mismatched == 0, "worker pool outputs match reference, mismatched " + std::to_string(mismatched) +
+                                         " of " + std::to_string(REQUEST_COUNT));
+    matched = Check(executed == REQUEST_COUNT, "worker pool executed " + std::to_string(executed) + " requests") &&
+              matched;
+    return REQUEST_COUNT / elapsed.count();
+}
+
+// 常驻模式 + 调用方缓冲区：每个请求把自己持有的device输入输出绑定到模型上再执行，
+// 模型不分配device内存，输出直接写入调用方缓冲区；最后用锁页host内存的绑定执行一次。
+// 所有输出都与串行执行的参考输出比较，matched返回是否全部一致
+double RunWorkerPoolBound(const std::vector<uint32_t> &deviceIds, const std::vector<float> &serialReference,
+                          bool &matched)
+{
+    DeviceWorkerPool<Model2> pool(deviceIds, WORKERS_PER_DEVICE);
+    pool.Start();
+
+    // 先用模型自己的缓冲区执行一次，得到输入输出的描述和输入数据
+    atb::Tensor inTensor;
+    atb::Tensor outTensor;
+    std::vector<float> inputData;
+    std::vector<float> reference;
+    pool.Submit(0, [&](Model2 &model) {
+        model.Execute();
+        inTensor = model.model_inTensors_.at(Model2::IN_TENSOR_X);
+        outTensor = model.model_outTensors_.at(Model2::OUT_TENSOR_LN_MATMUL);
+        inputData = DownloadTensor(inTensor);
+        reference = DownloadTensor(outTensor);
+    }).get();
+
+    // 调用方在请求所在的device上准备输入输出
+    std::vector<atb::Tensor> inputs(REQUEST_COUNT, inTensor);
+    std::vector<atb::Tensor> outputs(REQUEST_COUNT, outTensor);
+    for (size_t i = 0; i < REQUEST_COUNT; i++) {
+        auto ret = aclrtSetDevice(deviceIds.at(i % deviceIds.size()));
+        CHECK_RET(ret, "aclrtSetDevice failed. ret: " + std::to_string(ret));
+        ret = aclrtMalloc(&inputs.at(i).deviceData, inputs.at(i).dataSize, ACL_MEM_MALLOC_HUGE_FIRST);
+        CHECK_RET(ret, "aclrtMalloc input failed. ret: " + std::to_string(ret));
+        ret = aclrtMalloc(&outputs.at(i).deviceData, outputs.at(i).dataSize, ACL_MEM_MALLOC_HUGE_FIRST);
+        CHECK_RET(ret, "aclrtMalloc output failed. ret: " + std::to_string(ret));
+        UploadTensor(inputs.at(i), inputData.data());
+    }
+
+    auto start = Clock::now();
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < REQUEST_COUNT; i++) {
+        atb::Tensor &input = inputs.at(i);
+        atb::Tensor &output = outputs.at(i);
+        futures.push_back(pool.Submit(i % pool.GetDeviceCount(), [&input, &output](Model2 &model) {
+            bool bound = model.BindInput(Model2::IN_TENSOR_X, input.deviceData, input.dataSize,
+                                         BufferLocation::DEVICE) &&
+                         model.BindOutput(Model2::OUT_TENSOR_LN_MATMUL, output.deviceData, output.dataSize,
+                                          BufferLocation::DEVICE);
+            CHECK_RET(!bound, "bind request buffers failed");
+            model.Execute();
+        }));
+    }
+    for (auto &future : futures) {
+        future.get();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    size_t mismatched = 0;
+    for (size_t i = 0; i < REQUEST_COUNT; i++) {
+        mismatched += DownloadTensor(outputs.at(i)) == serialReference ? 0 : 1;
+    }
+    matched = Check(reference == serialReference, "worker pool own-buffer output matches reference");
+    matched = Check(mismatched == 0, "device-bound outputs match reference, mismatched " +
+                                         std::to_string(mismatched) + " of " + std::to_string(REQUEST_COUNT)) &&
+              matched;
+
+    // 锁页host内存的绑定：输入输出在模型的stream上与计算一起异步拷贝
+    void *hostInput = nullptr;
+    void *hostOutput = nullptr;
+    auto ret = aclrtMallocHost(&hostInput, inTensor.dataSize);
+    CHECK_RET(ret, "aclrtMallocHost input failed. ret: " + std::to_string(ret));
+    ret = aclrtMallocHost(&hostOutput, outTensor.dataSize);
+    CHECK_RET(ret, "aclrtMallocHost output failed. ret: " + std::to_string(ret));
+    auto status = aclrtMemcpy(hostInput, inTensor.dataSize, inputs.at(0).deviceData, inTensor.dataSize,
+                              ACL_MEMCPY_DEVICE_TO_HOST);
+    CHECK_RET(status, "aclrtMemcpy D2H failed. ret: " + std::to_string(status));
+    pool.Submit(0, [&](Model2 &model) {
+        bool bound = model.BindInput(Model2::IN_TENSOR_X, hostInput, inTensor.dataSize, BufferLocation::HOST) &&
+                     model.BindOutput(Model2::OUT_TENSOR_LN_MATMUL, hostOutput, outTensor.dataSize,
+                                      BufferLocation::HOST);
+        CHECK_RET(!bound, "bind host buffers failed");
+        model.Execute();
+    }).get();
+    std::vector<float> hostResult(reference.size());
+    ConvertToFloat(hostOutput, outTensor.desc.dtype, hostResult.data(), static_cast<int64_t>(hostResult.size()));
+    matched = Check(hostResult == serialReference, "host-bound output matches reference") && matched;
+
+    // 模型释放时不释放调用方缓冲区，停止后由调用方释放
+    pool.Stop();
+    aclrtFreeHost(hostInput);
+    aclrtFreeHost(hostOutput);
+    for (size_t i = 0; i < REQUEST_COUNT; i++) {
+        aclrtFree(inputs.at(i).deviceData);
+        aclrtFree(outputs.at(i).deviceData);
+    }
+    return REQUEST_COUNT / elapsed.count();
+}
+
+int main()
+{
+    // AscendCL初始化
+    auto ret = aclInit(nullptr);
+    CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+
+    // 创建内存池
+    size_t poolSize = 104857600; // Alloceted memory 100 MiB.
+    GetMemoryManager().CreateMemoryPool(poolSize);
+
+    uint32_t deviceCount = 0;
+    ret = aclrtGetDeviceCount(&deviceCount);
+    CHECK_RET(ret, "aclrtGetDeviceCount failed. ret: " + std::to_string(ret));
+    std::vector<uint32_t> deviceIds;
+    for (uint32_t i = 0; i < deviceCount; i++) {
+        deviceIds.push_back(i);
+    }
+
+    std::vector<float> reference = RunSerialReference(deviceIds.at(0));
+    bool createMatched = false;
+    bool poolMatched = false;
+    bool boundMatched = false;
+    double createRunDestroyQps = RunCreateRunDestroy(deviceIds, reference, createMatched);
+    double workerPoolQps = RunWorkerPool(deviceIds, reference, poolMatched);
+    double boundQps = RunWorkerPoolBound(deviceIds, reference, boundMatched);
+    LOG_ERROR("create-run-destroy throughput: " + std::to_string(createRunDestroyQps) + " req/s");
+    LOG_ERROR("worker pool steady-state throughput: " + std::to_string(workerPoolQps) + " req/s");
+    LOG_ERROR("worker pool with caller buffers throughput: " + std::to_string(boundQps) + " req/s");
+
+    aclFinalize();
+    LOG_ERROR("完成aclFinalize");
+    bool passed = createMatched && poolMatched && boundMatched;
+    LOG_ERROR(passed ? "worker pool check passed" : "worker pool check failed");
+    return passed ? 0 : 1;
+}
@@ -1,6 +1,7 @@
 #include <acl/acl.h>
 #include "memory_utils.h"
 #include "utils/log.h"
+#include "utils/metrics.h"
 #include "utils/utils.h"
 
 static MemoryManager g_memoryManager;
@@ -16,6 +17,21 @@ void MemoryManager::CreateMemoryPool(size_t poolSize)
         std::shared_ptr<MemoryPool> memoryPool = std::make_shared<MemoryPool>(poolSize);
         // 根据device_id 即可索引指定id下的memory pool
         memoryPools_.push_back(memoryPool);
+        // 池的占用在抓取时读取，不在分配路径上打点
+        // 指标注册表不随MemoryManager析构，回调只持有weak_ptr，池销毁后读数为0
+        std::weak_ptr<MemoryPool> weakPool = memoryPool;
+        std::string labels = "device=\"" + std::to_string(i) + "\"";
+        GetMetrics().RegisterCallback("memory_pool_used_bytes", "Bytes of allocated blocks in the memory pool",
+                                      MetricType::GAUGE, labels, [weakPool]() {
+                                          std::shared_ptr<MemoryPool> pool = weakPool.lock();
+                                          return pool ? static_cast<double>(pool->GetStats().usedBytes) : 0.0;
+                                      });
+        GetMetrics().RegisterCallback("memory_pool_peak_used_bytes",
+                                      "Peak bytes of allocated blocks in the memory pool", MetricType::GAUGE, labels,
+                                      [weakPool]() {
+                                          std::shared_ptr<MemoryPool> pool = weakPool.lock();
+                                          return pool ? static_cast<double>(pool->GetStats().peakUsedBytes) : 0.0;
+                                      });
         LOG_INFO("create mempool for device " + std::to_string(i) + " success");
     }
 }
@@ -50,6 +66,17 @@ void MemoryManager::GetBlockPtr(int blockId, void *&addr)
     GetMemoryPool()->GetBlockPtr(blockId, addr);
 }
 
+size_t MemoryManager::GetMemoryPoolCount() const
+{
+    return memoryPools_.size();
+}
+
+MemoryPoolStats MemoryManager::GetMemoryPoolStats(size_t deviceId)
+{
+    CHECK_RET(deviceId >= memoryPools_.size(), "Invalid device id " + std::to_string(deviceId));
+    return memoryPools_[deviceId]->GetStats();
+}
+
 MemoryManager &GetMemoryManager()
 {
     return g_memoryManager;
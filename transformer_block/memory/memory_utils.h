@@ -21,6 +21,10 @@ public:
     void FreeBlock(int blockId);
     // 获取指定blockId的内存块指针
     void GetBlockPtr(int blockId, void *&addr);
+    // 获取已创建的内存池个数，即device个数
+    size_t GetMemoryPoolCount() const;
+    // 获取指定device上内存池的使用统计
+    MemoryPoolStats GetMemoryPoolStats(size_t deviceId);
 
 private:
     // 存储每个设备的内存池
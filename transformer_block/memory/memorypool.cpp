@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <atb/types.h>
 #include <acl/acl.h>
 #include "memorypool.h"
 #include "utils/log.h"
+#include "utils/metrics.h"
 #include "utils/utils.h"
 
 constexpr size_t POOL_SIZE = 104857600; // Alloceted memory 100 MiB.
@@ -12,6 +14,7 @@ MemoryPool::MemoryPool(size_t poolSize = POOL_SIZE)
               "malloc huge size memrory " + std::to_string(poolSize) + " bytes fail");
     curMemPtr_ = baseMemPtr_;
     remainSize_ = poolSize;
+    poolSize_ = poolSize;
 }
 
 MemoryPool::~MemoryPool()
@@ -29,6 +32,9 @@ uint64_t MemoryPool::GenerateBlocksId()
 
 void MemoryPool::AllocateBlock(uint32_t size, int &blockId)
 {
+    // 抓取指标时会在注册表锁内读取池的统计，因此在取blockMutex_之前完成注册
+    static Counter &allocateFailures =
+        GetMetrics().GetCounter("memory_pool_allocation_failures_total", "Block allocations the pool could not satisfy");
     // 获取互斥锁，确保线程安全
     std::unique_lock<std::mutex> lock(blockMutex_);
 
@@ -44,6 +50,8 @@ void MemoryPool::AllocateBlock(uint32_t size, int &blockId)
             blockId = it->second.blockId;
             // 将块从空闲表移动到已使用表
             usedBlocks_.insert(*it);
+            usedBytes_ += it->second.blockSize;
+            peakUsedBytes_ = std::max(peakUsedBytes_, usedBytes_);
             freeBlocks_.erase(it);
             LOG_INFO("find free block id " + std::to_string(blockId) + " to allocate");
             return;
@@ -68,6 +76,8 @@ void MemoryPool::AllocateBlock(uint32_t size, int &blockId)
         // 创建新的内存块并添加到已使用表
         MemoryBlock block = {blockId, alignSize, curMemPtr_};
         usedBlocks_.insert({blockId, block});
+        usedBytes_ += alignSize;
+        peakUsedBytes_ = std::max(peakUsedBytes_, usedBytes_);
         
         // 更新剩余大小和当前指针
         remainSize_ -= alignSize;
@@ -78,6 +88,9 @@ void MemoryPool::AllocateBlock(uint32_t size, int &blockId)
     }
     
     // 内存不足，分配失败
+    if (GetMetrics().IsEnabled()) {
+        allocateFailures.Add();
+    }
     LOG_ERROR("allocate block fail");
 }
 
@@ -92,6 +105,7 @@ void MemoryPool::FreeBlock(int blockId)
     auto it = usedBlocks_.find(blockId);
     if (it != usedBlocks_.end()) {
         freeBlocks_.insert(*it);
+        usedBytes_ -= it->second.blockSize;
         usedBlocks_.erase(it);
     } else {
         LOG_ERROR("Double free block id " + std::to_string(blockId));
@@ -112,4 +126,15 @@ void MemoryPool::GetBlockPtr(int blockId, void *&addr)
     } else {
         LOG_ERROR("Get block address error, block id " + std::to_string(blockId));
     }
-}
\ No newline at end of file
+}
+MemoryPoolStats MemoryPool::GetStats()
+{
+    std::unique_lock<std::mutex> lock(blockMutex_);
+
+    MemoryPoolStats stats;
+    stats.poolSize = poolSize_;
+    stats.usedBytes = usedBytes_;
+    stats.peakUsedBytes = peakUsedBytes_;
+    stats.carvedBytes = poolSize_ - static_cast<size_t>(remainSize_);
+    return stats;
+}
@@ -7,6 +7,14 @@
 #include <atomic>
 #include "memory_env.h"
 
+// 内存池的使用统计（字节）
+struct MemoryPoolStats {
+    size_t poolSize = 0;      // 内存池总大小
+    size_t usedBytes = 0;     // 当前已分配块的大小之和
+    size_t peakUsedBytes = 0; // usedBytes的峰值
+    size_t carvedBytes = 0;   // 已从池中切分出的大小，包括空闲块，即池的实际占用
+};
+
 /**
  * 内存池类
  * 用于高效管理内存分配和释放，减少内存碎片化
@@ -46,6 +54,11 @@ public:
      */
     void GetBlockPtr(int blockId, void *&addr);
 
+    /**
+     * 获取内存池的使用统计
+     */
+    MemoryPoolStats GetStats();
+
 private:
     /**
      * 生成唯一的块ID
@@ -58,6 +71,9 @@ private:
     void *baseMemPtr_ = nullptr;                      // 内存池基地址指针
     void *curMemPtr_ = nullptr;                       // 当前可用内存指针
     int64_t remainSize_ = 0;                          // 剩余可用内存大小
+    size_t poolSize_ = 0;                             // 内存池总大小
+    size_t usedBytes_ = 0;                            // 已分配块的大小之和
+    size_t peakUsedBytes_ = 0;                        // usedBytes_的峰值
     std::unordered_map<int, MemoryBlock> freeBlocks_; // 空闲内存块映射表
     std::unordered_map<int, MemoryBlock> usedBlocks_; // 已使用内存块映射表
 };
@@ -0,0 +1,104 @@
+#include <acl/acl.h>
+#include <atb/utils.h>
+#include <vector>
+#include "weight_store.h"
+#include "memory_utils.h"
+#include "utils/log.h"
+#include "utils/utils.h"
+
+static WeightStore g_weightStore;
+
+static bool IsSameTensorDesc(const atb::TensorDesc &lhs, const atb::TensorDesc &rhs)
+{
+    if (lhs.dtype != rhs.dtype || lhs.format != rhs.format || lhs.shape.dimNum != rhs.shape.dimNum) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.shape.dimNum; i++) {
+        if (lhs.shape.dims[i] != rhs.shape.dims[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void WeightStore::Acquire(const std::string &name, const atb::TensorDesc &desc, const WeightLoader &loader,
+                          atb::Tensor &tensor)
+{
+    int32_t deviceId = GetMemoryManager().GetDeviceId();
+    std::unique_lock<std::mutex> lock(weightMutex_);
+
+    auto &weights = deviceWeights_[deviceId];
+    auto it = weights.find(name);
+    if (it != weights.end()) {
+        // 已上传过的权重直接复用，只增加引用计数
+        CHECK_RET(!IsSameTensorDesc(it->second.tensor.desc, desc), "weight " + name + " desc mismatch");
+        it->second.refCount++;
+        tensor = it->second.tensor;
+        return;
+    }
+
+    // 首次获取：分配device内存，加载host数据并上传
+    WeightEntry entry;
+    entry.tensor.desc = desc;
+    entry.tensor.dataSize = atb::Utils::GetTensorSize(entry.tensor);
+    std::vector<uint8_t> hostData(entry.tensor.dataSize);
+    loader(hostData.data(), hostData.size());
+
+    int ret = aclrtMalloc(&entry.tensor.deviceData, entry.tensor.dataSize, ACL_MEM_MALLOC_HUGE_FIRST);
+    CHECK_RET(ret, "alloc weight " + name + " error! ret: " + std::to_string(ret));
+    ret = aclrtMemcpy(entry.tensor.deviceData, entry.tensor.dataSize, hostData.data(), hostData.size(),
+                      ACL_MEMCPY_HOST_TO_DEVICE);
+    CHECK_RET(ret, "copy weight " + name + " error! ret: " + std::to_string(ret));
+
+    entry.refCount = 1;
+    weights.emplace(name, entry);
+    tensor = entry.tensor;
+    LOG_INFO("upload weight " + name + " to device " + std::to_string(deviceId) + ", size " +
+             std::to_string(entry.tensor.dataSize));
+}
+
+void WeightStore::Release(const std::string &name)
+{
+    int32_t deviceId = GetMemoryManager().GetDeviceId();
+    std::unique_lock<std::mutex> lock(weightMutex_);
+
+    auto &weights = deviceWeights_[deviceId];
+    auto it = weights.find(name);
+    if (it == weights.end()) {
+        LOG_ERROR("Release unknown weight " + name + " on device " + std::to_string(deviceId));
+        return;
+    }
+    if (--it->second.refCount > 0) {
+        return;
+    }
+    aclrtFree(it->second.tensor.deviceData);
+    weights.erase(it);
+    LOG_INFO("free weight " + name + " on device " + std::to_string(deviceId));
+}
+
+uint32_t WeightStore::GetRefCount(const std::string &name)
+{
+    int32_t deviceId = GetMemoryManager().GetDeviceId();
+    std::unique_lock<std::mutex> lock(weightMutex_);
+
+    auto &weights = deviceWeights_[deviceId];
+    auto it = weights.find(name);
+    return it == weights.end() ? 0 : it->second.refCount;
+}
+
+uint64_t WeightStore::GetResidentBytes()
+{
+    int32_t deviceId = GetMemoryManager().GetDeviceId();
+    std::unique_lock<std::mutex> lock(weightMutex_);
+
+    uint64_t residentBytes = 0;
+    for (const auto &weight : deviceWeights_[deviceId]) {
+        residentBytes += weight.second.tensor.dataSize;
+    }
+    return residentBytes;
+}
+
+WeightStore &GetWeightStore()
+{
+    return g_weightStore;
+}
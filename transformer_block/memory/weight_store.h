@@ -0,0 +1,65 @@
+#ifndef WEIGHT_STORE_H
+#define WEIGHT_STORE_H
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <atb/types.h>
+
+/**
+ * 权重存储类
+ * 按device管理只读权重，同一device上的多个模型实例共享同一份device内存
+ * 每个权重带引用计数，最后一个使用者释放时才真正释放device内存
+ */
+class WeightStore {
+public:
+    /**
+     * 权重加载函数
+     * 仅在权重首次上传时调用，负责把host侧数据填入hostData
+     */
+    using WeightLoader = std::function<void(void *hostData, uint64_t dataSize)>;
+
+    /**
+     * 获取当前device上的权重，引用计数加1
+     * 首次获取时分配device内存并通过loader准备数据后上传
+     * @param name 权重名称，同一device上唯一
+     * @param desc 权重的tensor描述，与已存在的同名权重必须一致
+     * @param loader 权重加载函数
+     * @param tensor 输出参数，返回共享的权重tensor
+     */
+    void Acquire(const std::string &name, const atb::TensorDesc &desc, const WeightLoader &loader,
+                 atb::Tensor &tensor);
+
+    /**
+     * 释放当前device上的权重，引用计数减1，归零时释放device内存
+     * @param name 权重名称
+     */
+    void Release(const std::string &name);
+
+    /**
+     * 获取当前device上权重的引用计数
+     * @param name 权重名称
+     * @return 引用计数，不存在时返回0
+     */
+    uint32_t GetRefCount(const std::string &name);
+
+    /**
+     * 获取当前device上常驻权重占用的device内存大小（字节）
+     */
+    uint64_t GetResidentBytes();
+
+private:
+    struct WeightEntry {
+        atb::Tensor tensor;
+        uint32_t refCount = 0;
+    };
+
+    std::mutex weightMutex_;                                                         // 互斥锁，保护权重表
+    std::map<int32_t, std::unordered_map<std::string, WeightEntry>> deviceWeights_; // device id -> 权重表
+};
+
+WeightStore &GetWeightStore();
+
+#endif
@@ -1,10 +1,15 @@
+// 编译时定义DISABLE_MEMPOOL时workspace直接使用aclrtMalloc，用于对比内存池的收益
+#ifndef DISABLE_MEMPOOL
 #define USE_MEMPOOL
+#endif
 
 #include "model/model.h"
 #include "aclnn/aclnn_gelu_operation.h"
 #include "utils/utils.h"
 #include "atb/atb_graph_op.h"
 #include "memory/memory_utils.h"
+#include "runtime/kernel_variants.h"
+#include "utils/profiler.h"
 
 void Model::InitResource(uint32_t deviceId)
 {
@@ -44,6 +49,8 @@ void Model::CreateModelGraph()
 
     // step2：创建aclnn算子的Node
     CreateAclnnOpLayer(nodeId);
+
+    PlanInPlace();
     LOG_INFO("CreateModelGraph end");
 }
 
@@ -75,9 +82,17 @@ void Model::CreateAclnnOpLayer(size_t nodeId)
 {
     // 创建aclnn算子的opreation
     Node &aclnn_node = nodes_[nodeId];
-    AclnnGeluParam AclnnGeluParam;
-    AclnnGeluParam.geluApproximate = -1;
-    aclnn_node.operation_ = new GeluOperation("Gelu", AclnnGeluParam);
+    // Gelu的输入为(a+b)+(c+d)的输出，与模型输入同形状，按形状查询KernelTuner选择的实现
+    atb::SVector<atb::TensorDesc> inTensorDescs;
+    inTensorDescs.resize(1);
+    CreateInTensorDescs(inTensorDescs);
+    const atb::Dims &shape = inTensorDescs.at(0).shape;
+    std::string geluVariant =
+        ChooseGeluVariant({mode_context_, model_stream_}, {batchSize_, shape.dims[1], shape.dims[2]});
+    aclnn_node.operation_ = CreateGeluVariant(geluVariant);
+    if (aclnn_node.operation_ == nullptr) {
+        aclnn_node.operation_ = CreateGeluVariant(GELU_VARIANT_DEFAULT);
+    }
     aclnn_node.inTensors_.resize(aclnn_node.operation_->GetInputNum());
 
     // 设置aclnn算子node节点的输入
@@ -88,6 +103,8 @@ void Model::CreateAclnnOpLayer(size_t nodeId)
     // 设置aclnn算子node节点的输出，model的输出
     aclnn_node.outTensors_ = {&model_outTensors_.at(GLUE_OUT)};
     aclnn_node.outTensorTypes_ = {TensorType::NOT_INTERNAL_TENSOR};
+    // Gelu逐元素计算，输出可以写在输入上
+    aclnn_node.inPlaceInTensorIds_ = {0};
     LOG_ERROR("完成创建aclnn算子");
 }
 
@@ -96,8 +113,17 @@ void Model::CreateModelInput()
     LOG_INFO("CreateModelInput start");
     atb::SVector<atb::TensorDesc> intensorDescs;
     intensorDescs.resize(Mode_INPUT_SIZE);
+    // (a + b) + (c + d)的四个输入形状相同，均为[batch, 197, 768]
     CreateInTensorDescs(intensorDescs);
+    for (size_t i = 0; i < intensorDescs.size(); i++) {
+        intensorDescs.at(i) = intensorDescs.at(0);
+        intensorDescs.at(i).shape.dims[0] = batchSize_;
+    }
     CreateInTensors(model_inTensors_, intensorDescs);
+    inBindings_.assign(model_inTensors_.size(), TensorBinding());
+    for (size_t i = 0; i < model_inTensors_.size(); i++) {
+        inBindings_.at(i).ownedData = model_inTensors_.at(i).deviceData;
+    }
     LOG_INFO("CreateModelInput end");
 }
 
@@ -118,6 +144,10 @@ void Model::CreateModelOutput()
     // 调用infer shape，推导出模型的输出
     InferShape(inTensorDescs, outtensorDescs);
     CreateOutTensors(model_outTensors_, outtensorDescs);
+    outBindings_.assign(model_outTensors_.size(), TensorBinding());
+    for (size_t i = 0; i < model_outTensors_.size(); i++) {
+        outBindings_.at(i).ownedData = model_outTensors_.at(i).deviceData;
+    }
     LOG_INFO("CreateModelOutput end");
 }
 
@@ -132,16 +162,79 @@ atb::Status Model::InferShape(const atb::SVector<atb::TensorDesc> &inTensorDescs
 void Model::Execute()
 {
     LOG_INFO(modelName_ + " Execute start");
-    for (size_t nodeId = 0; nodeId < nodes_.size(); ++nodeId) {
-        BuildNodeVariantPack(nodeId);
-        atb::Status status = ExecuteNode(nodeId);
-        CHECK_RET(status, "ExecuteNode " + std::to_string(nodeId) + " failed. status: " + std::to_string(status));
+    nodeMetrics_.Prepare("Model", nodes_.size());
+    ScopedLatency executeLatency(nodeMetrics_.GetExecuteHistogram());
+    CopyInBindings();
+    if (hostPipeline_) {
+        // 准备线程按顺序准备节点，本线程只下发已准备好的节点
+        atb::Status status = prepPipeline_.Run(
+            nodes_.size(),
+            [this](size_t nodeId) {
+                BuildNodeVariantPack(nodeId);
+                return SetupNode(nodeId);
+            },
+            [this](size_t nodeId) { return ExecuteNode(nodeId); });
+        CHECK_RET(status, "pipelined execute failed. status: " + std::to_string(status));
+    } else {
+        for (size_t nodeId = 0; nodeId < nodes_.size(); ++nodeId) {
+            atb::Status status = RunStep(nodeId);
+            CHECK_RET(status, "RunStep " + std::to_string(nodeId) + " failed. status: " + std::to_string(status));
+        }
     }
+    CopyOutBindings();
 
     WaitFinish();
     LOG_INFO(modelName_ + " Execute end");
 }
 
+size_t Model::GetStepCount() const
+{
+    return nodes_.size();
+}
+
+void Model::BeginSteps()
+{
+    nodeMetrics_.Prepare("Model", nodes_.size());
+    CopyInBindings();
+}
+
+atb::Status Model::RunStep(size_t stepId)
+{
+    BuildNodeVariantPack(stepId);
+    atb::Status status = SetupNode(stepId);
+    if (status != atb::NO_ERROR) {
+        return status;
+    }
+    status = ExecuteNode(stepId);
+    if (status != atb::NO_ERROR) {
+        LOG_ERROR("ExecuteNode " + std::to_string(stepId) + " failed. status: " + std::to_string(status));
+    }
+    return status;
+}
+
+void Model::EndSteps()
+{
+    CopyOutBindings();
+    WaitFinish();
+}
+
+void Model::CopyInBindings()
+{
+    // host侧绑定的输入输出与计算在同一个stream上排队，不需要额外同步
+    for (size_t i = 0; i < inBindings_.size(); ++i) {
+        auto ret = CopyBoundInput(model_inTensors_.at(i), inBindings_.at(i), model_stream_);
+        CHECK_RET(ret, "copy bound input " + std::to_string(i) + " failed. ret: " + std::to_string(ret));
+    }
+}
+
+void Model::CopyOutBindings()
+{
+    for (size_t i = 0; i < outBindings_.size(); ++i) {
+        auto ret = CopyBoundOutput(model_outTensors_.at(i), outBindings_.at(i), model_stream_);
+        CHECK_RET(ret, "copy bound output " + std::to_string(i) + " failed. ret: " + std::to_string(ret));
+    }
+}
+
 void Model::BuildNodeVariantPack(int nodeId)
 {
     LOG_INFO("buildNodeVariantPack nodes[" + std::to_string(nodeId) + "] start");
@@ -161,40 +254,105 @@ void Model::BuildNodeVariantPack(int nodeId)
     outTensorDescs.resize(node.operation_->GetOutputNum());
 
     // 调用operation_的InferShape，推导出out tensor的desc
-    atb::Status st = node.operation_->InferShape(inTensorDescs, outTensorDescs);
+    atb::Status st = atb::NO_ERROR;
+    {
+        ProfileScope scope("InferShape", nodeId);
+        st = node.operation_->InferShape(inTensorDescs, outTensorDescs);
+    }
 
     node.variantPack_.outTensors.resize(node.operation_->GetOutputNum());
     for (size_t i = 0; i < node.outTensors_.size(); ++i) {
         node.variantPack_.outTensors.at(i) = *node.outTensors_.at(i);
         if (node.outTensorTypes_.at(i) == TensorType::INTERNAL_TENSOR) {
+            atb::Tensor &internalTensor = *node.outTensors_.at(i);
+            uint64_t dataSize = atb::Utils::GetTensorSize(outTensorDescs.at(i));
+            int internalId = GetInternalTensorId(&internalTensor);
+            const atb::Tensor *storage = internalStorage_.at(internalId);
+            if (storage != nullptr && storage->dataSize >= dataSize) {
+                // 原地计算：直接使用复用的存储tensor的空间，存储tensor在之前的节点或CreateModelOutput中已分配
+                internalTensor.deviceData = storage->deviceData;
+                internalTensor.dataSize = dataSize;
+                internalTensor.desc = outTensorDescs.at(i);
+                node.variantPack_.outTensors.at(i) = internalTensor;
+                continue;
+            }
+            if (storage != nullptr) {
+                // 空间不够时改为单独分配，不再复用不会影响其他tensor的读写
+                LOG_WARNING("internal tensor " + std::to_string(internalId) +
+                            " storage too small, fall back to own buffer");
+                internalStorage_.at(internalId) = nullptr;
+                internalTensor.deviceData = nullptr;
+            }
             // 对于Internal类型的输出，需要创建输出tensor的空间
-            CreateTensorFromDesc(node.variantPack_.outTensors.at(i), outTensorDescs.at(i));
-            *node.outTensors_.at(i) = node.variantPack_.outTensors.at(i);
+            // 重复执行时复用已有空间，只在首次或大小变化时重新分配
+            if (internalTensor.deviceData == nullptr ||
+                internalTensor.dataSize != atb::Utils::GetTensorSize(outTensorDescs.at(i))) {
+                aclrtFree(internalTensor.deviceData);
+                CreateTensorFromDesc(internalTensor, outTensorDescs.at(i));
+            }
+            internalTensor.desc = outTensorDescs.at(i);
+            node.variantPack_.outTensors.at(i) = internalTensor;
         }
     }
     LOG_INFO("buildNodeVariantPack nodes[" + std::to_string(nodeId) + "] end");
 }
 
-atb::Status Model::ExecuteNode(int nodeId)
+atb::Status Model::SetupNode(int nodeId)
 {
     auto &node = nodes_.at(nodeId);
 
     uint64_t workspaceSize = 0;
-    atb::Status status = node.operation_->Setup(node.variantPack_, workspaceSize, mode_context_);
-    CHECK_RET(status, "Setup node " + std::to_string(nodeId) + " failed. status: " + std::to_string(status));
+    atb::Status status = atb::NO_ERROR;
+    {
+        ProfileScope scope("Setup", nodeId);
+        ScopedLatency setupLatency(nodeMetrics_.GetSetupHistogram(nodeId));
+        status = node.operation_->Setup(node.variantPack_, workspaceSize, mode_context_);
+    }
+    // 可能在准备线程上执行，失败时返回status由调用方处理，不在这里退出进程
+    if (status != atb::NO_ERROR) {
+        LOG_ERROR("Setup node " + std::to_string(nodeId) + " failed. status: " + std::to_string(status));
+        return status;
+    }
 
     LOG_INFO("Get node[" + std::to_string(nodeId) + "] workspace size:" + std::to_string(workspaceSize));
+    {
+        ProfileScope scope("Workspace", nodeId);
 #ifdef USE_MEMPOOL
-    CreateWorkspaceBuffer(nodeId, workspaceSize);
+        CreateWorkspaceBuffer(nodeId, workspaceSize);
 #else
-    if (workspaceSize != 0) {
-        status = aclrtMalloc(&node.workspace_, workspaceSize, ACL_MEM_MALLOC_HUGE_FIRST);
-        CHECK_RET(status, "alloc error!");
-    }
+        // 上一次执行已经同步完成，释放后重新申请
+        if (node.workspace_ != nullptr) {
+            aclrtFree(node.workspace_);
+            node.workspace_ = nullptr;
+        }
+        if (workspaceSize != 0) {
+            status = aclrtMalloc(&node.workspace_, workspaceSize, ACL_MEM_MALLOC_HUGE_FIRST);
+            if (status != ACL_SUCCESS) {
+                LOG_ERROR("alloc workspace for node " + std::to_string(nodeId) + " failed. ret: " +
+                          std::to_string(status));
+                return status;
+            }
+        }
 #endif
+    }
+    node.setupWorkspaceSize_ = workspaceSize;
+    return atb::NO_ERROR;
+}
+
+atb::Status Model::ExecuteNode(int nodeId)
+{
+    auto &node = nodes_.at(nodeId);
+    atb::Status status = atb::NO_ERROR;
     LOG_INFO("Execute node[" + std::to_string(nodeId) + "] start");
-    status =
-        node.operation_->Execute(node.variantPack_, (uint8_t *)(node.workspace_), workspaceSize, mode_context_);
+    {
+        // device区间覆盖节点在stream上的全部任务，host区间只是下发耗时
+        DeviceProfileScope deviceScope(model_stream_, "Device", nodeId);
+        ProfileScope scope("Launch", nodeId);
+        nodeMetrics_.BeginDevice(nodeId, model_stream_);
+        status = node.operation_->Execute(node.variantPack_, (uint8_t *)(node.workspace_), node.setupWorkspaceSize_,
+                                          mode_context_);
+        nodeMetrics_.EndDevice(nodeId, model_stream_);
+    }
     CHECK_RET(status, "Execute node " + std::to_string(nodeId) + " failed. status: " + std::to_string(status));
     LOG_INFO("Execute node[" + std::to_string(nodeId) + "] end");
     return atb::NO_ERROR;
@@ -223,6 +381,9 @@ void Model::CreateWorkspaceBuffer(int nodeId, int workspaceSizeNeeded)
 void Model::FreeResource()
 {
     LOG_INFO("FreeResource start");
+    prepPipeline_.Stop();
+    GetProfiler().ReleaseStream(model_stream_);  // 释放该stream上的打点event
+    nodeMetrics_.Release();
     auto status = aclrtDestroyStream(model_stream_);  // 销毁stream
     CHECK_RET(status, "aclrtDestroyStream failed");
 
@@ -234,32 +395,224 @@ void Model::FreeResource()
         atb::DestroyOperation(node.operation_);
 #ifdef USE_MEMPOOL
         GetMemoryManager().FreeBlock(node.workspaceBlockId_);
+#else
+        if (node.workspace_ != nullptr) {
+            aclrtFree(node.workspace_);
+        }
 #endif
     }
 
-    // 销毁输入tensor
-    for (size_t i = 0; i < model_inTensors_.size(); i++) {
-        aclrtFree(model_inTensors_.at(i).deviceData);
+    // 销毁输入输出tensor，绑定的调用方缓冲区不释放
+    for (auto &binding : inBindings_) {
+        FreeTensorBinding(binding);
     }
-
-    // 销毁输出tensor
-    for (size_t i = 0; i < model_outTensors_.size(); i++) {
-        aclrtFree(model_outTensors_.at(i).deviceData);
+    for (auto &binding : outBindings_) {
+        FreeTensorBinding(binding);
     }
 
-    // 释放中间tensor
+    // 释放中间tensor，复用其他tensor空间的不单独释放
     for (size_t i = 0; i < internalTensors_.size(); i++) {
-        aclrtFree(internalTensors_.at(i).deviceData);
+        if (internalStorage_.at(i) == nullptr) {
+            aclrtFree(internalTensors_.at(i).deviceData);
+        }
     }
 
     aclrtResetDevice(deviceId_);  // 重置deviceId
     LOG_INFO("FreeResource end");
 }
 
+void Model::SetBatchSize(uint32_t batchSize)
+{
+    batchSize_ = batchSize;
+}
+
+bool Model::SetHostPipeline(bool enable)
+{
+#ifndef USE_SIM_BACKEND
+    if (enable) {
+        // 准备线程与执行线程会同时使用mode_context_，atb::Context不保证多线程访问安全
+        LOG_ERROR(modelName_ + " host pipeline is only supported on the simulated backend, keep serial execution");
+        hostPipeline_ = false;
+        return false;
+    }
+#endif
+    hostPipeline_ = enable;
+    if (enable) {
+        prepPipeline_.Start(deviceId_);
+    } else {
+        prepPipeline_.Stop();
+    }
+    return true;
+}
+
+void Model::SetInPlace(bool enable)
+{
+    inPlace_ = enable;
+}
+
+uint64_t Model::GetInternalTensorBytes() const
+{
+    uint64_t bytes = 0;
+    for (size_t i = 0; i < internalTensors_.size(); i++) {
+        if (internalStorage_.at(i) == nullptr) {
+            bytes += internalTensors_.at(i).dataSize;
+        }
+    }
+    return bytes;
+}
+
+bool Model::BindInput(size_t inTensorId, void *data, uint64_t dataSize, BufferLocation location)
+{
+    if (inTensorId >= inBindings_.size()) {
+        LOG_ERROR("BindInput invalid inTensorId " + std::to_string(inTensorId));
+        return false;
+    }
+    return BindTensorBuffer(model_inTensors_.at(inTensorId), inBindings_.at(inTensorId), data, dataSize, location);
+}
+
+bool Model::BindOutput(size_t outTensorId, void *data, uint64_t dataSize, BufferLocation location)
+{
+    if (outTensorId >= outBindings_.size()) {
+        LOG_ERROR("BindOutput invalid outTensorId " + std::to_string(outTensorId));
+        return false;
+    }
+    return BindTensorBuffer(model_outTensors_.at(outTensorId), outBindings_.at(outTensorId), data, dataSize,
+                            location);
+}
+
+void Model::PlanInPlace()
+{
+    internalStorage_.assign(internalTensors_.size(), nullptr);
+    if (!inPlace_) {
+        return;
+    }
+    for (size_t nodeId = 0; nodeId < nodes_.size(); ++nodeId) {
+        const Node &node = nodes_.at(nodeId);
+        for (size_t i = 0; i < node.inPlaceInTensorIds_.size() && i < node.outTensors_.size(); ++i) {
+            int inTensorId = node.inPlaceInTensorIds_.at(i);
+            if (inTensorId < 0 || static_cast<size_t>(inTensorId) >= node.inTensors_.size()) {
+                continue;
+            }
+            const atb::Tensor *inTensor = node.inTensors_.at(inTensorId);
+            const atb::Tensor *outTensor = node.outTensors_.at(i);
+            // 模型输入由调用方持有并会被重复执行，不能改写；输入在后面还有读者时也不能改写
+            int inInternalId = GetInternalTensorId(inTensor);
+            if (inInternalId < 0 || IsTensorUsed(inTensor, nodeId + 1, nodes_.size())) {
+                continue;
+            }
+            int outInternalId = GetInternalTensorId(outTensor);
+            if (outInternalId >= 0) {
+                // 输出是中间张量：写在输入的空间上
+                internalStorage_.at(outInternalId) = inTensor;
+            } else {
+                // 输出是模型输出：输入的生产者直接写在模型输出上，本节点在模型输出上原地计算，
+                // 要求从生产者到本节点之间没有其他节点读写该模型输出
+                int producerId = GetProducerNodeId(inTensor);
+                if (internalStorage_.at(inInternalId) != nullptr || producerId < 0 ||
+                    IsTensorUsed(outTensor, producerId, nodeId)) {
+                    continue;
+                }
+                internalStorage_.at(inInternalId) = outTensor;
+            }
+            LOG_INFO("node[" + std::to_string(nodeId) + "] output " + std::to_string(i) + " in-place on input " +
+                     std::to_string(inTensorId));
+        }
+    }
+    if (!CheckInPlacePlan()) {
+        LOG_ERROR("in-place plan breaks a later reader, use separate buffers");
+        internalStorage_.assign(internalTensors_.size(), nullptr);
+    }
+}
+
+bool Model::CheckInPlacePlan() const
+{
+    // 每块空间（以单独分配空间的tensor表示）上当前保存的tensor
+    std::map<const atb::Tensor *, const atb::Tensor *> holders;
+    for (size_t i = 0; i < model_inTensors_.size(); i++) {
+        holders[&model_inTensors_.at(i)] = &model_inTensors_.at(i);
+    }
+    for (size_t nodeId = 0; nodeId < nodes_.size(); ++nodeId) {
+        const Node &node = nodes_.at(nodeId);
+        for (const atb::Tensor *inTensor : node.inTensors_) {
+            auto it = holders.find(GetStorageTensor(inTensor));
+            if (it == holders.end() || it->second != inTensor) {
+                LOG_ERROR("node[" + std::to_string(nodeId) + "] reads a tensor that is not in its storage");
+                return false;
+            }
+        }
+        for (const atb::Tensor *outTensor : node.outTensors_) {
+            holders[GetStorageTensor(outTensor)] = outTensor;
+        }
+    }
+    for (size_t i = 0; i < model_outTensors_.size(); i++) {
+        const atb::Tensor *outTensor = &model_outTensors_.at(i);
+        auto it = holders.find(GetStorageTensor(outTensor));
+        if (it == holders.end() || it->second != outTensor) {
+            LOG_ERROR("model output " + std::to_string(i) + " is overwritten");
+            return false;
+        }
+    }
+    return true;
+}
+
+int Model::GetInternalTensorId(const atb::Tensor *tensor) const
+{
+    for (size_t i = 0; i < internalTensors_.size(); i++) {
+        if (tensor == &internalTensors_.at(i)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+const atb::Tensor *Model::GetStorageTensor(const atb::Tensor *tensor) const
+{
+    int internalId = GetInternalTensorId(tensor);
+    while (internalId >= 0 && internalStorage_.at(internalId) != nullptr) {
+        tensor = internalStorage_.at(internalId);
+        internalId = GetInternalTensorId(tensor);
+    }
+    return tensor;
+}
+
+bool Model::IsTensorUsed(const atb::Tensor *tensor, size_t beginNodeId, size_t endNodeId) const
+{
+    for (size_t nodeId = beginNodeId; nodeId < endNodeId; ++nodeId) {
+        const Node &node = nodes_.at(nodeId);
+        for (const atb::Tensor *used : node.inTensors_) {
+            if (used == tensor) {
+                return true;
+            }
+        }
+        for (const atb::Tensor *used : node.outTensors_) {
+            if (used == tensor) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+int Model::GetProducerNodeId(const atb::Tensor *tensor) const
+{
+    for (size_t nodeId = 0; nodeId < nodes_.size(); ++nodeId) {
+        for (const atb::Tensor *outTensor : nodes_.at(nodeId).outTensors_) {
+            if (outTensor == tensor) {
+                return static_cast<int>(nodeId);
+            }
+        }
+    }
+    return -1;
+}
+
 void Model::WaitFinish()
 {
     // step9：销毁创建的对象，释放内存
     // 流同步，作用是等待device侧任务计算完成
     auto ret = aclrtSynchronizeStream(model_stream_);
     CHECK_RET(ret, "sync error!");
+    if (GetProfiler().IsEnabled()) {
+        GetProfiler().CollectDeviceSpans(model_stream_);
+    }
+    nodeMetrics_.CollectDevice();
 }
\ No newline at end of file
@@ -7,7 +7,10 @@
 #include <atb/types.h>
 #include <atb/utils.h>
 #include "atb/infer_op_params.h"
+#include "runtime/node_prep_pipeline.h"
 #include "utils/log.h"
+#include "utils/node_metrics.h"
+#include "utils/tensor_binding.h"
 
 enum class TensorType
 {
@@ -30,8 +33,13 @@ struct Node
     // Node的输出是中间tensor类型
     atb::SVector<TensorType> outTensorTypes_{};
 
+    // 第i个输出可以原地写入的输入序号，-1表示不能原地计算；为空表示所有输出都不能原地计算
+    // 只声明operation的能力（逐元素算子读完一个元素再写同位置），是否复用由Model构图后按tensor的读者决定
+    atb::SVector<int> inPlaceInTensorIds_{};
+
     atb::VariantPack variantPack_{};
 
+    uint64_t setupWorkspaceSize_ = 0;   // 本次Setup返回的workspace大小
     uint64_t workspaceSize_ = 0;
     int workspaceBlockId_ = -1;
     void *workspace_ = nullptr;
@@ -109,6 +117,30 @@ public:
      */
     void Execute();
 
+    /**
+     * 分步执行的步数，每步执行一个节点
+     */
+    size_t GetStepCount() const;
+
+    /**
+     * 开始分步执行，供在节点之间抢占的调度器使用（runtime/model_step_executor.h）
+     * BeginSteps之后按节点顺序对每一步调用RunStep，最后调用EndSteps，结果与一次Execute相同。
+     * 各步可以在不同线程上调用但不能同时调用，调用线程需要已绑定模型的device；分步执行不使用准备线程
+     */
+    void BeginSteps();
+
+    /**
+     * 执行一步：对节点stepId依次调用BuildNodeVariantPack、SetupNode和ExecuteNode
+     * @param stepId 节点ID
+     * @return 执行状态，失败时记录日志并返回，不退出进程
+     */
+    atb::Status RunStep(size_t stepId);
+
+    /**
+     * 结束分步执行：拷贝绑定的输出并等待stream完成
+     */
+    void EndSteps();
+
     /**
      * 等待流执行完成
      * 同步计算流，确保所有操作完成
@@ -121,6 +153,61 @@ public:
      */
     void FreeResource();
 
+    /**
+     * 设置batch大小，即激活输入x的第0维，必须在CreateModelGraph之前调用，构图时按形状选择算子实现
+     * @param batchSize batch大小，默认为1
+     */
+    void SetBatchSize(uint32_t batchSize);
+
+    /**
+     * 设置是否用准备线程提前准备节点（InferShape、分配输出、Setup、workspace），执行线程只下发已准备好的节点
+     * Setup较慢（如首次执行某个形状）时减少device在节点之间等待host的时间；
+     * 开启后同一context上不同节点的Setup与Execute会在两个线程上同时调用。
+     * 仅在仿真后端（USE_SIM_BACKEND）上可以开启：atb::Context不保证多线程同时使用是安全的，
+     * 而operation的Execute必须使用Setup时的context，不能简单地给准备线程另建context；
+     * 未定义USE_SIM_BACKEND时拒绝开启并记录错误，保持串行执行
+     * InitResource之后调用，默认为false
+     * @param enable 是否开启
+     * @return 设置是否生效，非仿真后端上请求开启时为false
+     */
+    bool SetHostPipeline(bool enable);
+
+    /**
+     * 设置是否允许原地计算，必须在CreateModelGraph之前调用
+     * 允许时声明了原地能力的节点在输入没有后续读者时直接在输入的空间上写输出，不再单独分配中间张量
+     * @param enable 默认为true
+     */
+    void SetInPlace(bool enable);
+
+    /**
+     * 获取中间张量单独分配的device内存大小（字节），与其他张量共用空间的中间张量不计入
+     * 在Execute之后有效
+     */
+    uint64_t GetInternalTensorBytes() const;
+
+    /**
+     * 把输入张量绑定到调用方持有的缓冲区，CreateModelInput之后调用，之后每次Execute都使用该缓冲区
+     * DEVICE：缓冲区直接作为输入张量的地址，换请求时用新地址重新绑定，不分配也不拷贝
+     * HOST：缓冲区需为锁页内存，Execute开始时异步拷贝到模型的device缓冲区
+     * @param inTensorId 输入张量ID
+     * @param data 缓冲区地址，由调用方持有和释放
+     * @param dataSize 缓冲区字节数，不能小于输入张量的大小
+     * @param location 缓冲区位置
+     * @return 绑定是否成功，失败时保持原有绑定
+     */
+    bool BindInput(size_t inTensorId, void *data, uint64_t dataSize, BufferLocation location);
+
+    /**
+     * 把输出张量绑定到调用方持有的缓冲区，CreateModelOutput之后调用，之后每次Execute都写入该缓冲区
+     * DEVICE：算子直接写调用方的device内存；HOST：缓冲区需为锁页内存，Execute结束前从模型的device缓冲区拷贝回来
+     * @param outTensorId 输出张量ID
+     * @param data 缓冲区地址，由调用方持有和释放
+     * @param dataSize 缓冲区字节数，不能小于输出张量的大小
+     * @param location 缓冲区位置
+     * @return 绑定是否成功，失败时保持原有绑定
+     */
+    bool BindOutput(size_t outTensorId, void *data, uint64_t dataSize, BufferLocation location);
+
     // 模型的输入张量集合
     atb::SVector<atb::Tensor> model_inTensors_;
 
@@ -146,9 +233,61 @@ private:
      * @param nodeId 节点ID
      */
     void BuildNodeVariantPack(int nodeId);
+
+    /**
+     * 把绑定的host输入拷贝到输入张量，与计算在同一个stream上排队
+     */
+    void CopyInBindings();
+
+    /**
+     * 把输出张量拷贝到绑定的host缓冲区，与计算在同一个stream上排队
+     */
+    void CopyOutBindings();
+
+    /**
+     * 原地计算规划
+     * 按节点声明的原地能力和各tensor的读者，决定哪些中间张量与其他张量共用空间，构图后调用
+     */
+    void PlanInPlace();
+
+    /**
+     * 检查原地计算规划
+     * 按执行顺序模拟每块空间上保存的tensor，任何节点读到的tensor和最终的模型输出都不能已被覆盖
+     * @return 规划是否安全
+     */
+    bool CheckInPlacePlan() const;
+
+    /**
+     * 获取tensor在internalTensors_中的序号
+     * @return 不是中间张量时返回-1
+     */
+    int GetInternalTensorId(const atb::Tensor *tensor) const;
+
+    /**
+     * 获取tensor实际使用的存储tensor，沿原地复用关系一直找到单独分配空间的tensor
+     */
+    const atb::Tensor *GetStorageTensor(const atb::Tensor *tensor) const;
+
+    /**
+     * 判断[beginNodeId, endNodeId)中是否有节点读或写tensor
+     */
+    bool IsTensorUsed(const atb::Tensor *tensor, size_t beginNodeId, size_t endNodeId) const;
+
+    /**
+     * 获取输出tensor的节点
+     * @return 没有节点输出该tensor时返回-1
+     */
+    int GetProducerNodeId(const atb::Tensor *tensor) const;
     
     /**
-     * 执行单个节点
+     * 准备单个节点：调用Setup并分配workspace，BuildNodeVariantPack之后调用
+     * @param nodeId 节点ID
+     * @return 准备状态，失败时记录日志并返回，不退出进程（可能在准备线程上调用）
+     */
+    atb::Status SetupNode(int nodeId);
+
+    /**
+     * 执行单个节点，把SetupNode准备好的节点下发到stream
      * @param nodeId 节点ID
      * @return 执行状态
      */
@@ -181,6 +320,20 @@ private:
     // 模型的中间张量，用于连接不同层之间的数据流
     // 注意：中间张量的顺序很重要，需要保持正确的数据流
     std::vector<atb::Tensor> internalTensors_;
+
+    // 中间张量复用空间的张量，按internalTensors_索引，nullptr表示单独分配
+    // 可以是被原地改写的中间张量，也可以是原地计算节点的模型输出
+    std::vector<const atb::Tensor *> internalStorage_;
+
+    std::vector<TensorBinding> inBindings_;   // 输入张量与调用方缓冲区的绑定，按InTensorId索引
+    std::vector<TensorBinding> outBindings_;  // 输出张量与调用方缓冲区的绑定，按OutTensorId索引
+
+    NodeMetrics nodeMetrics_;                 // Execute和各节点的耗时指标
+    NodePrepPipeline prepPipeline_;           // 提前准备节点的线程
+    bool hostPipeline_ = false;               // 是否用准备线程提前准备节点
+
+    bool inPlace_ = true;                     // 是否允许原地计算
+    uint32_t batchSize_ = 1;                  // batch大小
 };
 
 #endif
\ No newline at end of file
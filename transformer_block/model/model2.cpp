@@ -1,9 +1,83 @@
+// 编译时定义DISABLE_MEMPOOL时workspace直接使用aclrtMalloc，用于对比内存池的收益
+#ifndef DISABLE_MEMPOOL
 #define USE_MEMPOOL
+#endif
 
+#include <algorithm>
+#include <cmath>
+#include <random>
 #include "model/model2.h"
 #include "utils/utils.h"
 #include "atb/atb_graph_layer_norm.h"
 #include "memory/memory_utils.h"
+#include "memory/weight_store.h"
+#include "runtime/kernel_variants.h"
+#include "utils/dtype_convert.h"
+#include "utils/profiler.h"
+#include "utils/tensor_convert.h"
+#include "utils/weight_quant.h"
+
+// 权重在WeightStore中的名称，按InTensorId索引，激活输入为空
+static const char *WEIGHT_NAMES[Model2::Mode_INPUT_SIZE] = {
+    "",                    // IN_TENSOR_X
+    "layer_norm.gamma",    // IN_TENSOR_GAMMA
+    "layer_norm.beta",     // IN_TENSOR_BETA
+    "linear.weight",       // IN_TENSOR_MATMUL_WEIGHT
+    "linear.bias",         // IN_TENSOR_MATMUL_BIAS
+    "linear.scale",        // IN_TENSOR_MATMUL_SCALE
+    "linear.input_scale",  // IN_TENSOR_INPUT_SCALE
+    "linear.input_offset", // IN_TENSOR_INPUT_OFFSET
+};
+
+// 各量化方式下模型的输入张量个数
+constexpr size_t FP16_INPUT_NUM = Model2::IN_TENSOR_MATMUL_BIAS + 1;
+constexpr size_t W8A16_INPUT_NUM = Model2::IN_TENSOR_MATMUL_SCALE + 1;
+constexpr size_t W8A8_INPUT_NUM = Model2::IN_TENSOR_INPUT_OFFSET + 1;
+
+// W8A8激活的离线标定值：LayerNorm输出的绝对值上限
+constexpr float W8A8_ACTIVATION_ABS_MAX = 4.0f;
+
+// 流式加载时打包权重的对齐字节数
+constexpr uint64_t STREAMED_WEIGHT_ALIGN = 512;
+
+// fp16权重的host侧数据，种子为0时全2.0，否则在[-WEIGHT_RANDOM_RANGE, WEIGHT_RANDOM_RANGE]内随机
+constexpr float WEIGHT_FILL_VALUE = 2.0f;
+constexpr float WEIGHT_RANDOM_RANGE = 0.1f;
+
+static void FillWeight(void *hostData, uint64_t dataSize, uint32_t seed)
+{
+    if (seed == 0) {
+        FillTyped(hostData, ACL_FLOAT16, WEIGHT_FILL_VALUE, dataSize / sizeof(uint16_t));
+        return;
+    }
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> value(-WEIGHT_RANDOM_RANGE, WEIGHT_RANDOM_RANGE);
+    uint16_t *data = static_cast<uint16_t *>(hostData);
+    for (uint64_t i = 0; i < dataSize / sizeof(uint16_t); i++) {
+        data[i] = FloatToFp16(value(engine));
+    }
+}
+
+// 同一模型的各权重张量使用不同的种子
+static uint32_t TensorWeightSeed(uint32_t modelSeed, size_t inTensorId)
+{
+    return modelSeed == 0 ? 0 : modelSeed * 1000003u + static_cast<uint32_t>(inTensorId);
+}
+
+static uint64_t AlignWeightOffset(uint64_t offset)
+{
+    return (offset + STREAMED_WEIGHT_ALIGN - 1) / STREAMED_WEIGHT_ALIGN * STREAMED_WEIGHT_ALIGN;
+}
+
+// 对fp16参考权重做per-channel量化，weightDesc为量化后[k, n]的描述
+static QuantizedWeight QuantizeLinearWeight(const atb::TensorDesc &weightDesc, uint32_t seed)
+{
+    int64_t k = weightDesc.shape.dims[0];
+    int64_t n = weightDesc.shape.dims[1];
+    std::vector<uint16_t> fp16Weight(k * n);
+    FillWeight(fp16Weight.data(), fp16Weight.size() * sizeof(uint16_t), seed);
+    return QuantizePerChannel(fp16Weight.data(), k, n);
+}
 
 void Model2::InitResource(uint32_t deviceId)
 {
@@ -32,7 +106,10 @@ void Model2::CreateModelGraph()
         nodes_[i] = node;
     }
 
-    model_inTensors_.resize(Mode_INPUT_SIZE);
+    // 权重布局预处理只用于FP16的Linear
+    CHECK_RET(weightLayout_ != WeightLayout::ND && quantType_ != LinearQuantType::FP16,
+              "weight layout pre-transform requires FP16 linear");
+    model_inTensors_.resize(GetInputNum());
     model_outTensors_.resize(Mode_OUTPUT_SIZE);
 
     internalTensors_.resize(0);
@@ -52,19 +129,28 @@ void Model2::CreateGraphOpLayer(size_t nodeId)
     // 创建图算子的opreation
     Node2 &graph_node = nodes_[nodeId];
     LOG_ERROR("LN");
-    auto ret = CreateGraphOperationLN(&graph_node.operation_);
+    // FP16且权重为ND时Linear有atb和aclnn两种实现，按形状查询KernelTuner的选择
+    LinearKernel linearKernel = LinearKernel::ATB_LINEAR;
+    if (quantType_ == LinearQuantType::FP16 && weightLayout_ == WeightLayout::ND) {
+        atb::SVector<atb::TensorDesc> inTensorDescs;
+        inTensorDescs.resize(GetInputNum());
+        CreateInTensorDescs(inTensorDescs);
+        const atb::Dims &xShape = inTensorDescs.at(IN_TENSOR_X).shape;
+        std::vector<int64_t> xDims = {batchSize_, xShape.dims[1], xShape.dims[2]};
+        linearKernel = ChooseLinearKernel({mode_context_, model_stream_}, xDims,
+                                          inTensorDescs.at(IN_TENSOR_MATMUL_WEIGHT).shape.dims[1]);
+    }
+    auto ret = CreateGraphOperationLN(&graph_node.operation_, quantType_,
+                                      weightLayout_ == WeightLayout::ND_TRANSPOSED, linearKernel);
     CHECK_RET(ret, "CreateGraphOperation failed");
     // 设置图算子node节点的输入
     graph_node.inTensors_.resize(graph_node.operation_->GetInputNum());
 
     // 设置图算子node节点的输入
-    // 因为图算子的输入就是整个model的输入，因此这里直接从model的inTensors_赋值
-    size_t layerInTensorId = 0;
-    graph_node.inTensors_.at(layerInTensorId++) = &model_inTensors_.at(IN_TENSOR_X);
-    graph_node.inTensors_.at(layerInTensorId++) = &model_inTensors_.at(IN_TENSOR_GAMMA);
-    graph_node.inTensors_.at(layerInTensorId++) = &model_inTensors_.at(IN_TENSOR_BETA);
-    graph_node.inTensors_.at(layerInTensorId++) = &model_inTensors_.at(IN_TENSOR_MATMUL_WEIGHT);
-    graph_node.inTensors_.at(layerInTensorId++) = &model_inTensors_.at(IN_TENSOR_MATMUL_BIAS);
+    // 因为图算子的输入就是整个model的输入，且顺序与InTensorId一致，因此这里直接从model的inTensors_赋值
+    for (size_t layerInTensorId = 0; layerInTensorId < graph_node.inTensors_.size(); layerInTensorId++) {
+        graph_node.inTensors_.at(layerInTensorId) = &model_inTensors_.at(layerInTensorId);
+    }
 
     // 设置图算子node节点的输出，因为只有一个中间节点
     // outTensor直接赋值
@@ -97,9 +183,41 @@ void Model2::CreateModelInput()
 {
     LOG_ERROR("CreateModelInput start");
     atb::SVector<atb::TensorDesc> intensorDescs;
-    intensorDescs.resize(Mode_INPUT_SIZE);
+    intensorDescs.resize(model_inTensors_.size());
     CreateInTensorDescs(intensorDescs);
-    CreateInTensors(model_inTensors_, intensorDescs);
+    intensorDescs.at(IN_TENSOR_X).shape.dims[0] = batchSize_;
+    SetQuantTensorDescs(intensorDescs);
+    SetWeightLayoutDesc(intensorDescs);
+    // 量化权重的填充依赖Linear权重的描述，先设置所有输入的描述
+    for (size_t i = 0; i < model_inTensors_.size(); ++i) {
+        model_inTensors_.at(i).desc = intensorDescs.at(i);
+    }
+    for (size_t i = 0; i < model_inTensors_.size(); ++i) {
+        if (!IsWeightTensor(i)) {
+            // 激活是每个实例独有的输入
+            CreateInTensor(model_inTensors_.at(i), intensorDescs.at(i));
+            continue;
+        }
+        if (streamWeights_) {
+            // 流式加载的权重只有描述，device地址在执行前绑定
+            model_inTensors_.at(i).desc = intensorDescs.at(i);
+            model_inTensors_.at(i).dataSize = atb::Utils::GetTensorSize(model_inTensors_.at(i));
+            model_inTensors_.at(i).deviceData = nullptr;
+            continue;
+        }
+        // 权重绑定到当前device上的共享权重，只在首次获取时上传
+        GetWeightStore().Acquire(GetWeightName(i), intensorDescs.at(i),
+                                 [this, i](void *hostData, uint64_t dataSize) {
+                                     FillWeightTensor(i, hostData, dataSize);
+                                 },
+                                 model_inTensors_.at(i));
+    }
+    inBindings_.assign(model_inTensors_.size(), TensorBinding());
+    for (size_t i = 0; i < model_inTensors_.size(); ++i) {
+        if (!IsWeightTensor(i)) {
+            inBindings_.at(i).ownedData = model_inTensors_.at(i).deviceData;
+        }
+    }
     LOG_ERROR("CreateModelInput end");
 }
 
@@ -110,7 +228,7 @@ void Model2::CreateModelOutput()
     outtensorDescs.resize(Mode_OUTPUT_SIZE);
     // 设置输入的input desc
     atb::SVector<atb::TensorDesc> inTensorDescs;
-    inTensorDescs.resize(Mode_INPUT_SIZE);
+    inTensorDescs.resize(model_inTensors_.size());
     for (size_t i = 0; i < model_inTensors_.size(); ++i) {
         inTensorDescs.at(i) = model_inTensors_.at(i).desc;
     }
@@ -118,17 +236,23 @@ void Model2::CreateModelOutput()
     // 调用infer shape，推导出模型的输出
     InferShape(inTensorDescs, outtensorDescs);
     CreateOutTensors(model_outTensors_, outtensorDescs);
+    outBindings_.assign(model_outTensors_.size(), TensorBinding());
+    for (size_t i = 0; i < model_outTensors_.size(); ++i) {
+        outBindings_.at(i).ownedData = model_outTensors_.at(i).deviceData;
+    }
     LOG_ERROR("CreateModelOutput end");
 }
 
 atb::Status Model2::InferShape(const atb::SVector<atb::TensorDesc> &inTensorDescs,
                               atb::SVector<atb::TensorDesc> &outTensorDescs)
 {
-    // 输出的shape和输入时相同的。取第一个的输入即可
+    // 输出的dtype和format与输入x相同
     // outTensorDescs.at(0) = model_inTensors_.at(4).desc;
+    outTensorDescs.at(0).dtype = inTensorDescs.at(IN_TENSOR_X).dtype;
+    outTensorDescs.at(0).format = inTensorDescs.at(IN_TENSOR_X).format;
     outTensorDescs.at(0).shape.dimNum = 3;
-    outTensorDescs.at(0).shape.dims[0] = 1; // batch
-    outTensorDescs.at(0).shape.dims[1] = 197; // batch
+    outTensorDescs.at(0).shape.dims[0] = inTensorDescs.at(IN_TENSOR_X).shape.dims[0]; // batch
+    outTensorDescs.at(0).shape.dims[1] = inTensorDescs.at(IN_TENSOR_X).shape.dims[1];
     outTensorDescs.at(0).shape.dims[2] = 2304;
     // 输出模型的shape,todo: 动态计算
     // outTensorDescs.at(i).shape.dimNum = 3;
@@ -141,16 +265,79 @@ atb::Status Model2::InferShape(const atb::SVector<atb::TensorDesc> &inTensorDesc
 void Model2::Execute()
 {
     LOG_INFO(modelName_ + " Execute start");
-    for (size_t nodeId = 0; nodeId < nodes_.size(); ++nodeId) {
-        BuildNodeVariantPack(nodeId);
-        atb::Status status = ExecuteNode(nodeId);
-        CHECK_RET(status, "ExecuteNode " + std::to_string(nodeId) + " failed. status: " + std::to_string(status));
+    nodeMetrics_.Prepare("Model2", nodes_.size());
+    ScopedLatency executeLatency(nodeMetrics_.GetExecuteHistogram());
+    CopyInBindings();
+    if (hostPipeline_) {
+        // 准备线程按顺序准备节点，本线程只下发已准备好的节点
+        atb::Status status = prepPipeline_.Run(
+            nodes_.size(),
+            [this](size_t nodeId) {
+                BuildNodeVariantPack(nodeId);
+                return SetupNode(nodeId);
+            },
+            [this](size_t nodeId) { return ExecuteNode(nodeId); });
+        CHECK_RET(status, "pipelined execute failed. status: " + std::to_string(status));
+    } else {
+        for (size_t nodeId = 0; nodeId < nodes_.size(); ++nodeId) {
+            atb::Status status = RunStep(nodeId);
+            CHECK_RET(status, "RunStep " + std::to_string(nodeId) + " failed. status: " + std::to_string(status));
+        }
     }
+    CopyOutBindings();
 
     WaitFinish();
     LOG_INFO(modelName_ + " Execute end");
 }
 
+size_t Model2::GetStepCount() const
+{
+    return nodes_.size();
+}
+
+void Model2::BeginSteps()
+{
+    nodeMetrics_.Prepare("Model2", nodes_.size());
+    CopyInBindings();
+}
+
+atb::Status Model2::RunStep(size_t stepId)
+{
+    BuildNodeVariantPack(stepId);
+    atb::Status status = SetupNode(stepId);
+    if (status != atb::NO_ERROR) {
+        return status;
+    }
+    status = ExecuteNode(stepId);
+    if (status != atb::NO_ERROR) {
+        LOG_ERROR("ExecuteNode " + std::to_string(stepId) + " failed. status: " + std::to_string(status));
+    }
+    return status;
+}
+
+void Model2::EndSteps()
+{
+    CopyOutBindings();
+    WaitFinish();
+}
+
+void Model2::CopyInBindings()
+{
+    // host侧绑定的输入输出与计算在同一个stream上排队，不需要额外同步
+    for (size_t i = 0; i < inBindings_.size(); ++i) {
+        auto ret = CopyBoundInput(model_inTensors_.at(i), inBindings_.at(i), model_stream_);
+        CHECK_RET(ret, "copy bound input " + std::to_string(i) + " failed. ret: " + std::to_string(ret));
+    }
+}
+
+void Model2::CopyOutBindings()
+{
+    for (size_t i = 0; i < outBindings_.size(); ++i) {
+        auto ret = CopyBoundOutput(model_outTensors_.at(i), outBindings_.at(i), model_stream_);
+        CHECK_RET(ret, "copy bound output " + std::to_string(i) + " failed. ret: " + std::to_string(ret));
+    }
+}
+
 void Model2::BuildNodeVariantPack(int nodeId)
 {
     LOG_INFO("buildNodeVariantPack nodes[" + std::to_string(nodeId) + "] start");
@@ -170,40 +357,86 @@ void Model2::BuildNodeVariantPack(int nodeId)
     outTensorDescs.resize(node.operation_->GetOutputNum());
 
     // 调用operation_的InferShape，推导出out tensor的desc
-    atb::Status st = node.operation_->InferShape(inTensorDescs, outTensorDescs);
+    atb::Status st = atb::NO_ERROR;
+    {
+        ProfileScope scope("InferShape", nodeId);
+        st = node.operation_->InferShape(inTensorDescs, outTensorDescs);
+    }
 
     node.variantPack_.outTensors.resize(node.operation_->GetOutputNum());
     for (size_t i = 0; i < node.outTensors_.size(); ++i) {
         node.variantPack_.outTensors.at(i) = *node.outTensors_.at(i);
         if (node.outTensorTypes_.at(i) == TensorType2::INTERNAL_TENSOR) {
-            // 创建输出tensor的空间
-            CreateTensorFromDesc(node.variantPack_.outTensors.at(i), outTensorDescs.at(i));
-            *node.outTensors_.at(i) = node.variantPack_.outTensors.at(i);
+            // 创建输出tensor的空间，重复执行时复用已有空间
+            atb::Tensor &internalTensor = *node.outTensors_.at(i);
+            if (internalTensor.deviceData == nullptr ||
+                internalTensor.dataSize != atb::Utils::GetTensorSize(outTensorDescs.at(i))) {
+                aclrtFree(internalTensor.deviceData);
+                CreateTensorFromDesc(internalTensor, outTensorDescs.at(i));
+            }
+            internalTensor.desc = outTensorDescs.at(i);
+            node.variantPack_.outTensors.at(i) = internalTensor;
         }
     }
     LOG_INFO("buildNodeVariantPack nodes[" + std::to_string(nodeId) + "] end");
 }
 
-atb::Status Model2::ExecuteNode(int nodeId)
+atb::Status Model2::SetupNode(int nodeId)
 {
     auto &node = nodes_.at(nodeId);
 
     uint64_t workspaceSize = 0;
-    atb::Status status = node.operation_->Setup(node.variantPack_, workspaceSize, mode_context_);
-    CHECK_RET(status, "Setup node " + std::to_string(nodeId) + " failed. status: " + std::to_string(status));
+    atb::Status status = atb::NO_ERROR;
+    {
+        ProfileScope scope("Setup", nodeId);
+        ScopedLatency setupLatency(nodeMetrics_.GetSetupHistogram(nodeId));
+        status = node.operation_->Setup(node.variantPack_, workspaceSize, mode_context_);
+    }
+    // 可能在准备线程上执行，失败时返回status由调用方处理，不在这里退出进程
+    if (status != atb::NO_ERROR) {
+        LOG_ERROR("Setup node " + std::to_string(nodeId) + " failed. status: " + std::to_string(status));
+        return status;
+    }
 
     LOG_INFO("Get node[" + std::to_string(nodeId) + "] workspace size:" + std::to_string(workspaceSize));
+    {
+        ProfileScope scope("Workspace", nodeId);
 #ifdef USE_MEMPOOL
-    CreateWorkspaceBuffer(nodeId, workspaceSize);
+        CreateWorkspaceBuffer(nodeId, workspaceSize);
 #else
-    if (workspaceSize != 0) {
-        status = aclrtMalloc(&node.workspace_, workspaceSize, ACL_MEM_MALLOC_HUGE_FIRST);
-        CHECK_RET(status, "alloc error!");
-    }
+        // 上一次执行已经同步完成，释放后重新申请
+        if (node.workspace_ != nullptr) {
+            aclrtFree(node.workspace_);
+            node.workspace_ = nullptr;
+        }
+        if (workspaceSize != 0) {
+            status = aclrtMalloc(&node.workspace_, workspaceSize, ACL_MEM_MALLOC_HUGE_FIRST);
+            if (status != ACL_SUCCESS) {
+                LOG_ERROR("alloc workspace for node " + std::to_string(nodeId) + " failed. ret: " +
+                          std::to_string(status));
+                return status;
+            }
+        }
 #endif
+    }
+    node.setupWorkspaceSize_ = workspaceSize;
+    return atb::NO_ERROR;
+}
+
+atb::Status Model2::ExecuteNode(int nodeId)
+{
+    auto &node = nodes_.at(nodeId);
+    atb::Status status = atb::NO_ERROR;
     LOG_INFO("Execute node[" + std::to_string(nodeId) + "] start");
-    status =
-        node.operation_->Execute(node.variantPack_, (uint8_t *)(node.workspace_), workspaceSize, mode_context_);
+    {
+        // device区间覆盖节点在stream上的全部任务，host区间只是下发耗时
+        DeviceProfileScope deviceScope(model_stream_, "Device", nodeId);
+        ProfileScope scope("Launch", nodeId);
+        nodeMetrics_.BeginDevice(nodeId, model_stream_);
+        status = node.operation_->Execute(node.variantPack_, (uint8_t *)(node.workspace_), node.setupWorkspaceSize_,
+                                          mode_context_);
+        nodeMetrics_.EndDevice(nodeId, model_stream_);
+    }
     CHECK_RET(status, "Execute node " + std::to_string(nodeId) + " failed. status: " + std::to_string(status));
     LOG_INFO("Execute node[" + std::to_string(nodeId) + "] end");
     return atb::NO_ERROR;
@@ -232,6 +465,9 @@ void Model2::CreateWorkspaceBuffer(int nodeId, int workspaceSizeNeeded)
 void Model2::FreeResource()
 {
     LOG_INFO("FreeResource start");
+    prepPipeline_.Stop();
+    GetProfiler().ReleaseStream(model_stream_);  // 释放该stream上的打点event
+    nodeMetrics_.Release();
     auto status = aclrtDestroyStream(model_stream_);  // 销毁stream
     CHECK_RET(status, "aclrtDestroyStream failed");
 
@@ -244,17 +480,27 @@ void Model2::FreeResource()
         // atb::DestroyOperation(node.operation_);
 #ifdef USE_MEMPOOL
         GetMemoryManager().FreeBlock(node.workspaceBlockId_);
+#else
+        if (node.workspace_ != nullptr) {
+            aclrtFree(node.workspace_);
+        }
 #endif
     }
 
-    // 销毁输入tensor
+    // 销毁输入tensor，权重只释放引用，绑定的调用方缓冲区不释放
     for (size_t i = 0; i < model_inTensors_.size(); i++) {
-        aclrtFree(model_inTensors_.at(i).deviceData);
+        if (IsWeightTensor(i)) {
+            if (!streamWeights_) {
+                GetWeightStore().Release(GetWeightName(i));
+            }
+            continue;
+        }
+        FreeTensorBinding(inBindings_.at(i));
     }
 
     // 销毁输出tensor
-    for (size_t i = 0; i < model_outTensors_.size(); i++) {
-        aclrtFree(model_outTensors_.at(i).deviceData);
+    for (auto &binding : outBindings_) {
+        FreeTensorBinding(binding);
     }
 
     // 释放中间tensor
@@ -266,10 +512,302 @@ void Model2::FreeResource()
     LOG_INFO("FreeResource end");
 }
 
+bool Model2::BindInput(size_t inTensorId, void *data, uint64_t dataSize, BufferLocation location)
+{
+    if (inTensorId >= inBindings_.size() || IsWeightTensor(inTensorId)) {
+        LOG_ERROR("BindInput invalid inTensorId " + std::to_string(inTensorId) + ", only activations can be bound");
+        return false;
+    }
+    return BindTensorBuffer(model_inTensors_.at(inTensorId), inBindings_.at(inTensorId), data, dataSize, location);
+}
+
+bool Model2::BindOutput(size_t outTensorId, void *data, uint64_t dataSize, BufferLocation location)
+{
+    if (outTensorId >= outBindings_.size()) {
+        LOG_ERROR("BindOutput invalid outTensorId " + std::to_string(outTensorId));
+        return false;
+    }
+    return BindTensorBuffer(model_outTensors_.at(outTensorId), outBindings_.at(outTensorId), data, dataSize,
+                            location);
+}
+
+uint64_t Model2::GetInstanceBytes() const
+{
+    uint64_t instanceBytes = 0;
+    for (size_t i = 0; i < inBindings_.size(); i++) {
+        if (inBindings_.at(i).ownedData != nullptr) {
+            instanceBytes += model_inTensors_.at(i).dataSize;
+        }
+    }
+    for (size_t i = 0; i < outBindings_.size(); i++) {
+        if (outBindings_.at(i).ownedData != nullptr) {
+            instanceBytes += model_outTensors_.at(i).dataSize;
+        }
+    }
+    for (const auto &tensor : internalTensors_) {
+        instanceBytes += tensor.dataSize;
+    }
+    for (const auto &node : nodes_) {
+        instanceBytes += node.workspaceSize_;
+    }
+    return instanceBytes;
+}
+
+bool Model2::IsWeightTensor(size_t inTensorId)
+{
+    return inTensorId != IN_TENSOR_X;
+}
+
+void Model2::SetLinearQuantType(LinearQuantType quantType)
+{
+    quantType_ = quantType;
+}
+
+void Model2::SetBatchSize(uint32_t batchSize)
+{
+    batchSize_ = batchSize;
+}
+
+bool Model2::SetHostPipeline(bool enable)
+{
+#ifndef USE_SIM_BACKEND
+    if (enable) {
+        // 准备线程与执行线程会同时使用mode_context_，atb::Context不保证多线程访问安全
+        LOG_ERROR(modelName_ + " host pipeline is only supported on the simulated backend, keep serial execution");
+        hostPipeline_ = false;
+        return false;
+    }
+#endif
+    hostPipeline_ = enable;
+    if (enable) {
+        prepPipeline_.Start(deviceId_);
+    } else {
+        prepPipeline_.Stop();
+    }
+    return true;
+}
+
+void Model2::SetWeightLayout(WeightLayout weightLayout)
+{
+    weightLayout_ = weightLayout;
+}
+
+LinearQuantType Model2::GetLinearQuantType() const
+{
+    return quantType_;
+}
+
+WeightLayout Model2::GetWeightLayout() const
+{
+    return weightLayout_;
+}
+
+size_t Model2::GetInputNum() const
+{
+    if (quantType_ == LinearQuantType::W8A16) {
+        return W8A16_INPUT_NUM;
+    }
+    if (quantType_ == LinearQuantType::W8A8) {
+        return W8A8_INPUT_NUM;
+    }
+    return FP16_INPUT_NUM;
+}
+
+void Model2::SetQuantTensorDescs(atb::SVector<atb::TensorDesc> &inTensorDescs) const
+{
+    if (quantType_ == LinearQuantType::FP16) {
+        return;
+    }
+    atb::TensorDesc &weightDesc = inTensorDescs.at(IN_TENSOR_MATMUL_WEIGHT);
+    int64_t n = weightDesc.shape.dims[1];
+    weightDesc.dtype = ACL_INT8;
+
+    atb::TensorDesc &scaleDesc = inTensorDescs.at(IN_TENSOR_MATMUL_SCALE);
+    scaleDesc.format = ACL_FORMAT_ND;
+    if (quantType_ == LinearQuantType::W8A16) {
+        // antiquantScale：每个输出通道一个fp16
+        scaleDesc.dtype = ACL_FLOAT16;
+        scaleDesc.shape.dimNum = 1;
+        scaleDesc.shape.dims[0] = n;
+        return;
+    }
+
+    // W8A8：int32 bias，float deqScale，激活per-tensor量化参数
+    inTensorDescs.at(IN_TENSOR_MATMUL_BIAS).dtype = ACL_INT32;
+    scaleDesc.dtype = ACL_FLOAT;
+    scaleDesc.shape.dimNum = 2;
+    scaleDesc.shape.dims[0] = 1;
+    scaleDesc.shape.dims[1] = n;
+
+    atb::TensorDesc &inputScaleDesc = inTensorDescs.at(IN_TENSOR_INPUT_SCALE);
+    inputScaleDesc.dtype = ACL_FLOAT16;
+    inputScaleDesc.format = ACL_FORMAT_ND;
+    inputScaleDesc.shape.dimNum = 1;
+    inputScaleDesc.shape.dims[0] = 1;
+
+    atb::TensorDesc &inputOffsetDesc = inTensorDescs.at(IN_TENSOR_INPUT_OFFSET);
+    inputOffsetDesc = inputScaleDesc;
+    inputOffsetDesc.dtype = ACL_INT8;
+}
+
+void Model2::SetWeightLayoutDesc(atb::SVector<atb::TensorDesc> &inTensorDescs) const
+{
+    atb::TensorDesc &weightDesc = inTensorDescs.at(IN_TENSOR_MATMUL_WEIGHT);
+    int64_t k = weightDesc.shape.dims[0];
+    int64_t n = weightDesc.shape.dims[1];
+    if (weightLayout_ == WeightLayout::ND_TRANSPOSED) {
+        weightDesc.shape.dims[0] = n;
+        weightDesc.shape.dims[1] = k;
+    } else if (weightLayout_ == WeightLayout::FRACTAL_NZ) {
+        // [1, n/16, k, 16]，k和n按分形补齐
+        weightDesc.format = ACL_FORMAT_FRACTAL_NZ;
+        weightDesc.shape.dimNum = 4;
+        weightDesc.shape.dims[0] = 1;
+        weightDesc.shape.dims[1] = AlignToNzBlock(n) / NZ_BLOCK_SIZE;
+        weightDesc.shape.dims[2] = AlignToNzBlock(k);
+        weightDesc.shape.dims[3] = NZ_BLOCK_SIZE;
+    }
+}
+
+std::string Model2::GetWeightName(size_t inTensorId) const
+{
+    // 带种子的权重与默认权重不同，按种子分开存放
+    if (weightSeed_ != 0) {
+        return "seed" + std::to_string(weightSeed_) + "." + GetUnseededWeightName(inTensorId);
+    }
+    return GetUnseededWeightName(inTensorId);
+}
+
+std::string Model2::GetUnseededWeightName(size_t inTensorId) const
+{
+    // 不同布局的Linear权重描述不同，在WeightStore中分开存放
+    if (inTensorId == IN_TENSOR_MATMUL_WEIGHT && weightLayout_ != WeightLayout::ND) {
+        return std::string(WEIGHT_NAMES[inTensorId]) +
+               (weightLayout_ == WeightLayout::ND_TRANSPOSED ? ".transposed" : ".nz");
+    }
+    // LayerNorm的权重与量化方式无关，在不同量化方式的实例之间共享
+    if (quantType_ == LinearQuantType::FP16 || inTensorId < IN_TENSOR_MATMUL_WEIGHT) {
+        return WEIGHT_NAMES[inTensorId];
+    }
+    std::string prefix = quantType_ == LinearQuantType::W8A16 ? "w8a16." : "w8a8.";
+    return prefix + WEIGHT_NAMES[inTensorId];
+}
+
+void Model2::FillWeightTensor(size_t inTensorId, void *hostData, uint64_t dataSize) const
+{
+    if (inTensorId == IN_TENSOR_MATMUL_WEIGHT && weightLayout_ != WeightLayout::ND) {
+        // 先生成ND [k, n]的权重，再转换为目标布局
+        const atb::TensorDesc &xDesc = model_inTensors_.at(IN_TENSOR_X).desc;
+        const atb::TensorDesc &biasDesc = model_inTensors_.at(IN_TENSOR_MATMUL_BIAS).desc;
+        int64_t k = xDesc.shape.dims[xDesc.shape.dimNum - 1];
+        int64_t n = biasDesc.shape.dims[biasDesc.shape.dimNum - 1];
+        std::vector<uint16_t> ndWeight(k * n);
+        FillWeight(ndWeight.data(), ndWeight.size() * sizeof(uint16_t), TensorWeightSeed(weightSeed_, inTensorId));
+        PrepareWeight(ndWeight.data(), k, n, weightLayout_, static_cast<uint16_t *>(hostData));
+        return;
+    }
+    if (quantType_ == LinearQuantType::FP16 || inTensorId < IN_TENSOR_MATMUL_WEIGHT ||
+        (quantType_ == LinearQuantType::W8A16 && inTensorId == IN_TENSOR_MATMUL_BIAS)) {
+        FillWeight(hostData, dataSize, TensorWeightSeed(weightSeed_, inTensorId));
+        return;
+    }
+    if (inTensorId == IN_TENSOR_INPUT_SCALE) {
+        *static_cast<uint16_t *>(hostData) = FloatToFp16(ActivationScale(W8A8_ACTIVATION_ABS_MAX));
+        return;
+    }
+    if (inTensorId == IN_TENSOR_INPUT_OFFSET) {
+        *static_cast<int8_t *>(hostData) = 0;
+        return;
+    }
+
+    // 量化后的权重、scale和bias都由同一份fp16参考权重和bias导出
+    QuantizedWeight quant = QuantizeLinearWeight(model_inTensors_.at(IN_TENSOR_MATMUL_WEIGHT).desc,
+                                                 TensorWeightSeed(weightSeed_, IN_TENSOR_MATMUL_WEIGHT));
+    if (inTensorId == IN_TENSOR_MATMUL_WEIGHT) {
+        std::copy(quant.data.begin(), quant.data.end(), static_cast<int8_t *>(hostData));
+        return;
+    }
+    if (quantType_ == LinearQuantType::W8A16) {
+        // IN_TENSOR_MATMUL_SCALE
+        uint16_t *scales = static_cast<uint16_t *>(hostData);
+        for (int64_t j = 0; j < quant.n; j++) {
+            scales[j] = FloatToFp16(quant.scales[j]);
+        }
+        return;
+    }
+
+    // W8A8：int32累加结果乘以deqScale = actScale * weightScale，bias按同一scale量化到int32
+    float actScale = ActivationScale(W8A8_ACTIVATION_ABS_MAX);
+    uint16_t fp16Bias = 0;
+    FillWeight(&fp16Bias, sizeof(fp16Bias), TensorWeightSeed(weightSeed_, IN_TENSOR_MATMUL_BIAS));
+    for (int64_t j = 0; j < quant.n; j++) {
+        float deqScale = actScale * quant.scales[j];
+        if (inTensorId == IN_TENSOR_MATMUL_BIAS) {
+            static_cast<int32_t *>(hostData)[j] = static_cast<int32_t>(std::lround(Fp16ToFloat(fp16Bias) / deqScale));
+        } else {
+            static_cast<float *>(hostData)[j] = deqScale;
+        }
+    }
+}
+
+void Model2::EnableWeightStreaming()
+{
+    streamWeights_ = true;
+}
+
+void Model2::SetWeightSeed(uint32_t seed)
+{
+    weightSeed_ = seed;
+}
+
+uint64_t Model2::GetStreamedWeightBytes() const
+{
+    uint64_t offset = 0;
+    for (size_t i = 0; i < model_inTensors_.size(); i++) {
+        if (IsWeightTensor(i)) {
+            offset = AlignWeightOffset(offset) + model_inTensors_.at(i).dataSize;
+        }
+    }
+    return offset;
+}
+
+void Model2::FillStreamedWeights(void *hostData) const
+{
+    uint64_t offset = 0;
+    for (size_t i = 0; i < model_inTensors_.size(); i++) {
+        if (IsWeightTensor(i)) {
+            offset = AlignWeightOffset(offset);
+            FillWeightTensor(i, static_cast<uint8_t *>(hostData) + offset, model_inTensors_.at(i).dataSize);
+            offset += model_inTensors_.at(i).dataSize;
+        }
+    }
+}
+
+void Model2::BindWeightBuffer(void *deviceData)
+{
+    uint64_t offset = 0;
+    for (size_t i = 0; i < model_inTensors_.size(); i++) {
+        if (IsWeightTensor(i)) {
+            offset = AlignWeightOffset(offset);
+            model_inTensors_.at(i).deviceData = static_cast<uint8_t *>(deviceData) + offset;
+            offset += model_inTensors_.at(i).dataSize;
+        }
+    }
+}
+
+aclrtStream Model2::GetStream() const
+{
+    return model_stream_;
+}
+
 void Model2::WaitFinish()
 {
     // step9：销毁创建的对象，释放内存
     // 流同步，作用是等待device侧任务计算完成
     auto ret = aclrtSynchronizeStream(model_stream_);
     CHECK_RET(ret, "sync error!");
+    if (GetProfiler().IsEnabled()) {
+        GetProfiler().CollectDeviceSpans(model_stream_);
+    }
+    nodeMetrics_.CollectDevice();
 }
\ No newline at end of file
@@ -7,7 +7,12 @@
 #include <atb/types.h>
 #include <atb/utils.h>
 #include "atb/infer_op_params.h"
+#include "atb/atb_graph_layer_norm.h"
+#include "runtime/node_prep_pipeline.h"
 #include "utils/log.h"
+#include "utils/node_metrics.h"
+#include "utils/tensor_binding.h"
+#include "utils/weight_layout.h"
 
 enum class TensorType2
 {
@@ -32,6 +37,7 @@ struct Node2
 
     atb::VariantPack variantPack_{};
 
+    uint64_t setupWorkspaceSize_ = 0;   // 本次Setup返回的workspace大小
     uint64_t workspaceSize_ = 0;
     int workspaceBlockId_ = -1;
     void *workspace_ = nullptr;
@@ -57,6 +63,9 @@ public:
         IN_TENSOR_BETA,
         IN_TENSOR_MATMUL_WEIGHT,
         IN_TENSOR_MATMUL_BIAS,
+        IN_TENSOR_MATMUL_SCALE,  // 量化Linear：W8A16为antiquantScale，W8A8为deqScale
+        IN_TENSOR_INPUT_SCALE,   // W8A8：激活量化scale
+        IN_TENSOR_INPUT_OFFSET,  // W8A8：激活量化offset
         Mode_INPUT_SIZE,     // 输入张量总数
     };
 
@@ -110,6 +119,30 @@ public:
      */
     void Execute();
 
+    /**
+     * 分步执行的步数，每步执行一个节点
+     */
+    size_t GetStepCount() const;
+
+    /**
+     * 开始分步执行，供在节点之间抢占的调度器使用（runtime/model_step_executor.h）
+     * BeginSteps之后按节点顺序对每一步调用RunStep，最后调用EndSteps，结果与一次Execute相同。
+     * 各步可以在不同线程上调用但不能同时调用，调用线程需要已绑定模型的device；分步执行不使用准备线程
+     */
+    void BeginSteps();
+
+    /**
+     * 执行一步：对节点stepId依次调用BuildNodeVariantPack、SetupNode和ExecuteNode
+     * @param stepId 节点ID
+     * @return 执行状态，失败时记录日志并返回，不退出进程
+     */
+    atb::Status RunStep(size_t stepId);
+
+    /**
+     * 结束分步执行：拷贝绑定的输出并等待stream完成
+     */
+    void EndSteps();
+
     /**
      * 等待流执行完成
      * 同步计算流，确保所有操作完成
@@ -122,6 +155,129 @@ public:
      */
     void FreeResource();
 
+    /**
+     * 获取本实例独占的device内存大小（字节）
+     * 包括激活输入、输出、中间张量和workspace，不包括共享权重和绑定的调用方device缓冲区
+     * 即同一device上每增加一个模型实例所需的额外device内存
+     */
+    uint64_t GetInstanceBytes() const;
+
+    /**
+     * 判断输入张量是否为权重
+     * 权重由WeightStore在同一device上的模型实例之间共享，只读
+     * @param inTensorId 输入张量ID
+     */
+    static bool IsWeightTensor(size_t inTensorId);
+
+    /**
+     * 设置Linear的权重量化方式，必须在CreateModelGraph之前调用
+     * 量化权重由fp16权重按per-channel离线量化得到，不同量化方式的权重在WeightStore中互不共享
+     * @param quantType FP16/W8A16/W8A8
+     */
+    void SetLinearQuantType(LinearQuantType quantType);
+
+    /**
+     * 设置Linear权重在device上的存储布局，必须在CreateModelGraph之前调用
+     * 权重在加载时由host侧转换为目标布局，执行时kernel不再重排，只支持FP16的Linear
+     * @param weightLayout ND/ND_TRANSPOSED/FRACTAL_NZ
+     */
+    void SetWeightLayout(WeightLayout weightLayout);
+
+    /**
+     * 获取Linear的权重量化方式
+     */
+    LinearQuantType GetLinearQuantType() const;
+
+    /**
+     * 获取Linear权重在device上的存储布局
+     */
+    WeightLayout GetWeightLayout() const;
+
+    /**
+     * 获取当前量化方式下模型的输入张量个数
+     */
+    size_t GetInputNum() const;
+
+    /**
+     * 开启权重流式加载，必须在CreateModelInput之前调用
+     * 开启后权重不驻留device，也不经过WeightStore，只创建tensor描述，
+     * 每次执行前通过BindWeightBuffer绑定到打包好的一层权重上
+     */
+    void EnableWeightStreaming();
+
+    /**
+     * 设置权重的随机种子，必须在CreateModelInput之前调用
+     * 0（默认）时权重为全2.0；非0时权重为由种子生成的随机值，WeightStore中按种子分开存放，
+     * 流水线的各层用不同的种子得到不同的权重
+     * @param seed 随机种子
+     */
+    void SetWeightSeed(uint32_t seed);
+
+    /**
+     * 获取一层权重打包后的字节数，CreateModelInput之后有效
+     */
+    uint64_t GetStreamedWeightBytes() const;
+
+    /**
+     * 按打包布局在host内存中填充一层权重
+     * @param hostData 至少GetStreamedWeightBytes字节的host内存
+     */
+    void FillStreamedWeights(void *hostData) const;
+
+    /**
+     * 把所有权重tensor绑定到一块打包的device内存上
+     * @param deviceData 布局与FillStreamedWeights一致的device内存
+     */
+    void BindWeightBuffer(void *deviceData);
+
+    /**
+     * 设置batch大小，即激活输入x的第0维，必须在CreateModelGraph之前调用，构图时按形状选择算子实现
+     * @param batchSize batch大小，默认为1
+     */
+    void SetBatchSize(uint32_t batchSize);
+
+    /**
+     * 设置是否用准备线程提前准备节点（InferShape、分配输出、Setup、workspace），执行线程只下发已准备好的节点
+     * Setup较慢（如首次执行某个形状）时减少device在节点之间等待host的时间；
+     * 开启后同一context上不同节点的Setup与Execute会在两个线程上同时调用。
+     * 仅在仿真后端（USE_SIM_BACKEND）上可以开启：atb::Context不保证多线程同时使用是安全的，
+     * 而operation的Execute必须使用Setup时的context，不能简单地给准备线程另建context；
+     * 未定义USE_SIM_BACKEND时拒绝开启并记录错误，保持串行执行
+     * InitResource之后调用，默认为false
+     * @param enable 是否开启
+     * @return 设置是否生效，非仿真后端上请求开启时为false
+     */
+    bool SetHostPipeline(bool enable);
+
+    /**
+     * 把激活输入绑定到调用方持有的缓冲区，CreateModelInput之后调用，之后每次Execute都使用该缓冲区
+     * DEVICE：缓冲区直接作为输入张量的地址，换请求时用新地址重新绑定，不分配也不拷贝
+     * HOST：缓冲区需为锁页内存，Execute开始时异步拷贝到模型的device缓冲区
+     * 权重由WeightStore共享或流式绑定，不能通过BindInput绑定
+     * @param inTensorId 输入张量ID
+     * @param data 缓冲区地址，由调用方持有和释放
+     * @param dataSize 缓冲区字节数，不能小于输入张量的大小
+     * @param location 缓冲区位置
+     * @return 绑定是否成功，失败时保持原有绑定
+     */
+    bool BindInput(size_t inTensorId, void *data, uint64_t dataSize, BufferLocation location);
+
+    /**
+     * 把输出张量绑定到调用方持有的缓冲区，CreateModelOutput之后调用，之后每次Execute都写入该缓冲区
+     * DEVICE：算子直接写调用方的device内存；HOST：缓冲区需为锁页内存，Execute结束前从模型的device缓冲区拷贝回来
+     * @param outTensorId 输出张量ID
+     * @param data 缓冲区地址，由调用方持有和释放
+     * @param dataSize 缓冲区字节数，不能小于输出张量的大小
+     * @param location 缓冲区位置
+     * @return 绑定是否成功，失败时保持原有绑定
+     */
+    bool BindOutput(size_t outTensorId, void *data, uint64_t dataSize, BufferLocation location);
+
+    /**
+     * 获取模型的计算流
+     */
+    aclrtStream GetStream() const;
+
     // 模型的输入张量集合
     atb::SVector<atb::Tensor> model_inTensors_;
 
@@ -147,9 +303,26 @@ private:
      * @param nodeId 节点ID
      */
     void BuildNodeVariantPack(int nodeId);
+
+    /**
+     * 把绑定的host输入拷贝到输入张量，与计算在同一个stream上排队
+     */
+    void CopyInBindings();
+
+    /**
+     * 把输出张量拷贝到绑定的host缓冲区，与计算在同一个stream上排队
+     */
+    void CopyOutBindings();
     
     /**
-     * 执行单个节点
+     * 准备单个节点：调用Setup并分配workspace，BuildNodeVariantPack之后调用
+     * @param nodeId 节点ID
+     * @return 准备状态，失败时记录日志并返回，不退出进程（可能在准备线程上调用）
+     */
+    atb::Status SetupNode(int nodeId);
+
+    /**
+     * 执行单个节点，把SetupNode准备好的节点下发到stream
      * @param nodeId 节点ID
      * @return 执行状态
      */
@@ -173,6 +346,38 @@ private:
     atb::Status InferShape(
         const atb::SVector<atb::TensorDesc> &inTensorDescs, atb::SVector<atb::TensorDesc> &outTensorDescs);
 
+    /**
+     * 按量化方式修改权重的tensor描述
+     * @param inTensorDescs fp16的输入张量描述
+     */
+    void SetQuantTensorDescs(atb::SVector<atb::TensorDesc> &inTensorDescs) const;
+
+    /**
+     * 按存储布局修改Linear权重的tensor描述
+     * @param inTensorDescs ND的输入张量描述
+     */
+    void SetWeightLayoutDesc(atb::SVector<atb::TensorDesc> &inTensorDescs) const;
+
+    /**
+     * 获取权重在WeightStore中的名称，量化后的Linear权重带量化方式前缀
+     * @param inTensorId 输入张量ID
+     */
+    std::string GetWeightName(size_t inTensorId) const;
+
+    /**
+     * 获取不带种子前缀的权重名称
+     * @param inTensorId 输入张量ID
+     */
+    std::string GetUnseededWeightName(size_t inTensorId) const;
+
+    /**
+     * 在host内存中填充一个权重张量
+     * @param inTensorId 输入张量ID
+     * @param hostData host内存
+     * @param dataSize 字节数
+     */
+    void FillWeightTensor(size_t inTensorId, void *hostData, uint64_t dataSize) const;
+
     std::string modelName_;                    // 模型名称
     uint32_t deviceId_ = 1;                   // 设备ID，默认为1
     atb::Context *mode_context_ = nullptr;    // 模型上下文，管理计算资源
@@ -182,6 +387,19 @@ private:
     // 模型的中间张量，用于连接不同层之间的数据流
     // 注意：中间张量的顺序很重要，需要保持正确的数据流
     std::vector<atb::Tensor> internalTensors_;
+
+    std::vector<TensorBinding> inBindings_;   // 输入张量与调用方缓冲区的绑定，按InTensorId索引，权重不绑定
+    std::vector<TensorBinding> outBindings_;  // 输出张量与调用方缓冲区的绑定，按OutTensorId索引
+
+    NodeMetrics nodeMetrics_;                 // Execute和各节点的耗时指标
+    NodePrepPipeline prepPipeline_;           // 提前准备节点的线程
+    bool hostPipeline_ = false;               // 是否用准备线程提前准备节点
+
+    bool streamWeights_ = false;              // 是否流式加载权重
+    uint32_t weightSeed_ = 0;                 // 权重的随机种子，0表示全2.0
+    LinearQuantType quantType_ = LinearQuantType::FP16; // Linear的权重量化方式
+    WeightLayout weightLayout_ = WeightLayout::ND;       // Linear权重的存储布局
+    uint32_t batchSize_ = 1;                             // batch大小
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "utils/dtype_convert.h"
+#include "utils/log.h"
+#include "utils/weight_quant.h"
+
+// 离线权重量化工具：fp16权重文件 -> int8权重 + fp16 per-channel scale，并与fp16 CPU参考比较精度
+// 用法：
+//   quantize_weights                                  对合成权重做自检（768x2304以及MLP的768x3072、3072x768）
+//   quantize_weights <fp16.bin> <k> <n> <outPrefix>   量化[k, n]的fp16权重，输出<outPrefix>.int8.bin和<outPrefix>.scale.bin
+constexpr int64_t CHECK_ROWS = 32;                // 精度检查使用的激活行数
+constexpr double W8A16_MIN_COSINE = 0.999;
+constexpr double W8A8_MIN_COSINE = 0.99;
+constexpr float SYNTHETIC_WEIGHT_STD = 0.02f;
+
+static bool ReadFile(const std::string &path, std::vector<uint16_t> &data, size_t count)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    data.resize(count);
+    file.read(reinterpret_cast<char *>(data.data()), count * sizeof(uint16_t));
+    return static_cast<size_t>(file.gcount()) == count * sizeof(uint16_t);
+}
+
+static bool WriteFile(const std::string &path, const void *data, size_t bytes)
+{
+    std::ofstream file(path, std::ios::binary);
+    file.write(static_cast<const char *>(data), bytes);
+    return static_cast<bool>(file);
+}
+
+static std::vector<uint16_t> RandomFp16(size_t count, float stddev, std::mt19937 &gen)
+{
+    std::normal_distribution<float> dist(0.0f, stddev);
+    std::vector<uint16_t> values(count);
+    for (auto &value : values) {
+        value = FloatToFp16(dist(gen));
+    }
+    return values;
+}
+
+// 用随机激活比较fp16参考与W8A16、W8A8的输出，返回是否满足精度要求
+static bool CheckAccuracy(const std::string &name, const std::vector<uint16_t> &weight, const QuantizedWeight &quant,
+                          std::mt19937 &gen)
+{
+    int64_t k = quant.k;
+    int64_t n = quant.n;
+    std::vector<uint16_t> x = RandomFp16(CHECK_ROWS * k, 1.0f, gen); // LayerNorm之后的激活近似标准正态
+    std::vector<uint16_t> bias = RandomFp16(n, SYNTHETIC_WEIGHT_STD, gen);
+    float absMax = 0;
+    for (auto value : x) {
+        absMax = std::max(absMax, std::fabs(Fp16ToFloat(value)));
+    }
+    float actScale = ActivationScale(absMax);
+
+    std::vector<float> reference(CHECK_ROWS * n);
+    std::vector<float> w8a16(CHECK_ROWS * n);
+    std::vector<float> w8a8(CHECK_ROWS * n);
+    ReferenceLinearFp16(x.data(), weight.data(), bias.data(), reference.data(), CHECK_ROWS, k, n);
+    ReferenceLinearW8A16(x.data(), quant, bias.data(), w8a16.data(), CHECK_ROWS);
+    ReferenceLinearW8A8(x.data(), actScale, quant, bias.data(), w8a8.data(), CHECK_ROWS);
+
+    QuantAccuracy a16 = CompareOutputs(reference.data(), w8a16.data(), CHECK_ROWS * n);
+    QuantAccuracy a8 = CompareOutputs(reference.data(), w8a8.data(), CHECK_ROWS * n);
+    LOG_ERROR(name + " [" + std::to_string(k) + ", " + std::to_string(n) + "] fp16 bytes " +
+              std::to_string(k * n * sizeof(uint16_t)) + ", int8 + scale bytes " +
+              std::to_string(k * n + n * sizeof(uint16_t)));
+    LOG_ERROR(name + " W8A16 cosine " + std::to_string(a16.cosineSimilarity) + ", max abs error " +
+              std::to_string(a16.maxAbsError) + ", mean abs error " + std::to_string(a16.meanAbsError));
+    LOG_ERROR(name + " W8A8 cosine " + std::to_string(a8.cosineSimilarity) + ", max abs error " +
+              std::to_string(a8.maxAbsError) + ", mean abs error " + std::to_string(a8.meanAbsError) +
+              ", activation scale " + std::to_string(actScale));
+    return a16.cosineSimilarity >= W8A16_MIN_COSINE && a8.cosineSimilarity >= W8A8_MIN_COSINE;
+}
+
+static int SelfCheck()
+{
+    std::mt19937 gen(2024);
+    const std::vector<std::pair<int64_t, int64_t>> shapes = {{768, 2304}, {768, 3072}, {3072, 768}};
+    bool passed = true;
+    for (const auto &shape : shapes) {
+        std::vector<uint16_t> weight = RandomFp16(shape.first * shape.second, SYNTHETIC_WEIGHT_STD, gen);
+        QuantizedWeight quant = QuantizePerChannel(weight.data(), shape.first, shape.second);
+        passed = CheckAccuracy("synthetic", weight, quant, gen) && passed;
+    }
+    LOG_ERROR(std::string("self check ") + (passed ? "passed" : "failed"));
+    return passed ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 1) {
+        return SelfCheck();
+    }
+    if (argc != 5) {
+        LOG_ERROR("usage: quantize_weights [<fp16.bin> <k> <n> <outPrefix>]");
+        return 1;
+    }
+    std::string input = argv[1];
+    int64_t k = std::stoll(argv[2]);
+    int64_t n = std::stoll(argv[3]);
+    std::string outPrefix = argv[4];
+
+    std::vector<uint16_t> weight;
+    if (!ReadFile(input, weight, static_cast<size_t>(k * n))) {
+        LOG_ERROR("read " + input + " failed, expect " + std::to_string(k * n) + " fp16 values");
+        return 1;
+    }
+    QuantizedWeight quant = QuantizePerChannel(weight.data(), k, n);
+
+    // W8A16的antiquantScale与激活同为fp16
+    std::vector<uint16_t> scales(n);
+    for (int64_t i = 0; i < n; i++) {
+        scales[i] = FloatToFp16(quant.scales[i]);
+    }
+    if (!WriteFile(outPrefix + ".int8.bin", quant.data.data(), quant.data.size()) ||
+        !WriteFile(outPrefix + ".scale.bin", scales.data(), scales.size() * sizeof(uint16_t))) {
+        LOG_ERROR("write " + outPrefix + " failed");
+        return 1;
+    }
+
+    std::mt19937 gen(2024);
+    bool passed = CheckAccuracy(input, weight, quant, gen);
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+#include <atomic>
+#include <cmath>
+#include <vector>
+#include "reference/cpu_kernels.h"
+#include "reference/cpu_kernels_internal.h"
+#include "utils/tensor_convert.h"
+
+float ScalarGelu(float x, int64_t approximate)
+{
+    if (approximate == 1) {
+        float inner = GELU_SQRT_2_OVER_PI * (x + GELU_KAPPA * x * x * x);
+        return 0.5f * x * (1.0f + std::tanh(inner));
+    }
+    return 0.5f * x * (1.0f + std::erf(x * GELU_INV_SQRT_2));
+}
+
+void ScalarLinearTile(const float *x, int64_t ldx, const float *weight, int64_t ldw, float *y, int64_t ldy, int64_t mr,
+                      int64_t nr, int64_t kc)
+{
+    for (int64_t i = 0; i < mr; i++) {
+        for (int64_t p = 0; p < kc; p++) {
+            float a = x[i * ldx + p];
+            const float *w = weight + p * ldw;
+            float *out = y + i * ldy;
+            for (int64_t j = 0; j < nr; j++) {
+                out[j] += a * w[j];
+            }
+        }
+    }
+}
+
+// 标量实现即朴素循环，同时作为基准测试中的对照
+static void ScalarLayerNorm(const float *x, const float *gamma, const float *beta, float *y, int64_t rows,
+                            int64_t cols, float epsilon)
+{
+    for (int64_t r = 0; r < rows; r++) {
+        const float *in = x + r * cols;
+        float *out = y + r * cols;
+        float mean = 0;
+        for (int64_t c = 0; c < cols; c++) {
+            mean += in[c];
+        }
+        mean /= cols;
+        float variance = 0;
+        for (int64_t c = 0; c < cols; c++) {
+            variance += (in[c] - mean) * (in[c] - mean);
+        }
+        variance /= cols;
+        float rstd = 1.0f / std::sqrt(variance + epsilon);
+        for (int64_t c = 0; c < cols; c++) {
+            out[c] = (in[c] - mean) * rstd * gamma[c] + beta[c];
+        }
+    }
+}
+
+static void ScalarLinear(const float *x, const float *weight, const float *bias, float *y, int64_t m, int64_t k,
+                         int64_t n, bool transposeB)
+{
+    for (int64_t i = 0; i < m; i++) {
+        for (int64_t j = 0; j < n; j++) {
+            y[i * n + j] = bias == nullptr ? 0.0f : bias[j];
+        }
+    }
+    if (transposeB) {
+        for (int64_t i = 0; i < m; i++) {
+            for (int64_t j = 0; j < n; j++) {
+                float sum = 0;
+                for (int64_t p = 0; p < k; p++) {
+                    sum += x[i * k + p] * weight[j * k + p];
+                }
+                y[i * n + j] += sum;
+            }
+        }
+        return;
+    }
+    ScalarLinearTile(x, k, weight, n, y, n, m, n, k);
+}
+
+static void ScalarGeluKernel(const float *x, float *y, int64_t count, int64_t approximate)
+{
+    for (int64_t i = 0; i < count; i++) {
+        y[i] = ScalarGelu(x[i], approximate);
+    }
+}
+
+const CpuKernelTable &GetScalarKernels()
+{
+    static const CpuKernelTable table = {ScalarLayerNorm, ScalarLinear, ScalarGeluKernel};
+    return table;
+}
+
+static CpuIsa DetectCpuIsa()
+{
+#ifdef CPU_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return CpuIsa::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return CpuIsa::AVX2;
+    }
+#endif
+    return CpuIsa::SCALAR;
+}
+
+static const CpuKernelTable &GetKernelTable(CpuIsa isa)
+{
+#ifdef CPU_KERNELS_X86
+    if (isa == CpuIsa::AVX512) {
+        return GetAvx512Kernels();
+    }
+    if (isa == CpuIsa::AVX2) {
+        return GetAvx2Kernels();
+    }
+#endif
+    return GetScalarKernels();
+}
+
+static std::atomic<CpuIsa> g_cpuIsa{GetSupportedCpuIsa()};
+
+CpuIsa GetSupportedCpuIsa()
+{
+    static const CpuIsa supported = DetectCpuIsa();
+    return supported;
+}
+
+CpuIsa GetCpuIsa()
+{
+    return g_cpuIsa.load(std::memory_order_relaxed);
+}
+
+void SetCpuIsa(CpuIsa isa)
+{
+    CpuIsa supported = GetSupportedCpuIsa();
+    g_cpuIsa.store(static_cast<int>(isa) > static_cast<int>(supported) ? supported : isa, std::memory_order_relaxed);
+}
+
+const char *GetCpuIsaName(CpuIsa isa)
+{
+    switch (isa) {
+        case CpuIsa::AVX512:
+            return "avx512";
+        case CpuIsa::AVX2:
+            return "avx2";
+        default:
+            return "scalar";
+    }
+}
+
+void CpuLayerNorm(const float *x, const float *gamma, const float *beta, float *y, int64_t rows, int64_t cols,
+                  float epsilon)
+{
+    GetKernelTable(GetCpuIsa()).layerNorm(x, gamma, beta, y, rows, cols, epsilon);
+}
+
+void CpuLinear(const float *x, const float *weight, const float *bias, float *y, int64_t m, int64_t k, int64_t n,
+               bool transposeB)
+{
+    GetKernelTable(GetCpuIsa()).linear(x, weight, bias, y, m, k, n, transposeB);
+}
+
+void CpuGelu(const float *x, float *y, int64_t count, int64_t approximate)
+{
+    GetKernelTable(GetCpuIsa()).gelu(x, y, count, approximate);
+}
+
+static std::vector<float> ToFloat(const uint16_t *data, int64_t count)
+{
+    std::vector<float> result(count);
+    ConvertFp16ToFloat(data, result.data(), count);
+    return result;
+}
+
+static void ToFp16(const std::vector<float> &data, uint16_t *result)
+{
+    ConvertFloatToFp16(data.data(), result, static_cast<int64_t>(data.size()));
+}
+
+void CpuLayerNormFp16(const uint16_t *x, const uint16_t *gamma, const uint16_t *beta, uint16_t *y, int64_t rows,
+                      int64_t cols, float epsilon)
+{
+    std::vector<float> xFloat = ToFloat(x, rows * cols);
+    std::vector<float> gammaFloat = ToFloat(gamma, cols);
+    std::vector<float> betaFloat = ToFloat(beta, cols);
+    std::vector<float> yFloat(rows * cols);
+    CpuLayerNorm(xFloat.data(), gammaFloat.data(), betaFloat.data(), yFloat.data(), rows, cols, epsilon);
+    ToFp16(yFloat, y);
+}
+
+void CpuLinearFp16(const uint16_t *x, const uint16_t *weight, const uint16_t *bias, uint16_t *y, int64_t m, int64_t k,
+                   int64_t n, bool transposeB)
+{
+    std::vector<float> xFloat = ToFloat(x, m * k);
+    std::vector<float> weightFloat = ToFloat(weight, k * n);
+    std::vector<float> biasFloat;
+    if (bias != nullptr) {
+        biasFloat = ToFloat(bias, n);
+    }
+    std::vector<float> yFloat(m * n);
+    CpuLinear(xFloat.data(), weightFloat.data(), bias == nullptr ? nullptr : biasFloat.data(), yFloat.data(), m, k, n,
+              transposeB);
+    ToFp16(yFloat, y);
+}
+
+void CpuGeluFp16(const uint16_t *x, uint16_t *y, int64_t count, int64_t approximate)
+{
+    std::vector<float> xFloat = ToFloat(x, count);
+    std::vector<float> yFloat(count);
+    CpuGelu(xFloat.data(), yFloat.data(), count, approximate);
+    ToFp16(yFloat, y);
+}
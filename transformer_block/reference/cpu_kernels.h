@@ -0,0 +1,63 @@
+#ifndef CPU_KERNELS_H
+#define CPU_KERNELS_H
+
+#include <cstdint>
+
+/**
+ * host侧参考kernel，用于校验device输出，也可以作为没有device时的回退实现
+ * 计算以float进行，fp16接口在输入输出时转换；x86上按CPU支持的指令集在运行时选择AVX-512/AVX2实现，
+ * 其他平台只有标量实现
+ */
+enum class CpuIsa
+{
+    SCALAR = 0,
+    AVX2,   // AVX2 + FMA
+    AVX512, // AVX-512F
+};
+
+/**
+ * 获取CPU和编译同时支持的最高指令集
+ */
+CpuIsa GetSupportedCpuIsa();
+
+/**
+ * 获取当前使用的指令集，默认为GetSupportedCpuIsa()
+ */
+CpuIsa GetCpuIsa();
+
+/**
+ * 指定使用的指令集，超过支持范围时降为支持的最高指令集
+ */
+void SetCpuIsa(CpuIsa isa);
+
+const char *GetCpuIsaName(CpuIsa isa);
+
+/**
+ * LayerNorm，与LayerNormParam的LAYER_NORM_NORM一致
+ * @param rows beginNormAxis之前各维的乘积
+ * @param cols beginNormAxis及之后各维的乘积，gamma/beta为[cols]
+ */
+void CpuLayerNorm(const float *x, const float *gamma, const float *beta, float *y, int64_t rows, int64_t cols,
+                  float epsilon);
+
+/**
+ * Linear，与LinearParam一致：y[m, n] = x[m, k] @ w + bias[n]
+ * @param weight transposeB为false时为[k, n]，为true时为[n, k]
+ * @param bias 可以为空
+ */
+void CpuLinear(const float *x, const float *weight, const float *bias, float *y, int64_t m, int64_t k, int64_t n,
+               bool transposeB);
+
+/**
+ * Gelu，approximate与AclnnGeluParam::geluApproximate一致：1为tanh近似，0和-1为erf精确计算
+ */
+void CpuGelu(const float *x, float *y, int64_t count, int64_t approximate);
+
+// fp16输入输出的版本，中间以float计算
+void CpuLayerNormFp16(const uint16_t *x, const uint16_t *gamma, const uint16_t *beta, uint16_t *y, int64_t rows,
+                      int64_t cols, float epsilon);
+void CpuLinearFp16(const uint16_t *x, const uint16_t *weight, const uint16_t *bias, uint16_t *y, int64_t m, int64_t k,
+                   int64_t n, bool transposeB);
+void CpuGeluFp16(const uint16_t *x, uint16_t *y, int64_t count, int64_t approximate);
+
+#endif
@@ -0,0 +1,234 @@
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include "reference/cpu_kernels_internal.h"
+
+// AVX2 + FMA实现，本文件单独以-mavx2 -mfma编译，只在CPU支持时经由kernel表调用
+constexpr int64_t AVX2_LANES = 8;
+constexpr int64_t AVX2_TILE_N = 2 * AVX2_LANES;
+
+static inline float HorizontalSum(__m256 v)
+{
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+    return _mm_cvtss_f32(sum);
+}
+
+static inline __m256 Exp(__m256 x)
+{
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(EXP_MIN_INPUT)), _mm256_set1_ps(EXP_MAX_INPUT));
+    // exp(x) = 2^n * exp(r)，r = x - n * ln2
+    __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(EXP_LOG2E)),
+                               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(EXP_LN2_HI), x);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(EXP_LN2_LO), r);
+    __m256 p = _mm256_set1_ps(EXP_P0);
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P1));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P2));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P3));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P4));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P5));
+    p = _mm256_fmadd_ps(p, _mm256_mul_ps(r, r), _mm256_add_ps(r, _mm256_set1_ps(1.0f)));
+    __m256i exponent = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+    return _mm256_mul_ps(p, _mm256_castsi256_ps(exponent));
+}
+
+// tanh(x) = 1 - 2 / (exp(2x) + 1)
+static inline __m256 Tanh(__m256 x)
+{
+    __m256 e = Exp(_mm256_add_ps(x, x));
+    __m256 one = _mm256_set1_ps(1.0f);
+    return _mm256_sub_ps(one, _mm256_div_ps(_mm256_set1_ps(2.0f), _mm256_add_ps(e, one)));
+}
+
+static inline __m256 Erf(__m256 x)
+{
+    __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 sign = _mm256_and_ps(x, signMask);
+    __m256 a = _mm256_andnot_ps(signMask, x);
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 t = _mm256_div_ps(one, _mm256_fmadd_ps(_mm256_set1_ps(ERF_P), a, one));
+    __m256 p = _mm256_set1_ps(ERF_A5);
+    p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(ERF_A4));
+    p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(ERF_A3));
+    p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(ERF_A2));
+    p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(ERF_A1));
+    p = _mm256_mul_ps(p, t);
+    __m256 e = Exp(_mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(a, a)));
+    __m256 result = _mm256_fnmadd_ps(p, e, one);
+    return _mm256_or_ps(result, sign);
+}
+
+static void Avx2LayerNorm(const float *x, const float *gamma, const float *beta, float *y, int64_t rows, int64_t cols,
+                          float epsilon)
+{
+    int64_t vecCols = cols - cols % AVX2_LANES;
+    for (int64_t r = 0; r < rows; r++) {
+        const float *in = x + r * cols;
+        float *out = y + r * cols;
+        __m256 sumVec = _mm256_setzero_ps();
+        for (int64_t c = 0; c < vecCols; c += AVX2_LANES) {
+            sumVec = _mm256_add_ps(sumVec, _mm256_loadu_ps(in + c));
+        }
+        float sum = HorizontalSum(sumVec);
+        for (int64_t c = vecCols; c < cols; c++) {
+            sum += in[c];
+        }
+        float mean = sum / cols;
+
+        __m256 meanVec = _mm256_set1_ps(mean);
+        __m256 varVec = _mm256_setzero_ps();
+        for (int64_t c = 0; c < vecCols; c += AVX2_LANES) {
+            __m256 d = _mm256_sub_ps(_mm256_loadu_ps(in + c), meanVec);
+            varVec = _mm256_fmadd_ps(d, d, varVec);
+        }
+        float variance = HorizontalSum(varVec);
+        for (int64_t c = vecCols; c < cols; c++) {
+            variance += (in[c] - mean) * (in[c] - mean);
+        }
+        variance /= cols;
+        float rstd = 1.0f / std::sqrt(variance + epsilon);
+
+        __m256 rstdVec = _mm256_set1_ps(rstd);
+        for (int64_t c = 0; c < vecCols; c += AVX2_LANES) {
+            __m256 norm = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(in + c), meanVec), rstdVec);
+            _mm256_storeu_ps(out + c, _mm256_fmadd_ps(norm, _mm256_loadu_ps(gamma + c), _mm256_loadu_ps(beta + c)));
+        }
+        for (int64_t c = vecCols; c < cols; c++) {
+            out[c] = (in[c] - mean) * rstd * gamma[c] + beta[c];
+        }
+    }
+}
+
+// y[4, 16] += x[4, kc] @ w[kc, 16]，累加结果保存在8个寄存器中
+static void Avx2LinearTile4x16(const float *x, int64_t ldx, const float *weight, int64_t ldw, float *y, int64_t ldy,
+                               int64_t kc)
+{
+    __m256 acc[LINEAR_TILE_M][2];
+    for (int64_t i = 0; i < LINEAR_TILE_M; i++) {
+        acc[i][0] = _mm256_loadu_ps(y + i * ldy);
+        acc[i][1] = _mm256_loadu_ps(y + i * ldy + AVX2_LANES);
+    }
+    for (int64_t p = 0; p < kc; p++) {
+        __m256 w0 = _mm256_loadu_ps(weight + p * ldw);
+        __m256 w1 = _mm256_loadu_ps(weight + p * ldw + AVX2_LANES);
+        for (int64_t i = 0; i < LINEAR_TILE_M; i++) {
+            __m256 a = _mm256_broadcast_ss(x + i * ldx + p);
+            acc[i][0] = _mm256_fmadd_ps(a, w0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_ps(a, w1, acc[i][1]);
+        }
+    }
+    for (int64_t i = 0; i < LINEAR_TILE_M; i++) {
+        _mm256_storeu_ps(y + i * ldy, acc[i][0]);
+        _mm256_storeu_ps(y + i * ldy + AVX2_LANES, acc[i][1]);
+    }
+}
+
+// transposeB时weight为[n, k]，每个输出是x的一行与weight的一行的点积，一次计算4个输出
+static void Avx2LinearTransposed(const float *x, const float *weight, float *y, int64_t m, int64_t k, int64_t n)
+{
+    int64_t vecK = k - k % AVX2_LANES;
+    for (int64_t i = 0; i < m; i++) {
+        const float *row = x + i * k;
+        int64_t j = 0;
+        for (; j + 4 <= n; j += 4) {
+            const float *w = weight + j * k;
+            __m256 acc0 = _mm256_setzero_ps();
+            __m256 acc1 = _mm256_setzero_ps();
+            __m256 acc2 = _mm256_setzero_ps();
+            __m256 acc3 = _mm256_setzero_ps();
+            for (int64_t p = 0; p < vecK; p += AVX2_LANES) {
+                __m256 a = _mm256_loadu_ps(row + p);
+                acc0 = _mm256_fmadd_ps(a, _mm256_loadu_ps(w + p), acc0);
+                acc1 = _mm256_fmadd_ps(a, _mm256_loadu_ps(w + k + p), acc1);
+                acc2 = _mm256_fmadd_ps(a, _mm256_loadu_ps(w + 2 * k + p), acc2);
+                acc3 = _mm256_fmadd_ps(a, _mm256_loadu_ps(w + 3 * k + p), acc3);
+            }
+            float sum[4] = {HorizontalSum(acc0), HorizontalSum(acc1), HorizontalSum(acc2), HorizontalSum(acc3)};
+            for (int64_t p = vecK; p < k; p++) {
+                for (int64_t jj = 0; jj < 4; jj++) {
+                    sum[jj] += row[p] * w[jj * k + p];
+                }
+            }
+            for (int64_t jj = 0; jj < 4; jj++) {
+                y[i * n + j + jj] += sum[jj];
+            }
+        }
+        for (; j < n; j++) {
+            const float *w = weight + j * k;
+            __m256 acc = _mm256_setzero_ps();
+            for (int64_t p = 0; p < vecK; p += AVX2_LANES) {
+                acc = _mm256_fmadd_ps(_mm256_loadu_ps(row + p), _mm256_loadu_ps(w + p), acc);
+            }
+            float sum = HorizontalSum(acc);
+            for (int64_t p = vecK; p < k; p++) {
+                sum += row[p] * w[p];
+            }
+            y[i * n + j] += sum;
+        }
+    }
+}
+
+static void Avx2Linear(const float *x, const float *weight, const float *bias, float *y, int64_t m, int64_t k,
+                       int64_t n, bool transposeB)
+{
+    for (int64_t i = 0; i < m; i++) {
+        for (int64_t j = 0; j < n; j++) {
+            y[i * n + j] = bias == nullptr ? 0.0f : bias[j];
+        }
+    }
+    if (transposeB) {
+        Avx2LinearTransposed(x, weight, y, m, k, n);
+        return;
+    }
+    // 按[KC, NC]切分weight，块内以4x16为单位累加，不足一个tile的边缘走标量
+    for (int64_t jc = 0; jc < n; jc += LINEAR_BLOCK_N) {
+        int64_t nc = std::min(LINEAR_BLOCK_N, n - jc);
+        for (int64_t pc = 0; pc < k; pc += LINEAR_BLOCK_K) {
+            int64_t kc = std::min(LINEAR_BLOCK_K, k - pc);
+            for (int64_t i = 0; i < m; i += LINEAR_TILE_M) {
+                int64_t mr = std::min(LINEAR_TILE_M, m - i);
+                for (int64_t j = jc; j < jc + nc; j += AVX2_TILE_N) {
+                    int64_t nr = std::min(AVX2_TILE_N, jc + nc - j);
+                    const float *xTile = x + i * k + pc;
+                    const float *wTile = weight + pc * n + j;
+                    float *yTile = y + i * n + j;
+                    if (mr == LINEAR_TILE_M && nr == AVX2_TILE_N) {
+                        Avx2LinearTile4x16(xTile, k, wTile, n, yTile, n, kc);
+                    } else {
+                        ScalarLinearTile(xTile, k, wTile, n, yTile, n, mr, nr, kc);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void Avx2Gelu(const float *x, float *y, int64_t count, int64_t approximate)
+{
+    int64_t vecCount = count - count % AVX2_LANES;
+    __m256 half = _mm256_set1_ps(0.5f);
+    __m256 one = _mm256_set1_ps(1.0f);
+    for (int64_t i = 0; i < vecCount; i += AVX2_LANES) {
+        __m256 v = _mm256_loadu_ps(x + i);
+        __m256 t;
+        if (approximate == 1) {
+            __m256 cube = _mm256_mul_ps(_mm256_mul_ps(v, v), v);
+            __m256 inner = _mm256_fmadd_ps(_mm256_set1_ps(GELU_KAPPA), cube, v);
+            t = Tanh(_mm256_mul_ps(_mm256_set1_ps(GELU_SQRT_2_OVER_PI), inner));
+        } else {
+            t = Erf(_mm256_mul_ps(v, _mm256_set1_ps(GELU_INV_SQRT_2)));
+        }
+        _mm256_storeu_ps(y + i, _mm256_mul_ps(_mm256_mul_ps(half, v), _mm256_add_ps(one, t)));
+    }
+    for (int64_t i = vecCount; i < count; i++) {
+        y[i] = ScalarGelu(x[i], approximate);
+    }
+}
+
+const CpuKernelTable &GetAvx2Kernels()
+{
+    static const CpuKernelTable table = {Avx2LayerNorm, Avx2Linear, Avx2Gelu};
+    return table;
+}
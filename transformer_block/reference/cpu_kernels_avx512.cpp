@@ -0,0 +1,213 @@
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include "reference/cpu_kernels_internal.h"
+
+// AVX-512F实现，本文件单独以-mavx512f -mfma编译，只在CPU支持时经由kernel表调用，尾部用掩码处理
+constexpr int64_t AVX512_LANES = 16;
+constexpr int64_t AVX512_TILE_N = 2 * AVX512_LANES;
+
+static inline __mmask16 TailMask(int64_t remain)
+{
+    return remain >= AVX512_LANES ? static_cast<__mmask16>(0xffff) : static_cast<__mmask16>((1u << remain) - 1);
+}
+
+static inline __m512 Exp(__m512 x)
+{
+    x = _mm512_min_ps(_mm512_max_ps(x, _mm512_set1_ps(EXP_MIN_INPUT)), _mm512_set1_ps(EXP_MAX_INPUT));
+    // exp(x) = 2^n * exp(r)，r = x - n * ln2
+    __m512 n = _mm512_roundscale_ps(_mm512_mul_ps(x, _mm512_set1_ps(EXP_LOG2E)),
+                                    _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512 r = _mm512_fnmadd_ps(n, _mm512_set1_ps(EXP_LN2_HI), x);
+    r = _mm512_fnmadd_ps(n, _mm512_set1_ps(EXP_LN2_LO), r);
+    __m512 p = _mm512_set1_ps(EXP_P0);
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P1));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P2));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P3));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P4));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P5));
+    p = _mm512_fmadd_ps(p, _mm512_mul_ps(r, r), _mm512_add_ps(r, _mm512_set1_ps(1.0f)));
+    return _mm512_scalef_ps(p, n);
+}
+
+// tanh(x) = 1 - 2 / (exp(2x) + 1)
+static inline __m512 Tanh(__m512 x)
+{
+    __m512 e = Exp(_mm512_add_ps(x, x));
+    __m512 one = _mm512_set1_ps(1.0f);
+    return _mm512_sub_ps(one, _mm512_div_ps(_mm512_set1_ps(2.0f), _mm512_add_ps(e, one)));
+}
+
+static inline __m512 Erf(__m512 x)
+{
+    __m512i signMask = _mm512_set1_epi32(static_cast<int>(0x80000000u));
+    __m512i bits = _mm512_castps_si512(x);
+    __m512i sign = _mm512_and_si512(bits, signMask);
+    __m512 a = _mm512_castsi512_ps(_mm512_andnot_si512(signMask, bits));
+    __m512 one = _mm512_set1_ps(1.0f);
+    __m512 t = _mm512_div_ps(one, _mm512_fmadd_ps(_mm512_set1_ps(ERF_P), a, one));
+    __m512 p = _mm512_set1_ps(ERF_A5);
+    p = _mm512_fmadd_ps(p, t, _mm512_set1_ps(ERF_A4));
+    p = _mm512_fmadd_ps(p, t, _mm512_set1_ps(ERF_A3));
+    p = _mm512_fmadd_ps(p, t, _mm512_set1_ps(ERF_A2));
+    p = _mm512_fmadd_ps(p, t, _mm512_set1_ps(ERF_A1));
+    p = _mm512_mul_ps(p, t);
+    __m512 e = Exp(_mm512_sub_ps(_mm512_setzero_ps(), _mm512_mul_ps(a, a)));
+    __m512 result = _mm512_fnmadd_ps(p, e, one);
+    return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(result), sign));
+}
+
+static void Avx512LayerNorm(const float *x, const float *gamma, const float *beta, float *y, int64_t rows,
+                            int64_t cols, float epsilon)
+{
+    for (int64_t r = 0; r < rows; r++) {
+        const float *in = x + r * cols;
+        float *out = y + r * cols;
+        __m512 sumVec = _mm512_setzero_ps();
+        for (int64_t c = 0; c < cols; c += AVX512_LANES) {
+            sumVec = _mm512_add_ps(sumVec, _mm512_maskz_loadu_ps(TailMask(cols - c), in + c));
+        }
+        float mean = _mm512_reduce_add_ps(sumVec) / cols;
+
+        __m512 meanVec = _mm512_set1_ps(mean);
+        __m512 varVec = _mm512_setzero_ps();
+        for (int64_t c = 0; c < cols; c += AVX512_LANES) {
+            __mmask16 mask = TailMask(cols - c);
+            __m512 d = _mm512_maskz_sub_ps(mask, _mm512_maskz_loadu_ps(mask, in + c), meanVec);
+            varVec = _mm512_fmadd_ps(d, d, varVec);
+        }
+        float variance = _mm512_reduce_add_ps(varVec) / cols;
+        __m512 rstdVec = _mm512_set1_ps(1.0f / std::sqrt(variance + epsilon));
+
+        for (int64_t c = 0; c < cols; c += AVX512_LANES) {
+            __mmask16 mask = TailMask(cols - c);
+            __m512 norm = _mm512_mul_ps(_mm512_sub_ps(_mm512_maskz_loadu_ps(mask, in + c), meanVec), rstdVec);
+            __m512 result =
+                _mm512_fmadd_ps(norm, _mm512_maskz_loadu_ps(mask, gamma + c), _mm512_maskz_loadu_ps(mask, beta + c));
+            _mm512_mask_storeu_ps(out + c, mask, result);
+        }
+    }
+}
+
+// y[4, 32] += x[4, kc] @ w[kc, 32]，nr不足32列时用掩码读写
+static void Avx512LinearTile(const float *x, int64_t ldx, const float *weight, int64_t ldw, float *y, int64_t ldy,
+                             int64_t nr, int64_t kc)
+{
+    __mmask16 mask0 = TailMask(nr);
+    __mmask16 mask1 = nr > AVX512_LANES ? TailMask(nr - AVX512_LANES) : 0;
+    __m512 acc[LINEAR_TILE_M][2];
+    for (int64_t i = 0; i < LINEAR_TILE_M; i++) {
+        acc[i][0] = _mm512_maskz_loadu_ps(mask0, y + i * ldy);
+        acc[i][1] = _mm512_maskz_loadu_ps(mask1, y + i * ldy + AVX512_LANES);
+    }
+    for (int64_t p = 0; p < kc; p++) {
+        __m512 w0 = _mm512_maskz_loadu_ps(mask0, weight + p * ldw);
+        __m512 w1 = _mm512_maskz_loadu_ps(mask1, weight + p * ldw + AVX512_LANES);
+        for (int64_t i = 0; i < LINEAR_TILE_M; i++) {
+            __m512 a = _mm512_set1_ps(x[i * ldx + p]);
+            acc[i][0] = _mm512_fmadd_ps(a, w0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_ps(a, w1, acc[i][1]);
+        }
+    }
+    for (int64_t i = 0; i < LINEAR_TILE_M; i++) {
+        _mm512_mask_storeu_ps(y + i * ldy, mask0, acc[i][0]);
+        _mm512_mask_storeu_ps(y + i * ldy + AVX512_LANES, mask1, acc[i][1]);
+    }
+}
+
+// transposeB时weight为[n, k]，每个输出是x的一行与weight的一行的点积，一次计算4个输出
+static void Avx512LinearTransposed(const float *x, const float *weight, float *y, int64_t m, int64_t k, int64_t n)
+{
+    for (int64_t i = 0; i < m; i++) {
+        const float *row = x + i * k;
+        int64_t j = 0;
+        for (; j + 4 <= n; j += 4) {
+            const float *w = weight + j * k;
+            __m512 acc0 = _mm512_setzero_ps();
+            __m512 acc1 = _mm512_setzero_ps();
+            __m512 acc2 = _mm512_setzero_ps();
+            __m512 acc3 = _mm512_setzero_ps();
+            for (int64_t p = 0; p < k; p += AVX512_LANES) {
+                __mmask16 mask = TailMask(k - p);
+                __m512 a = _mm512_maskz_loadu_ps(mask, row + p);
+                acc0 = _mm512_fmadd_ps(a, _mm512_maskz_loadu_ps(mask, w + p), acc0);
+                acc1 = _mm512_fmadd_ps(a, _mm512_maskz_loadu_ps(mask, w + k + p), acc1);
+                acc2 = _mm512_fmadd_ps(a, _mm512_maskz_loadu_ps(mask, w + 2 * k + p), acc2);
+                acc3 = _mm512_fmadd_ps(a, _mm512_maskz_loadu_ps(mask, w + 3 * k + p), acc3);
+            }
+            y[i * n + j] += _mm512_reduce_add_ps(acc0);
+            y[i * n + j + 1] += _mm512_reduce_add_ps(acc1);
+            y[i * n + j + 2] += _mm512_reduce_add_ps(acc2);
+            y[i * n + j + 3] += _mm512_reduce_add_ps(acc3);
+        }
+        for (; j < n; j++) {
+            const float *w = weight + j * k;
+            __m512 acc = _mm512_setzero_ps();
+            for (int64_t p = 0; p < k; p += AVX512_LANES) {
+                __mmask16 mask = TailMask(k - p);
+                acc = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, row + p), _mm512_maskz_loadu_ps(mask, w + p), acc);
+            }
+            y[i * n + j] += _mm512_reduce_add_ps(acc);
+        }
+    }
+}
+
+static void Avx512Linear(const float *x, const float *weight, const float *bias, float *y, int64_t m, int64_t k,
+                         int64_t n, bool transposeB)
+{
+    for (int64_t i = 0; i < m; i++) {
+        for (int64_t j = 0; j < n; j++) {
+            y[i * n + j] = bias == nullptr ? 0.0f : bias[j];
+        }
+    }
+    if (transposeB) {
+        Avx512LinearTransposed(x, weight, y, m, k, n);
+        return;
+    }
+    // 按[KC, NC]切分weight，块内以4x32为单位累加，列方向的边缘用掩码，不足4行的边缘走标量
+    for (int64_t jc = 0; jc < n; jc += LINEAR_BLOCK_N) {
+        int64_t nc = std::min(LINEAR_BLOCK_N, n - jc);
+        for (int64_t pc = 0; pc < k; pc += LINEAR_BLOCK_K) {
+            int64_t kc = std::min(LINEAR_BLOCK_K, k - pc);
+            for (int64_t i = 0; i < m; i += LINEAR_TILE_M) {
+                int64_t mr = std::min(LINEAR_TILE_M, m - i);
+                for (int64_t j = jc; j < jc + nc; j += AVX512_TILE_N) {
+                    int64_t nr = std::min(AVX512_TILE_N, jc + nc - j);
+                    const float *xTile = x + i * k + pc;
+                    const float *wTile = weight + pc * n + j;
+                    float *yTile = y + i * n + j;
+                    if (mr == LINEAR_TILE_M) {
+                        Avx512LinearTile(xTile, k, wTile, n, yTile, n, nr, kc);
+                    } else {
+                        ScalarLinearTile(xTile, k, wTile, n, yTile, n, mr, nr, kc);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void Avx512Gelu(const float *x, float *y, int64_t count, int64_t approximate)
+{
+    __m512 half = _mm512_set1_ps(0.5f);
+    __m512 one = _mm512_set1_ps(1.0f);
+    for (int64_t i = 0; i < count; i += AVX512_LANES) {
+        __mmask16 mask = TailMask(count - i);
+        __m512 v = _mm512_maskz_loadu_ps(mask, x + i);
+        __m512 t;
+        if (approximate == 1) {
+            __m512 cube = _mm512_mul_ps(_mm512_mul_ps(v, v), v);
+            __m512 inner = _mm512_fmadd_ps(_mm512_set1_ps(GELU_KAPPA), cube, v);
+            t = Tanh(_mm512_mul_ps(_mm512_set1_ps(GELU_SQRT_2_OVER_PI), inner));
+        } else {
+            t = Erf(_mm512_mul_ps(v, _mm512_set1_ps(GELU_INV_SQRT_2)));
+        }
+        _mm512_mask_storeu_ps(y + i, mask, _mm512_mul_ps(_mm512_mul_ps(half, v), _mm512_add_ps(one, t)));
+    }
+}
+
+const CpuKernelTable &GetAvx512Kernels()
+{
+    static const CpuKernelTable table = {Avx512LayerNorm, Avx512Linear, Avx512Gelu};
+    return table;
+}
@@ -0,0 +1,60 @@
+#ifndef CPU_KERNELS_INTERNAL_H
+#define CPU_KERNELS_INTERNAL_H
+
+#include <cstdint>
+
+// 各指令集实现的kernel表，由cpu_kernels.cpp在运行时选择
+struct CpuKernelTable
+{
+    void (*layerNorm)(const float *x, const float *gamma, const float *beta, float *y, int64_t rows, int64_t cols,
+                      float epsilon);
+    void (*linear)(const float *x, const float *weight, const float *bias, float *y, int64_t m, int64_t k, int64_t n,
+                   bool transposeB);
+    void (*gelu)(const float *x, float *y, int64_t count, int64_t approximate);
+};
+
+const CpuKernelTable &GetScalarKernels();
+#ifdef CPU_KERNELS_X86
+const CpuKernelTable &GetAvx2Kernels();
+const CpuKernelTable &GetAvx512Kernels();
+#endif
+
+// 向量实现处理尾部元素时使用的标量计算
+float ScalarGelu(float x, int64_t approximate);
+
+// 矩阵分块尾部的标量计算：y[mr, nr] += x[mr, kc] @ w[kc, nr]，各矩阵按行存储，ld为行跨度
+void ScalarLinearTile(const float *x, int64_t ldx, const float *weight, int64_t ldw, float *y, int64_t ldy, int64_t mr,
+                      int64_t nr, int64_t kc);
+
+// GELU常数
+constexpr float GELU_SQRT_2_OVER_PI = 0.7978845608028654f;
+constexpr float GELU_KAPPA = 0.044715f;
+constexpr float GELU_INV_SQRT_2 = 0.7071067811865476f;
+
+// erf的Abramowitz-Stegun 7.1.26近似，最大绝对误差1.5e-7
+constexpr float ERF_P = 0.3275911f;
+constexpr float ERF_A1 = 0.254829592f;
+constexpr float ERF_A2 = -0.284496736f;
+constexpr float ERF_A3 = 1.421413741f;
+constexpr float ERF_A4 = -1.453152027f;
+constexpr float ERF_A5 = 1.061405429f;
+
+// exp的Cephes多项式系数
+constexpr float EXP_MAX_INPUT = 88.3762626647949f;
+constexpr float EXP_MIN_INPUT = -88.3762626647949f;
+constexpr float EXP_LOG2E = 1.44269504088896341f;
+constexpr float EXP_LN2_HI = 0.693359375f;
+constexpr float EXP_LN2_LO = -2.12194440e-4f;
+constexpr float EXP_P0 = 1.9875691500e-4f;
+constexpr float EXP_P1 = 1.3981999507e-3f;
+constexpr float EXP_P2 = 8.3334519073e-3f;
+constexpr float EXP_P3 = 4.1665795894e-2f;
+constexpr float EXP_P4 = 1.6666665459e-1f;
+constexpr float EXP_P5 = 5.0000001201e-1f;
+
+// 矩阵乘法分块大小：KC行weight的NR列面板放在L1中
+constexpr int64_t LINEAR_BLOCK_K = 256;
+constexpr int64_t LINEAR_BLOCK_N = 256;
+constexpr int64_t LINEAR_TILE_M = 4;
+
+#endif
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "reference/golden_compare.h"
+#include "reference/cpu_kernels.h"
+#include "utils/dtype_convert.h"
+#include "utils/utils.h"
+#include "utils/weight_layout.h"
+
+// 与device算子参数一致：LayerNormParam的默认epsilon，Model::CreateAclnnOpLayer中的geluApproximate
+constexpr float LAYER_NORM_EPSILON = 1e-5f;
+constexpr int64_t MODEL_GELU_APPROXIMATE = -1;
+
+static std::vector<uint16_t> ReadTensor(const atb::Tensor &tensor)
+{
+    std::vector<uint16_t> hostData(tensor.dataSize / sizeof(uint16_t));
+    auto ret = aclrtMemcpy(hostData.data(), tensor.dataSize, tensor.deviceData, tensor.dataSize,
+                           ACL_MEMCPY_DEVICE_TO_HOST);
+    CHECK_RET(ret, "golden read tensor failed. ret: " + std::to_string(ret));
+    return hostData;
+}
+
+static bool IsFp16Nan(uint16_t value)
+{
+    return (value & 0x7fff) > 0x7c00;
+}
+
+uint32_t Fp16UlpDistance(uint16_t a, uint16_t b)
+{
+    if (IsFp16Nan(a) || IsFp16Nan(b)) {
+        return std::numeric_limits<uint32_t>::max();
+    }
+    // 符号-幅值编码映射为有序整数，+0和-0重合
+    auto toOrdered = [](uint16_t value) {
+        int32_t magnitude = value & 0x7fff;
+        return (value & 0x8000) ? -magnitude : magnitude;
+    };
+    return static_cast<uint32_t>(std::abs(toOrdered(a) - toOrdered(b)));
+}
+
+GoldenResult CompareFp16(const uint16_t *expected, const uint16_t *actual, int64_t count,
+                         const GoldenTolerance &tolerance)
+{
+    GoldenResult result;
+    result.count = count;
+    for (int64_t i = 0; i < count; i++) {
+        uint32_t ulp = Fp16UlpDistance(expected[i], actual[i]);
+        double expectedValue = Fp16ToFloat(expected[i]);
+        double absError = std::fabs(Fp16ToFloat(actual[i]) - expectedValue);
+        double relError = expectedValue == 0 ? absError : absError / std::fabs(expectedValue);
+        if (std::isnan(absError)) {
+            absError = std::numeric_limits<double>::infinity();
+            relError = absError;
+        }
+        result.maxUlp = std::max(result.maxUlp, ulp);
+        result.maxAbsError = std::max(result.maxAbsError, absError);
+        result.maxRelError = std::max(result.maxRelError, relError);
+        bool withinTolerance = ulp <= tolerance.maxUlp ||
+                               absError <= tolerance.absTol + tolerance.relTol * std::fabs(expectedValue);
+        if (!withinTolerance) {
+            if (result.mismatchCount == 0) {
+                result.firstMismatch = i;
+            }
+            result.mismatchCount++;
+        }
+    }
+    result.passed = result.mismatchCount == 0;
+    return result;
+}
+
+// 逐元素加法，结果与device上的中间tensor一样舍入到fp16
+static std::vector<uint16_t> AddFp16(const std::vector<uint16_t> &a, const std::vector<uint16_t> &b)
+{
+    std::vector<uint16_t> result(a.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        result[i] = FloatToFp16(Fp16ToFloat(a[i]) + Fp16ToFloat(b[i]));
+    }
+    return result;
+}
+
+GoldenResult CheckModelGolden(Model &model, const GoldenTolerance &tolerance)
+{
+    std::vector<uint16_t> a = ReadTensor(model.model_inTensors_.at(Model::IN_TENSOR_A));
+    std::vector<uint16_t> b = ReadTensor(model.model_inTensors_.at(Model::IN_TENSOR_B));
+    std::vector<uint16_t> c = ReadTensor(model.model_inTensors_.at(Model::IN_TENSOR_C));
+    std::vector<uint16_t> d = ReadTensor(model.model_inTensors_.at(Model::IN_TENSOR_D));
+    std::vector<uint16_t> actual = ReadTensor(model.model_outTensors_.at(0));
+
+    std::vector<uint16_t> sum = AddFp16(AddFp16(a, b), AddFp16(c, d));
+    std::vector<uint16_t> expected(sum.size());
+    CpuGeluFp16(sum.data(), expected.data(), static_cast<int64_t>(sum.size()), MODEL_GELU_APPROXIMATE);
+    if (expected.size() != actual.size()) {
+        LOG_ERROR("golden output size mismatch: " + std::to_string(expected.size()) + " vs " +
+                  std::to_string(actual.size()));
+        return GoldenResult();
+    }
+    return CompareFp16(expected.data(), actual.data(), static_cast<int64_t>(expected.size()), tolerance);
+}
+
+GoldenResult CheckModel2Golden(Model2 &model, const GoldenTolerance &tolerance)
+{
+    if (model.GetLinearQuantType() != LinearQuantType::FP16) {
+        LOG_ERROR("golden compare only supports FP16 Linear");
+        return GoldenResult();
+    }
+    std::vector<uint16_t> x = ReadTensor(model.model_inTensors_.at(Model2::IN_TENSOR_X));
+    std::vector<uint16_t> gamma = ReadTensor(model.model_inTensors_.at(Model2::IN_TENSOR_GAMMA));
+    std::vector<uint16_t> beta = ReadTensor(model.model_inTensors_.at(Model2::IN_TENSOR_BETA));
+    std::vector<uint16_t> weight = ReadTensor(model.model_inTensors_.at(Model2::IN_TENSOR_MATMUL_WEIGHT));
+    std::vector<uint16_t> bias = ReadTensor(model.model_inTensors_.at(Model2::IN_TENSOR_MATMUL_BIAS));
+    std::vector<uint16_t> actual = ReadTensor(model.model_outTensors_.at(Model2::OUT_TENSOR_LN_MATMUL));
+
+    // beginNormAxis之后的维度合并为cols，即Linear的k
+    int64_t k = static_cast<int64_t>(gamma.size());
+    int64_t m = static_cast<int64_t>(x.size()) / k;
+    int64_t n = static_cast<int64_t>(bias.size());
+    std::vector<uint16_t> normed(x.size());
+    CpuLayerNormFp16(x.data(), gamma.data(), beta.data(), normed.data(), m, k, LAYER_NORM_EPSILON);
+
+    bool transposeB = model.GetWeightLayout() == WeightLayout::ND_TRANSPOSED;
+    if (model.GetWeightLayout() == WeightLayout::FRACTAL_NZ) {
+        std::vector<uint16_t> ndWeight(k * n);
+        NzToNd(weight.data(), k, n, ndWeight.data());
+        weight.swap(ndWeight);
+    }
+    std::vector<uint16_t> expected(m * n);
+    CpuLinearFp16(normed.data(), weight.data(), bias.data(), expected.data(), m, k, n, transposeB);
+    if (expected.size() != actual.size()) {
+        LOG_ERROR("golden output size mismatch: " + std::to_string(expected.size()) + " vs " +
+                  std::to_string(actual.size()));
+        return GoldenResult();
+    }
+    return CompareFp16(expected.data(), actual.data(), static_cast<int64_t>(expected.size()), tolerance);
+}
+
+void LogGoldenResult(const std::string &name, const GoldenResult &result)
+{
+    LOG_ERROR("golden " + name + (result.passed ? " PASS" : " FAIL") + ": count " + std::to_string(result.count) +
+              ", mismatch " + std::to_string(result.mismatchCount) + ", first mismatch " +
+              std::to_string(result.firstMismatch) + ", max ulp " + std::to_string(result.maxUlp) + ", max abs " +
+              std::to_string(result.maxAbsError) + ", max rel " + std::to_string(result.maxRelError));
+}
@@ -0,0 +1,59 @@
+#ifndef GOLDEN_COMPARE_H
+#define GOLDEN_COMPARE_H
+
+#include <cstdint>
+#include <string>
+#include "model/model.h"
+#include "model/model2.h"
+
+/**
+ * golden比对的容差，元素满足任一条件即视为一致：
+ * fp16的ULP距离不超过maxUlp，或|actual - expected| <= absTol + relTol * |expected|
+ */
+struct GoldenTolerance
+{
+    uint32_t maxUlp = 4;
+    double relTol = 1e-2;
+    double absTol = 1e-3;
+};
+
+struct GoldenResult
+{
+    int64_t count = 0;
+    int64_t mismatchCount = 0;
+    int64_t firstMismatch = -1;  // 第一个超出容差的元素下标
+    uint32_t maxUlp = 0;
+    double maxAbsError = 0;
+    double maxRelError = 0;
+    bool passed = false;
+};
+
+/**
+ * fp16 ULP距离，符号不同时为两边到0的距离之和，NaN视为无穷远
+ */
+uint32_t Fp16UlpDistance(uint16_t a, uint16_t b);
+
+/**
+ * 逐元素比较fp16结果
+ */
+GoldenResult CompareFp16(const uint16_t *expected, const uint16_t *actual, int64_t count,
+                         const GoldenTolerance &tolerance);
+
+/**
+ * 把device上的模型输出与host参考实现的结果比较，需在Execute之后调用
+ * 输入从device读回，因此可以在执行前任意改写输入数据；中间结果与device一样舍入到fp16
+ * Model：gelu((a + b) + (c + d))
+ */
+GoldenResult CheckModelGolden(Model &model, const GoldenTolerance &tolerance);
+
+/**
+ * Model2：Linear(LayerNorm(x))，只支持FP16的Linear，三种权重布局都支持
+ */
+GoldenResult CheckModel2Golden(Model2 &model, const GoldenTolerance &tolerance);
+
+/**
+ * 按一行日志输出比对结果
+ */
+void LogGoldenResult(const std::string &name, const GoldenResult &result);
+
+#endif
@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "memory/memory_utils.h"
+#include "model/model.h"
+#include "runtime/device_worker_pool.h"
+#include "runtime/priority_scheduler.h"
+#include "runtime/request_trace.h"
+#include "utils/utils.h"
+
+// 开环回放负载生成器：按记录的（或泊松）到达时间提交请求，不等待前一个请求完成，
+// 分别统计排队时间与服务时间以及端到端延迟的尾部分布，输出一行JSON
+// 用法：replay_trace [--trace path | --poisson-rate R --count N [--steps N] [--deadline-ms X] [--record path]]
+//                    [--time-scale S] [--backend sim|model] [--sim-step-ms X] [--workers N] [--devices N]
+//                    [--scheduler fifo|priority] [--output path]
+// --trace读取inference_server --trace记录的文件；--record把生成的泊松到达序列保存为同样格式，便于重复回放
+// --time-scale为到达时间的缩放系数，0.5表示以两倍速率回放
+constexpr size_t POOL_SIZE = 104857600; // Alloceted memory 100 MiB.
+constexpr uint32_t RANDOM_SEED = 2024;
+// 提交时刻晚于计划超过该值时计为生成器跟不上
+constexpr double LATE_SUBMIT_MS = 1.0;
+
+using Clock = std::chrono::steady_clock;
+
+struct ReplayConfig
+{
+    std::string tracePath;
+    double poissonRate = 0; // 每秒请求数
+    uint64_t count = 1000;
+    uint32_t steps = 1;
+    double deadlineMs = 0;
+    std::string recordPath;
+    double timeScale = 1.0;
+    std::string backend = "sim";
+    double simStepMs = 1.0; // batch为1时每步的仿真执行时间，按batch大小线性放大
+    uint32_t workers = 2;   // sim为工作线程数，model为每个device的工作线程数
+    uint32_t devices = 0;   // 0表示使用全部device
+    std::string scheduler = "fifo";
+    std::string output;
+};
+
+struct ReplayRequest
+{
+    size_t index = 0;
+    uint32_t stepCount = 1;
+    double stepMs = 0;
+};
+
+// 记录每个请求最后一步结束的时刻和各步执行时间之和
+class ReplayExecutor : public StepExecutor<ReplayRequest>
+{
+public:
+    using StepFunc = std::function<void(ReplayRequest &request, uint32_t step)>;
+
+    ReplayExecutor(size_t requestCount, StepFunc runStep)
+        : runStep_(std::move(runStep)), finishTimes_(requestCount), serviceMs_(requestCount, 0)
+    {
+    }
+
+    void RunStep(ReplayRequest &request, uint32_t step) override
+    {
+        auto begin = Clock::now();
+        runStep_(request, step);
+        auto end = Clock::now();
+        std::chrono::duration<double, std::milli> stepTime = end - begin;
+        serviceMs_.at(request.index) += stepTime.count();
+        if (step + 1 == request.stepCount) {
+            finishTimes_.at(request.index) = end;
+        }
+    }
+
+    Clock::time_point GetFinishTime(size_t index) const
+    {
+        return finishTimes_.at(index);
+    }
+
+    double GetServiceMs(size_t index) const
+    {
+        return serviceMs_.at(index);
+    }
+
+private:
+    StepFunc runStep_;
+    // 同一请求的各步不会并发执行，每个下标同一时刻只有一个线程写入
+    std::vector<Clock::time_point> finishTimes_;
+    std::vector<double> serviceMs_;
+};
+
+static bool ParseArgs(int argc, char **argv, ReplayConfig &config)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            LOG_ERROR("missing value for " + arg);
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--trace") {
+            config.tracePath = value;
+        } else if (arg == "--poisson-rate") {
+            config.poissonRate = std::stod(value);
+        } else if (arg == "--count") {
+            config.count = std::stoull(value);
+        } else if (arg == "--steps") {
+            config.steps = std::stoul(value);
+        } else if (arg == "--deadline-ms") {
+            config.deadlineMs = std::stod(value);
+        } else if (arg == "--record") {
+            config.recordPath = value;
+        } else if (arg == "--time-scale") {
+            config.timeScale = std::stod(value);
+        } else if (arg == "--backend") {
+            config.backend = value;
+        } else if (arg == "--sim-step-ms") {
+            config.simStepMs = std::stod(value);
+        } else if (arg == "--workers") {
+            config.workers = std::stoul(value);
+        } else if (arg == "--devices") {
+            config.devices = std::stoul(value);
+        } else if (arg == "--scheduler") {
+            config.scheduler = value;
+        } else if (arg == "--output") {
+            config.output = value;
+        } else {
+            LOG_ERROR("unknown argument " + arg);
+            return false;
+        }
+    }
+    if (config.tracePath.empty() == (config.poissonRate <= 0)) {
+        LOG_ERROR("exactly one of --trace and --poisson-rate is required");
+        return false;
+    }
+    if ((config.backend != "sim" && config.backend != "model") ||
+        (config.scheduler != "fifo" && config.scheduler != "priority")) {
+        LOG_ERROR("unknown backend or scheduler");
+        return false;
+    }
+    return config.timeScale > 0 && config.workers > 0 && config.steps > 0;
+}
+
+static std::vector<TraceRecord> GeneratePoisson(const ReplayConfig &config)
+{
+    std::mt19937 generator(RANDOM_SEED);
+    std::exponential_distribution<double> intervalUs(config.poissonRate / 1e6);
+    std::vector<TraceRecord> records(config.count);
+    double arrivalUs = 0;
+    for (auto &record : records) {
+        arrivalUs += intervalUs(generator);
+        record.arrivalUs = static_cast<uint64_t>(arrivalUs);
+        record.deadlineMs = static_cast<float>(config.deadlineMs);
+        record.stepCount = static_cast<uint8_t>(config.steps);
+    }
+    return records;
+}
+
+// 把有序样本的分布写成JSON对象
+static std::string Distribution(std::vector<double> values)
+{
+    std::ostringstream json;
+    if (values.empty()) {
+        json << "{}";
+        return json.str();
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (double value : values) {
+        sum += value;
+    }
+    auto percentile = [&values](double ratio) {
+        size_t rank = static_cast<size_t>(std::ceil(ratio * values.size()));
+        return values.at(rank == 0 ? 0 : rank - 1);
+    };
+    json << "{\"mean\":" << sum / values.size() << ",\"p50\":" << percentile(0.5) << ",\"p90\":" << percentile(0.9)
+         << ",\"p99\":" << percentile(0.99) << ",\"p999\":" << percentile(0.999) << ",\"max\":" << values.back()
+         << "}";
+    return json.str();
+}
+
+int main(int argc, char **argv)
+{
+    ReplayConfig config;
+    if (!ParseArgs(argc, argv, config)) {
+        return 1;
+    }
+    std::vector<TraceRecord> records;
+    if (!config.tracePath.empty()) {
+        if (!LoadTrace(config.tracePath, records)) {
+            return 1;
+        }
+    } else {
+        records = GeneratePoisson(config);
+        if (!config.recordPath.empty() && !SaveTrace(config.recordPath, records)) {
+            return 1;
+        }
+    }
+    if (records.empty()) {
+        LOG_ERROR("trace is empty");
+        return 1;
+    }
+
+    // model后端：每个请求在常驻工作线程上执行一次完整的Model::Execute，整个请求为一步
+    std::unique_ptr<DeviceWorkerPool<Model>> pool;
+    std::atomic<uint64_t> nextGroup{0};
+    ReplayExecutor::StepFunc runStep = [](ReplayRequest &request, uint32_t step) {
+        (void)step;
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(request.stepMs));
+    };
+    uint32_t schedulerWorkers = config.workers;
+    bool modelBackend = config.backend == "model";
+    if (modelBackend) {
+        auto ret = aclInit(nullptr);
+        CHECK_RET(ret, "aclInit failed. ret: " + std::to_string(ret));
+        GetMemoryManager().CreateMemoryPool(POOL_SIZE);
+        uint32_t deviceCount = 0;
+        ret = aclrtGetDeviceCount(&deviceCount);
+        CHECK_RET(ret, "aclrtGetDeviceCount failed. ret: " + std::to_string(ret));
+        uint32_t deviceNum = config.devices == 0 || config.devices > deviceCount ? deviceCount : config.devices;
+        std::vector<uint32_t> deviceIds;
+        for (uint32_t i = 0; i < deviceNum; i++) {
+            deviceIds.push_back(i);
+        }
+        pool = std::make_unique<DeviceWorkerPool<Model>>(deviceIds, config.workers);
+        pool->Start();
+        schedulerWorkers = deviceNum * config.workers;
+        runStep = [&pool, &nextGroup](ReplayRequest &request, uint32_t step) {
+            (void)request;
+            (void)step;
+            size_t group = nextGroup.fetch_add(1) % pool->GetDeviceCount();
+            pool->Submit(group, [](Model &model) { model.Execute(); }).get();
+        };
+        bool batched = std::any_of(records.begin(), records.end(),
+                                   [](const TraceRecord &record) { return record.batchSize > 1; });
+        if (batched) {
+            LOG_WARNING("model backend executes every request with the model's fixed batch size");
+        }
+    }
+
+    auto executor = std::make_shared<ReplayExecutor>(records.size(), runStep);
+    SchedulerMode mode = config.scheduler == "priority" ? SchedulerMode::PRIORITY_EDF : SchedulerMode::FIFO;
+    std::vector<Clock::time_point> submitTimes(records.size());
+    std::vector<std::future<ScheduleOutcome>> outcomes;
+    uint64_t lateSubmits = 0;
+    auto start = Clock::now();
+    {
+        PriorityScheduler<ReplayRequest> scheduler(mode, executor, schedulerWorkers);
+        uint64_t firstArrivalUs = records.front().arrivalUs;
+        for (size_t i = 0; i < records.size(); i++) {
+            const TraceRecord &record = records[i];
+            double offsetMs = (record.arrivalUs - firstArrivalUs) / 1000.0 * config.timeScale;
+            auto plannedTime =
+                start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(offsetMs));
+            std::this_thread::sleep_until(plannedTime);
+            ReplayRequest request;
+            request.index = i;
+            request.stepCount = modelBackend ? 1 : std::max<uint32_t>(record.stepCount, 1);
+            request.stepMs = config.simStepMs * std::max<uint32_t>(record.batchSize, 1);
+            submitTimes[i] = Clock::now();
+            std::chrono::duration<double, std::milli> lateness = submitTimes[i] - plannedTime;
+            if (lateness.count() > LATE_SUBMIT_MS) {
+                lateSubmits++;
+            }
+            RequestPriority priority = record.priority < PRIORITY_CLASS_COUNT
+                                           ? static_cast<RequestPriority>(record.priority)
+                                           : RequestPriority::STANDARD;
+            // 开环：只提交，不等待完成
+            outcomes.push_back(
+                scheduler.Submit(request, priority, record.shapeKey, request.stepCount, record.deadlineMs));
+        }
+        scheduler.WaitIdle();
+    }
+    std::chrono::duration<double> wallTime = Clock::now() - start;
+    if (pool != nullptr) {
+        pool->Stop();
+        pool.reset();
+        aclFinalize();
+    }
+
+    // 排队时间 = 端到端延迟 - 各步执行时间之和，包含被抢占后重新排队的时间
+    std::vector<double> queueMs;
+    std::vector<double> serviceMs;
+    std::vector<double> latencyMs;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (outcomes[i].get() != ScheduleOutcome::COMPLETED) {
+            continue;
+        }
+        std::chrono::duration<double, std::milli> latency = executor->GetFinishTime(i) - submitTimes[i];
+        double service = executor->GetServiceMs(i);
+        latencyMs.push_back(latency.count());
+        serviceMs.push_back(service);
+        queueMs.push_back(std::max(latency.count() - service, 0.0));
+    }
+    double spanS = (records.back().arrivalUs - records.front().arrivalUs) / 1e6 * config.timeScale;
+
+    std::ostringstream json;
+    json << "{\"source\":\"" << (config.tracePath.empty() ? "poisson" : config.tracePath) << "\",\"backend\":\""
+         << config.backend << "\",\"scheduler\":\"" << config.scheduler << "\",\"workers\":" << schedulerWorkers
+         << ",\"time_scale\":" << config.timeScale;
+    json << ",\"requests\":" << records.size() << ",\"completed\":" << latencyMs.size()
+         << ",\"rejected\":" << records.size() - latencyMs.size() << ",\"late_submits\":" << lateSubmits;
+    json << ",\"offered_rps\":" << (spanS > 0 ? records.size() / spanS : 0)
+         << ",\"achieved_rps\":" << latencyMs.size() / wallTime.count();
+    json << ",\"queue_ms\":" << Distribution(queueMs) << ",\"service_ms\":" << Distribution(serviceMs)
+         << ",\"latency_ms\":" << Distribution(latencyMs) << "}";
+
+    // JSON单独占一行输出到标准输出，指定--output时同时写入文件
+    std::cout << json.str() << std::endl;
+    if (!config.output.empty()) {
+        std::ofstream file(config.output, std::ios::out | std::ios::trunc);
+        file << json.str() << std::endl;
+        if (!file) {
+            LOG_ERROR("Failed to write " + config.output);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include "runtime/acl_pipeline_backend.h"
+#include <algorithm>
+#include <chrono>
+#include "memory/memory_utils.h"
+#include "utils/tensor_io.h"
+#include "utils/utils.h"
+
+AclPipelineBackend::AclPipelineBackend(
+    std::vector<uint32_t> stageDeviceIds, std::vector<StageRange> stages, size_t slotCount)
+    : stageRanges_(std::move(stages)), slotCount_(slotCount == 0 ? 1 : slotCount)
+{
+    stages_.resize(stageRanges_.size());
+    for (size_t i = 0; i < stages_.size(); i++) {
+        stages_[i].deviceId = stageDeviceIds.at(i);
+    }
+}
+
+void AclPipelineBackend::InitStage(size_t stage)
+{
+    StageResource &resource = stages_[stage];
+    const StageRange &range = stageRanges_[stage];
+    for (size_t layer = range.beginLayer; layer < range.endLayer; layer++) {
+        auto model = std::make_unique<Model2>("layer_" + std::to_string(layer));
+        model->InitResource(resource.deviceId);
+        model->SetWeightSeed(LayerWeightSeed(layer));
+        model->CreateModelGraph();
+        model->CreateModelInput();
+        model->CreateModelOutput();
+        resource.layers.push_back(std::move(model));
+    }
+
+    // 输入槽大小与本stage第一层的激活输入一致
+    Model2 &first = *resource.layers.front();
+    resource.slotBytes = first.model_inTensors_.at(Model2::IN_TENSOR_X).dataSize;
+    if (stage > 0) {
+        for (size_t slot = 0; slot < slotCount_; slot++) {
+            int blockId = -1;
+            void *addr = nullptr;
+            GetMemoryManager().AllocateBlock(resource.slotBytes, blockId);
+            GetMemoryManager().GetBlockPtr(blockId, addr);
+            resource.slotBlockIds.push_back(blockId);
+            resource.slots.push_back(addr);
+        }
+    }
+
+    if (stage + 1 < stages_.size()) {
+        uint32_t nextDeviceId = stages_[stage + 1].deviceId;
+        int32_t canAccessPeer = 0;
+        if (nextDeviceId == resource.deviceId) {
+            canAccessPeer = 1;
+        } else {
+            auto ret = aclrtDeviceCanAccessPeer(&canAccessPeer, resource.deviceId, nextDeviceId);
+            CHECK_RET(ret, "aclrtDeviceCanAccessPeer failed. ret: " + std::to_string(ret));
+            if (canAccessPeer != 0) {
+                ret = aclrtDeviceEnablePeerAccess(nextDeviceId, 0);
+                CHECK_RET(ret, "aclrtDeviceEnablePeerAccess failed. ret: " + std::to_string(ret));
+            }
+        }
+        resource.peerToNext = canAccessPeer != 0;
+        if (!resource.peerToNext) {
+            uint64_t outBytes = resource.layers.back()->model_outTensors_.at(0).dataSize;
+            auto ret = aclrtMallocHost(&resource.hostStaging, outBytes);
+            CHECK_RET(ret, "aclrtMallocHost failed. ret: " + std::to_string(ret));
+        }
+    }
+    LOG_INFO("pipeline stage " + std::to_string(stage) + " on device " + std::to_string(resource.deviceId) +
+             " layers [" + std::to_string(range.beginLayer) + ", " + std::to_string(range.endLayer) + ")");
+}
+
+void AclPipelineBackend::RunStage(size_t stage, size_t microBatch, size_t inSlot)
+{
+    StageResource &resource = stages_[stage];
+    atb::Tensor &firstX = resource.layers.front()->model_inTensors_.at(Model2::IN_TENSOR_X);
+    if (stage > 0) {
+        CopyDeviceToDevice(firstX.deviceData, firstX.dataSize, resource.slots.at(inSlot), resource.slotBytes);
+    } else if (!microBatchInputs_.empty()) {
+        UploadTensor(firstX, microBatchInputs_.at(microBatch).data());
+    }
+    for (size_t i = 0; i < resource.layers.size(); i++) {
+        Model2 &layer = *resource.layers[i];
+        layer.Execute();
+        if (i + 1 < resource.layers.size()) {
+            // Model2的输出比输入宽，下一层只消费与其输入等长的前缀
+            atb::Tensor &out = layer.model_outTensors_.at(0);
+            atb::Tensor &x = resource.layers[i + 1]->model_inTensors_.at(Model2::IN_TENSOR_X);
+            CopyDeviceToDevice(x.deviceData, x.dataSize, out.deviceData, out.dataSize);
+        }
+    }
+    if (stage + 1 == stages_.size() && !microBatchOutputs_.empty()) {
+        microBatchOutputs_.at(microBatch) = DownloadTensor(resource.layers.back()->model_outTensors_.at(0));
+    }
+}
+
+void AclPipelineBackend::TransferActivation(size_t stage, size_t microBatch, size_t dstSlot)
+{
+    (void)microBatch;
+    StageResource &resource = stages_[stage];
+    StageResource &next = stages_[stage + 1];
+    atb::Tensor &out = resource.layers.back()->model_outTensors_.at(0);
+    uint64_t bytes = std::min(out.dataSize, next.slotBytes);
+    if (resource.peerToNext) {
+        CopyDeviceToDevice(next.slots.at(dstSlot), next.slotBytes, out.deviceData, bytes);
+        return;
+    }
+    auto ret = aclrtMemcpy(resource.hostStaging, bytes, out.deviceData, bytes, ACL_MEMCPY_DEVICE_TO_HOST);
+    CHECK_RET(ret, "aclrtMemcpy D2H failed. ret: " + std::to_string(ret));
+    ret = aclrtMemcpy(next.slots.at(dstSlot), next.slotBytes, resource.hostStaging, bytes, ACL_MEMCPY_HOST_TO_DEVICE);
+    CHECK_RET(ret, "aclrtMemcpy H2D failed. ret: " + std::to_string(ret));
+}
+
+void AclPipelineBackend::FreeStage(size_t stage)
+{
+    StageResource &resource = stages_[stage];
+    for (int blockId : resource.slotBlockIds) {
+        GetMemoryManager().FreeBlock(blockId);
+    }
+    resource.slotBlockIds.clear();
+    resource.slots.clear();
+    if (resource.hostStaging != nullptr) {
+        aclrtFreeHost(resource.hostStaging);
+        resource.hostStaging = nullptr;
+    }
+    for (auto &layer : resource.layers) {
+        layer->FreeResource();
+    }
+    resource.layers.clear();
+}
+
+void AclPipelineBackend::SetMicroBatchInputs(std::vector<std::vector<float>> inputs)
+{
+    microBatchInputs_ = std::move(inputs);
+    microBatchOutputs_.assign(microBatchInputs_.size(), {});
+}
+
+const std::vector<float> &AclPipelineBackend::GetMicroBatchOutput(size_t microBatch) const
+{
+    return microBatchOutputs_.at(microBatch);
+}
+
+uint32_t AclPipelineBackend::LayerWeightSeed(size_t layer)
+{
+    return static_cast<uint32_t>(layer + 1);
+}
+
+std::vector<double> AclPipelineBackend::MeasureLayerTimesMs(uint32_t deviceId, size_t layerCount, size_t iterations)
+{
+    std::vector<double> layerTimesMs;
+    for (size_t layer = 0; layer < layerCount; layer++) {
+        Model2 model("profile_layer_" + std::to_string(layer));
+        model.InitResource(deviceId);
+        model.SetWeightSeed(LayerWeightSeed(layer));
+        model.CreateModelGraph();
+        model.CreateModelInput();
+        model.CreateModelOutput();
+        model.Execute(); // 预热，完成workspace和中间tensor分配
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            model.Execute();
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        layerTimesMs.push_back(elapsed.count() / std::max<size_t>(iterations, 1));
+        model.FreeResource();
+    }
+    return layerTimesMs;
+}
+
+void AclPipelineBackend::CopyDeviceToDevice(void *dst, uint64_t dstBytes, const void *src, uint64_t srcBytes)
+{
+    uint64_t bytes = std::min(dstBytes, srcBytes);
+    auto ret = aclrtMemcpy(dst, dstBytes, src, bytes, ACL_MEMCPY_DEVICE_TO_DEVICE);
+    CHECK_RET(ret, "aclrtMemcpy D2D failed. ret: " + std::to_string(ret));
+}
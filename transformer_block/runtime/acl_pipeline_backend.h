@@ -0,0 +1,81 @@
+#ifndef ACL_PIPELINE_BACKEND_H
+#define ACL_PIPELINE_BACKEND_H
+
+#include <memory>
+#include <vector>
+#include "model/model2.h"
+#include "runtime/pipeline_scheduler.h"
+
+/**
+ * 基于Model2的流水线后端
+ * 每层是一个Model2实例，权重种子为LayerWeightSeed(layer)，各层权重互不相同；
+ * stage内的层在同一device上顺序执行，层之间在device内拷贝激活；
+ * stage之间的激活通过device间拷贝写入下一stage的输入槽，不支持peer访问时经pinned host内存中转。
+ * 输入槽从下一stage所在device的MemoryPool中分配。
+ */
+class AclPipelineBackend : public PipelineStageBackend
+{
+public:
+    /**
+     * 构造函数
+     * @param stageDeviceIds 每个stage绑定的device
+     * @param stages 每个stage负责的层范围
+     * @param slotCount 每个stage的输入槽数量，与PipelineScheduler一致
+     */
+    AclPipelineBackend(std::vector<uint32_t> stageDeviceIds, std::vector<StageRange> stages, size_t slotCount);
+
+    void InitStage(size_t stage) override;
+    void RunStage(size_t stage, size_t microBatch, size_t inSlot) override;
+    void TransferActivation(size_t stage, size_t microBatch, size_t dstSlot) override;
+    void FreeStage(size_t stage) override;
+
+    /**
+     * 设置每个micro-batch的输入，必须在Run之前调用
+     * 未设置时第一层使用CreateModelInput填充的默认输入，也不保存输出
+     * @param inputs 按micro-batch索引，每个输入为第一层IN_TENSOR_X的float数据
+     */
+    void SetMicroBatchInputs(std::vector<std::vector<float>> inputs);
+
+    /**
+     * 获取micro-batch经过最后一层后的输出，Run返回后有效
+     * @param microBatch micro-batch序号
+     */
+    const std::vector<float> &GetMicroBatchOutput(size_t microBatch) const;
+
+    /**
+     * 获取第layer层的权重种子
+     * @param layer 层序号
+     */
+    static uint32_t LayerWeightSeed(size_t layer);
+
+    /**
+     * 在指定device上逐层实测处理一个micro-batch的耗时，作为stage切分的输入
+     * @param deviceId 测量使用的device
+     * @param layerCount 层数
+     * @param iterations 每层预热后重复执行的次数
+     */
+    static std::vector<double> MeasureLayerTimesMs(uint32_t deviceId, size_t layerCount, size_t iterations);
+
+private:
+    struct StageResource
+    {
+        uint32_t deviceId = 0;
+        std::vector<std::unique_ptr<Model2>> layers;
+        std::vector<int> slotBlockIds; // 输入槽在MemoryPool中的blockId
+        std::vector<void *> slots;     // 输入槽地址
+        uint64_t slotBytes = 0;
+        bool peerToNext = false;       // 能否直接拷贝到下一stage的device
+        void *hostStaging = nullptr;   // 不能peer访问时的中转内存
+    };
+
+    // 把src拷贝到dst，超出较小一方的部分忽略
+    static void CopyDeviceToDevice(void *dst, uint64_t dstBytes, const void *src, uint64_t srcBytes);
+
+    std::vector<StageRange> stageRanges_;
+    size_t slotCount_;
+    std::vector<StageResource> stages_;
+    std::vector<std::vector<float>> microBatchInputs_;  // 只由第一个stage的线程读取
+    std::vector<std::vector<float>> microBatchOutputs_; // 只由最后一个stage的线程写入
+};
+
+#endif
@@ -0,0 +1,307 @@
+#ifndef DEVICE_WORKER_POOL_H
+#define DEVICE_WORKER_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "utils/log.h"
+#include "utils/metrics.h"
+
+/**
+ * 常驻的device工作线程池
+ * 每个工作线程绑定一个device，在线程内完成一次InitResource/CreateModelGraph/
+ * CreateModelInput/CreateModelOutput，之后常驻并反复执行请求，直到Stop时才FreeResource。
+ * 每个工作线程拥有自己的请求队列，空闲时从同一device上其他工作线程的队列尾部窃取请求。
+ * ModelT需要提供与Model/Model2一致的资源管理接口。
+ * 指标开启时记录请求的排队时间、执行中的请求数和各device的忙碌时间。
+ */
+template <typename ModelT>
+class DeviceWorkerPool {
+public:
+    // 请求在工作线程上执行，参数为该线程常驻的模型
+    using RequestFunc = std::function<void(ModelT &model)>;
+
+    // 工作线程的统计信息
+    struct WorkerStats {
+        uint32_t deviceId = 0;
+        uint64_t executedCount = 0; // 执行的请求数
+        uint64_t stolenCount = 0;   // 其中从其他工作线程窃取的请求数
+    };
+
+    /**
+     * 构造函数
+     * @param deviceIds 参与执行的device列表
+     * @param workersPerDevice 每个device上的工作线程数
+     */
+    DeviceWorkerPool(const std::vector<uint32_t> &deviceIds, uint32_t workersPerDevice)
+        : queueWait_(GetMetrics().GetHistogram("worker_pool_queue_wait_seconds",
+                                               "Time a request waits in the worker pool queues")),
+          inFlight_(GetMetrics().GetGauge("requests_in_flight", "Requests submitted to the worker pool and not finished"))
+    {
+        for (uint32_t deviceId : deviceIds) {
+            auto group = std::make_unique<DeviceGroup>();
+            group->deviceId = deviceId;
+            for (uint32_t i = 0; i < workersPerDevice; i++) {
+                group->workers.push_back(std::make_unique<Worker>());
+            }
+            groups_.push_back(std::move(group));
+        }
+    }
+
+    ~DeviceWorkerPool()
+    {
+        Stop();
+    }
+
+    DeviceWorkerPool(const DeviceWorkerPool &) = delete;
+    DeviceWorkerPool &operator=(const DeviceWorkerPool &) = delete;
+
+    /**
+     * 启动所有工作线程，阻塞到所有模型完成资源初始化和构图
+     */
+    void Start()
+    {
+        size_t workerCount = 0;
+        for (auto &group : groups_) {
+            for (auto &worker : group->workers) {
+                worker->thread = std::thread([this, &group, &worker] { WorkerLoop(*group, *worker); });
+                workerCount++;
+            }
+        }
+        std::unique_lock<std::mutex> lock(readyMutex_);
+        readyCv_.wait(lock, [this, workerCount] { return readyCount_ == workerCount; });
+        startTime_ = std::chrono::steady_clock::now();
+        RegisterDeviceMetrics();
+        LOG_INFO("DeviceWorkerPool started with " + std::to_string(workerCount) + " workers");
+    }
+
+    /**
+     * 提交请求到指定device，由该device上的工作线程执行
+     * @param groupIndex 构造时deviceIds中的下标
+     * @param func 请求函数
+     * @return 请求完成的future
+     */
+    std::future<void> Submit(size_t groupIndex, RequestFunc func)
+    {
+        Task task;
+        task.func = std::make_shared<std::packaged_task<void(ModelT &)>>(std::move(func));
+        std::future<void> future = task.func->get_future();
+        task.metered = GetMetrics().IsEnabled();
+        if (task.metered) {
+            task.enqueueTime = std::chrono::steady_clock::now();
+            inFlight_.Add(1);
+        }
+        DeviceGroup &group = *groups_.at(groupIndex);
+        // 轮询放入各工作线程的队列，负载不均时由窃取平衡
+        Worker &worker = *group.workers.at(group.nextWorker.fetch_add(1) % group.workers.size());
+        {
+            std::unique_lock<std::mutex> lock(worker.queueMutex);
+            worker.queue.push_back(std::move(task));
+        }
+        {
+            std::unique_lock<std::mutex> lock(group.wakeMutex);
+            group.pendingCount++;
+        }
+        group.wakeCv.notify_one();
+        return future;
+    }
+
+    /**
+     * 执行完已提交的请求后停止所有工作线程并释放模型资源
+     */
+    void Stop()
+    {
+        UnregisterDeviceMetrics();
+        for (auto &group : groups_) {
+            {
+                std::unique_lock<std::mutex> lock(group->wakeMutex);
+                group->stop = true;
+            }
+            group->wakeCv.notify_all();
+        }
+        for (auto &group : groups_) {
+            for (auto &worker : group->workers) {
+                if (worker->thread.joinable()) {
+                    worker->thread.join();
+                }
+            }
+        }
+    }
+
+    /**
+     * 获取device数量
+     */
+    size_t GetDeviceCount() const
+    {
+        return groups_.size();
+    }
+
+    /**
+     * 获取各工作线程的统计信息
+     */
+    std::vector<WorkerStats> GetStats() const
+    {
+        std::vector<WorkerStats> stats;
+        for (const auto &group : groups_) {
+            for (const auto &worker : group->workers) {
+                WorkerStats workerStats;
+                workerStats.deviceId = group->deviceId;
+                workerStats.executedCount = worker->executedCount.load();
+                workerStats.stolenCount = worker->stolenCount.load();
+                stats.push_back(workerStats);
+            }
+        }
+        return stats;
+    }
+
+private:
+    struct Task {
+        std::shared_ptr<std::packaged_task<void(ModelT &)>> func;
+        bool metered = false;                              // 提交时指标是否开启
+        std::chrono::steady_clock::time_point enqueueTime; // 仅metered时有效
+    };
+
+    struct Worker {
+        std::thread thread;
+        std::mutex queueMutex;        // 保护queue
+        std::deque<Task> queue;       // 本线程的请求队列，自己从头部取，被窃取时从尾部取
+        std::atomic<uint64_t> executedCount{0};
+        std::atomic<uint64_t> stolenCount{0};
+    };
+
+    struct DeviceGroup {
+        uint32_t deviceId = 0;
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::atomic<uint32_t> nextWorker{0};
+        std::mutex wakeMutex;          // 保护pendingCount和stop
+        std::condition_variable wakeCv;
+        size_t pendingCount = 0;       // 本device上尚未被取走的请求数
+        bool stop = false;
+        std::atomic<uint64_t> busyNs{0}; // 工作线程执行请求的累计时间，指标开启时统计
+    };
+
+    // 先取自己队列头部的请求，没有时从同device其他工作线程的队列尾部窃取
+    bool PopTask(DeviceGroup &group, Worker &self, Task &task, bool &stolen)
+    {
+        {
+            std::unique_lock<std::mutex> lock(self.queueMutex);
+            if (!self.queue.empty()) {
+                task = std::move(self.queue.front());
+                self.queue.pop_front();
+                stolen = false;
+                return true;
+            }
+        }
+        for (auto &other : group.workers) {
+            if (other.get() == &self) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(other->queueMutex);
+            if (!other->queue.empty()) {
+                task = std::move(other->queue.back());
+                other->queue.pop_back();
+                stolen = true;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkerLoop(DeviceGroup &group, Worker &self)
+    {
+        // 线程内创建context、stream和图，之后常驻复用
+        ModelT model;
+        model.InitResource(group.deviceId);
+        model.CreateModelGraph();
+        model.CreateModelInput();
+        model.CreateModelOutput();
+        {
+            std::unique_lock<std::mutex> lock(readyMutex_);
+            readyCount_++;
+        }
+        readyCv_.notify_all();
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(group.wakeMutex);
+                group.wakeCv.wait(lock, [&group] { return group.stop || group.pendingCount > 0; });
+                if (group.pendingCount == 0) {
+                    break; // stop且没有剩余请求
+                }
+                group.pendingCount--;
+            }
+            // pendingCount保证至少有一个请求留在本device的某个队列中
+            Task task;
+            bool stolen = false;
+            while (!PopTask(group, self, task, stolen)) {
+                std::this_thread::yield();
+            }
+            if (task.metered) {
+                auto begin = std::chrono::steady_clock::now();
+                queueWait_.Record(begin - task.enqueueTime);
+                (*task.func)(model);
+                auto busy = std::chrono::steady_clock::now() - begin;
+                group.busyNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(busy).count(),
+                                       std::memory_order_relaxed);
+                inFlight_.Add(-1);
+            } else {
+                (*task.func)(model);
+            }
+            self.executedCount++;
+            if (stolen) {
+                self.stolenCount++;
+            }
+        }
+        model.FreeResource();
+    }
+
+    static std::string DeviceLabel(const DeviceGroup &group)
+    {
+        return "device=\"" + std::to_string(group.deviceId) + "\"";
+    }
+
+    // 忙碌时间和利用率在抓取时由busyNs计算
+    void RegisterDeviceMetrics()
+    {
+        for (auto &group : groups_) {
+            DeviceGroup *groupPtr = group.get();
+            GetMetrics().RegisterCallback(
+                "device_busy_seconds_total", "Time worker threads of the device spent executing requests",
+                MetricType::COUNTER, DeviceLabel(*group),
+                [groupPtr]() { return groupPtr->busyNs.load(std::memory_order_relaxed) / 1e9; });
+            GetMetrics().RegisterCallback(
+                "device_utilization", "Busy time over worker time of the device since the pool started",
+                MetricType::GAUGE, DeviceLabel(*group), [this, groupPtr]() {
+                    double elapsedNs = std::chrono::duration<double, std::nano>(
+                        std::chrono::steady_clock::now() - startTime_).count();
+                    double workerNs = elapsedNs * groupPtr->workers.size();
+                    return workerNs > 0 ? groupPtr->busyNs.load(std::memory_order_relaxed) / workerNs : 0.0;
+                });
+        }
+    }
+
+    void UnregisterDeviceMetrics()
+    {
+        for (auto &group : groups_) {
+            GetMetrics().UnregisterCallback("device_busy_seconds_total", DeviceLabel(*group));
+            GetMetrics().UnregisterCallback("device_utilization", DeviceLabel(*group));
+        }
+    }
+
+    std::vector<std::unique_ptr<DeviceGroup>> groups_;
+    std::mutex readyMutex_;
+    std::condition_variable readyCv_;
+    size_t readyCount_ = 0;
+    LatencyHistogram &queueWait_;
+    Gauge &inFlight_;
+    std::chrono::steady_clock::time_point startTime_;
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include "runtime/dispatch_router.h"
+
+// 服务时间滑动平均的权重，越大越偏向最近的请求
+constexpr double SERVICE_TIME_EWMA_ALPHA = 0.2;
+
+DispatchRouter::DispatchRouter(RoutePolicy policy, const std::vector<uint32_t> &deviceIds, uint32_t concurrencyLimit)
+    : policy_(policy), startTime_(Clock::now())
+{
+    devices_.resize(deviceIds.size());
+    for (size_t i = 0; i < deviceIds.size(); i++) {
+        devices_[i].stats.deviceId = deviceIds[i];
+        devices_[i].stats.concurrencyLimit = concurrencyLimit == 0 ? 1 : concurrencyLimit;
+        devices_[i].lastChange = startTime_;
+    }
+}
+
+double DispatchRouter::EstimateLocked(const DeviceState &state) const
+{
+    double serviceTimeMs = state.stats.serviceTimeMs;
+    if (serviceTimeMs <= 0) {
+        // 尚无样本的device使用已知device的平均服务时间，保证新device也能被选中
+        double sum = 0;
+        size_t count = 0;
+        for (const auto &device : devices_) {
+            if (device.stats.serviceTimeMs > 0) {
+                sum += device.stats.serviceTimeMs;
+                count++;
+            }
+        }
+        serviceTimeMs = count == 0 ? 1.0 : sum / count;
+    }
+    // 排在前面的请求加上新请求，按并发上限分摊
+    double outstanding = static_cast<double>(state.stats.queued + state.stats.inFlight + 1);
+    return outstanding * serviceTimeMs / state.stats.concurrencyLimit;
+}
+
+void DispatchRouter::AccumulateLocked(DeviceState &state, Clock::time_point now)
+{
+    std::chrono::duration<double> elapsed = now - state.lastChange;
+    state.busyIntegral += elapsed.count() * state.stats.inFlight / state.stats.concurrencyLimit;
+    state.lastChange = now;
+}
+
+size_t DispatchRouter::Route()
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    size_t best = 0;
+    double bestScore = 0;
+    for (size_t i = 0; i < devices_.size(); i++) {
+        const auto &stats = devices_[i].stats;
+        double score = policy_ == RoutePolicy::QUEUE_DEPTH
+                           ? static_cast<double>(stats.queued + stats.inFlight) / stats.concurrencyLimit
+                           : EstimateLocked(devices_[i]);
+        if (i == 0 || score < bestScore) {
+            best = i;
+            bestScore = score;
+        }
+    }
+    devices_[best].stats.queued++;
+    return best;
+}
+
+bool DispatchRouter::TryStart(size_t index)
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    auto &state = devices_.at(index);
+    if (state.stats.queued == 0 || state.stats.inFlight >= state.stats.concurrencyLimit) {
+        return false;
+    }
+    AccumulateLocked(state, Clock::now());
+    state.stats.queued--;
+    state.stats.inFlight++;
+    return true;
+}
+
+void DispatchRouter::OnComplete(size_t index, double serviceTimeMs)
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    auto &state = devices_.at(index);
+    AccumulateLocked(state, Clock::now());
+    state.stats.inFlight--;
+    state.stats.completed++;
+    state.stats.serviceTimeMs = state.stats.serviceTimeMs <= 0
+                                    ? serviceTimeMs
+                                    : (1 - SERVICE_TIME_EWMA_ALPHA) * state.stats.serviceTimeMs +
+                                          SERVICE_TIME_EWMA_ALPHA * serviceTimeMs;
+}
+
+double DispatchRouter::EstimateCompletionMs(size_t index) const
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    return EstimateLocked(devices_.at(index));
+}
+
+std::vector<DeviceLoadStats> DispatchRouter::GetStats() const
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    auto now = Clock::now();
+    std::chrono::duration<double> wall = now - startTime_;
+    std::vector<DeviceLoadStats> result;
+    for (const auto &state : devices_) {
+        DeviceLoadStats stats = state.stats;
+        std::chrono::duration<double> pending = now - state.lastChange;
+        double busy = state.busyIntegral + pending.count() * stats.inFlight / stats.concurrencyLimit;
+        stats.utilization = wall.count() > 0 ? busy / wall.count() : 0;
+        result.push_back(stats);
+    }
+    return result;
+}
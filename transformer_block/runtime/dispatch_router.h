@@ -0,0 +1,93 @@
+#ifndef DISPATCH_ROUTER_H
+#define DISPATCH_ROUTER_H
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+// 请求路由策略
+enum class RoutePolicy
+{
+    QUEUE_DEPTH = 0,      // 选择排队+执行中请求最少的device
+    ESTIMATED_COMPLETION, // 选择预计完成时间最早的device
+};
+
+// 单个device的负载统计
+struct DeviceLoadStats
+{
+    uint32_t deviceId = 0;
+    uint32_t concurrencyLimit = 0; // 同时执行的请求上限
+    uint64_t queued = 0;           // 已路由但尚未开始执行的请求数
+    uint64_t inFlight = 0;         // 正在执行的请求数
+    uint64_t completed = 0;        // 已完成的请求数
+    double serviceTimeMs = 0;      // 单个请求服务时间的滑动平均
+    double utilization = 0;        // 时间加权的 inFlight / concurrencyLimit
+};
+
+/**
+ * 请求路由器
+ * 只负责路由决策和负载统计，不持有请求本身，便于用仿真device单独验证路由逻辑
+ * 所有接口线程安全
+ */
+class DispatchRouter
+{
+public:
+    /**
+     * 构造函数
+     * @param policy 路由策略
+     * @param deviceIds 参与路由的device
+     * @param concurrencyLimit 每个device同时执行的请求上限
+     */
+    DispatchRouter(RoutePolicy policy, const std::vector<uint32_t> &deviceIds, uint32_t concurrencyLimit);
+
+    /**
+     * 为新请求选择device，并计入该device的排队数
+     * @return device在deviceIds中的下标
+     */
+    size_t Route();
+
+    /**
+     * device有排队请求且未达到并发上限时，把一个请求从排队转为执行中
+     * @param index device下标
+     * @return 是否可以开始执行一个请求
+     */
+    bool TryStart(size_t index);
+
+    /**
+     * 请求执行完成
+     * @param index device下标
+     * @param serviceTimeMs 该请求的服务时间
+     */
+    void OnComplete(size_t index, double serviceTimeMs);
+
+    /**
+     * 预计在该device上新提交一个请求的完成时间（毫秒）
+     * @param index device下标
+     */
+    double EstimateCompletionMs(size_t index) const;
+
+    /**
+     * 获取所有device的负载统计
+     */
+    std::vector<DeviceLoadStats> GetStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct DeviceState
+    {
+        DeviceLoadStats stats;
+        Clock::time_point lastChange;
+        double busyIntegral = 0; // 累计的 inFlight/limit * 时间（秒）
+    };
+
+    double EstimateLocked(const DeviceState &state) const;
+    void AccumulateLocked(DeviceState &state, Clock::time_point now);
+
+    RoutePolicy policy_;
+    Clock::time_point startTime_;
+    mutable std::mutex stateMutex_;
+    std::vector<DeviceState> devices_;
+};
+
+#endif
@@ -0,0 +1,369 @@
+#include "runtime/inference_server.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "runtime/shm_ring.h"
+#include "utils/utils.h"
+
+// poll的超时，也是发现RequestDrain的最长延迟
+constexpr int POLL_INTERVAL_MS = 50;
+
+struct InferenceServer::Connection
+{
+    int fd = -1;
+    ShmRing ring;
+    bool registered = false;         // ring是否已注册为pinned内存
+    std::mutex slotMutex;            // 保护slotBusy
+    std::vector<bool> slotBusy;      // slot上是否有未回复的请求
+    std::atomic<bool> closed{false}; // 对端已关闭，排队中的请求不再执行
+
+    ~Connection()
+    {
+        if (registered) {
+            aclrtHostUnregister(ring.GetBase());
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    bool TryAcquireSlot(uint32_t slot)
+    {
+        std::unique_lock<std::mutex> lock(slotMutex);
+        if (slot >= slotBusy.size() || slotBusy[slot]) {
+            return false;
+        }
+        slotBusy[slot] = true;
+        return true;
+    }
+
+    void ReleaseSlot(uint32_t slot)
+    {
+        std::unique_lock<std::mutex> lock(slotMutex);
+        slotBusy[slot] = false;
+    }
+};
+
+static uint64_t ElapsedUs(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+InferenceServer::InferenceServer(const ServerConfig &config)
+    : config_(config),
+      requestLatency_(GetMetrics().GetHistogram("server_request_seconds",
+                                                "Time from receiving a request to replying OK"))
+{
+}
+
+InferenceServer::~InferenceServer()
+{
+    CloseListen();
+}
+
+void InferenceServer::RequestDrain()
+{
+    drainRequested_ = true;
+}
+
+ServerStats InferenceServer::GetStats() const
+{
+    std::unique_lock<std::mutex> lock(statsMutex_);
+    return stats_;
+}
+
+bool InferenceServer::Run()
+{
+    bool exportMetrics = config_.metricsPort != 0 || !config_.metricsFile.empty();
+    if (exportMetrics) {
+        // 在模型首次执行前开启，使各模型注册的指标完整
+        GetMetrics().Enable();
+    }
+    std::vector<uint32_t> deviceIds = config_.deviceIds;
+    if (deviceIds.empty()) {
+        uint32_t deviceCount = 0;
+        auto ret = aclrtGetDeviceCount(&deviceCount);
+        CHECK_RET(ret, "aclrtGetDeviceCount failed. ret: " + std::to_string(ret));
+        for (uint32_t i = 0; i < deviceCount; i++) {
+            deviceIds.push_back(i);
+        }
+    }
+    // 注册pinned内存需要当前线程有device上下文
+    auto ret = aclrtSetDevice(deviceIds.at(0));
+    CHECK_RET(ret, "aclrtSetDevice failed. ret: " + std::to_string(ret));
+
+    pool_ = std::make_unique<DeviceWorkerPool<Model2>>(deviceIds, config_.workersPerDevice);
+    pool_->Start();
+    // 所有模型实例的输入输出描述相同，从任意一个取得
+    pool_->Submit(0, [this](Model2 &model) {
+        const atb::Tensor &input = model.model_inTensors_.at(Model2::IN_TENSOR_X);
+        const atb::Tensor &output = model.model_outTensors_.at(Model2::OUT_TENSOR_LN_MATMUL);
+        hello_.inputDtype = input.desc.dtype;
+        hello_.inputBytes = input.dataSize;
+        hello_.outputDtype = output.desc.dtype;
+        hello_.outputBytes = output.dataSize;
+    }).get();
+    hello_.slotCount = config_.slotsPerConnection;
+
+    if (!config_.tracePath.empty() && !recorder_.Open(config_.tracePath)) {
+        pool_->Stop();
+        return false;
+    }
+    if ((config_.metricsPort != 0 && !exporter_.StartHttp(config_.metricsPort)) ||
+        (!config_.metricsFile.empty() && !exporter_.StartDump(config_.metricsFile, config_.metricsIntervalMs))) {
+        exporter_.Stop();
+        pool_->Stop();
+        return false;
+    }
+    if (config_.metricsPort != 0) {
+        LOG_ERROR("metrics on http://127.0.0.1:" + std::to_string(exporter_.GetHttpPort()) + "/metrics");
+    }
+    if (!Listen()) {
+        exporter_.Stop();
+        pool_->Stop();
+        return false;
+    }
+    LOG_ERROR("inference server listening on " + config_.socketPath);
+    GetMetrics().RegisterCallback("server_pending_requests", "Requests queued or executing in the server",
+                                  MetricType::GAUGE, "", [this]() { return static_cast<double>(pending_.load()); });
+
+    std::vector<ConnectionPtr> connections;
+    bool draining = false;
+    while (true) {
+        if (!draining && drainRequested_) {
+            draining = true;
+            CloseListen();
+            LOG_ERROR("inference server draining, pending requests: " + std::to_string(pending_.load()));
+        }
+        if (draining && pending_ == 0) {
+            break;
+        }
+        std::vector<pollfd> pollFds;
+        if (!draining) {
+            pollFds.push_back({listenFd_, POLLIN, 0});
+        }
+        size_t firstConnection = pollFds.size();
+        for (const auto &connection : connections) {
+            pollFds.push_back({connection->fd, POLLIN, 0});
+        }
+        int ready = poll(pollFds.data(), pollFds.size(), POLL_INTERVAL_MS);
+        if (ready < 0 && errno != EINTR) {
+            LOG_ERROR("poll failed, errno " + std::to_string(errno));
+            break;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+        // 先处理已有连接，新连接在下一轮加入poll
+        for (size_t i = firstConnection; i < pollFds.size(); i++) {
+            if ((pollFds[i].revents & (POLLIN | POLLHUP | POLLERR)) == 0) {
+                continue;
+            }
+            const ConnectionPtr &connection = connections.at(i - firstConnection);
+            if (!HandleMessage(connection)) {
+                connection->closed = true;
+            }
+        }
+        connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                         [](const ConnectionPtr &connection) { return connection->closed.load(); }),
+                          connections.end());
+        if (!draining && (pollFds[0].revents & POLLIN) != 0) {
+            AcceptConnection(connections);
+        }
+    }
+
+    // 工作线程执行完已提交的请求后释放模型，连接在最后一个引用释放时关闭
+    pool_->Stop();
+    GetMetrics().UnregisterCallback("server_pending_requests", "");
+    exporter_.Stop();
+    connections.clear();
+    CloseListen();
+    recorder_.Close();
+    LOG_ERROR("inference server drained");
+    return true;
+}
+
+bool InferenceServer::Listen()
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (config_.socketPath.size() >= sizeof(address.sun_path)) {
+        LOG_ERROR("socket path too long: " + config_.socketPath);
+        return false;
+    }
+    std::strncpy(address.sun_path, config_.socketPath.c_str(), sizeof(address.sun_path) - 1);
+    listenFd_ = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        LOG_ERROR("socket failed, errno " + std::to_string(errno));
+        return false;
+    }
+    // 上一次异常退出时可能残留socket文件
+    unlink(config_.socketPath.c_str());
+    if (bind(listenFd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        listen(listenFd_, static_cast<int>(config_.maxConnections)) != 0) {
+        LOG_ERROR("bind/listen " + config_.socketPath + " failed, errno " + std::to_string(errno));
+        CloseListen();
+        return false;
+    }
+    return true;
+}
+
+void InferenceServer::CloseListen()
+{
+    if (listenFd_ < 0) {
+        return;
+    }
+    close(listenFd_);
+    listenFd_ = -1;
+    unlink(config_.socketPath.c_str());
+}
+
+void InferenceServer::AcceptConnection(std::vector<ConnectionPtr> &connections)
+{
+    int fd = accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0) {
+        LOG_ERROR("accept failed, errno " + std::to_string(errno));
+        return;
+    }
+    auto connection = std::make_shared<Connection>();
+    connection->fd = fd;
+    if (connections.size() >= config_.maxConnections) {
+        LOG_ERROR("too many connections, reject");
+        return;
+    }
+    uint64_t connectionId = 0;
+    {
+        std::unique_lock<std::mutex> lock(statsMutex_);
+        connectionId = stats_.connections++;
+    }
+    if (!connection->ring.Create("transformer_block_ring_" + std::to_string(connectionId), hello_.slotCount,
+                                 hello_.inputBytes, hello_.outputBytes)) {
+        return;
+    }
+    // 整个环注册为pinned内存，执行时直接作为异步拷贝的源和目的
+    void *devicePtr = nullptr;
+    auto ret = aclrtHostRegister(connection->ring.GetBase(), connection->ring.GetSize(), ACL_HOST_REGISTER_MAPPED,
+                                 &devicePtr);
+    if (ret != ACL_SUCCESS) {
+        LOG_ERROR("aclrtHostRegister shm ring failed. ret: " + std::to_string(ret));
+        return;
+    }
+    connection->registered = true;
+    connection->slotBusy.assign(hello_.slotCount, false);
+    if (!SendMessage(fd, &hello_, sizeof(hello_), connection->ring.GetFd())) {
+        LOG_ERROR("send hello failed");
+        return;
+    }
+    connections.push_back(connection);
+    LOG_INFO("accept connection " + std::to_string(connectionId));
+}
+
+bool InferenceServer::HandleMessage(const ConnectionPtr &connection)
+{
+    RequestMessage request;
+    ssize_t received = RecvMessage(connection->fd, &request, sizeof(request));
+    if (received <= 0) {
+        return false;
+    }
+    auto receivedTime = Clock::now();
+    if (received != static_cast<ssize_t>(sizeof(request)) || request.type != ServerMessageType::REQUEST ||
+        !connection->TryAcquireSlot(request.slot)) {
+        Reply(connection, request, RequestStatus::INVALID);
+        return true;
+    }
+    // 记录每个到达的请求，包括随后回复BUSY/DRAINING的请求，回放时得到与线上相同的到达过程
+    // 协议中没有优先级，Model2只有一个输入形状，以输入字节数作为形状标识
+    recorder_.Record(hello_.inputBytes, 1, RequestPriority::STANDARD, 1, request.timeoutMs);
+    if (drainRequested_) {
+        connection->ReleaseSlot(request.slot);
+        Reply(connection, request, RequestStatus::DRAINING);
+        return true;
+    }
+    if (pending_.fetch_add(1) >= config_.maxPending) {
+        pending_--;
+        connection->ReleaseSlot(request.slot);
+        Reply(connection, request, RequestStatus::BUSY);
+        return true;
+    }
+    size_t group = nextGroup_.fetch_add(1) % pool_->GetDeviceCount();
+    pool_->Submit(group, [this, connection, request, receivedTime](Model2 &model) {
+        ExecuteRequest(model, connection, request, receivedTime);
+    });
+    return true;
+}
+
+void InferenceServer::ExecuteRequest(Model2 &model, const ConnectionPtr &connection, const RequestMessage &request,
+                                     Clock::time_point receivedTime)
+{
+    auto startTime = Clock::now();
+    ResponseMessage response;
+    response.slot = request.slot;
+    response.requestId = request.requestId;
+    response.queueUs = ElapsedUs(receivedTime, startTime);
+    bool dropped = connection->closed;
+    if (dropped) {
+        // 对端已关闭，结果无人读取
+    } else if (request.timeoutMs != 0 && response.queueUs > request.timeoutMs * 1000ULL) {
+        response.status = RequestStatus::TIMEOUT;
+    } else {
+        bool bound = model.BindInput(Model2::IN_TENSOR_X, connection->ring.GetInput(request.slot),
+                                     hello_.inputBytes, BufferLocation::HOST) &&
+                     model.BindOutput(Model2::OUT_TENSOR_LN_MATMUL, connection->ring.GetOutput(request.slot),
+                                      hello_.outputBytes, BufferLocation::HOST);
+        CHECK_RET(!bound, "bind shm slot failed");
+        model.Execute();
+        response.status = RequestStatus::OK;
+    }
+    response.executeUs = ElapsedUs(startTime, Clock::now());
+
+    // 先释放slot和排队名额再回复，客户端收到回复后可以立即复用该slot
+    connection->ReleaseSlot(request.slot);
+    pending_--;
+    if (dropped) {
+        std::unique_lock<std::mutex> lock(statsMutex_);
+        stats_.dropped++;
+        return;
+    }
+    SendMessage(connection->fd, &response, sizeof(response));
+    if (response.status == RequestStatus::OK && GetMetrics().IsEnabled()) {
+        requestLatency_.Record(Clock::now() - receivedTime);
+    }
+    CountStatus(response.status);
+}
+
+void InferenceServer::Reply(const ConnectionPtr &connection, const RequestMessage &request, RequestStatus status)
+{
+    ResponseMessage response;
+    response.slot = request.slot;
+    response.requestId = request.requestId;
+    response.status = status;
+    SendMessage(connection->fd, &response, sizeof(response));
+    CountStatus(status);
+}
+
+void InferenceServer::CountStatus(RequestStatus status)
+{
+    std::unique_lock<std::mutex> lock(statsMutex_);
+    switch (status) {
+        case RequestStatus::OK:
+            stats_.completed++;
+            break;
+        case RequestStatus::BUSY:
+            stats_.busy++;
+            break;
+        case RequestStatus::TIMEOUT:
+            stats_.timeout++;
+            break;
+        case RequestStatus::DRAINING:
+            stats_.draining++;
+            break;
+        default:
+            stats_.invalid++;
+            break;
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef INFERENCE_SERVER_H
+#define INFERENCE_SERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "model/model2.h"
+#include "runtime/device_worker_pool.h"
+#include "runtime/request_trace.h"
+#include "runtime/server_protocol.h"
+#include "utils/metrics.h"
+#include "utils/metrics_exporter.h"
+
+// 本地推理服务的配置
+struct ServerConfig
+{
+    std::string socketPath = "/tmp/transformer_block.sock";
+    std::vector<uint32_t> deviceIds;  // 为空时使用全部device
+    uint32_t workersPerDevice = 2;
+    uint32_t slotsPerConnection = 8;  // 每个连接共享内存环的slot个数
+    uint32_t maxPending = 32;         // 所有连接排队+执行中的请求上限，超过时直接回复BUSY
+    uint32_t maxConnections = 16;     // 同时保持的连接上限，超过时拒绝新连接
+    std::string tracePath;            // 不为空时把每个请求的到达时间和元数据记录到该文件，用replay_trace回放
+    uint16_t metricsPort = 0;         // 不为0时在127.0.0.1的该端口上以HTTP提供/metrics
+    std::string metricsFile;          // 不为空时定期把指标写入该文件
+    uint32_t metricsIntervalMs = 1000; // 写指标文件的间隔
+};
+
+// 本地推理服务的请求统计
+struct ServerStats
+{
+    uint64_t connections = 0; // 累计接受的连接数
+    uint64_t completed = 0;   // 执行完成的请求数
+    uint64_t busy = 0;        // 因排队已满回复BUSY的请求数
+    uint64_t timeout = 0;     // 开始执行前已超时的请求数
+    uint64_t draining = 0;    // 排空期间拒绝的请求数
+    uint64_t invalid = 0;     // 格式错误或slot冲突的请求数
+    uint64_t dropped = 0;     // 连接关闭后未执行的请求数
+};
+
+/**
+ * 本地推理服务
+ * 在Unix域socket上接收请求，每个连接有一个共享内存环（ShmRing），整块注册为pinned内存，
+ * 模型的输入输出通过BindInput/BindOutput以HOST方式绑定到请求所在的slot，
+ * 数据在模型的stream上直接在slot和device之间拷贝，不经过socket也不经过额外的host缓冲。
+ * 请求按device轮询提交到常驻的DeviceWorkerPool<Model2>执行；
+ * 排队+执行中的请求达到maxPending时新请求直接回复BUSY（背压），
+ * 请求的超时时间在开始执行前检查，已超时的请求不再执行。
+ * 配置了metricsPort或metricsFile时开启指标并导出，排空完成时最后写一次指标文件。
+ */
+class InferenceServer
+{
+public:
+    explicit InferenceServer(const ServerConfig &config);
+
+    ~InferenceServer();
+
+    InferenceServer(const InferenceServer &) = delete;
+    InferenceServer &operator=(const InferenceServer &) = delete;
+
+    /**
+     * 启动工作线程池并在socketPath上监听，阻塞到排空完成
+     * 需要在aclInit和创建内存池之后调用
+     * @return 启动失败时返回false
+     */
+    bool Run();
+
+    /**
+     * 请求优雅退出：停止接受新连接，新请求回复DRAINING，已接收的请求执行并回复后Run返回
+     * 只写一个原子变量，可以在信号处理函数中调用
+     */
+    void RequestDrain();
+
+    /**
+     * 获取请求统计
+     */
+    ServerStats GetStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Connection;
+    using ConnectionPtr = std::shared_ptr<Connection>;
+
+    bool Listen();
+    void CloseListen();
+    void AcceptConnection(std::vector<ConnectionPtr> &connections);
+
+    // 读取并处理连接上的一个请求，连接已关闭时返回false
+    bool HandleMessage(const ConnectionPtr &connection);
+
+    // 在工作线程上执行一个请求并回复
+    void ExecuteRequest(Model2 &model, const ConnectionPtr &connection, const RequestMessage &request,
+                        Clock::time_point receivedTime);
+
+    // 不执行，直接回复
+    void Reply(const ConnectionPtr &connection, const RequestMessage &request, RequestStatus status);
+
+    void CountStatus(RequestStatus status);
+
+    ServerConfig config_;
+    std::unique_ptr<DeviceWorkerPool<Model2>> pool_;
+    HelloMessage hello_;
+    int listenFd_ = -1;
+    std::atomic<bool> drainRequested_{false};
+    std::atomic<uint32_t> pending_{0};       // 已提交到工作线程池但尚未回复的请求数
+    std::atomic<uint64_t> nextGroup_{0};     // 轮询提交的device下标
+    mutable std::mutex statsMutex_;          // 保护stats_
+    ServerStats stats_;
+    TraceRecorder recorder_;
+    LatencyHistogram &requestLatency_;       // 成功请求从收到到回复的时间
+    MetricsExporter exporter_;
+};
+
+#endif
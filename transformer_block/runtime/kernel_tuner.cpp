@@ -0,0 +1,237 @@
+#include "runtime/kernel_tuner.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "utils/log.h"
+#include "utils/utils.h"
+
+static KernelTuner g_kernelTuner;
+
+constexpr const char *TUNING_CACHE_HEADER = "# kernel tuning cache v1: <key> <variant> <time_us>";
+
+bool TuningCache::Load(const std::string &path)
+{
+    entries_.clear();
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return true;
+    }
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string key;
+        TuneRecord record;
+        if (!(fields >> key >> record.variant >> record.timeUs)) {
+            LOG_ERROR("invalid tuning cache line " + std::to_string(lineNumber) + " in " + path);
+            entries_.clear();
+            return false;
+        }
+        entries_[key] = record;
+    }
+    return true;
+}
+
+bool TuningCache::Save(const std::string &path) const
+{
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_ERROR("open tuning cache " + tmpPath + " failed");
+            return false;
+        }
+        file << TUNING_CACHE_HEADER << "\n";
+        for (const auto &entry : entries_) {
+            file << entry.first << " " << entry.second.variant << " " << entry.second.timeUs << "\n";
+        }
+        if (!file.good()) {
+            LOG_ERROR("write tuning cache " + tmpPath + " failed");
+            return false;
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        LOG_ERROR("rename tuning cache to " + path + " failed");
+        return false;
+    }
+    return true;
+}
+
+bool TuningCache::Lookup(const std::string &key, TuneRecord &record) const
+{
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return false;
+    }
+    record = it->second;
+    return true;
+}
+
+void TuningCache::Store(const std::string &key, const TuneRecord &record)
+{
+    entries_[key] = record;
+}
+
+std::string MakeTuneKey(const std::string &op, const std::vector<int64_t> &dims, const std::string &dtype)
+{
+    std::string shape;
+    for (size_t i = 0; i < dims.size(); i++) {
+        shape += (i == 0 ? "" : "x") + std::to_string(dims[i]);
+    }
+    return op + "|" + shape + "|" + dtype;
+}
+
+const char *AutotuneModeToString(AutotuneMode mode)
+{
+    switch (mode) {
+        case AutotuneMode::CACHED:
+            return "cached";
+        case AutotuneMode::TUNE:
+            return "tune";
+        default:
+            return "off";
+    }
+}
+
+bool ParseAutotuneMode(const std::string &text, AutotuneMode &mode)
+{
+    for (AutotuneMode candidate : {AutotuneMode::OFF, AutotuneMode::CACHED, AutotuneMode::TUNE}) {
+        if (text == AutotuneModeToString(candidate)) {
+            mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void KernelTuner::SetMode(AutotuneMode mode)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    mode_ = mode;
+}
+
+AutotuneMode KernelTuner::GetMode() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return mode_;
+}
+
+bool KernelTuner::OpenCache(const std::string &path)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cachePath_ = path;
+    bool loaded = cache_.Load(path);
+    LOG_INFO("tuning cache " + path + " loaded, entries: " + std::to_string(cache_.Size()));
+    return loaded;
+}
+
+std::string KernelTuner::Choose(const std::string &key, const std::string &defaultVariant) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    TuneRecord record;
+    if (mode_ == AutotuneMode::OFF || !cache_.Lookup(key, record)) {
+        return defaultVariant;
+    }
+    return record.variant;
+}
+
+bool KernelTuner::NeedsTuning(const std::string &key) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    TuneRecord record;
+    return mode_ == AutotuneMode::TUNE && !cache_.Lookup(key, record);
+}
+
+// 计时的中位数
+static double MeasureMedianUs(const TuneCandidate &candidate, const TuneOptions &options)
+{
+    for (uint32_t i = 0; i < options.warmupCount; i++) {
+        candidate.run();
+    }
+    std::vector<double> times;
+    for (uint32_t i = 0; i < std::max(options.repeatCount, 1U); i++) {
+        times.push_back(candidate.run());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+// 返回最大绝对误差，超出容差或长度不一致时withinTolerance为false
+static double CompareOutput(const std::vector<float> &reference, const std::vector<float> &actual,
+                            const TuneTolerance &tolerance, bool &withinTolerance)
+{
+    withinTolerance = reference.size() == actual.size();
+    double maxAbsError = 0;
+    for (size_t i = 0; withinTolerance && i < reference.size(); i++) {
+        double error = std::fabs(static_cast<double>(actual[i]) - reference[i]);
+        maxAbsError = std::max(maxAbsError, error);
+        withinTolerance = error <= tolerance.absTol + tolerance.relTol * std::fabs(reference[i]);
+    }
+    return maxAbsError;
+}
+
+TuneReport KernelTuner::Tune(const std::string &key, const std::vector<TuneCandidate> &candidates,
+                             const TuneOptions &options)
+{
+    std::unique_lock<std::mutex> tuneLock(tuneMutex_);
+    TuneReport report;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        TuneRecord record;
+        if (cache_.Lookup(key, record)) {
+            report.chosen = record.variant;
+            report.fromCache = true;
+            return report;
+        }
+    }
+    CHECK_RET(candidates.empty(), "no candidate to tune for " + key);
+
+    std::vector<float> reference;
+    double bestUs = 0;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        const TuneCandidate &candidate = candidates[i];
+        CandidateResult result;
+        result.name = candidate.name;
+        result.medianUs = MeasureMedianUs(candidate, options);
+        result.accepted = true;
+        if (candidate.output != nullptr) {
+            if (i == 0) {
+                reference = candidate.output();
+            } else {
+                result.maxAbsError = CompareOutput(reference, candidate.output(), options.tolerance, result.accepted);
+            }
+        }
+        if (result.accepted && (report.chosen.empty() || result.medianUs < bestUs)) {
+            report.chosen = result.name;
+            bestUs = result.medianUs;
+        }
+        LOG_INFO("tune " + key + " candidate " + result.name + ": " + std::to_string(result.medianUs) +
+                 " us, max abs error " + std::to_string(result.maxAbsError) +
+                 (result.accepted ? "" : ", out of tolerance"));
+        report.candidates.push_back(result);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cache_.Store(key, {report.chosen, bestUs});
+    if (!cachePath_.empty()) {
+        cache_.Save(cachePath_);
+    }
+    return report;
+}
+
+void KernelTuner::Reset()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cache_ = TuningCache();
+}
+
+KernelTuner &GetKernelTuner()
+{
+    return g_kernelTuner;
+}
@@ -0,0 +1,161 @@
+#ifndef KERNEL_TUNER_H
+#define KERNEL_TUNER_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * 算子实现的自动选择
+ * 同一计算有多种实现（atb Linear与aclnn matmul、Gelu精确与tanh近似、融合与分开的节点），
+ * 按(算子, 形状, dtype)在预热时对各候选实现计时，选出输出在容差内且最快的一个，记录到调优缓存文件。
+ * 构图时通过Choose查询缓存中的选择，没有记录时使用默认实现。
+ * 本文件只依赖host代码，候选实现的执行和计时由调用方提供，可以用合成的耗时测试。
+ */
+
+enum class AutotuneMode
+{
+    OFF = 0, // 始终使用默认实现，不读缓存
+    CACHED,  // 使用缓存中的选择，没有记录时使用默认实现
+    TUNE,    // 没有记录时在构图前计时选择并写入缓存
+};
+
+// 候选实现
+struct TuneCandidate
+{
+    std::string name;
+    // 执行一次并返回耗时（微秒）
+    std::function<double()> run;
+    // 最近一次执行的输出，与第一个候选（参考实现）比较；为空时不检查
+    std::function<std::vector<float>()> output;
+};
+
+// |actual - reference| <= absTol + relTol * |reference| 时认为一致
+struct TuneTolerance
+{
+    double absTol = 1e-3;
+    double relTol = 1e-2;
+};
+
+struct TuneOptions
+{
+    uint32_t warmupCount = 3;  // 不计时的预热次数
+    uint32_t repeatCount = 10; // 计时次数，取中位数
+    TuneTolerance tolerance;
+};
+
+// 缓存中一个key的选择
+struct TuneRecord
+{
+    std::string variant;
+    double timeUs = 0; // 选中实现的中位耗时
+};
+
+// 一个候选实现的计时结果
+struct CandidateResult
+{
+    std::string name;
+    double medianUs = 0;
+    double maxAbsError = 0; // 与参考实现输出的最大绝对误差
+    bool accepted = false;  // 输出在容差内
+};
+
+struct TuneReport
+{
+    std::string chosen;
+    bool fromCache = false; // 已有记录，没有计时
+    std::vector<CandidateResult> candidates;
+};
+
+/**
+ * 调优缓存文件，文本格式，每行一个key：<key> <variant> <timeUs>，#开头的行为注释
+ */
+class TuningCache
+{
+public:
+    /**
+     * 读取缓存文件，文件不存在时为空缓存
+     * @return 文件存在但格式错误时返回false
+     */
+    bool Load(const std::string &path);
+
+    /**
+     * 先写临时文件再rename，读取方不会看到写了一半的文件
+     */
+    bool Save(const std::string &path) const;
+
+    bool Lookup(const std::string &key, TuneRecord &record) const;
+
+    void Store(const std::string &key, const TuneRecord &record);
+
+    size_t Size() const
+    {
+        return entries_.size();
+    }
+
+private:
+    std::map<std::string, TuneRecord> entries_;
+};
+
+/**
+ * 生成缓存的key，如 linear|1x197x768x2304|fp16
+ */
+std::string MakeTuneKey(const std::string &op, const std::vector<int64_t> &dims, const std::string &dtype);
+
+const char *AutotuneModeToString(AutotuneMode mode);
+
+// 解析off/cached/tune，失败时返回false
+bool ParseAutotuneMode(const std::string &text, AutotuneMode &mode);
+
+/**
+ * 调优器，Choose/Tune可以在多个工作线程上并发调用，同一时间只有一个Tune在计时
+ */
+class KernelTuner
+{
+public:
+    void SetMode(AutotuneMode mode);
+
+    AutotuneMode GetMode() const;
+
+    /**
+     * 设置缓存文件并读取，之后每次Tune后写回该文件
+     * @return 文件格式错误时返回false
+     */
+    bool OpenCache(const std::string &path);
+
+    /**
+     * 构图时调用：返回缓存中的选择，没有记录或mode为OFF时返回defaultVariant
+     */
+    std::string Choose(const std::string &key, const std::string &defaultVariant) const;
+
+    /**
+     * mode为TUNE且缓存中没有该key的记录
+     */
+    bool NeedsTuning(const std::string &key) const;
+
+    /**
+     * 对候选实现计时并把选择写入缓存，已有记录时直接返回记录
+     * 第一个候选为参考实现，输出超出容差的候选不会被选中
+     */
+    TuneReport Tune(const std::string &key, const std::vector<TuneCandidate> &candidates,
+                    const TuneOptions &options = TuneOptions());
+
+    /**
+     * 清空内存中的记录，不修改缓存文件
+     */
+    void Reset();
+
+private:
+    mutable std::mutex mutex_; // 保护mode_、cache_和cachePath_
+    std::mutex tuneMutex_;     // 计时互斥，避免多个工作线程同时计时互相干扰
+    AutotuneMode mode_ = AutotuneMode::OFF;
+    TuningCache cache_;
+    std::string cachePath_;
+};
+
+KernelTuner &GetKernelTuner();
+
+#endif
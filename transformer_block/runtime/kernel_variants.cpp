@@ -0,0 +1,326 @@
+#include "runtime/kernel_variants.h"
+#include <memory>
+#include <random>
+#include <utility>
+#include "aclnn/aclnn_fused_ops.h"
+#include "aclnn/aclnn_gelu_operation.h"
+#include "utils/tensor_io.h"
+#include "utils/utils.h"
+
+// 随机输入的范围与main_fused_ops一致
+constexpr float ACTIVATION_RANGE = 1.0f;
+constexpr float WEIGHT_RANGE = 0.1f;
+constexpr uint32_t TUNING_SEED = 0;
+
+// 各实现的累加顺序不同，fp16输出按绝对误差比较
+static TuneOptions MatmulTuneOptions()
+{
+    TuneOptions options;
+    options.tolerance.absTol = 1e-2;
+    return options;
+}
+
+// tanh近似与erf的差异不超过约5e-4，在该容差内可以被选中
+static TuneOptions GeluTuneOptions()
+{
+    TuneOptions options;
+    options.tolerance.absTol = 2e-3;
+    return options;
+}
+
+/**
+ * 在给定输入上反复执行一个候选算子，device时间由前后的event得到
+ */
+class OperationRunner
+{
+public:
+    OperationRunner(atb::Operation *operation, const TuningDevice &device, const atb::SVector<atb::Tensor> &inTensors)
+        : operation_(operation), device_(device)
+    {
+        variantPack_.inTensors = inTensors;
+        atb::SVector<atb::TensorDesc> inDescs;
+        for (const auto &tensor : inTensors) {
+            inDescs.push_back(tensor.desc);
+        }
+        atb::SVector<atb::TensorDesc> outDescs;
+        outDescs.resize(operation_->GetOutputNum());
+        auto status = operation_->InferShape(inDescs, outDescs);
+        CHECK_RET(status, operation_->GetName() + " InferShape failed. status: " + std::to_string(status));
+        for (auto &desc : outDescs) {
+            atb::Tensor tensor;
+            CreateTensorFromDesc(tensor, desc);
+            variantPack_.outTensors.push_back(tensor);
+        }
+        CHECK_RET(aclrtCreateEvent(&start_) != ACL_SUCCESS || aclrtCreateEvent(&end_) != ACL_SUCCESS,
+                  "create tuning event failed");
+    }
+
+    ~OperationRunner()
+    {
+        for (auto &tensor : variantPack_.outTensors) {
+            aclrtFree(tensor.deviceData);
+        }
+        aclrtFree(workspace_);
+        aclrtDestroyEvent(start_);
+        aclrtDestroyEvent(end_);
+        atb::DestroyOperation(operation_);
+    }
+
+    OperationRunner(const OperationRunner &) = delete;
+    OperationRunner &operator=(const OperationRunner &) = delete;
+
+    // 执行一次，返回device耗时（微秒）
+    double Run()
+    {
+        uint64_t workspaceSize = 0;
+        auto status = operation_->Setup(variantPack_, workspaceSize, device_.context);
+        CHECK_RET(status, operation_->GetName() + " Setup failed. status: " + std::to_string(status));
+        if (workspaceSize > workspaceSize_) {
+            aclrtFree(workspace_);
+            status = aclrtMalloc(&workspace_, workspaceSize, ACL_MEM_MALLOC_HUGE_FIRST);
+            CHECK_RET(status, "aclrtMalloc tuning workspace failed. status: " + std::to_string(status));
+            workspaceSize_ = workspaceSize;
+        }
+        aclrtRecordEvent(start_, device_.stream);
+        status = operation_->Execute(variantPack_, static_cast<uint8_t *>(workspace_), workspaceSize, device_.context);
+        CHECK_RET(status, operation_->GetName() + " Execute failed. status: " + std::to_string(status));
+        aclrtRecordEvent(end_, device_.stream);
+        status = aclrtSynchronizeStream(device_.stream);
+        CHECK_RET(status, "aclrtSynchronizeStream failed. status: " + std::to_string(status));
+        float elapsedMs = 0;
+        aclrtEventElapsedTime(&elapsedMs, start_, end_);
+        return elapsedMs * 1000.0;
+    }
+
+    std::vector<float> Output() const
+    {
+        return DownloadTensor(variantPack_.outTensors.at(0));
+    }
+
+private:
+    atb::Operation *operation_;
+    TuningDevice device_;
+    atb::VariantPack variantPack_;
+    void *workspace_ = nullptr;
+    uint64_t workspaceSize_ = 0;
+    aclrtEvent start_ = nullptr;
+    aclrtEvent end_ = nullptr;
+};
+
+static atb::TensorDesc Fp16Desc(const std::vector<int64_t> &dims)
+{
+    atb::TensorDesc desc;
+    desc.dtype = ACL_FLOAT16;
+    desc.format = ACL_FORMAT_ND;
+    desc.shape.dimNum = dims.size();
+    for (size_t i = 0; i < dims.size(); i++) {
+        desc.shape.dims[i] = dims[i];
+    }
+    return desc;
+}
+
+// 创建输入并填入[-range, range]的随机数，各候选共用
+static atb::SVector<atb::Tensor> CreateRandomInputs(const std::vector<std::pair<std::vector<int64_t>, float>> &inputs)
+{
+    std::mt19937 engine(TUNING_SEED);
+    atb::SVector<atb::Tensor> tensors;
+    for (const auto &input : inputs) {
+        atb::TensorDesc desc = Fp16Desc(input.first);
+        atb::Tensor tensor;
+        CreateTensorFromDesc(tensor, desc);
+        std::uniform_real_distribution<float> dist(-input.second, input.second);
+        std::vector<float> hostData(atb::Utils::GetTensorNumel(tensor));
+        for (auto &value : hostData) {
+            value = dist(engine);
+        }
+        UploadTensor(tensor, hostData.data());
+        tensors.push_back(tensor);
+    }
+    return tensors;
+}
+
+// 第一个为参考实现
+static TuneReport TuneOperations(const std::string &key, const TuningDevice &device,
+                                 const std::vector<std::pair<std::string, atb::Operation *>> &operations,
+                                 const atb::SVector<atb::Tensor> &inTensors, const TuneOptions &options)
+{
+    std::vector<std::unique_ptr<OperationRunner>> runners;
+    std::vector<TuneCandidate> candidates;
+    for (const auto &operation : operations) {
+        CHECK_RET(operation.second == nullptr, "create tuning candidate " + operation.first + " failed");
+        runners.push_back(std::make_unique<OperationRunner>(operation.second, device, inTensors));
+        OperationRunner *runner = runners.back().get();
+        candidates.push_back({operation.first, [runner]() { return runner->Run(); },
+                              [runner]() { return runner->Output(); }});
+    }
+    TuneReport report = GetKernelTuner().Tune(key, candidates, options);
+    LOG_INFO("tune " + key + " chose " + report.chosen);
+    return report;
+}
+
+static void FreeTensors(atb::SVector<atb::Tensor> &tensors)
+{
+    for (auto &tensor : tensors) {
+        aclrtFree(tensor.deviceData);
+    }
+}
+
+static std::vector<int64_t> AppendDim(std::vector<int64_t> dims, int64_t n)
+{
+    dims.push_back(n);
+    return dims;
+}
+
+std::string LinearTuneKey(const std::vector<int64_t> &xDims, int64_t n)
+{
+    return MakeTuneKey("linear", AppendDim(xDims, n), "fp16");
+}
+
+std::string GeluTuneKey(const std::vector<int64_t> &dims)
+{
+    return MakeTuneKey("gelu", dims, "fp16");
+}
+
+std::string MatmulGeluTuneKey(const std::vector<int64_t> &xDims, int64_t n)
+{
+    return MakeTuneKey("matmul_gelu", AppendDim(xDims, n), "fp16");
+}
+
+static atb::Operation *CreateLinearVariant(LinearKernel kernel)
+{
+    if (kernel == LinearKernel::ACLNN_MATMUL) {
+        return new MatmulBiasOperation("MatmulBias");
+    }
+    atb::infer::LinearParam param;
+    param.transposeA = false;
+    param.transposeB = false;
+    param.hasBias = true;
+    atb::Operation *operation = nullptr;
+    auto status = atb::CreateOperation(param, &operation);
+    CHECK_RET(status, "linearParam CreateOperation failed. status: " + std::to_string(status));
+    return operation;
+}
+
+atb::Operation *CreateGeluVariant(const std::string &variant)
+{
+    AclnnGeluParam param;
+    if (variant == "gelu") {
+        param.geluApproximate = -1;
+    } else if (variant == "gelu_v2_erf") {
+        param.geluApproximate = 0;
+    } else if (variant == "gelu_v2_tanh") {
+        param.geluApproximate = 1;
+    } else {
+        LOG_ERROR("unknown gelu variant " + variant);
+        return nullptr;
+    }
+    return new GeluOperation("Gelu", param);
+}
+
+atb::Status CreateMatmulGeluVariant(const std::string &variant, atb::Operation **operation)
+{
+    if (variant == "fused") {
+        *operation = new MatmulGeluOperation("MatmulGelu");
+        return atb::NO_ERROR;
+    }
+    if (variant != "separate") {
+        LOG_ERROR("unknown matmul_gelu variant " + variant);
+        return atb::ERROR_INVALID_PARAM;
+    }
+    enum TensorId : uint32_t
+    {
+        IN_TENSOR_X = 0,
+        IN_TENSOR_WEIGHT,
+        IN_TENSOR_BIAS,
+        OUT_TENSOR_Y,
+        INTERNAL_TENSOR_LINEAR,
+    };
+    atb::GraphParam opGraph;
+    opGraph.name = "matmul_gelu_separate";
+    opGraph.inTensorNum = 3;
+    opGraph.outTensorNum = 1;
+    opGraph.internalTensorNum = 1;
+    opGraph.nodes.resize(2);
+    opGraph.nodes.at(0).operation = new MatmulBiasOperation("MatmulBias");
+    opGraph.nodes.at(0).inTensorIds = {IN_TENSOR_X, IN_TENSOR_WEIGHT, IN_TENSOR_BIAS};
+    opGraph.nodes.at(0).outTensorIds = {INTERNAL_TENSOR_LINEAR};
+    opGraph.nodes.at(1).operation = CreateGeluVariant("gelu");
+    opGraph.nodes.at(1).inTensorIds = {INTERNAL_TENSOR_LINEAR};
+    opGraph.nodes.at(1).outTensorIds = {OUT_TENSOR_Y};
+    return atb::CreateOperation(opGraph, operation);
+}
+
+TuneReport TuneLinearKernel(const TuningDevice &device, const std::vector<int64_t> &xDims, int64_t n)
+{
+    int64_t k = xDims.back();
+    atb::SVector<atb::Tensor> inTensors =
+        CreateRandomInputs({{xDims, ACTIVATION_RANGE}, {{k, n}, WEIGHT_RANGE}, {{n}, WEIGHT_RANGE}});
+    TuneReport report = TuneOperations(
+        LinearTuneKey(xDims, n), device,
+        {{LinearKernelToString(LinearKernel::ATB_LINEAR), CreateLinearVariant(LinearKernel::ATB_LINEAR)},
+         {LinearKernelToString(LinearKernel::ACLNN_MATMUL), CreateLinearVariant(LinearKernel::ACLNN_MATMUL)}},
+        inTensors, MatmulTuneOptions());
+    FreeTensors(inTensors);
+    return report;
+}
+
+TuneReport TuneGeluKernel(const TuningDevice &device, const std::vector<int64_t> &dims)
+{
+    atb::SVector<atb::Tensor> inTensors = CreateRandomInputs({{dims, ACTIVATION_RANGE}});
+    std::vector<std::pair<std::string, atb::Operation *>> operations;
+    for (const char *variant : {"gelu", "gelu_v2_erf", "gelu_v2_tanh"}) {
+        operations.push_back({variant, CreateGeluVariant(variant)});
+    }
+    TuneReport report = TuneOperations(GeluTuneKey(dims), device, operations, inTensors, GeluTuneOptions());
+    FreeTensors(inTensors);
+    return report;
+}
+
+TuneReport TuneMatmulGeluKernel(const TuningDevice &device, const std::vector<int64_t> &xDims, int64_t n)
+{
+    int64_t k = xDims.back();
+    atb::SVector<atb::Tensor> inTensors =
+        CreateRandomInputs({{xDims, ACTIVATION_RANGE}, {{k, n}, WEIGHT_RANGE}, {{n}, WEIGHT_RANGE}});
+    std::vector<std::pair<std::string, atb::Operation *>> operations;
+    for (const char *variant : {"fused", "separate"}) {
+        atb::Operation *operation = nullptr;
+        CreateMatmulGeluVariant(variant, &operation);
+        operations.push_back({variant, operation});
+    }
+    TuneReport report =
+        TuneOperations(MatmulGeluTuneKey(xDims, n), device, operations, inTensors, MatmulTuneOptions());
+    FreeTensors(inTensors);
+    return report;
+}
+
+LinearKernel ChooseLinearKernel(const TuningDevice &device, const std::vector<int64_t> &xDims, int64_t n)
+{
+    std::string key = LinearTuneKey(xDims, n);
+    if (GetKernelTuner().NeedsTuning(key)) {
+        TuneLinearKernel(device, xDims, n);
+    }
+    LinearKernel kernel = LinearKernel::ATB_LINEAR;
+    std::string variant = GetKernelTuner().Choose(key, LinearKernelToString(kernel));
+    if (!ParseLinearKernel(variant, kernel)) {
+        LOG_WARNING("unknown linear kernel " + variant + " in tuning cache, use atb_linear");
+    }
+    return kernel;
+}
+
+std::string ChooseGeluVariant(const TuningDevice &device, const std::vector<int64_t> &dims)
+{
+    std::string key = GeluTuneKey(dims);
+    if (GetKernelTuner().NeedsTuning(key)) {
+        TuneGeluKernel(device, dims);
+    }
+    return GetKernelTuner().Choose(key, GELU_VARIANT_DEFAULT);
+}
+
+std::string ChooseMatmulGeluVariant(const TuningDevice &device, const std::vector<int64_t> &xDims, int64_t n)
+{
+    std::string key = MatmulGeluTuneKey(xDims, n);
+    if (GetKernelTuner().NeedsTuning(key)) {
+        TuneMatmulGeluKernel(device, xDims, n);
+    }
+    return GetKernelTuner().Choose(key, MATMUL_GELU_VARIANT_DEFAULT);
+}
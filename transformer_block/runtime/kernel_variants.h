@@ -0,0 +1,57 @@
+#ifndef KERNEL_VARIANTS_H
+#define KERNEL_VARIANTS_H
+
+#include <string>
+#include <vector>
+#include <acl/acl.h>
+#include <atb/atb_infer.h>
+#include "atb/atb_graph_layer_norm.h"
+#include "runtime/kernel_tuner.h"
+
+/**
+ * 可由KernelTuner选择的算子实现，以及在device上对它们计时的候选
+ *   linear       atb_linear（默认）/ aclnn_matmul，见LinearKernel
+ *   gelu         gelu（aclnnGelu，默认）/ gelu_v2_erf / gelu_v2_tanh（tanh近似）
+ *   matmul_gelu  fused（MatmulGelu一个节点，默认）/ separate（MatmulBias + Gelu两个节点）
+ * 输入为fp16，key的形状为x的各维加上输出维n（linear、matmul_gelu）
+ * Tune*在KernelTuner需要调优时用随机数据计时并写入缓存，返回选择的实现；
+ * 计时使用调用方的stream和context，需在构图线程上、模型执行前调用
+ */
+
+constexpr const char *GELU_VARIANT_DEFAULT = "gelu";
+constexpr const char *MATMUL_GELU_VARIANT_DEFAULT = "fused";
+
+// 计时使用的device资源
+struct TuningDevice
+{
+    atb::Context *context = nullptr;
+    aclrtStream stream = nullptr;
+};
+
+std::string LinearTuneKey(const std::vector<int64_t> &xDims, int64_t n);
+std::string GeluTuneKey(const std::vector<int64_t> &dims);
+std::string MatmulGeluTuneKey(const std::vector<int64_t> &xDims, int64_t n);
+
+/**
+ * 构图时查询的实现：TUNE模式下没有记录时先计时，其余情况返回缓存中的选择或默认实现
+ */
+LinearKernel ChooseLinearKernel(const TuningDevice &device, const std::vector<int64_t> &xDims, int64_t n);
+std::string ChooseGeluVariant(const TuningDevice &device, const std::vector<int64_t> &dims);
+std::string ChooseMatmulGeluVariant(const TuningDevice &device, const std::vector<int64_t> &xDims, int64_t n);
+
+// 对候选实现计时，不检查mode，已有记录时直接返回记录
+TuneReport TuneLinearKernel(const TuningDevice &device, const std::vector<int64_t> &xDims, int64_t n);
+TuneReport TuneGeluKernel(const TuningDevice &device, const std::vector<int64_t> &dims);
+TuneReport TuneMatmulGeluKernel(const TuningDevice &device, const std::vector<int64_t> &xDims, int64_t n);
+
+/**
+ * 按实现名创建Gelu算子，输入x，输出y；名字无效时返回nullptr
+ */
+atb::Operation *CreateGeluVariant(const std::string &variant);
+
+/**
+ * 按实现名创建y = Gelu(x @ weight + bias)，输入x, weight, bias，输出y
+ */
+atb::Status CreateMatmulGeluVariant(const std::string &variant, atb::Operation **operation);
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef MODEL_STEP_EXECUTOR_H
+#define MODEL_STEP_EXECUTOR_H
+
+#include <string>
+#include <acl/acl.h>
+#include <atb/types.h>
+#include "runtime/priority_scheduler.h"
+#include "utils/log.h"
+
+/**
+ * 在模型上执行的调度请求
+ * 一个请求独占一个模型实例直到完成，请求被抢占时执行进度保存在模型的节点中，
+ * 之后由任一工作线程从下一个节点继续执行
+ */
+template <typename ModelT>
+struct ModelStepRequest
+{
+    ModelT *model = nullptr;             // 执行请求的模型，已完成构图和输入输出的创建
+    int32_t deviceId = 0;                // 模型所在的device
+    atb::Status status = atb::NO_ERROR;  // 第一个失败的步骤的状态，失败后跳过剩余的节点
+    bool started = false;                // 是否已调用BeginSteps
+};
+
+/**
+ * 按节点分步执行模型的执行器，提交请求时stepCount取model->GetStepCount()
+ * 第一步前调用BeginSteps，每步调用RunStep执行一个节点，最后一步后调用EndSteps等待stream完成，
+ * 调度器在节点之间抢占BULK请求。ModelT为Model或Model2
+ */
+template <typename ModelT>
+class ModelStepExecutor : public StepExecutor<ModelStepRequest<ModelT>>
+{
+public:
+    void RunStep(ModelStepRequest<ModelT> &request, uint32_t step) override
+    {
+        bool bound = BindDevice(request.deviceId);
+        if (!bound) {
+            request.status = atb::ERROR_INVALID_PARAM;
+        }
+        if (step == 0 && request.status == atb::NO_ERROR) {
+            request.model->BeginSteps();
+            request.started = true;
+        }
+        if (request.status == atb::NO_ERROR) {
+            request.status = request.model->RunStep(step);
+        }
+        // 没有绑定device的线程不能同步stream
+        if (step + 1 == request.model->GetStepCount() && request.started && bound) {
+            request.model->EndSteps();
+        }
+    }
+
+private:
+    // 工作线程第一次执行某个device上的请求时绑定该device，之后随线程保持
+    static bool BindDevice(int32_t deviceId)
+    {
+        static thread_local int32_t boundDeviceId = -1;
+        if (boundDeviceId == deviceId) {
+            return true;
+        }
+        auto ret = aclrtSetDevice(deviceId);
+        if (ret != ACL_SUCCESS) {
+            LOG_ERROR("scheduler worker aclrtSetDevice failed. ret: " + std::to_string(ret));
+            return false;
+        }
+        boundDeviceId = deviceId;
+        return true;
+    }
+};
+
+#endif
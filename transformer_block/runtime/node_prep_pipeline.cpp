@@ -0,0 +1,108 @@
+#include "runtime/node_prep_pipeline.h"
+#include <acl/acl.h>
+#include "utils/log.h"
+
+NodePrepPipeline::~NodePrepPipeline()
+{
+    Stop();
+}
+
+void NodePrepPipeline::Start(int32_t deviceId)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (thread_.joinable()) {
+        return;
+    }
+    stop_ = false;
+    thread_ = std::thread([this, deviceId] { PrepLoop(deviceId); });
+}
+
+void NodePrepPipeline::Stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!thread_.joinable()) {
+            return;
+        }
+        stop_ = true;
+    }
+    jobCv_.notify_all();
+    thread_.join();
+}
+
+bool NodePrepPipeline::IsRunning() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return thread_.joinable() && !stop_;
+}
+
+atb::Status NodePrepPipeline::Run(size_t nodeCount, const NodeFunc &prepare, const NodeFunc &launch)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!thread_.joinable()) {
+        LOG_ERROR("node prep pipeline is not started");
+        return atb::ERROR_INVALID_PARAM;
+    }
+    prepare_ = &prepare;
+    nodeCount_ = nodeCount;
+    prepared_ = 0;
+    cancelled_ = false;
+    prepareStatus_ = atb::NO_ERROR;
+    uint64_t seq = ++jobSeq_;
+    jobCv_.notify_all();
+
+    atb::Status status = atb::NO_ERROR;
+    for (size_t nodeId = 0; nodeId < nodeCount; nodeId++) {
+        preparedCv_.wait(lock, [this, nodeId] { return prepared_ > nodeId || prepareStatus_ != atb::NO_ERROR; });
+        if (prepared_ <= nodeId) {
+            status = prepareStatus_;
+            break;
+        }
+        lock.unlock();
+        status = launch(nodeId);
+        lock.lock();
+        if (status != atb::NO_ERROR) {
+            cancelled_ = true;
+            break;
+        }
+    }
+    // prepare引用调用方的状态，需等准备线程结束本次Run后再返回
+    preparedCv_.wait(lock, [this, seq] { return doneSeq_ == seq; });
+    prepare_ = nullptr;
+    return status;
+}
+
+void NodePrepPipeline::PrepLoop(int32_t deviceId)
+{
+    // 准备阶段会分配device内存，内存池按当前线程的device选择
+    auto ret = aclrtSetDevice(deviceId);
+    if (ret != ACL_SUCCESS) {
+        LOG_ERROR("node prep thread aclrtSetDevice failed. ret: " + std::to_string(ret));
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        jobCv_.wait(lock, [this] { return stop_ || jobSeq_ != doneSeq_; });
+        if (jobSeq_ == doneSeq_) {
+            break;
+        }
+        for (size_t nodeId = 0; nodeId < nodeCount_ && !cancelled_; nodeId++) {
+            const NodeFunc &prepare = *prepare_;
+            lock.unlock();
+            atb::Status status = ret == ACL_SUCCESS ? prepare(nodeId) : atb::ERROR_INVALID_PARAM;
+            lock.lock();
+            if (status != atb::NO_ERROR) {
+                prepareStatus_ = status;
+                preparedCv_.notify_all();
+                break;
+            }
+            prepared_ = nodeId + 1;
+            preparedCv_.notify_all();
+        }
+        doneSeq_ = jobSeq_;
+        preparedCv_.notify_all();
+    }
+    lock.unlock();
+    if (ret == ACL_SUCCESS) {
+        aclrtResetDevice(deviceId);
+    }
+}
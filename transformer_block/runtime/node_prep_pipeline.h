@@ -0,0 +1,74 @@
+#ifndef NODE_PREP_PIPELINE_H
+#define NODE_PREP_PIPELINE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <atb/types.h>
+
+/**
+ * 节点执行的两级host流水
+ * 准备线程按节点顺序执行prepare（InferShape、分配输出、Setup、workspace），不等待device，
+ * 调用线程只对已准备好的节点执行launch（把任务下发到stream）。
+ * 串行执行时每个节点的host耗时是准备与下发之和，流水后为两者中较大的一个，
+ * 首次遇到新形状等Setup较慢的情况下，device在节点之间等待host的时间随之减少。
+ * prepare与launch都只访问模型自己的节点，节点i的prepare在launch(i)之前完成，
+ * 之后的节点可以在launch(i)执行时准备；同一operation的Setup和Execute不会同时调用，
+ * 但不同节点的Setup和Execute会同时使用调用方的context，context需要支持多线程访问（见Model::SetHostPipeline）。
+ * 一个pipeline同一时间只执行一次Run。
+ */
+class NodePrepPipeline
+{
+public:
+    using NodeFunc = std::function<atb::Status(size_t nodeId)>;
+
+    NodePrepPipeline() = default;
+
+    ~NodePrepPipeline();
+
+    NodePrepPipeline(const NodePrepPipeline &) = delete;
+    NodePrepPipeline &operator=(const NodePrepPipeline &) = delete;
+
+    /**
+     * 启动准备线程，准备线程绑定deviceId，已启动时直接返回
+     */
+    void Start(int32_t deviceId);
+
+    /**
+     * 停止并回收准备线程，不能与Run同时调用
+     */
+    void Stop();
+
+    bool IsRunning() const;
+
+    /**
+     * 按节点顺序执行nodeCount个节点，返回时所有prepare都已结束
+     * 任一节点的prepare或launch失败后，不再准备和下发之后的节点
+     * @param prepare 在准备线程上执行
+     * @param launch 在调用线程上执行
+     * @return 第一个失败的status，全部成功时为atb::NO_ERROR
+     */
+    atb::Status Run(size_t nodeCount, const NodeFunc &prepare, const NodeFunc &launch);
+
+private:
+    void PrepLoop(int32_t deviceId);
+
+    mutable std::mutex mutex_;
+    std::condition_variable jobCv_;      // 准备线程等待新的Run
+    std::condition_variable preparedCv_; // 调用线程等待节点准备完成
+    std::thread thread_;
+    bool stop_ = false;
+
+    // 当前Run的状态，由mutex_保护
+    uint64_t jobSeq_ = 0;          // 已提交的Run次数
+    uint64_t doneSeq_ = 0;         // 准备线程已结束的Run次数
+    const NodeFunc *prepare_ = nullptr;
+    size_t nodeCount_ = 0;
+    size_t prepared_ = 0;          // 已准备完成的节点数
+    bool cancelled_ = false;       // launch失败后停止准备
+    atb::Status prepareStatus_ = atb::NO_ERROR;
+};
+
+#endif
@@ -0,0 +1,169 @@
+#include "runtime/pipeline_scheduler.h"
+#include <tuple>
+#include "utils/log.h"
+
+PipelineScheduler::PipelineScheduler(PipelineStageBackend &backend, size_t stageCount, size_t slotCount)
+    : backend_(backend), stageCount_(stageCount), slotCount_(slotCount == 0 ? 1 : slotCount)
+{
+    for (size_t stage = 0; stage < stageCount_; stage++) {
+        auto channel = std::make_unique<StageChannel>();
+        for (size_t slot = 0; slot < slotCount_; slot++) {
+            channel->freeSlots.push_back(slot);
+        }
+        channels_.push_back(std::move(channel));
+    }
+}
+
+PipelineScheduler::~PipelineScheduler()
+{
+    Stop();
+}
+
+void PipelineScheduler::Start()
+{
+    for (size_t stage = 0; stage < stageCount_; stage++) {
+        threads_.emplace_back([this, stage] { StageLoop(stage); });
+    }
+    std::unique_lock<std::mutex> lock(runMutex_);
+    runCv_.wait(lock, [this] { return readyCount_ == stageCount_; });
+    LOG_INFO("PipelineScheduler started with " + std::to_string(stageCount_) + " stages");
+}
+
+PipelineRunStats PipelineScheduler::Run(size_t microBatchCount)
+{
+    auto start = Clock::now();
+    std::unique_lock<std::mutex> lock(runMutex_);
+    runMicroBatchCount_ = microBatchCount;
+    finishedStages_ = 0;
+    runStats_.assign(stageCount_, PipelineStageStats());
+    runGeneration_++;
+    runCv_.notify_all();
+    runCv_.wait(lock, [this] { return finishedStages_ == stageCount_; });
+    std::chrono::duration<double, std::milli> makespan = Clock::now() - start;
+
+    PipelineRunStats stats;
+    stats.makespanMs = makespan.count();
+    stats.stages = runStats_;
+    double busyMs = 0;
+    for (const auto &stage : stats.stages) {
+        busyMs += stage.computeMs + stage.transferMs;
+    }
+    if (stats.makespanMs > 0 && stageCount_ > 0) {
+        stats.bubbleRatio = 1.0 - busyMs / (stageCount_ * stats.makespanMs);
+    }
+    return stats;
+}
+
+void PipelineScheduler::Stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(runMutex_);
+        stop_ = true;
+    }
+    runCv_.notify_all();
+    for (auto &thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+}
+
+void PipelineScheduler::StageLoop(size_t stage)
+{
+    backend_.InitStage(stage);
+    uint64_t generation = 0;
+    {
+        std::unique_lock<std::mutex> lock(runMutex_);
+        readyCount_++;
+        generation = runGeneration_;
+    }
+    runCv_.notify_all();
+
+    while (true) {
+        size_t microBatchCount = 0;
+        {
+            std::unique_lock<std::mutex> lock(runMutex_);
+            runCv_.wait(lock, [this, generation] { return stop_ || runGeneration_ != generation; });
+            if (stop_) {
+                break;
+            }
+            generation = runGeneration_;
+            microBatchCount = runMicroBatchCount_;
+        }
+        PipelineStageStats stats;
+        RunMicroBatches(stage, microBatchCount, stats);
+        {
+            std::unique_lock<std::mutex> lock(runMutex_);
+            runStats_[stage] = stats;
+            finishedStages_++;
+        }
+        runCv_.notify_all();
+    }
+    backend_.FreeStage(stage);
+}
+
+void PipelineScheduler::RunMicroBatches(size_t stage, size_t microBatchCount, PipelineStageStats &stats)
+{
+    for (size_t i = 0; i < microBatchCount; i++) {
+        auto waitStart = Clock::now();
+        size_t microBatch = i;
+        size_t inSlot = 0;
+        if (stage > 0) {
+            std::tie(microBatch, inSlot) = AcquireReadySlot(stage);
+        }
+        auto computeStart = Clock::now();
+        backend_.RunStage(stage, microBatch, inSlot);
+        auto computeEnd = Clock::now();
+        stats.waitMs += std::chrono::duration<double, std::milli>(computeStart - waitStart).count();
+        stats.computeMs += std::chrono::duration<double, std::milli>(computeEnd - computeStart).count();
+
+        if (stage > 0) {
+            // RunStage是同步的，输入槽已经被消费完，可以归还给上一stage
+            StageChannel &channel = *channels_[stage];
+            {
+                std::unique_lock<std::mutex> lock(channel.mutex);
+                channel.freeSlots.push_back(inSlot);
+            }
+            channel.cv.notify_all();
+        }
+        if (stage + 1 == stageCount_) {
+            continue;
+        }
+
+        // 下一stage没有空闲槽时阻塞，形成反压，避免上游无限超前
+        size_t dstSlot = AcquireFreeSlot(stage + 1);
+        auto transferStart = Clock::now();
+        backend_.TransferActivation(stage, microBatch, dstSlot);
+        auto transferEnd = Clock::now();
+        stats.waitMs += std::chrono::duration<double, std::milli>(transferStart - computeEnd).count();
+        stats.transferMs += std::chrono::duration<double, std::milli>(transferEnd - transferStart).count();
+
+        StageChannel &next = *channels_[stage + 1];
+        {
+            std::unique_lock<std::mutex> lock(next.mutex);
+            next.readySlots.emplace_back(microBatch, dstSlot);
+        }
+        next.cv.notify_all();
+    }
+}
+
+size_t PipelineScheduler::AcquireFreeSlot(size_t stage)
+{
+    StageChannel &channel = *channels_[stage];
+    std::unique_lock<std::mutex> lock(channel.mutex);
+    channel.cv.wait(lock, [&channel] { return !channel.freeSlots.empty(); });
+    size_t slot = channel.freeSlots.front();
+    channel.freeSlots.pop_front();
+    return slot;
+}
+
+std::pair<size_t, size_t> PipelineScheduler::AcquireReadySlot(size_t stage)
+{
+    StageChannel &channel = *channels_[stage];
+    std::unique_lock<std::mutex> lock(channel.mutex);
+    channel.cv.wait(lock, [&channel] { return !channel.readySlots.empty(); });
+    auto ready = channel.readySlots.front();
+    channel.readySlots.pop_front();
+    return ready;
+}
@@ -0,0 +1,181 @@
+#ifndef PIPELINE_SCHEDULER_H
+#define PIPELINE_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "runtime/stage_partitioner.h"
+
+/**
+ * 流水线stage的执行后端
+ * 每个stage绑定一个device，拥有slotCount个接收上一stage激活的输入槽
+ * 所有接口都在该stage的常驻线程上调用
+ */
+class PipelineStageBackend
+{
+public:
+    virtual ~PipelineStageBackend() = default;
+
+    /**
+     * 在stage线程上初始化device资源（context、stream、模型和输入槽）
+     */
+    virtual void InitStage(size_t stage) = 0;
+
+    /**
+     * 同步执行stage内的所有层，返回时输入槽已经可以复用
+     * @param stage stage下标
+     * @param microBatch micro-batch序号
+     * @param inSlot 输入槽下标，第一个stage从模型输入读取，忽略该参数
+     */
+    virtual void RunStage(size_t stage, size_t microBatch, size_t inSlot) = 0;
+
+    /**
+     * 把stage的输出激活同步拷贝到下一stage的输入槽
+     * @param stage 发送方stage下标
+     * @param microBatch micro-batch序号
+     * @param dstSlot 下一stage的输入槽下标
+     */
+    virtual void TransferActivation(size_t stage, size_t microBatch, size_t dstSlot) = 0;
+
+    /**
+     * 在stage线程上释放device资源
+     */
+    virtual void FreeStage(size_t stage) = 0;
+};
+
+// 单个stage在一次Run中的时间统计
+struct PipelineStageStats
+{
+    double computeMs = 0;  // RunStage耗时
+    double transferMs = 0; // TransferActivation耗时
+    double waitMs = 0;     // 等待上一stage激活或下一stage空闲输入槽的时间
+};
+
+// 一次Run的统计
+struct PipelineRunStats
+{
+    double makespanMs = 0;   // 所有micro-batch从开始到全部完成的时间
+    double bubbleRatio = 0;  // 1 - 总忙碌时间 / (stage数 * makespan)
+    std::vector<PipelineStageStats> stages;
+};
+
+/**
+ * 层间流水线调度器
+ * 每个stage一个常驻线程，micro-batch按顺序依次流过各stage，不同stage同时处理不同micro-batch。
+ * stage之间通过输入槽传递激活：发送方先占用下一stage的空闲槽再传输，
+ * 接收方执行完成后归还该槽，槽数即stage之间可以缓冲的micro-batch数。
+ */
+class PipelineScheduler
+{
+public:
+    /**
+     * 构造函数
+     * @param backend stage执行后端
+     * @param stageCount stage数量
+     * @param slotCount 每个stage的输入槽数量，至少为1，通常为2实现双缓冲
+     */
+    PipelineScheduler(PipelineStageBackend &backend, size_t stageCount, size_t slotCount);
+
+    ~PipelineScheduler();
+
+    PipelineScheduler(const PipelineScheduler &) = delete;
+    PipelineScheduler &operator=(const PipelineScheduler &) = delete;
+
+    /**
+     * 启动stage线程，阻塞到所有stage完成初始化
+     */
+    void Start();
+
+    /**
+     * 执行microBatchCount个micro-batch，阻塞到最后一个stage全部完成
+     */
+    PipelineRunStats Run(size_t microBatchCount);
+
+    /**
+     * 停止stage线程并释放stage资源
+     */
+    void Stop();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct StageChannel
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<size_t> freeSlots;                        // 可以写入的输入槽
+        std::deque<std::pair<size_t, size_t>> readySlots;   // 已写入的(micro-batch, 槽)
+    };
+
+    void StageLoop(size_t stage);
+    void RunMicroBatches(size_t stage, size_t microBatchCount, PipelineStageStats &stats);
+    size_t AcquireFreeSlot(size_t stage);
+    std::pair<size_t, size_t> AcquireReadySlot(size_t stage);
+
+    PipelineStageBackend &backend_;
+    size_t stageCount_;
+    size_t slotCount_;
+    std::vector<std::unique_ptr<StageChannel>> channels_;
+    std::vector<std::thread> threads_;
+
+    std::mutex runMutex_; // 保护以下成员
+    std::condition_variable runCv_;
+    size_t readyCount_ = 0;
+    uint64_t runGeneration_ = 0;
+    size_t runMicroBatchCount_ = 0;
+    size_t finishedStages_ = 0;
+    std::vector<PipelineStageStats> runStats_;
+    bool stop_ = false;
+};
+
+/**
+ * 仿真后端，按给定的每层耗时和传输耗时睡眠，用于在没有NPU的环境下验证切分和调度
+ */
+class SimulatedPipelineBackend : public PipelineStageBackend
+{
+public:
+    SimulatedPipelineBackend(std::vector<double> layerTimesMs, std::vector<StageRange> stages, double transferMs)
+        : layerTimesMs_(std::move(layerTimesMs)), stages_(std::move(stages)), transferMs_(transferMs)
+    {
+    }
+
+    void InitStage(size_t stage) override
+    {
+        (void)stage;
+    }
+
+    void RunStage(size_t stage, size_t microBatch, size_t inSlot) override
+    {
+        (void)microBatch;
+        (void)inSlot;
+        double timeMs = 0;
+        for (size_t layer = stages_[stage].beginLayer; layer < stages_[stage].endLayer; layer++) {
+            timeMs += layerTimesMs_[layer];
+        }
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(timeMs));
+    }
+
+    void TransferActivation(size_t stage, size_t microBatch, size_t dstSlot) override
+    {
+        (void)stage;
+        (void)microBatch;
+        (void)dstSlot;
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(transferMs_));
+    }
+
+    void FreeStage(size_t stage) override
+    {
+        (void)stage;
+    }
+
+private:
+    std::vector<double> layerTimesMs_;
+    std::vector<StageRange> stages_;
+    double transferMs_;
+};
+
+#endif
@@ -0,0 +1,185 @@
+#include "runtime/prefetch_scheduler.h"
+#include <algorithm>
+
+WeightPrefetchScheduler::WeightPrefetchScheduler(size_t layerCount, const StreamingConfig &config)
+    : layerCount_(layerCount), ringSize_(std::max<size_t>(config.ringSize, 1))
+{
+    effectiveDepth_ = std::min(config.prefetchDepth, ringSize_ - 1);
+    size_t nextPrefetch = 0;
+    for (size_t layer = 0; layer < layerCount_; layer++) {
+        // 计算当前层之前，先发射到layer + effectiveDepth_为止的拷贝
+        size_t limit = std::min(layerCount_, layer + effectiveDepth_ + 1);
+        for (; nextPrefetch < limit; nextPrefetch++) {
+            plan_.push_back({StreamingStepType::PREFETCH, nextPrefetch, nextPrefetch % ringSize_});
+        }
+        plan_.push_back({StreamingStepType::WAIT, layer, layer % ringSize_});
+        plan_.push_back({StreamingStepType::COMPUTE, layer, layer % ringSize_});
+    }
+}
+
+size_t WeightPrefetchScheduler::GetEffectiveDepth() const
+{
+    return effectiveDepth_;
+}
+
+size_t WeightPrefetchScheduler::GetRingSize() const
+{
+    return ringSize_;
+}
+
+size_t WeightPrefetchScheduler::GetLayerCount() const
+{
+    return layerCount_;
+}
+
+const std::vector<StreamingStep> &WeightPrefetchScheduler::GetPlan() const
+{
+    return plan_;
+}
+
+bool WeightPrefetchScheduler::Validate(std::string &error) const
+{
+    constexpr size_t NONE = static_cast<size_t>(-1);
+    std::vector<size_t> slotOwner(ringSize_, NONE);
+    std::vector<bool> prefetched(layerCount_, false);
+    std::vector<bool> waited(layerCount_, false);
+    std::vector<bool> computed(layerCount_, false);
+    for (const auto &step : plan_) {
+        std::string where = "layer " + std::to_string(step.layer) + " slot " + std::to_string(step.slot);
+        if (step.layer >= layerCount_ || step.slot >= ringSize_) {
+            error = "step out of range at " + where;
+            return false;
+        }
+        switch (step.type) {
+            case StreamingStepType::PREFETCH:
+                if (slotOwner[step.slot] != NONE && !computed[slotOwner[step.slot]]) {
+                    error = "prefetch overwrites uncomputed layer " + std::to_string(slotOwner[step.slot]) + " at " +
+                            where;
+                    return false;
+                }
+                slotOwner[step.slot] = step.layer;
+                prefetched[step.layer] = true;
+                break;
+            case StreamingStepType::WAIT:
+                if (!prefetched[step.layer]) {
+                    error = "wait before prefetch at " + where;
+                    return false;
+                }
+                waited[step.layer] = true;
+                break;
+            case StreamingStepType::COMPUTE:
+                if (!waited[step.layer] || slotOwner[step.slot] != step.layer) {
+                    error = "compute without its weights at " + where;
+                    return false;
+                }
+                computed[step.layer] = true;
+                break;
+        }
+    }
+    for (size_t layer = 0; layer < layerCount_; layer++) {
+        if (!computed[layer]) {
+            error = "layer " + std::to_string(layer) + " never computed";
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace {
+std::vector<TimeInterval> MergeIntervals(std::vector<TimeInterval> intervals)
+{
+    std::sort(intervals.begin(), intervals.end(),
+              [](const TimeInterval &a, const TimeInterval &b) { return a.begin < b.begin; });
+    std::vector<TimeInterval> merged;
+    for (const auto &interval : intervals) {
+        if (!merged.empty() && interval.begin <= merged.back().end) {
+            merged.back().end = std::max(merged.back().end, interval.end);
+        } else {
+            merged.push_back(interval);
+        }
+    }
+    return merged;
+}
+
+double TotalLength(const std::vector<TimeInterval> &intervals)
+{
+    double length = 0;
+    for (const auto &interval : intervals) {
+        length += interval.end - interval.begin;
+    }
+    return length;
+}
+} // namespace
+
+StreamingStats SummarizeStreaming(const std::vector<TimeInterval> &transfers,
+                                  const std::vector<TimeInterval> &computes)
+{
+    auto mergedTransfers = MergeIntervals(transfers);
+    auto mergedComputes = MergeIntervals(computes);
+    StreamingStats stats;
+    stats.transferMs = TotalLength(mergedTransfers);
+    stats.computeMs = TotalLength(mergedComputes);
+
+    // 两个有序且互不相交的区间序列求交集长度
+    size_t i = 0;
+    size_t j = 0;
+    while (i < mergedTransfers.size() && j < mergedComputes.size()) {
+        double begin = std::max(mergedTransfers[i].begin, mergedComputes[j].begin);
+        double end = std::min(mergedTransfers[i].end, mergedComputes[j].end);
+        if (end > begin) {
+            stats.overlapMs += end - begin;
+        }
+        if (mergedTransfers[i].end < mergedComputes[j].end) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+    if (stats.transferMs > 0) {
+        stats.overlapRatio = stats.overlapMs / stats.transferMs;
+    }
+
+    double first = 0;
+    double last = 0;
+    bool any = false;
+    for (const auto *list : {&mergedTransfers, &mergedComputes}) {
+        if (list->empty()) {
+            continue;
+        }
+        first = any ? std::min(first, list->front().begin) : list->front().begin;
+        last = any ? std::max(last, list->back().end) : list->back().end;
+        any = true;
+    }
+    stats.totalMs = last - first;
+    return stats;
+}
+
+StreamingStats SimulateStreaming(const WeightPrefetchScheduler &scheduler, const std::vector<double> &computeMs,
+                                 const std::vector<double> &transferMs)
+{
+    double hostTime = 0;
+    double copyStreamFree = 0;
+    std::vector<double> transferEnd(scheduler.GetLayerCount(), 0);
+    std::vector<TimeInterval> transfers;
+    std::vector<TimeInterval> computes;
+    for (const auto &step : scheduler.GetPlan()) {
+        switch (step.type) {
+            case StreamingStepType::PREFETCH: {
+                // 异步发射，拷贝流空闲后开始
+                double begin = std::max(hostTime, copyStreamFree);
+                copyStreamFree = begin + transferMs.at(step.layer);
+                transferEnd[step.layer] = copyStreamFree;
+                transfers.push_back({begin, copyStreamFree});
+                break;
+            }
+            case StreamingStepType::WAIT:
+                hostTime = std::max(hostTime, transferEnd[step.layer]);
+                break;
+            case StreamingStepType::COMPUTE:
+                computes.push_back({hostTime, hostTime + computeMs.at(step.layer)});
+                hostTime += computeMs.at(step.layer);
+                break;
+        }
+    }
+    return SummarizeStreaming(transfers, computes);
+}
@@ -0,0 +1,92 @@
+#ifndef PREFETCH_SCHEDULER_H
+#define PREFETCH_SCHEDULER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 权重流式加载的配置
+struct StreamingConfig
+{
+    size_t ringSize = 2;      // device上权重缓冲环的槽数
+    size_t prefetchDepth = 1; // 计算第i层前最多预取到第i+prefetchDepth层
+};
+
+enum class StreamingStepType
+{
+    PREFETCH = 0, // 在拷贝流上把一层权重从host拷贝到缓冲槽
+    WAIT,         // 等待该层权重拷贝完成
+    COMPUTE,      // 用该缓冲槽中的权重同步执行一层
+};
+
+struct StreamingStep
+{
+    StreamingStepType type = StreamingStepType::PREFETCH;
+    size_t layer = 0;
+    size_t slot = 0;
+};
+
+/**
+ * 权重预取调度器
+ * 只负责生成host侧的发射顺序，不依赖ACL，可以在host上单独验证。
+ * 第i层使用第 i % ringSize 个槽；由于计算是同步的，某个槽在其上一层计算返回后才能被覆盖，
+ * 因此实际预取深度不超过ringSize - 1，ringSize为1时退化为先拷贝后计算。
+ */
+class WeightPrefetchScheduler
+{
+public:
+    WeightPrefetchScheduler(size_t layerCount, const StreamingConfig &config);
+
+    // 实际生效的预取深度
+    size_t GetEffectiveDepth() const;
+
+    size_t GetRingSize() const;
+
+    size_t GetLayerCount() const;
+
+    const std::vector<StreamingStep> &GetPlan() const;
+
+    /**
+     * 检查发射顺序：每层计算前已等待其拷贝完成，且拷贝不会覆盖尚未计算的槽
+     * @param error 不合法时返回原因
+     */
+    bool Validate(std::string &error) const;
+
+private:
+    size_t layerCount_;
+    size_t ringSize_;
+    size_t effectiveDepth_;
+    std::vector<StreamingStep> plan_;
+};
+
+struct TimeInterval
+{
+    double begin = 0;
+    double end = 0;
+};
+
+// 一次流式执行的统计
+struct StreamingStats
+{
+    double totalMs = 0;      // 第一次拷贝开始到最后一层计算结束
+    double computeMs = 0;    // 计算区间的并集长度
+    double transferMs = 0;   // 拷贝区间的并集长度
+    double overlapMs = 0;    // 拷贝与计算重叠的长度
+    double overlapRatio = 0; // overlapMs / transferMs，即被计算隐藏的拷贝比例
+};
+
+/**
+ * 根据拷贝和计算的时间区间汇总统计
+ */
+StreamingStats SummarizeStreaming(const std::vector<TimeInterval> &transfers,
+                                  const std::vector<TimeInterval> &computes);
+
+/**
+ * 在host上按发射顺序推演时间线：拷贝流串行执行，计算同步执行
+ * @param computeMs 每层计算耗时
+ * @param transferMs 每层权重拷贝耗时
+ */
+StreamingStats SimulateStreaming(const WeightPrefetchScheduler &scheduler, const std::vector<double> &computeMs,
+                                 const std::vector<double> &transferMs);
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef PRIORITY_SCHEDULER_H
+#define PRIORITY_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "runtime/scheduling_policy.h"
+
+/**
+ * 分步执行请求的执行器
+ * 一个请求分为stepCount步（对应图中的节点），调度器只在两步之间抢占，
+ * 请求被抢占后可能由另一个工作线程继续执行，执行进度之外的状态需要保存在请求自身中
+ * 在模型上执行的实现见runtime/model_step_executor.h，SimulatedStepExecutor用于没有NPU的环境
+ */
+template <typename RequestT>
+class StepExecutor
+{
+public:
+    virtual ~StepExecutor() = default;
+    virtual void RunStep(RequestT &request, uint32_t step) = 0;
+};
+
+// 请求的调度结果
+enum class ScheduleOutcome
+{
+    COMPLETED = 0, // 执行完成
+    REJECTED,      // 准入控制预计会超时，未执行
+};
+
+/**
+ * 带优先级和截止时间的请求调度器，位于模型执行之前
+ * 请求按SchedulingPolicy的顺序由workerCount个工作线程执行；
+ * BULK请求每执行完一步检查一次，有更高优先级的请求在排队时放回队列，让出工作线程
+ */
+template <typename RequestT>
+class PriorityScheduler
+{
+public:
+    using ExecutorPtr = std::shared_ptr<StepExecutor<RequestT>>;
+
+    /**
+     * 构造函数
+     * @param mode 调度模式
+     * @param executor 执行器，所有工作线程共用
+     * @param workerCount 工作线程数
+     */
+    PriorityScheduler(SchedulerMode mode, ExecutorPtr executor, uint32_t workerCount)
+        : policy_(mode, workerCount), executor_(std::move(executor))
+    {
+        for (uint32_t i = 0; i < workerCount; i++) {
+            workers_.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ~PriorityScheduler()
+    {
+        WaitIdle();
+        {
+            std::unique_lock<std::mutex> lock(jobMutex_);
+            stop_ = true;
+        }
+        jobCv_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    PriorityScheduler(const PriorityScheduler &) = delete;
+    PriorityScheduler &operator=(const PriorityScheduler &) = delete;
+
+    /**
+     * 提交请求
+     * @param priority 优先级类别
+     * @param shapeKey 输入形状的标识
+     * @param stepCount 执行步数
+     * @param deadlineMs 从提交开始的截止时间，0表示没有截止时间
+     * @return 请求完成或被拒绝的future
+     */
+    std::future<ScheduleOutcome> Submit(RequestT request, RequestPriority priority, uint64_t shapeKey,
+                                        uint32_t stepCount, double deadlineMs)
+    {
+        ScheduleEntry entry;
+        entry.priority = priority;
+        entry.shapeKey = shapeKey;
+        entry.arrival = SchedulingPolicy::Clock::now();
+        if (deadlineMs > 0) {
+            entry.deadline = entry.arrival + std::chrono::duration_cast<SchedulingPolicy::Clock::duration>(
+                                                 std::chrono::duration<double, std::milli>(deadlineMs));
+        }
+        entry.stepCount = stepCount == 0 ? 1 : stepCount;
+
+        auto job = std::make_shared<Job>();
+        job->request = std::move(request);
+        std::future<ScheduleOutcome> future = job->promise.get_future();
+        {
+            // 准入和登记在同一把锁内完成，工作线程取到ticket时请求一定已登记
+            std::unique_lock<std::mutex> lock(jobMutex_);
+            if (!policy_.Admit(entry)) {
+                job->promise.set_value(ScheduleOutcome::REJECTED);
+                return future;
+            }
+            jobs_[entry.ticket] = job;
+        }
+        jobCv_.notify_one();
+        return future;
+    }
+
+    /**
+     * 等待所有已准入的请求完成
+     */
+    void WaitIdle()
+    {
+        std::unique_lock<std::mutex> lock(jobMutex_);
+        idleCv_.wait(lock, [this] { return jobs_.empty(); });
+    }
+
+    /**
+     * 获取各优先级类别的统计
+     */
+    std::vector<PriorityClassStats> GetStats() const
+    {
+        return policy_.GetStats();
+    }
+
+private:
+    using Clock = SchedulingPolicy::Clock;
+
+    struct Job
+    {
+        RequestT request;
+        std::promise<ScheduleOutcome> promise;
+    };
+
+    void WorkerLoop()
+    {
+        while (true) {
+            ScheduleEntry entry;
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(jobMutex_);
+                jobCv_.wait(lock, [this] { return stop_ || policy_.GetQueuedCount() > 0; });
+                if (!policy_.PopNext(entry)) {
+                    return; // stop且没有排队请求
+                }
+                job = jobs_.at(entry.ticket);
+            }
+            if (RunSteps(entry, *job)) {
+                continue;
+            }
+            policy_.OnComplete(entry);
+            job->promise.set_value(ScheduleOutcome::COMPLETED);
+            std::unique_lock<std::mutex> lock(jobMutex_);
+            jobs_.erase(entry.ticket);
+            idleCv_.notify_all();
+        }
+    }
+
+    // 从entry.nextStep开始执行，被抢占时放回队列并返回true
+    bool RunSteps(ScheduleEntry &entry, Job &job)
+    {
+        while (entry.nextStep < entry.stepCount) {
+            auto begin = Clock::now();
+            executor_->RunStep(job.request, entry.nextStep);
+            std::chrono::duration<double, std::milli> stepTime = Clock::now() - begin;
+            entry.nextStep++;
+            policy_.OnStepComplete(entry, stepTime.count());
+            if (policy_.ShouldPreempt(entry)) {
+                {
+                    std::unique_lock<std::mutex> lock(jobMutex_);
+                    policy_.Preempt(entry);
+                }
+                jobCv_.notify_one();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SchedulingPolicy policy_;
+    ExecutorPtr executor_;
+    std::mutex jobMutex_; // 保护jobs_和stop_，并保证准入、取请求与等待条件的一致
+    std::condition_variable jobCv_;
+    std::condition_variable idleCv_;
+    std::unordered_map<uint64_t, std::shared_ptr<Job>> jobs_; // 已准入未完成的请求，key为ticket
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+};
+
+/**
+ * 仿真执行器，用于在没有NPU的环境下验证调度策略
+ * RequestT需要提供stepMs成员，每一步按该时间"执行"
+ */
+template <typename RequestT>
+class SimulatedStepExecutor : public StepExecutor<RequestT>
+{
+public:
+    void RunStep(RequestT &request, uint32_t step) override
+    {
+        (void)step;
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(request.stepMs));
+    }
+};
+
+#endif
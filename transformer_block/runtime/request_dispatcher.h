@@ -0,0 +1,250 @@
+#ifndef REQUEST_DISPATCHER_H
+#define REQUEST_DISPATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "runtime/device_worker_pool.h"
+#include "runtime/dispatch_router.h"
+
+/**
+ * device上的模型副本
+ * Execute异步执行请求，完成后必须调用一次done
+ */
+template <typename RequestT>
+class DeviceReplica
+{
+public:
+    virtual ~DeviceReplica() = default;
+    virtual uint32_t GetDeviceId() const = 0;
+    virtual void Execute(RequestT request, std::function<void()> done) = 0;
+};
+
+/**
+ * 多device数据并行的请求分发器
+ * 每个请求由DispatchRouter选择device后进入该device的排队队列，
+ * device上执行中的请求数不超过并发上限，完成一个再从队列中取下一个
+ */
+template <typename RequestT>
+class RequestDispatcher
+{
+public:
+    using ReplicaPtr = std::shared_ptr<DeviceReplica<RequestT>>;
+
+    /**
+     * 构造函数
+     * @param policy 路由策略
+     * @param replicas 参与分发的device副本，可以是全部或部分device
+     * @param concurrencyLimit 每个device同时执行的请求上限
+     */
+    RequestDispatcher(RoutePolicy policy, std::vector<ReplicaPtr> replicas, uint32_t concurrencyLimit)
+        : replicas_(std::move(replicas)), router_(policy, GetDeviceIds(replicas_), concurrencyLimit),
+          pending_(replicas_.size())
+    {
+    }
+
+    ~RequestDispatcher()
+    {
+        WaitIdle();
+    }
+
+    /**
+     * 提交请求
+     * @return 请求完成的future
+     */
+    std::future<void> Submit(RequestT request)
+    {
+        auto promise = std::make_shared<std::promise<void>>();
+        std::future<void> future = promise->get_future();
+        size_t index = 0;
+        {
+            // 路由计数和入队在同一把锁内完成，保证router中的排队数不超过队列中的请求数
+            std::unique_lock<std::mutex> lock(pendingMutex_);
+            index = router_.Route();
+            pending_[index].push_back({std::move(request), promise});
+            outstanding_++;
+        }
+        Pump(index);
+        return future;
+    }
+
+    /**
+     * 等待所有已提交的请求完成
+     */
+    void WaitIdle()
+    {
+        std::unique_lock<std::mutex> lock(pendingMutex_);
+        idleCv_.wait(lock, [this] { return outstanding_ == 0; });
+    }
+
+    /**
+     * 获取各device的负载和利用率
+     */
+    std::vector<DeviceLoadStats> GetStats() const
+    {
+        return router_.GetStats();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct PendingRequest
+    {
+        RequestT request;
+        std::shared_ptr<std::promise<void>> promise;
+    };
+
+    static std::vector<uint32_t> GetDeviceIds(const std::vector<ReplicaPtr> &replicas)
+    {
+        std::vector<uint32_t> deviceIds;
+        for (const auto &replica : replicas) {
+            deviceIds.push_back(replica->GetDeviceId());
+        }
+        return deviceIds;
+    }
+
+    // 在并发上限内把排队请求交给device执行
+    void Pump(size_t index)
+    {
+        while (router_.TryStart(index)) {
+            PendingRequest pending;
+            {
+                std::unique_lock<std::mutex> lock(pendingMutex_);
+                pending = std::move(pending_[index].front());
+                pending_[index].pop_front();
+            }
+            auto start = Clock::now();
+            auto promise = pending.promise;
+            replicas_[index]->Execute(std::move(pending.request), [this, index, start, promise] {
+                std::chrono::duration<double, std::milli> serviceTime = Clock::now() - start;
+                router_.OnComplete(index, serviceTime.count());
+                promise->set_value();
+                Pump(index);
+                // 最后再减少outstanding_，WaitIdle返回后不再访问分发器的成员
+                std::unique_lock<std::mutex> lock(pendingMutex_);
+                outstanding_--;
+                idleCv_.notify_all();
+            });
+        }
+    }
+
+    std::vector<ReplicaPtr> replicas_;
+    DispatchRouter router_;
+    std::mutex pendingMutex_;                          // 保护pending_和outstanding_
+    std::condition_variable idleCv_;
+    std::vector<std::deque<PendingRequest>> pending_; // 每个device的排队请求
+    size_t outstanding_ = 0;                          // 已提交未完成的请求数
+};
+
+/**
+ * 基于DeviceWorkerPool的真实device副本
+ * 请求在pool中对应device的常驻工作线程上执行
+ */
+template <typename ModelT>
+class WorkerPoolReplica : public DeviceReplica<typename DeviceWorkerPool<ModelT>::RequestFunc>
+{
+public:
+    using RequestFunc = typename DeviceWorkerPool<ModelT>::RequestFunc;
+
+    WorkerPoolReplica(DeviceWorkerPool<ModelT> &pool, size_t groupIndex, uint32_t deviceId)
+        : pool_(pool), groupIndex_(groupIndex), deviceId_(deviceId)
+    {
+    }
+
+    uint32_t GetDeviceId() const override
+    {
+        return deviceId_;
+    }
+
+    void Execute(RequestFunc request, std::function<void()> done) override
+    {
+        pool_.Submit(groupIndex_, [request = std::move(request), done = std::move(done)](ModelT &model) {
+            request(model);
+            done();
+        });
+    }
+
+private:
+    DeviceWorkerPool<ModelT> &pool_;
+    size_t groupIndex_;
+    uint32_t deviceId_;
+};
+
+/**
+ * 仿真device副本，用于在没有NPU的环境下验证路由逻辑
+ * 每个请求按 baseServiceMs / speed 的时间在内部线程上"执行"，并发数为workerCount
+ */
+template <typename RequestT>
+class SimulatedReplica : public DeviceReplica<RequestT>
+{
+public:
+    SimulatedReplica(uint32_t deviceId, double speed, double baseServiceMs, uint32_t workerCount = 1)
+        : deviceId_(deviceId), serviceTime_(baseServiceMs / speed)
+    {
+        for (uint32_t i = 0; i < workerCount; i++) {
+            workers_.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ~SimulatedReplica() override
+    {
+        {
+            std::unique_lock<std::mutex> lock(taskMutex_);
+            stop_ = true;
+        }
+        taskCv_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    uint32_t GetDeviceId() const override
+    {
+        return deviceId_;
+    }
+
+    void Execute(RequestT request, std::function<void()> done) override
+    {
+        (void)request;
+        {
+            std::unique_lock<std::mutex> lock(taskMutex_);
+            tasks_.push_back(std::move(done));
+        }
+        taskCv_.notify_one();
+    }
+
+private:
+    void WorkerLoop()
+    {
+        while (true) {
+            std::function<void()> done;
+            {
+                std::unique_lock<std::mutex> lock(taskMutex_);
+                taskCv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return;
+                }
+                done = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            std::this_thread::sleep_for(serviceTime_);
+            done();
+        }
+    }
+
+    uint32_t deviceId_;
+    std::chrono::duration<double, std::milli> serviceTime_;
+    std::mutex taskMutex_;
+    std::condition_variable taskCv_;
+    std::deque<std::function<void()>> tasks_;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+};
+
+#endif
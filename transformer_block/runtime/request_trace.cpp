@@ -0,0 +1,150 @@
+#include "runtime/request_trace.h"
+#include <cstring>
+#include "utils/log.h"
+
+// 缓冲区中的记录数达到该值时写入文件
+constexpr size_t TRACE_FLUSH_RECORDS = 4096;
+
+static TraceFileHeader MakeHeader(uint64_t recordCount)
+{
+    TraceFileHeader header;
+    std::memcpy(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic));
+    header.recordSize = sizeof(TraceRecord);
+    header.recordCount = recordCount;
+    header.startUnixUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+    return header;
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    Close();
+}
+
+bool TraceRecorder::Open(const std::string &path)
+{
+    Close();
+    std::unique_lock<std::mutex> lock(recordMutex_);
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        LOG_ERROR("open trace file " + path + " failed");
+        return false;
+    }
+    // 先写入记录数为0的文件头，Close时只更新记录数后回写
+    header_ = MakeHeader(0);
+    if (std::fwrite(&header_, sizeof(header_), 1, file_) != 1) {
+        LOG_ERROR("write trace header failed");
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    start_ = std::chrono::steady_clock::now();
+    buffer_.clear();
+    buffer_.reserve(TRACE_FLUSH_RECORDS);
+    recordCount_ = 0;
+    return true;
+}
+
+void TraceRecorder::Record(uint64_t shapeKey, uint32_t batchSize, RequestPriority priority, uint32_t stepCount,
+                           double deadlineMs)
+{
+    auto now = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(recordMutex_);
+    if (file_ == nullptr) {
+        return;
+    }
+    TraceRecord record;
+    record.arrivalUs = std::chrono::duration_cast<std::chrono::microseconds>(now - start_).count();
+    record.shapeKey = shapeKey;
+    record.deadlineMs = static_cast<float>(deadlineMs);
+    record.batchSize = static_cast<uint16_t>(batchSize);
+    record.priority = static_cast<uint8_t>(priority);
+    record.stepCount = static_cast<uint8_t>(stepCount);
+    buffer_.push_back(record);
+    recordCount_++;
+    if (buffer_.size() >= TRACE_FLUSH_RECORDS) {
+        FlushLocked();
+    }
+}
+
+bool TraceRecorder::FlushLocked()
+{
+    if (buffer_.empty()) {
+        return true;
+    }
+    bool written = std::fwrite(buffer_.data(), sizeof(TraceRecord), buffer_.size(), file_) == buffer_.size();
+    if (!written) {
+        LOG_ERROR("write trace records failed");
+    }
+    buffer_.clear();
+    return written;
+}
+
+void TraceRecorder::Close()
+{
+    std::unique_lock<std::mutex> lock(recordMutex_);
+    if (file_ == nullptr) {
+        return;
+    }
+    FlushLocked();
+    header_.recordCount = recordCount_;
+    if (std::fseek(file_, 0, SEEK_SET) != 0 || std::fwrite(&header_, sizeof(header_), 1, file_) != 1) {
+        LOG_ERROR("rewrite trace header failed");
+    }
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+uint64_t TraceRecorder::GetRecordCount() const
+{
+    std::unique_lock<std::mutex> lock(recordMutex_);
+    return recordCount_;
+}
+
+bool LoadTrace(const std::string &path, std::vector<TraceRecord> &records)
+{
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        LOG_ERROR("open trace file " + path + " failed");
+        return false;
+    }
+    TraceFileHeader header;
+    bool valid = std::fread(&header, sizeof(header), 1, file) == 1 &&
+                 std::memcmp(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic)) == 0 &&
+                 header.version == TRACE_FILE_VERSION && header.recordSize == sizeof(TraceRecord);
+    if (!valid) {
+        LOG_ERROR(path + " is not a trace file of version " + std::to_string(TRACE_FILE_VERSION));
+        std::fclose(file);
+        return false;
+    }
+    // 记录数以文件中实际完整的记录为准，未正常Close的文件也可以读取
+    records.clear();
+    TraceRecord record;
+    while (std::fread(&record, sizeof(record), 1, file) == 1) {
+        records.push_back(record);
+    }
+    std::fclose(file);
+    if (header.recordCount != 0 && header.recordCount != records.size()) {
+        LOG_WARNING(path + " header has " + std::to_string(header.recordCount) + " records, read " +
+                    std::to_string(records.size()));
+    }
+    return true;
+}
+
+bool SaveTrace(const std::string &path, const std::vector<TraceRecord> &records)
+{
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        LOG_ERROR("open trace file " + path + " failed");
+        return false;
+    }
+    TraceFileHeader header = MakeHeader(records.size());
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   std::fwrite(records.data(), sizeof(TraceRecord), records.size(), file) == records.size();
+    written = std::fclose(file) == 0 && written;
+    if (!written) {
+        LOG_ERROR("write trace file " + path + " failed");
+    }
+    return written;
+}
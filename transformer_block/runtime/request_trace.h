@@ -0,0 +1,101 @@
+#ifndef REQUEST_TRACE_H
+#define REQUEST_TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "runtime/scheduling_policy.h"
+
+/**
+ * 请求到达记录的二进制文件格式
+ * 文件头TraceFileHeader之后是recordCount个定长的TraceRecord，均为小端，
+ * 每个请求24字节，只记录到达时间和调度相关的元数据，不记录tensor数据
+ */
+constexpr char TRACE_FILE_MAGIC[8] = {'T', 'B', 'T', 'R', 'A', 'C', 'E', '\0'};
+constexpr uint32_t TRACE_FILE_VERSION = 1;
+
+struct TraceFileHeader
+{
+    char magic[8] = {};
+    uint32_t version = TRACE_FILE_VERSION;
+    uint32_t recordSize = 0;  // sizeof(TraceRecord)，读取时校验
+    uint64_t recordCount = 0; // 关闭时回写，异常退出时为0，读取时按文件大小恢复
+    uint64_t startUnixUs = 0; // 开始记录的墙上时间，仅用于标识
+};
+
+struct TraceRecord
+{
+    uint64_t arrivalUs = 0; // 相对开始记录时刻的到达时间
+    uint64_t shapeKey = 0;  // 输入形状的标识
+    float deadlineMs = 0;   // 从到达起算的截止时间，0表示没有
+    uint16_t batchSize = 1;
+    uint8_t priority = static_cast<uint8_t>(RequestPriority::STANDARD);
+    uint8_t stepCount = 1;  // 执行步数（图中的节点数）
+};
+
+static_assert(sizeof(TraceFileHeader) == 32, "trace header layout changed");
+static_assert(sizeof(TraceRecord) == 24, "trace record layout changed");
+
+/**
+ * 请求到达记录器
+ * Record只在内存缓冲区中追加一条记录，缓冲满时批量写入文件，Close时写完并回写记录数
+ * 所有接口线程安全
+ */
+class TraceRecorder
+{
+public:
+    TraceRecorder() = default;
+
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder &) = delete;
+    TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+    /**
+     * 创建记录文件，到达时间从此刻开始计算
+     * @return 文件无法创建时返回false
+     */
+    bool Open(const std::string &path);
+
+    /**
+     * 记录一个请求在当前时刻到达
+     */
+    void Record(uint64_t shapeKey, uint32_t batchSize, RequestPriority priority, uint32_t stepCount,
+                double deadlineMs);
+
+    /**
+     * 写完缓冲区的记录并关闭文件
+     */
+    void Close();
+
+    /**
+     * 已记录的请求数
+     */
+    uint64_t GetRecordCount() const;
+
+private:
+    bool FlushLocked();
+
+    mutable std::mutex recordMutex_; // 保护以下成员
+    std::FILE *file_ = nullptr;
+    TraceFileHeader header_;         // Open时写入的文件头，保留开始记录的墙上时间
+    std::chrono::steady_clock::time_point start_;
+    std::vector<TraceRecord> buffer_;
+    uint64_t recordCount_ = 0;
+};
+
+/**
+ * 读取记录文件
+ * @return 文件不存在、格式或版本不匹配时返回false
+ */
+bool LoadTrace(const std::string &path, std::vector<TraceRecord> &records);
+
+/**
+ * 写入完整的记录文件，用于保存生成的合成到达序列
+ */
+bool SaveTrace(const std::string &path, const std::vector<TraceRecord> &records);
+
+#endif
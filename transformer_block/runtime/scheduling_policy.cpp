@@ -0,0 +1,171 @@
+#include "runtime/scheduling_policy.h"
+#include <algorithm>
+
+// 单步执行时间滑动平均的权重，越大越偏向最近的样本
+constexpr double STEP_TIME_EWMA_ALPHA = 0.2;
+
+static size_t ClassIndex(RequestPriority priority)
+{
+    return static_cast<size_t>(priority);
+}
+
+bool SchedulingPolicy::EntryOrder::operator()(const ScheduleEntry &lhs, const ScheduleEntry &rhs) const
+{
+    if (mode == SchedulerMode::PRIORITY_EDF) {
+        if (lhs.priority != rhs.priority) {
+            return lhs.priority < rhs.priority;
+        }
+        if (lhs.deadline != rhs.deadline) {
+            return lhs.deadline < rhs.deadline;
+        }
+    }
+    return lhs.ticket < rhs.ticket;
+}
+
+SchedulingPolicy::SchedulingPolicy(SchedulerMode mode, uint32_t workerCount)
+    : mode_(mode), workerCount_(workerCount == 0 ? 1 : workerCount), queue_(EntryOrder{mode}),
+      stats_(PRIORITY_CLASS_COUNT)
+{
+}
+
+double SchedulingPolicy::EstimateStepMsLocked(uint64_t shapeKey) const
+{
+    auto it = stepTimeMs_.find(shapeKey);
+    if (it != stepTimeMs_.end()) {
+        return it->second;
+    }
+    // 新形状使用已知形状的平均值；一个样本都没有时不拒绝任何请求
+    if (stepTimeMs_.empty()) {
+        return 0;
+    }
+    double sum = 0;
+    for (const auto &item : stepTimeMs_) {
+        sum += item.second;
+    }
+    return sum / stepTimeMs_.size();
+}
+
+double SchedulingPolicy::RemainingMsLocked(const ScheduleEntry &entry) const
+{
+    return EstimateStepMsLocked(entry.shapeKey) * (entry.stepCount - entry.nextStep);
+}
+
+double SchedulingPolicy::PredictWaitMsLocked(const ScheduleEntry &entry) const
+{
+    // 队列中排在新请求前面的请求会先执行
+    double aheadMs = 0;
+    for (const auto &queued : queue_) {
+        if (!queue_.key_comp()(queued, entry)) {
+            break;
+        }
+        aheadMs += RemainingMsLocked(queued);
+    }
+    // 执行中的BULK请求最多再执行一步就会被更高优先级的请求抢占
+    for (const auto &item : running_) {
+        const ScheduleEntry &running = item.second;
+        if (running.priority == RequestPriority::BULK && entry.priority != RequestPriority::BULK) {
+            aheadMs += std::min(RemainingMsLocked(running), EstimateStepMsLocked(running.shapeKey));
+        } else {
+            aheadMs += RemainingMsLocked(running);
+        }
+    }
+    return aheadMs / workerCount_;
+}
+
+bool SchedulingPolicy::Admit(ScheduleEntry &entry)
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    entry.ticket = nextTicket_++;
+    entry.nextStep = 0;
+    PriorityClassStats &stats = stats_.at(ClassIndex(entry.priority));
+    stats.submitted++;
+    if (mode_ == SchedulerMode::PRIORITY_EDF && entry.deadline != Clock::time_point::max()) {
+        double predictMs = PredictWaitMsLocked(entry) + RemainingMsLocked(entry);
+        auto predictFinish = entry.arrival + std::chrono::duration_cast<Clock::duration>(
+                                                 std::chrono::duration<double, std::milli>(predictMs));
+        if (predictFinish > entry.deadline) {
+            stats.rejected++;
+            return false;
+        }
+    }
+    queue_.insert(entry);
+    return true;
+}
+
+bool SchedulingPolicy::PopNext(ScheduleEntry &entry)
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    if (queue_.empty()) {
+        return false;
+    }
+    entry = *queue_.begin();
+    queue_.erase(queue_.begin());
+    running_[entry.ticket] = entry;
+    return true;
+}
+
+bool SchedulingPolicy::ShouldPreempt(const ScheduleEntry &entry) const
+{
+    if (mode_ != SchedulerMode::PRIORITY_EDF || entry.priority != RequestPriority::BULK ||
+        entry.nextStep >= entry.stepCount) {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    return !queue_.empty() && queue_.begin()->priority < RequestPriority::BULK;
+}
+
+void SchedulingPolicy::Preempt(const ScheduleEntry &entry)
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    running_.erase(entry.ticket);
+    queue_.insert(entry);
+    stats_.at(ClassIndex(entry.priority)).preempted++;
+}
+
+void SchedulingPolicy::OnStepComplete(const ScheduleEntry &entry, double stepMs)
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    auto it = stepTimeMs_.find(entry.shapeKey);
+    if (it == stepTimeMs_.end()) {
+        stepTimeMs_[entry.shapeKey] = stepMs;
+    } else {
+        it->second = (1 - STEP_TIME_EWMA_ALPHA) * it->second + STEP_TIME_EWMA_ALPHA * stepMs;
+    }
+    auto running = running_.find(entry.ticket);
+    if (running != running_.end()) {
+        running->second.nextStep = entry.nextStep;
+    }
+}
+
+void SchedulingPolicy::OnComplete(const ScheduleEntry &entry)
+{
+    auto now = Clock::now();
+    std::chrono::duration<double, std::milli> latency = now - entry.arrival;
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    running_.erase(entry.ticket);
+    PriorityClassStats &stats = stats_.at(ClassIndex(entry.priority));
+    stats.completed++;
+    stats.latencySumMs += latency.count();
+    stats.maxLatencyMs = std::max(stats.maxLatencyMs, latency.count());
+    if (now > entry.deadline) {
+        stats.deadlineMissed++;
+    }
+}
+
+double SchedulingPolicy::EstimateServiceMs(uint64_t shapeKey, uint32_t stepCount) const
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    return EstimateStepMsLocked(shapeKey) * stepCount;
+}
+
+size_t SchedulingPolicy::GetQueuedCount() const
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    return queue_.size();
+}
+
+std::vector<PriorityClassStats> SchedulingPolicy::GetStats() const
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    return stats_;
+}
@@ -0,0 +1,146 @@
+#ifndef SCHEDULING_POLICY_H
+#define SCHEDULING_POLICY_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+// 请求的优先级类别，数值越小越优先
+enum class RequestPriority
+{
+    INTERACTIVE = 0, // 延迟敏感的在线请求
+    STANDARD,        // 普通请求
+    BULK,            // 批量任务，可以在节点边界被抢占
+};
+
+constexpr size_t PRIORITY_CLASS_COUNT = 3;
+
+// 调度模式
+enum class SchedulerMode
+{
+    FIFO = 0,     // 按到达顺序执行，不做准入控制和抢占，作为对比基线
+    PRIORITY_EDF, // 先按优先级类别，同类别内截止时间最早优先，带准入控制和节点边界抢占
+};
+
+// 调度器中的一个请求
+struct ScheduleEntry
+{
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t ticket = 0; // Admit时分配，同时作为到达顺序
+    RequestPriority priority = RequestPriority::STANDARD;
+    uint64_t shapeKey = 0; // 输入形状的标识，延迟估计按形状分别统计
+    Clock::time_point arrival;
+    Clock::time_point deadline = Clock::time_point::max(); // max表示没有截止时间
+    uint32_t stepCount = 1; // 执行步数，对应图中的节点数，抢占只发生在两步之间
+    uint32_t nextStep = 0;  // 下一个要执行的步
+};
+
+// 单个优先级类别的统计
+struct PriorityClassStats
+{
+    uint64_t submitted = 0;      // 提交的请求数
+    uint64_t rejected = 0;       // 准入控制预计会超时而拒绝的请求数
+    uint64_t completed = 0;      // 执行完成的请求数
+    uint64_t deadlineMissed = 0; // 完成时已超过截止时间的请求数
+    uint64_t preempted = 0;      // 在节点边界被抢占的次数
+    double latencySumMs = 0;     // 完成请求从提交到完成的延迟之和
+    double maxLatencyMs = 0;
+};
+
+/**
+ * 带截止时间和优先级的调度策略
+ * 只负责排队顺序、准入控制、抢占决策和延迟估计，不持有请求本身，便于用仿真负载单独验证
+ * 每个形状的单步执行时间用滑动平均在线估计，准入时按排在前面的剩余工作量和新请求的服务时间预测完成时间，
+ * 预计超过截止时间的请求直接拒绝
+ * 所有接口线程安全
+ */
+class SchedulingPolicy
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * 构造函数
+     * @param mode 调度模式
+     * @param workerCount 同时执行请求的工作线程数，用于把排队的工作量折算为等待时间
+     */
+    SchedulingPolicy(SchedulerMode mode, uint32_t workerCount);
+
+    /**
+     * 准入并排队，分配ticket
+     * @param entry 需要填写priority、shapeKey、arrival、deadline和stepCount
+     * @return 预计会超过截止时间而拒绝时返回false
+     */
+    bool Admit(ScheduleEntry &entry);
+
+    /**
+     * 取出下一个要执行的请求，并记为执行中
+     * @return 没有排队请求时返回false
+     */
+    bool PopNext(ScheduleEntry &entry);
+
+    /**
+     * 执行中的请求是否应该在当前节点边界让出：只有BULK请求会被更高优先级的排队请求抢占
+     */
+    bool ShouldPreempt(const ScheduleEntry &entry) const;
+
+    /**
+     * 把被抢占的请求放回队列，保留执行进度和原来的到达顺序
+     */
+    void Preempt(const ScheduleEntry &entry);
+
+    /**
+     * 完成一步，更新该形状的单步执行时间估计
+     * @param entry nextStep已指向下一步
+     * @param stepMs 这一步的执行时间
+     */
+    void OnStepComplete(const ScheduleEntry &entry, double stepMs);
+
+    /**
+     * 请求执行完成，统计延迟和截止时间
+     */
+    void OnComplete(const ScheduleEntry &entry);
+
+    /**
+     * 预计该形状执行stepCount步的时间（毫秒），没有样本时返回已知形状的平均值，都没有时返回0
+     */
+    double EstimateServiceMs(uint64_t shapeKey, uint32_t stepCount) const;
+
+    /**
+     * 排队中的请求数
+     */
+    size_t GetQueuedCount() const;
+
+    /**
+     * 获取各优先级类别的统计，下标为RequestPriority的值
+     */
+    std::vector<PriorityClassStats> GetStats() const;
+
+private:
+    // 队列中排在前面的请求先执行
+    struct EntryOrder
+    {
+        SchedulerMode mode;
+        bool operator()(const ScheduleEntry &lhs, const ScheduleEntry &rhs) const;
+    };
+
+    double EstimateStepMsLocked(uint64_t shapeKey) const;
+    double RemainingMsLocked(const ScheduleEntry &entry) const;
+    double PredictWaitMsLocked(const ScheduleEntry &entry) const;
+
+    SchedulerMode mode_;
+    uint32_t workerCount_;
+    uint64_t nextTicket_ = 0;
+    mutable std::mutex stateMutex_;
+    std::set<ScheduleEntry, EntryOrder> queue_;
+    std::map<uint64_t, ScheduleEntry> running_;        // 执行中的请求，key为ticket
+    std::unordered_map<uint64_t, double> stepTimeMs_; // 每个形状单步执行时间的滑动平均
+    std::vector<PriorityClassStats> stats_;
+};
+
+#endif
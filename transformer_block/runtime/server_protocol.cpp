@@ -0,0 +1,76 @@
+#include "runtime/server_protocol.h"
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <unistd.h>
+
+bool SendMessage(int socketFd, const void *message, size_t size, int passFd)
+{
+    struct iovec iov;
+    iov.iov_base = const_cast<void *>(message);
+    iov.iov_len = size;
+    struct msghdr header;
+    std::memset(&header, 0, sizeof(header));
+    header.msg_iov = &iov;
+    header.msg_iovlen = 1;
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    if (passFd >= 0) {
+        std::memset(control, 0, sizeof(control));
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&header);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &passFd, sizeof(int));
+    }
+    ssize_t sent = 0;
+    do {
+        sent = sendmsg(socketFd, &header, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    return sent == static_cast<ssize_t>(size);
+}
+
+ssize_t RecvMessage(int socketFd, void *message, size_t size, int *passedFd)
+{
+    struct iovec iov;
+    iov.iov_base = message;
+    iov.iov_len = size;
+    struct msghdr header;
+    std::memset(&header, 0, sizeof(header));
+    header.msg_iov = &iov;
+    header.msg_iovlen = 1;
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    header.msg_control = control;
+    header.msg_controllen = sizeof(control);
+    ssize_t received = 0;
+    do {
+        // MSG_TRUNC：SOCK_SEQPACKET上超长的消息返回实际长度，而不是截断后的size
+        received = recvmsg(socketFd, &header, MSG_CMSG_CLOEXEC | MSG_TRUNC);
+    } while (received < 0 && errno == EINTR);
+    if (passedFd != nullptr) {
+        *passedFd = -1;
+    }
+    // 对端可以在任何消息上附带fd，内核已把它们装入本进程，调用方不需要的fd都要关闭，否则会耗尽fd
+    for (struct cmsghdr *cmsg = received >= 0 ? CMSG_FIRSTHDR(&header) : nullptr; cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&header, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+            continue;
+        }
+        size_t fdCount = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < fdCount; i++) {
+            int fd = -1;
+            std::memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+            if (passedFd != nullptr && *passedFd < 0) {
+                *passedFd = fd;
+            } else {
+                close(fd);
+            }
+        }
+    }
+    if (received >= 0 && (header.msg_flags & MSG_TRUNC) != 0 && received <= static_cast<ssize_t>(size)) {
+        // 不支持MSG_TRUNC返回实际长度的socket上，同样让调用方看到长度不符
+        received = static_cast<ssize_t>(size) + 1;
+    }
+    return received;
+}
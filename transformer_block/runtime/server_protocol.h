@@ -0,0 +1,81 @@
+#ifndef SERVER_PROTOCOL_H
+#define SERVER_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+/**
+ * 本地推理服务的协议
+ * 使用SOCK_SEQPACKET的Unix域socket，每个消息是一个定长结构体，消息边界由socket保证。
+ * 连接建立后服务端发送HelloMessage，并通过SCM_RIGHTS附带共享内存环（ShmRing）的fd；
+ * 之后客户端把输入写入自己持有的slot，发送RequestMessage，服务端执行完成后回复ResponseMessage，
+ * 输出已写入同一个slot的输出区。socket上只传slot序号，不传tensor数据。
+ */
+constexpr uint32_t SERVER_PROTOCOL_VERSION = 1;
+
+enum class ServerMessageType : uint32_t
+{
+    HELLO = 1,
+    REQUEST,
+    RESPONSE,
+};
+
+// 请求的处理结果
+enum class RequestStatus : uint32_t
+{
+    OK = 0,   // 执行完成，输出在slot的输出区
+    BUSY,     // 服务端排队已满，未执行，客户端可以稍后重试
+    TIMEOUT,  // 开始执行前已超过请求的超时时间，未执行
+    DRAINING, // 服务端正在退出，不再接收新请求
+    INVALID,  // slot越界或该slot已有未完成的请求
+};
+
+// 服务端 -> 客户端，连接建立后发送一次
+struct HelloMessage
+{
+    ServerMessageType type = ServerMessageType::HELLO;
+    uint32_t version = SERVER_PROTOCOL_VERSION;
+    uint32_t slotCount = 0;   // 共享内存环的slot个数，即该连接同时未完成的请求上限
+    int32_t inputDtype = 0;   // 输入的aclDataType
+    uint64_t inputBytes = 0;  // 每个slot输入区的有效字节数
+    int32_t outputDtype = 0;  // 输出的aclDataType
+    uint32_t reserved = 0;
+    uint64_t outputBytes = 0; // 每个slot输出区的有效字节数
+};
+
+// 客户端 -> 服务端
+struct RequestMessage
+{
+    ServerMessageType type = ServerMessageType::REQUEST;
+    uint32_t slot = 0;
+    uint64_t requestId = 0;
+    uint32_t timeoutMs = 0; // 从服务端收到请求起算，0表示不超时
+    uint32_t reserved = 0;
+};
+
+// 服务端 -> 客户端
+struct ResponseMessage
+{
+    ServerMessageType type = ServerMessageType::RESPONSE;
+    uint32_t slot = 0;
+    uint64_t requestId = 0;
+    RequestStatus status = RequestStatus::OK;
+    uint32_t reserved = 0;
+    uint64_t queueUs = 0;   // 服务端收到请求到开始执行的时间
+    uint64_t executeUs = 0; // 服务端执行的时间
+};
+
+/**
+ * 发送一个消息，passFd >= 0时通过SCM_RIGHTS附带该fd
+ * @return 是否完整发送，对端关闭时返回false且不会触发SIGPIPE
+ */
+bool SendMessage(int socketFd, const void *message, size_t size, int passFd = -1);
+
+/**
+ * 接收一个消息，passedFd不为空时取出附带的第一个fd，没有附带fd时为-1；其余附带的fd直接关闭
+ * @return 收到的字节数，对端关闭返回0，出错返回-1；消息超过size时被截断，返回值大于size
+ */
+ssize_t RecvMessage(int socketFd, void *message, size_t size, int *passedFd = nullptr);
+
+#endif
@@ -0,0 +1,124 @@
+#include "runtime/shm_ring.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "utils/log.h"
+
+// slot内各区域的对齐字节数，按页对齐便于整块注册为pinned内存
+constexpr uint64_t SHM_ALIGN = 4096;
+
+static uint64_t AlignShm(uint64_t bytes)
+{
+    return (bytes + SHM_ALIGN - 1) / SHM_ALIGN * SHM_ALIGN;
+}
+
+ShmRing::~ShmRing()
+{
+    Release();
+}
+
+bool ShmRing::Create(const std::string &name, uint32_t slotCount, uint64_t inputBytes, uint64_t outputBytes)
+{
+    Release();
+    SetLayout(slotCount, inputBytes, outputBytes);
+    fd_ = memfd_create(name.c_str(), MFD_CLOEXEC);
+    if (fd_ < 0) {
+        LOG_ERROR("memfd_create " + name + " failed, errno " + std::to_string(errno));
+        return false;
+    }
+    if (ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+        LOG_ERROR("ftruncate " + name + " failed, errno " + std::to_string(errno));
+        Release();
+        return false;
+    }
+    return Map();
+}
+
+bool ShmRing::Attach(int fd, uint32_t slotCount, uint64_t inputBytes, uint64_t outputBytes)
+{
+    Release();
+    fd_ = fd;
+    SetLayout(slotCount, inputBytes, outputBytes);
+    struct stat fileStat;
+    if (fd_ < 0 || fstat(fd_, &fileStat) != 0 || static_cast<uint64_t>(fileStat.st_size) != size_) {
+        LOG_ERROR("shm ring size mismatch, expect " + std::to_string(size_));
+        Release();
+        return false;
+    }
+    return Map();
+}
+
+void ShmRing::SetLayout(uint32_t slotCount, uint64_t inputBytes, uint64_t outputBytes)
+{
+    slotCount_ = slotCount;
+    outputOffset_ = AlignShm(inputBytes);
+    slotStride_ = outputOffset_ + AlignShm(outputBytes);
+    size_ = slotStride_ * slotCount_;
+}
+
+bool ShmRing::Map()
+{
+    if (size_ == 0) {
+        LOG_ERROR("shm ring is empty");
+        Release();
+        return false;
+    }
+    base_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (base_ == MAP_FAILED) {
+        LOG_ERROR("mmap shm ring failed, errno " + std::to_string(errno));
+        base_ = nullptr;
+        Release();
+        return false;
+    }
+    return true;
+}
+
+void ShmRing::Release()
+{
+    if (base_ != nullptr) {
+        munmap(base_, size_);
+        base_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+void *ShmRing::GetInput(uint32_t slot) const
+{
+    if (base_ == nullptr || slot >= slotCount_) {
+        return nullptr;
+    }
+    return static_cast<uint8_t *>(base_) + slot * slotStride_;
+}
+
+void *ShmRing::GetOutput(uint32_t slot) const
+{
+    if (base_ == nullptr || slot >= slotCount_) {
+        return nullptr;
+    }
+    return static_cast<uint8_t *>(base_) + slot * slotStride_ + outputOffset_;
+}
+
+int ShmRing::GetFd() const
+{
+    return fd_;
+}
+
+uint32_t ShmRing::GetSlotCount() const
+{
+    return slotCount_;
+}
+
+void *ShmRing::GetBase() const
+{
+    return base_;
+}
+
+uint64_t ShmRing::GetSize() const
+{
+    return size_;
+}
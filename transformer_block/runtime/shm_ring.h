@@ -0,0 +1,66 @@
+#ifndef SHM_RING_H
+#define SHM_RING_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * 共享内存请求环
+ * 由memfd创建并按slot划分，每个slot包含一个请求的输入区和输出区，均按页对齐。
+ * 服务端创建后通过Unix域socket把fd传给客户端，两端各自mmap同一块内存，请求数据只在slot中读写。
+ * slot的归属由协议保证：客户端写完输入后发送请求，收到该slot的响应前不再访问该slot。
+ */
+class ShmRing
+{
+public:
+    ShmRing() = default;
+
+    ~ShmRing();
+
+    ShmRing(const ShmRing &) = delete;
+    ShmRing &operator=(const ShmRing &) = delete;
+
+    /**
+     * 创建memfd并映射
+     * @param name memfd的名称，只用于调试
+     * @param slotCount slot个数
+     * @param inputBytes 每个slot输入区的字节数
+     * @param outputBytes 每个slot输出区的字节数
+     * @return 是否成功
+     */
+    bool Create(const std::string &name, uint32_t slotCount, uint64_t inputBytes, uint64_t outputBytes);
+
+    /**
+     * 映射对端传来的memfd，成功或失败都取得fd的所有权
+     * @return fd的大小与参数不一致或映射失败时返回false
+     */
+    bool Attach(int fd, uint32_t slotCount, uint64_t inputBytes, uint64_t outputBytes);
+
+    // slot的输入区，slot越界时返回nullptr
+    void *GetInput(uint32_t slot) const;
+
+    // slot的输出区，slot越界时返回nullptr
+    void *GetOutput(uint32_t slot) const;
+
+    int GetFd() const;
+
+    uint32_t GetSlotCount() const;
+
+    // 映射的起始地址和总字节数
+    void *GetBase() const;
+    uint64_t GetSize() const;
+
+private:
+    void SetLayout(uint32_t slotCount, uint64_t inputBytes, uint64_t outputBytes);
+    bool Map();
+    void Release();
+
+    int fd_ = -1;
+    void *base_ = nullptr;
+    uint64_t size_ = 0;
+    uint32_t slotCount_ = 0;
+    uint64_t outputOffset_ = 0; // 输出区在slot中的偏移
+    uint64_t slotStride_ = 0;   // 相邻slot的间隔
+};
+
+#endif
@@ -0,0 +1,83 @@
+#include "runtime/stage_partitioner.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+StageRange MakeStage(const std::vector<double> &prefix, size_t begin, size_t end, bool isLast, double transferMs)
+{
+    StageRange stage;
+    stage.beginLayer = begin;
+    stage.endLayer = end;
+    stage.timeMs = prefix[end] - prefix[begin] + (isLast ? 0 : transferMs);
+    return stage;
+}
+} // namespace
+
+std::vector<StageRange> PartitionStages(const std::vector<double> &layerTimesMs, size_t stageCount, double transferMs)
+{
+    size_t layerCount = layerTimesMs.size();
+    stageCount = std::min(stageCount, layerCount);
+    if (stageCount == 0) {
+        return {};
+    }
+    std::vector<double> prefix(layerCount + 1, 0);
+    for (size_t i = 0; i < layerCount; i++) {
+        prefix[i + 1] = prefix[i] + layerTimesMs[i];
+    }
+
+    // cost[k][i]: 前i层切成k个非最后stage时最大stage耗时的最小值，split记录第k个stage的起始层
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    std::vector<std::vector<double>> cost(stageCount, std::vector<double>(layerCount + 1, INF));
+    std::vector<std::vector<size_t>> split(stageCount, std::vector<size_t>(layerCount + 1, 0));
+    cost[0][0] = 0;
+    for (size_t k = 1; k < stageCount; k++) {
+        for (size_t i = k; i <= layerCount - (stageCount - k); i++) {
+            for (size_t j = k - 1; j < i; j++) {
+                double value = std::max(cost[k - 1][j], prefix[i] - prefix[j] + transferMs);
+                if (value < cost[k][i]) {
+                    cost[k][i] = value;
+                    split[k][i] = j;
+                }
+            }
+        }
+    }
+
+    // 最后一个stage不需要传输，单独枚举其起始层
+    size_t lastBegin = stageCount - 1;
+    double best = INF;
+    for (size_t j = stageCount - 1; j < layerCount; j++) {
+        double value = std::max(cost[stageCount - 1][j], prefix[layerCount] - prefix[j]);
+        if (value < best) {
+            best = value;
+            lastBegin = j;
+        }
+    }
+
+    std::vector<StageRange> stages(stageCount);
+    stages[stageCount - 1] = MakeStage(prefix, lastBegin, layerCount, true, transferMs);
+    size_t end = lastBegin;
+    for (size_t k = stageCount - 1; k > 0; k--) {
+        size_t begin = split[k][end];
+        stages[k - 1] = MakeStage(prefix, begin, end, false, transferMs);
+        end = begin;
+    }
+    return stages;
+}
+
+std::vector<StageRange> PartitionStagesEvenly(const std::vector<double> &layerTimesMs, size_t stageCount,
+                                              double transferMs)
+{
+    size_t layerCount = layerTimesMs.size();
+    stageCount = std::min(stageCount, layerCount);
+    std::vector<double> prefix(layerCount + 1, 0);
+    for (size_t i = 0; i < layerCount; i++) {
+        prefix[i + 1] = prefix[i] + layerTimesMs[i];
+    }
+    std::vector<StageRange> stages;
+    for (size_t k = 0; k < stageCount; k++) {
+        size_t begin = layerCount * k / stageCount;
+        size_t end = layerCount * (k + 1) / stageCount;
+        stages.push_back(MakeStage(prefix, begin, end, k + 1 == stageCount, transferMs));
+    }
+    return stages;
+}
@@ -0,0 +1,32 @@
+#ifndef STAGE_PARTITIONER_H
+#define STAGE_PARTITIONER_H
+
+#include <cstddef>
+#include <vector>
+
+// 流水线的一个stage，负责[beginLayer, endLayer)范围内的层
+struct StageRange
+{
+    size_t beginLayer = 0;
+    size_t endLayer = 0;
+    double timeMs = 0; // 该stage处理一个micro-batch的预计时间，包括向下一stage传输激活
+};
+
+/**
+ * 按实测的每层耗时把层切分成连续的stage，使最慢的stage尽量快
+ * 流水线稳态吞吐由最慢的stage决定，因此用动态规划求最大stage耗时的最小值
+ * @param layerTimesMs 每层处理一个micro-batch的耗时
+ * @param stageCount stage数量，超过层数时按层数截断
+ * @param transferMs 非最后一个stage向下一stage传输激活的耗时
+ * @return 各stage的层范围，按层顺序排列
+ */
+std::vector<StageRange> PartitionStages(const std::vector<double> &layerTimesMs, size_t stageCount,
+                                        double transferMs = 0);
+
+/**
+ * 按层数平均切分，用于和按耗时切分对比
+ */
+std::vector<StageRange> PartitionStagesEvenly(const std::vector<double> &layerTimesMs, size_t stageCount,
+                                              double transferMs = 0);
+
+#endif
@@ -0,0 +1,135 @@
+#include "runtime/weight_streamer.h"
+#include "memory/memory_utils.h"
+#include "utils/log.h"
+#include "utils/utils.h"
+
+WeightStreamer::WeightStreamer(const StreamingConfig &config) : config_(config)
+{
+}
+
+WeightStreamer::~WeightStreamer()
+{
+    Free();
+}
+
+void WeightStreamer::Init(size_t layerCount, uint64_t layerBytes, const WeightLoader &loader)
+{
+    layerCount_ = layerCount;
+    layerBytes_ = layerBytes;
+    for (size_t layer = 0; layer < layerCount_; layer++) {
+        void *hostData = nullptr;
+        auto ret = aclrtMallocHost(&hostData, layerBytes_);
+        CHECK_RET(ret, "aclrtMallocHost failed. ret: " + std::to_string(ret));
+        loader(layer, hostData);
+        hostWeights_.push_back(hostData);
+    }
+
+    WeightPrefetchScheduler scheduler(layerCount_, config_);
+    for (size_t slot = 0; slot < scheduler.GetRingSize(); slot++) {
+        int blockId = -1;
+        void *addr = nullptr;
+        // 内存池耗尽时blockId保持-1，地址保持nullptr
+        GetMemoryManager().AllocateBlock(layerBytes_, blockId);
+        CHECK_RET(blockId < 0, "allocate weight slot " + std::to_string(slot) + " from memory pool failed");
+        GetMemoryManager().GetBlockPtr(blockId, addr);
+        CHECK_RET(addr == nullptr, "get weight slot " + std::to_string(slot) + " address failed");
+        slotBlockIds_.push_back(blockId);
+        slots_.push_back(addr);
+    }
+
+    auto ret = aclrtCreateStream(&copyStream_);
+    CHECK_RET(ret, "aclrtCreateStream failed. ret: " + std::to_string(ret));
+    ret = aclrtCreateEvent(&baseEvent_);
+    CHECK_RET(ret, "aclrtCreateEvent failed. ret: " + std::to_string(ret));
+    for (auto *events : {&transferBegin_, &transferEnd_, &computeBegin_, &computeEnd_}) {
+        events->resize(layerCount_);
+        for (auto &event : *events) {
+            ret = aclrtCreateEvent(&event);
+            CHECK_RET(ret, "aclrtCreateEvent failed. ret: " + std::to_string(ret));
+        }
+    }
+    LOG_INFO("WeightStreamer init " + std::to_string(layerCount_) + " layers, " + std::to_string(layerBytes_) +
+             " bytes per layer, ring size " + std::to_string(slots_.size()));
+}
+
+StreamingStats WeightStreamer::Run(aclrtStream computeStream, const LayerFunc &runLayer)
+{
+    WeightPrefetchScheduler scheduler(layerCount_, config_);
+    auto ret = aclrtRecordEvent(baseEvent_, copyStream_);
+    CHECK_RET(ret, "aclrtRecordEvent failed. ret: " + std::to_string(ret));
+    ret = aclrtSynchronizeEvent(baseEvent_);
+    CHECK_RET(ret, "aclrtSynchronizeEvent failed. ret: " + std::to_string(ret));
+
+    for (const auto &step : scheduler.GetPlan()) {
+        size_t layer = step.layer;
+        switch (step.type) {
+            case StreamingStepType::PREFETCH:
+                ret = aclrtRecordEvent(transferBegin_[layer], copyStream_);
+                CHECK_RET(ret, "aclrtRecordEvent failed. ret: " + std::to_string(ret));
+                ret = aclrtMemcpyAsync(slots_[step.slot], layerBytes_, hostWeights_[layer], layerBytes_,
+                                       ACL_MEMCPY_HOST_TO_DEVICE, copyStream_);
+                CHECK_RET(ret, "aclrtMemcpyAsync failed. ret: " + std::to_string(ret));
+                ret = aclrtRecordEvent(transferEnd_[layer], copyStream_);
+                CHECK_RET(ret, "aclrtRecordEvent failed. ret: " + std::to_string(ret));
+                break;
+            case StreamingStepType::WAIT:
+                ret = aclrtSynchronizeEvent(transferEnd_[layer]);
+                CHECK_RET(ret, "aclrtSynchronizeEvent failed. ret: " + std::to_string(ret));
+                break;
+            case StreamingStepType::COMPUTE:
+                ret = aclrtRecordEvent(computeBegin_[layer], computeStream);
+                CHECK_RET(ret, "aclrtRecordEvent failed. ret: " + std::to_string(ret));
+                runLayer(layer, slots_[step.slot]);
+                ret = aclrtRecordEvent(computeEnd_[layer], computeStream);
+                CHECK_RET(ret, "aclrtRecordEvent failed. ret: " + std::to_string(ret));
+                break;
+        }
+    }
+    ret = aclrtSynchronizeStream(computeStream);
+    CHECK_RET(ret, "aclrtSynchronizeStream failed. ret: " + std::to_string(ret));
+    ret = aclrtSynchronizeStream(copyStream_);
+    CHECK_RET(ret, "aclrtSynchronizeStream failed. ret: " + std::to_string(ret));
+
+    std::vector<TimeInterval> transfers;
+    std::vector<TimeInterval> computes;
+    for (size_t layer = 0; layer < layerCount_; layer++) {
+        transfers.push_back({ElapsedMs(transferBegin_[layer]), ElapsedMs(transferEnd_[layer])});
+        computes.push_back({ElapsedMs(computeBegin_[layer]), ElapsedMs(computeEnd_[layer])});
+    }
+    return SummarizeStreaming(transfers, computes);
+}
+
+void WeightStreamer::Free()
+{
+    for (auto *events : {&transferBegin_, &transferEnd_, &computeBegin_, &computeEnd_}) {
+        for (auto event : *events) {
+            aclrtDestroyEvent(event);
+        }
+        events->clear();
+    }
+    if (baseEvent_ != nullptr) {
+        aclrtDestroyEvent(baseEvent_);
+        baseEvent_ = nullptr;
+    }
+    if (copyStream_ != nullptr) {
+        aclrtDestroyStream(copyStream_);
+        copyStream_ = nullptr;
+    }
+    for (int blockId : slotBlockIds_) {
+        GetMemoryManager().FreeBlock(blockId);
+    }
+    slotBlockIds_.clear();
+    slots_.clear();
+    for (void *hostData : hostWeights_) {
+        aclrtFreeHost(hostData);
+    }
+    hostWeights_.clear();
+}
+
+float WeightStreamer::ElapsedMs(aclrtEvent event) const
+{
+    float ms = 0;
+    auto ret = aclrtEventElapsedTime(&ms, baseEvent_, event);
+    CHECK_RET(ret, "aclrtEventElapsedTime failed. ret: " + std::to_string(ret));
+    return ms;
+}
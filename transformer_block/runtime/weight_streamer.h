@@ -0,0 +1,68 @@
+#ifndef WEIGHT_STREAMER_H
+#define WEIGHT_STREAMER_H
+
+#include <functional>
+#include <vector>
+#include <acl/acl.h>
+#include "runtime/prefetch_scheduler.h"
+
+/**
+ * 逐层权重流式加载
+ * 所有层的权重保存在pinned host内存中，device上只保留ringSize个缓冲槽（从MemoryPool分配）。
+ * 按WeightPrefetchScheduler的发射顺序，在独立的拷贝流上预取后续层的权重，与当前层计算重叠。
+ * 所有接口需要在已经设置device的同一线程上调用。
+ */
+class WeightStreamer
+{
+public:
+    // 填充一层host权重
+    using WeightLoader = std::function<void(size_t layer, void *hostData)>;
+    // 同步执行一层，deviceWeights为该层权重所在的缓冲槽
+    using LayerFunc = std::function<void(size_t layer, void *deviceWeights)>;
+
+    explicit WeightStreamer(const StreamingConfig &config);
+
+    ~WeightStreamer();
+
+    WeightStreamer(const WeightStreamer &) = delete;
+    WeightStreamer &operator=(const WeightStreamer &) = delete;
+
+    /**
+     * 分配pinned host权重、device缓冲环、拷贝流和事件
+     * @param layerCount 层数
+     * @param layerBytes 每层权重字节数
+     * @param loader 填充每层host权重
+     */
+    void Init(size_t layerCount, uint64_t layerBytes, const WeightLoader &loader);
+
+    /**
+     * 流式执行所有层
+     * @param computeStream runLayer使用的计算流，用于记录计算区间
+     * @param runLayer 同步执行一层
+     * @return 拷贝和计算的重叠统计
+     */
+    StreamingStats Run(aclrtStream computeStream, const LayerFunc &runLayer);
+
+    /**
+     * 释放Init分配的所有资源
+     */
+    void Free();
+
+private:
+    float ElapsedMs(aclrtEvent event) const;
+
+    StreamingConfig config_;
+    size_t layerCount_ = 0;
+    uint64_t layerBytes_ = 0;
+    std::vector<void *> hostWeights_;  // 每层的pinned host权重
+    std::vector<int> slotBlockIds_;    // 缓冲槽在MemoryPool中的blockId
+    std::vector<void *> slots_;        // 缓冲槽地址
+    aclrtStream copyStream_ = nullptr;
+    aclrtEvent baseEvent_ = nullptr;   // 时间基准
+    std::vector<aclrtEvent> transferBegin_;
+    std::vector<aclrtEvent> transferEnd_;
+    std::vector<aclrtEvent> computeBegin_;
+    std::vector<aclrtEvent> computeEnd_;
+};
+
+#endif
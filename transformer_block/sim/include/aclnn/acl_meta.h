@@ -0,0 +1,32 @@
+#ifndef SIM_ACL_META_H
+#define SIM_ACL_META_H
+
+// 仿真后端：aclnn公共数据结构
+// aclTensor记录view的shape/stride/offset与storage地址，aclOpExecutor保存一次下发所需的host闭包
+
+#include "acl/acl.h"
+
+typedef int32_t aclnnStatus;
+
+struct aclTensor;
+struct aclScalar;
+struct aclIntArray;
+struct aclOpExecutor;
+
+aclTensor *aclCreateTensor(const int64_t *viewDims, uint64_t viewDimsNum, aclDataType dataType, const int64_t *stride,
+                           int64_t offset, aclFormat format, const int64_t *storageDims, uint64_t storageDimsNum,
+                           void *tensorData);
+aclnnStatus aclDestroyTensor(const aclTensor *tensor);
+
+aclScalar *aclCreateScalar(void *value, aclDataType dataType);
+aclnnStatus aclDestroyScalar(const aclScalar *scalar);
+
+aclIntArray *aclCreateIntArray(const int64_t *value, uint64_t size);
+aclnnStatus aclDestroyIntArray(const aclIntArray *array);
+
+aclnnStatus aclSetInputTensorAddr(aclOpExecutor *executor, const size_t index, aclTensor *tensor, void *addr);
+aclnnStatus aclSetOutputTensorAddr(aclOpExecutor *executor, const size_t index, aclTensor *tensor, void *addr);
+aclnnStatus aclSetAclOpExecutorRepeatable(aclOpExecutor *executor);
+aclnnStatus aclDestroyAclOpExecutor(aclOpExecutor *executor);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef SIM_ACLNN_ADD_H
+#define SIM_ACLNN_ADD_H
+
+#include "aclnn/acl_meta.h"
+
+// out = self + alpha * other，other按尾部维度广播
+aclnnStatus aclnnAddGetWorkspaceSize(const aclTensor *self, const aclTensor *other, const aclScalar *alpha,
+                                     aclTensor *out, uint64_t *workspaceSize, aclOpExecutor **executor);
+aclnnStatus aclnnAdd(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef SIM_ACLNN_ADD_LAYER_NORM_H
+#define SIM_ACLNN_ADD_LAYER_NORM_H
+
+#include "aclnn/acl_meta.h"
+
+// x = x1 + x2 (+ bias)，按gamma的维度对x的最后几维做LayerNorm
+// meanOut/rstdOut为float，形状与x1相同但归一化的维度为1；additionalOutput为true时输出xOut
+aclnnStatus aclnnAddLayerNormGetWorkspaceSize(const aclTensor *x1, const aclTensor *x2, const aclTensor *gamma,
+                                              const aclTensor *beta, const aclTensor *biasOptional, double epsilon,
+                                              bool additionalOutput, const aclTensor *yOut, const aclTensor *meanOut,
+                                              const aclTensor *rstdOut, const aclTensor *xOut, uint64_t *workspaceSize,
+                                              aclOpExecutor **executor);
+aclnnStatus aclnnAddLayerNorm(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef SIM_ACLNN_AMAX_H
+#define SIM_ACLNN_AMAX_H
+
+#include "aclnn/acl_meta.h"
+
+// 沿dim规约取最大值，dim为空时规约全部维度；输入含nan时结果为nan
+aclnnStatus aclnnAmaxGetWorkspaceSize(const aclTensor *self, const aclIntArray *dim, bool keepDim, aclTensor *out,
+                                      uint64_t *workspaceSize, aclOpExecutor **executor);
+aclnnStatus aclnnAmax(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef SIM_ACLNN_AMIN_H
+#define SIM_ACLNN_AMIN_H
+
+#include "aclnn/acl_meta.h"
+
+// 沿dim规约取最小值，dim为空时规约全部维度；输入含nan时结果为nan
+aclnnStatus aclnnAminGetWorkspaceSize(const aclTensor *self, const aclIntArray *dim, bool keepDim, aclTensor *out,
+                                      uint64_t *workspaceSize, aclOpExecutor **executor);
+aclnnStatus aclnnAmin(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef SIM_ACLNN_BATCH_MATMUL_H
+#define SIM_ACLNN_BATCH_MATMUL_H
+
+#include "aclnn/acl_meta.h"
+
+// out[..., m, n] = self[..., m, k] @ mat2[..., k, n]，batch维需一致；self/mat2可以是任意stride的view
+aclnnStatus aclnnBatchMatMulGetWorkspaceSize(const aclTensor *self, const aclTensor *mat2, aclTensor *out,
+                                             int8_t cubeMathType, uint64_t *workspaceSize, aclOpExecutor **executor);
+aclnnStatus aclnnBatchMatMul(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef SIM_ACLNN_FUSED_MATMUL_H
+#define SIM_ACLNN_FUSED_MATMUL_H
+
+#include "aclnn/acl_meta.h"
+
+// y = fusedOp(x @ x2 + bias, x3)
+// 仿真支持的fusedOpType：""（只做matmul）、"gelu_erf"、"gelu_tanh"，x3需为空；x2为[k, n]，bias为[n]
+aclnnStatus aclnnFusedMatmulGetWorkspaceSize(const aclTensor *x, const aclTensor *x2, const aclTensor *bias,
+                                             const aclTensor *x3, const char *fusedOpType, int8_t cubeMathType,
+                                             const aclTensor *y, uint64_t *workspaceSize, aclOpExecutor **executor);
+aclnnStatus aclnnFusedMatmul(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
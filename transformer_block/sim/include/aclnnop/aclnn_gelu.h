@@ -0,0 +1,10 @@
+#ifndef SIM_ACLNN_GELU_H
+#define SIM_ACLNN_GELU_H
+
+#include "aclnn/acl_meta.h"
+
+aclnnStatus aclnnGeluGetWorkspaceSize(
+    const aclTensor *self, aclTensor *out, uint64_t *workspaceSize, aclOpExecutor **executor);
+aclnnStatus aclnnGelu(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
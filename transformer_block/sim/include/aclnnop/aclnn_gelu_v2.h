@@ -0,0 +1,11 @@
+#ifndef SIM_ACLNN_GELU_V2_H
+#define SIM_ACLNN_GELU_V2_H
+
+#include "aclnn/acl_meta.h"
+
+// approximate: 0 精确erf计算，1 tanh近似
+aclnnStatus aclnnGeluV2GetWorkspaceSize(
+    const aclTensor *x, int64_t approximate, aclTensor *y, uint64_t *workspaceSize, aclOpExecutor **executor);
+aclnnStatus aclnnGeluV2(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
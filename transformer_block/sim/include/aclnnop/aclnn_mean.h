@@ -0,0 +1,11 @@
+#ifndef SIM_ACLNN_MEAN_H
+#define SIM_ACLNN_MEAN_H
+
+#include "aclnn/acl_meta.h"
+
+// 沿dim求平均，dim为空时规约全部维度；dtype为计算和输出的数据类型
+aclnnStatus aclnnMeanGetWorkspaceSize(const aclTensor *self, const aclIntArray *dim, bool keepDim, aclDataType dtype,
+                                      aclTensor *out, uint64_t *workspaceSize, aclOpExecutor **executor);
+aclnnStatus aclnnMean(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef SIM_ACLNN_MUL_H
+#define SIM_ACLNN_MUL_H
+
+#include "aclnn/acl_meta.h"
+
+// out = self * other，other按尾部维度广播；self与other的dtype可以不同，按out的dtype写出
+aclnnStatus aclnnMulGetWorkspaceSize(const aclTensor *self, const aclTensor *other, aclTensor *out,
+                                     uint64_t *workspaceSize, aclOpExecutor **executor);
+aclnnStatus aclnnMul(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef SIM_ACLNN_NE_TENSOR_H
+#define SIM_ACLNN_NE_TENSOR_H
+
+#include "aclnn/acl_meta.h"
+
+// out = self != other，out为ACL_BOOL；仿真只支持other与self同shape或只有一个元素
+aclnnStatus aclnnNeTensorGetWorkspaceSize(const aclTensor *self, const aclTensor *other, aclTensor *out,
+                                          uint64_t *workspaceSize, aclOpExecutor **executor);
+aclnnStatus aclnnNeTensor(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef SIM_ACLNN_REDUCE_SUM_H
+#define SIM_ACLNN_REDUCE_SUM_H
+
+#include "aclnn/acl_meta.h"
+
+// 沿dims求和，dims为空时规约全部维度；dtype为计算和输出的数据类型，bool输入按0/1累加
+aclnnStatus aclnnReduceSumGetWorkspaceSize(const aclTensor *self, const aclIntArray *dims, bool keepDims,
+                                           aclDataType dtype, aclTensor *out, uint64_t *workspaceSize,
+                                           aclOpExecutor **executor);
+aclnnStatus aclnnReduceSum(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
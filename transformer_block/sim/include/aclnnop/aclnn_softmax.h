@@ -0,0 +1,11 @@
+#ifndef SIM_ACLNN_SOFTMAX_H
+#define SIM_ACLNN_SOFTMAX_H
+
+#include "aclnn/acl_meta.h"
+
+// 沿dim做softmax，dim可为负数
+aclnnStatus aclnnSoftmaxGetWorkspaceSize(
+    const aclTensor *self, int64_t dim, aclTensor *out, uint64_t *workspaceSize, aclOpExecutor **executor);
+aclnnStatus aclnnSoftmax(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
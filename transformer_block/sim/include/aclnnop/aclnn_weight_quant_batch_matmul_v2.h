@@ -0,0 +1,16 @@
+#ifndef SIM_ACLNN_WEIGHT_QUANT_BATCH_MATMUL_V2_H
+#define SIM_ACLNN_WEIGHT_QUANT_BATCH_MATMUL_V2_H
+
+#include "aclnn/acl_meta.h"
+
+// y = x @ ((weight + antiquantOffset) * antiquantScale) + bias
+// weight为int8 [k, n]，antiquantScale/antiquantOffset为per-channel [n]或per-tensor [1]
+// 输入下标按参数顺序计数，可选输入为空时仍占用下标
+aclnnStatus aclnnWeightQuantBatchMatmulV2GetWorkspaceSize(const aclTensor *x, const aclTensor *weight,
+    const aclTensor *antiquantScale, const aclTensor *antiquantOffsetOptional, const aclTensor *quantScaleOptional,
+    const aclTensor *quantOffsetOptional, const aclTensor *biasOptional, int antiquantGroupSize, const aclTensor *y,
+    uint64_t *workspaceSize, aclOpExecutor **executor);
+aclnnStatus aclnnWeightQuantBatchMatmulV2(
+    void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream);
+
+#endif
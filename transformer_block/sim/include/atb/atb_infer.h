@@ -0,0 +1,18 @@
+#ifndef SIM_ATB_ATB_INFER_H
+#define SIM_ATB_ATB_INFER_H
+
+#include "atb/context.h"
+#include "atb/infer_op_params.h"
+#include "atb/operation.h"
+#include "atb/svector.h"
+#include "atb/types.h"
+#include "atb/utils.h"
+
+namespace atb {
+template <> Status CreateOperation(const infer::ElewiseParam &opParam, Operation **operation);
+template <> Status CreateOperation(const infer::LayerNormParam &opParam, Operation **operation);
+template <> Status CreateOperation(const infer::LinearParam &opParam, Operation **operation);
+template <> Status CreateOperation(const GraphParam &opParam, Operation **operation);
+} // namespace atb
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef SIM_ATB_CONTEXT_H
+#define SIM_ATB_CONTEXT_H
+
+#include "atb/types.h"
+
+namespace atb {
+class Context {
+public:
+    Context() = default;
+    virtual ~Context() = default;
+    virtual Status SetExecuteStream(aclrtStream stream);
+    virtual aclrtStream GetExecuteStream() const;
+
+private:
+    aclrtStream executeStream_ = nullptr;
+};
+
+Status CreateContext(Context **context);
+Status DestroyContext(Context *context);
+} // namespace atb
+
+#endif
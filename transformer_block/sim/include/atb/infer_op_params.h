@@ -0,0 +1,81 @@
+#ifndef SIM_ATB_INFER_OP_PARAMS_H
+#define SIM_ATB_INFER_OP_PARAMS_H
+
+#include "atb/types.h"
+
+namespace atb {
+namespace infer {
+struct ElewiseParam {
+    enum ElewiseType : int {
+        ELEWISE_UNDEFINED = 0,
+        ELEWISE_CAST,
+        ELEWISE_MULS,
+        ELEWISE_COS,
+        ELEWISE_SIN,
+        ELEWISE_NEG,
+        ELEWISE_QUANT,
+        ELEWISE_LOGICAL_NOT,
+        ELEWISE_ADD,
+        ELEWISE_MUL,
+        ELEWISE_REALDIV,
+        ELEWISE_LOGICAL_AND,
+        ELEWISE_LOGICAL_OR,
+        ELEWISE_LESS,
+        ELEWISE_GREATER,
+        ELEWISE_SUB,
+        ELEWISE_EQUAL,
+        ELEWISE_QUANT_PER_CHANNEL,
+        ELEWISE_DEQUANT_PER_CHANNEL,
+        ELEWISE_DYNAMIC_QUANT,
+        ELEWISE_TANH,
+    };
+    struct MulsParam {
+        float varAttr = 0.0f;
+    };
+    ElewiseType elewiseType = ELEWISE_UNDEFINED;
+    MulsParam mulsParam;
+    aclDataType outTensorType = ACL_DT_UNDEFINED;
+};
+
+struct LayerNormParam {
+    enum LayerNormType : int {
+        LAYER_NORM_UNDEFINED = 0,
+        LAYER_NORM_NORM,
+        LAYER_NORM_PRENORM,
+        LAYER_NORM_POSTNORM,
+    };
+    enum QuantType : int {
+        QUANT_UNDEFINED = 0,
+    };
+    struct NormParam {
+        QuantType quantType = QUANT_UNDEFINED;
+        float epsilon = 1e-5f;
+        int32_t beginNormAxis = 0;
+        int32_t beginParamsAxis = 0;
+    };
+    LayerNormType layerType = LAYER_NORM_UNDEFINED;
+    NormParam normParam;
+};
+
+struct LinearParam {
+    enum MatmulType : int {
+        MATMUL_UNDEFINED = 0,
+        MATMUL_EIN_SUM,
+    };
+    enum QuantMode : int {
+        QUANT_UNDEFINED = 0,
+        PER_CHANNEL,
+        PER_TOKEN,
+    };
+    bool transposeA = false;
+    bool transposeB = true;
+    bool hasBias = true;
+    aclDataType outDataType = ACL_DT_UNDEFINED;
+    bool enAccum = false;
+    MatmulType matmulType = MATMUL_UNDEFINED;
+    QuantMode quantMode = QUANT_UNDEFINED;
+};
+} // namespace infer
+} // namespace atb
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef SIM_ATB_SVECTOR_H
+#define SIM_ATB_SVECTOR_H
+
+#include <vector>
+
+namespace atb {
+// 仿真后端中SVector直接复用std::vector的语义
+template <typename T> class SVector : public std::vector<T> {
+public:
+    using std::vector<T>::vector;
+};
+} // namespace atb
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef SIM_ATB_TYPES_H
+#define SIM_ATB_TYPES_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "acl/acl.h"
+#include "atb/svector.h"
+
+namespace atb {
+using Status = int32_t;
+
+enum ErrorType : int {
+    NO_ERROR = 0,
+    ERROR_INVALID_PARAM,
+    ERROR_INVALID_GRAPH,
+    ERROR_INTERNAL_ERROR,
+    ERROR_RT_FAIL,
+    ERROR_INVALID_IN_TENSOR_NUM,
+    ERROR_INVALID_TENSOR_DTYPE,
+    ERROR_INVALID_TENSOR_FORMAT,
+    ERROR_INVALID_TENSOR_DIM,
+    ERROR_INVALID_TENSOR_SIZE,
+    ERROR_OPERATION_NULL_RUNNER,
+    ERROR_GRAPH_INFERSHAPE_FUNC_FAIL,
+    ERROR_CANN_ERROR,
+    ERROR_INVALID_TENSOR_INI_MATCH,
+};
+
+constexpr uint32_t MAX_DIM = 8;
+
+struct Dims {
+    int64_t dims[MAX_DIM] = {0};
+    uint64_t dimNum = 0;
+};
+
+struct TensorDesc {
+    aclDataType dtype = ACL_DT_UNDEFINED;
+    aclFormat format = ACL_FORMAT_UNDEFINED;
+    Dims shape;
+};
+
+struct Tensor {
+    TensorDesc desc;
+    void *deviceData = nullptr;
+    void *hostData = nullptr;
+    uint64_t dataSize = 0;
+};
+
+struct VariantPack {
+    SVector<Tensor> inTensors;
+    SVector<Tensor> outTensors;
+};
+
+class Operation;
+
+using InferShapeFunc = std::function<Status(const SVector<TensorDesc> &inTensorDescs,
+                                            SVector<TensorDesc> &outTensorDescs)>;
+
+struct Node {
+    Operation *operation = nullptr;
+    SVector<uint32_t> inTensorIds;
+    SVector<uint32_t> outTensorIds;
+};
+
+struct GraphParam {
+    std::string name;
+    uint32_t inTensorNum = 0;
+    uint32_t outTensorNum = 0;
+    uint32_t internalTensorNum = 0;
+    std::vector<Node> nodes;
+    InferShapeFunc inferShapeFunc = nullptr;
+};
+} // namespace atb
+
+#endif
@@ -0,0 +1,448 @@
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include "sim_runtime.h"
+
+namespace sim {
+namespace {
+constexpr size_t MEM_ALIGN = 64;
+constexpr uint32_t DEFAULT_DEVICE_COUNT = 2;
+constexpr size_t DEFAULT_DEVICE_MEM_MB = 32768;
+
+thread_local int32_t t_deviceId = 0;
+thread_local uint32_t t_setupDelaySuppress = 0;
+
+uint32_t EnvOrDefault(const char *name, uint32_t defaultValue)
+{
+    const char *value = std::getenv(name);
+    if (value == nullptr || *value == '\0') {
+        return defaultValue;
+    }
+    return static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+}
+
+// 记录每个device已分配的内存，用于aclrtGetMemInfo
+struct DeviceMemory {
+    std::mutex mutex;
+    std::map<void *, std::pair<int32_t, size_t>> allocations;
+    std::vector<size_t> usedBytes;
+    size_t totalBytes = 0;
+
+    DeviceMemory()
+    {
+        usedBytes.resize(EnvOrDefault("SIM_DEVICE_COUNT", DEFAULT_DEVICE_COUNT), 0);
+        totalBytes = static_cast<size_t>(EnvOrDefault("SIM_DEVICE_MEM_MB", DEFAULT_DEVICE_MEM_MB)) << 20;
+    }
+};
+
+// 不析构：进程退出时静态对象析构顺序不确定，仍可能有内存池在释放device内存
+DeviceMemory &GetDeviceMemory()
+{
+    static DeviceMemory *deviceMemory = new DeviceMemory();
+    return *deviceMemory;
+}
+} // namespace
+
+SimStream::SimStream(int32_t deviceId) : deviceId_(deviceId)
+{
+    worker_ = std::thread([this] { WorkerLoop(); });
+}
+
+SimStream::~SimStream()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    taskCv_.notify_all();
+    worker_.join();
+}
+
+void SimStream::Enqueue(std::function<void()> task)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    taskCv_.notify_one();
+}
+
+void SimStream::Synchronize()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCv_.wait(lock, [this] { return tasks_.empty() && !busy_; });
+}
+
+void SimStream::WorkerLoop()
+{
+    t_deviceId = deviceId_;
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            taskCv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+            busy_ = true;
+        }
+        task();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            busy_ = false;
+            if (tasks_.empty()) {
+                idleCv_.notify_all();
+            }
+        }
+    }
+}
+
+int32_t CurrentDevice()
+{
+    return t_deviceId;
+}
+
+void Launch(aclrtStream stream, std::function<void()> task)
+{
+    if (stream == nullptr) {
+        task();
+        return;
+    }
+    static const uint32_t kernelLatencyUs = EnvOrDefault("SIM_KERNEL_LATENCY_US", 0);
+    if (kernelLatencyUs == 0) {
+        static_cast<SimStream *>(stream)->Enqueue(std::move(task));
+        return;
+    }
+    static_cast<SimStream *>(stream)->Enqueue([task = std::move(task)] {
+        auto deadline = Clock::now() + std::chrono::microseconds(kernelLatencyUs);
+        task();
+        std::this_thread::sleep_until(deadline);
+    });
+}
+
+void HostSetupDelay()
+{
+    static const uint32_t setupLatencyUs = EnvOrDefault("SIM_SETUP_LATENCY_US", 0);
+    if (setupLatencyUs != 0 && t_setupDelaySuppress == 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(setupLatencyUs));
+    }
+}
+
+ScopedSetupDelaySuppress::ScopedSetupDelaySuppress()
+{
+    t_setupDelaySuppress++;
+}
+
+ScopedSetupDelaySuppress::~ScopedSetupDelaySuppress()
+{
+    t_setupDelaySuppress--;
+}
+
+void HostLaunchDelay()
+{
+    static const uint32_t launchLatencyUs = EnvOrDefault("SIM_LAUNCH_LATENCY_US", 0);
+    if (launchLatencyUs != 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(launchLatencyUs));
+    }
+}
+} // namespace sim
+
+using sim::SimEvent;
+using sim::SimStream;
+
+aclError aclInit(const char *configPath)
+{
+    (void)configPath;
+    return ACL_SUCCESS;
+}
+
+aclError aclFinalize()
+{
+    return ACL_SUCCESS;
+}
+
+aclError aclrtSetDevice(int32_t deviceId)
+{
+    if (deviceId < 0 || static_cast<size_t>(deviceId) >= sim::GetDeviceMemory().usedBytes.size()) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    sim::t_deviceId = deviceId;
+    return ACL_SUCCESS;
+}
+
+aclError aclrtResetDevice(int32_t deviceId)
+{
+    (void)deviceId;
+    return ACL_SUCCESS;
+}
+
+aclError aclrtGetDevice(int32_t *deviceId)
+{
+    *deviceId = sim::t_deviceId;
+    return ACL_SUCCESS;
+}
+
+aclError aclrtGetDeviceCount(uint32_t *count)
+{
+    *count = static_cast<uint32_t>(sim::GetDeviceMemory().usedBytes.size());
+    return ACL_SUCCESS;
+}
+
+aclError aclrtDeviceCanAccessPeer(int32_t *canAccessPeer, int32_t deviceId, int32_t peerDeviceId)
+{
+    size_t deviceCount = sim::GetDeviceMemory().usedBytes.size();
+    if (canAccessPeer == nullptr || deviceId < 0 || peerDeviceId < 0 || static_cast<size_t>(deviceId) >= deviceCount ||
+        static_cast<size_t>(peerDeviceId) >= deviceCount) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    // 仿真device内存都在host上，不同device之间总是可以直接拷贝
+    *canAccessPeer = deviceId != peerDeviceId ? 1 : 0;
+    return ACL_SUCCESS;
+}
+
+aclError aclrtDeviceEnablePeerAccess(int32_t peerDeviceId, uint32_t flags)
+{
+    (void)flags;
+    if (peerDeviceId < 0 || static_cast<size_t>(peerDeviceId) >= sim::GetDeviceMemory().usedBytes.size()) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    return ACL_SUCCESS;
+}
+
+aclError aclrtGetMemInfo(aclrtMemAttr attr, size_t *free, size_t *total)
+{
+    (void)attr;
+    auto &deviceMemory = sim::GetDeviceMemory();
+    std::unique_lock<std::mutex> lock(deviceMemory.mutex);
+    size_t used = deviceMemory.usedBytes.at(sim::t_deviceId);
+    *total = deviceMemory.totalBytes;
+    *free = used > deviceMemory.totalBytes ? 0 : deviceMemory.totalBytes - used;
+    return ACL_SUCCESS;
+}
+
+aclError aclrtMalloc(void **devPtr, size_t size, aclrtMemMallocPolicy policy)
+{
+    (void)policy;
+    if (devPtr == nullptr || size == 0) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    auto &deviceMemory = sim::GetDeviceMemory();
+    size_t alignedSize = (size + sim::MEM_ALIGN - 1) & ~(sim::MEM_ALIGN - 1);
+    {
+        std::unique_lock<std::mutex> lock(deviceMemory.mutex);
+        if (deviceMemory.usedBytes.at(sim::t_deviceId) + alignedSize > deviceMemory.totalBytes) {
+            return ACL_ERROR_BAD_ALLOC;
+        }
+    }
+    *devPtr = std::aligned_alloc(sim::MEM_ALIGN, alignedSize);
+    if (*devPtr == nullptr) {
+        return ACL_ERROR_BAD_ALLOC;
+    }
+    std::unique_lock<std::mutex> lock(deviceMemory.mutex);
+    deviceMemory.allocations[*devPtr] = {sim::t_deviceId, alignedSize};
+    deviceMemory.usedBytes.at(sim::t_deviceId) += alignedSize;
+    return ACL_SUCCESS;
+}
+
+aclError aclrtFree(void *devPtr)
+{
+    if (devPtr == nullptr) {
+        return ACL_SUCCESS;
+    }
+    auto &deviceMemory = sim::GetDeviceMemory();
+    {
+        std::unique_lock<std::mutex> lock(deviceMemory.mutex);
+        auto it = deviceMemory.allocations.find(devPtr);
+        if (it == deviceMemory.allocations.end()) {
+            return ACL_ERROR_INVALID_PARAM;
+        }
+        deviceMemory.usedBytes.at(it->second.first) -= it->second.second;
+        deviceMemory.allocations.erase(it);
+    }
+    std::free(devPtr);
+    return ACL_SUCCESS;
+}
+
+aclError aclrtMallocHost(void **hostPtr, size_t size)
+{
+    if (hostPtr == nullptr || size == 0) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    *hostPtr = std::aligned_alloc(sim::MEM_ALIGN, (size + sim::MEM_ALIGN - 1) & ~(sim::MEM_ALIGN - 1));
+    return *hostPtr == nullptr ? ACL_ERROR_BAD_ALLOC : ACL_SUCCESS;
+}
+
+aclError aclrtFreeHost(void *hostPtr)
+{
+    std::free(hostPtr);
+    return ACL_SUCCESS;
+}
+
+aclError aclrtHostRegister(void *ptr, uint64_t size, aclrtHostRegisterType type, void **devPtr)
+{
+    (void)size;
+    (void)type;
+    // host与device共享同一地址空间，注册后的device地址即host地址
+    *devPtr = ptr;
+    return ACL_SUCCESS;
+}
+
+aclError aclrtHostUnregister(void *ptr)
+{
+    (void)ptr;
+    return ACL_SUCCESS;
+}
+
+aclError aclrtMemset(void *devPtr, size_t maxCount, int32_t value, size_t count)
+{
+    if (count > maxCount) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    std::memset(devPtr, value, count);
+    return ACL_SUCCESS;
+}
+
+aclError aclrtMemcpy(void *dst, size_t destMax, const void *src, size_t count, aclrtMemcpyKind kind)
+{
+    (void)kind;
+    if (count > destMax || dst == nullptr || src == nullptr) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    std::memcpy(dst, src, count);
+    return ACL_SUCCESS;
+}
+
+aclError aclrtMemcpyAsync(
+    void *dst, size_t destMax, const void *src, size_t count, aclrtMemcpyKind kind, aclrtStream stream)
+{
+    (void)kind;
+    if (count > destMax || dst == nullptr || src == nullptr) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    sim::Launch(stream, [dst, src, count] { std::memcpy(dst, src, count); });
+    return ACL_SUCCESS;
+}
+
+aclError aclrtMemcpy2d(void *dst, size_t dpitch, const void *src, size_t spitch, size_t width, size_t height,
+                       aclrtMemcpyKind kind)
+{
+    (void)kind;
+    if (width > dpitch || width > spitch || dst == nullptr || src == nullptr) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    for (size_t row = 0; row < height; ++row) {
+        std::memcpy(static_cast<uint8_t *>(dst) + row * dpitch, static_cast<const uint8_t *>(src) + row * spitch,
+                    width);
+    }
+    return ACL_SUCCESS;
+}
+
+aclError aclrtCreateStream(aclrtStream *stream)
+{
+    *stream = new SimStream(sim::t_deviceId);
+    return ACL_SUCCESS;
+}
+
+aclError aclrtDestroyStream(aclrtStream stream)
+{
+    if (stream == nullptr) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    auto *simStream = static_cast<SimStream *>(stream);
+    simStream->Synchronize();
+    delete simStream;
+    return ACL_SUCCESS;
+}
+
+aclError aclrtSynchronizeStream(aclrtStream stream)
+{
+    if (stream == nullptr) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    static_cast<SimStream *>(stream)->Synchronize();
+    return ACL_SUCCESS;
+}
+
+aclError aclrtCreateEvent(aclrtEvent *event)
+{
+    *event = new SimEvent();
+    return ACL_SUCCESS;
+}
+
+aclError aclrtDestroyEvent(aclrtEvent event)
+{
+    delete static_cast<SimEvent *>(event);
+    return ACL_SUCCESS;
+}
+
+aclError aclrtRecordEvent(aclrtEvent event, aclrtStream stream)
+{
+    auto *simEvent = static_cast<SimEvent *>(event);
+    uint64_t seq = 0;
+    {
+        std::unique_lock<std::mutex> lock(simEvent->mutex);
+        seq = ++simEvent->recordSeq;
+    }
+    sim::Launch(stream, [simEvent, seq] {
+        std::unique_lock<std::mutex> lock(simEvent->mutex);
+        simEvent->timestamp = sim::Clock::now();
+        simEvent->completeSeq = seq;
+        simEvent->cv.notify_all();
+    });
+    return ACL_SUCCESS;
+}
+
+aclError aclrtStreamWaitEvent(aclrtStream stream, aclrtEvent event)
+{
+    auto *simEvent = static_cast<SimEvent *>(event);
+    uint64_t seq = 0;
+    {
+        std::unique_lock<std::mutex> lock(simEvent->mutex);
+        seq = simEvent->recordSeq;
+    }
+    sim::Launch(stream, [simEvent, seq] {
+        std::unique_lock<std::mutex> lock(simEvent->mutex);
+        simEvent->cv.wait(lock, [simEvent, seq] { return simEvent->completeSeq >= seq; });
+    });
+    return ACL_SUCCESS;
+}
+
+aclError aclrtSynchronizeEvent(aclrtEvent event)
+{
+    auto *simEvent = static_cast<SimEvent *>(event);
+    std::unique_lock<std::mutex> lock(simEvent->mutex);
+    uint64_t seq = simEvent->recordSeq;
+    simEvent->cv.wait(lock, [simEvent, seq] { return simEvent->completeSeq >= seq; });
+    return ACL_SUCCESS;
+}
+
+aclError aclrtQueryEventStatus(aclrtEvent event, aclrtEventRecordedStatus *status)
+{
+    auto *simEvent = static_cast<SimEvent *>(event);
+    std::unique_lock<std::mutex> lock(simEvent->mutex);
+    *status = simEvent->completeSeq >= simEvent->recordSeq ? ACL_EVENT_RECORDED_STATUS_COMPLETE
+                                                           : ACL_EVENT_RECORDED_STATUS_NOT_READY;
+    return ACL_SUCCESS;
+}
+
+aclError aclrtEventElapsedTime(float *ms, aclrtEvent startEvent, aclrtEvent endEvent)
+{
+    auto *start = static_cast<SimEvent *>(startEvent);
+    auto *end = static_cast<SimEvent *>(endEvent);
+    sim::Clock::time_point startTime;
+    sim::Clock::time_point endTime;
+    {
+        std::unique_lock<std::mutex> lock(start->mutex);
+        startTime = start->timestamp;
+    }
+    {
+        std::unique_lock<std::mutex> lock(end->mutex);
+        endTime = end->timestamp;
+    }
+    *ms = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+    return ACL_SUCCESS;
+}
@@ -0,0 +1,666 @@
+#include <algorithm>
+#include <string>
+#include "aclnnop/aclnn_add.h"
+#include "aclnnop/aclnn_add_layer_norm.h"
+#include "aclnnop/aclnn_amax.h"
+#include "aclnnop/aclnn_amin.h"
+#include "aclnnop/aclnn_batch_matmul.h"
+#include "aclnnop/aclnn_fused_matmul.h"
+#include "aclnnop/aclnn_gelu.h"
+#include "aclnnop/aclnn_gelu_v2.h"
+#include "aclnnop/aclnn_mean.h"
+#include "aclnnop/aclnn_mul.h"
+#include "aclnnop/aclnn_ne_tensor.h"
+#include "aclnnop/aclnn_reduce_sum.h"
+#include "aclnnop/aclnn_softmax.h"
+#include "aclnnop/aclnn_weight_quant_batch_matmul_v2.h"
+#include "sim_aclnn.h"
+#include "sim_runtime.h"
+
+namespace sim {
+StridedView ToView(const aclTensor &tensor)
+{
+    StridedView view;
+    view.data = tensor.data;
+    view.dtype = tensor.dtype;
+    view.shape = tensor.viewDims;
+    view.strides = tensor.strides;
+    view.offset = tensor.offset;
+    return view;
+}
+
+aclnnStatus CreateExecutor(std::vector<aclTensor *> inputs, std::vector<aclTensor *> outputs, SimAclnnKernel kernel,
+                           uint64_t *workspaceSize, aclOpExecutor **executor, uint64_t optionalMask)
+{
+    if (workspaceSize == nullptr || executor == nullptr) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    for (size_t i = 0; i < inputs.size(); i++) {
+        if (inputs[i] == nullptr && ((optionalMask >> i) & 1) == 0) {
+            return ACL_ERROR_INVALID_PARAM;
+        }
+    }
+    for (auto *tensor : outputs) {
+        if (tensor == nullptr) {
+            return ACL_ERROR_INVALID_PARAM;
+        }
+    }
+    HostSetupDelay();
+    auto *newExecutor = new aclOpExecutor();
+    newExecutor->inputs = std::move(inputs);
+    newExecutor->outputs = std::move(outputs);
+    newExecutor->kernel = std::move(kernel);
+    *workspaceSize = 0;
+    *executor = newExecutor;
+    return ACL_SUCCESS;
+}
+
+aclnnStatus LaunchExecutor(aclOpExecutor *executor, aclrtStream stream)
+{
+    if (executor == nullptr) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    std::vector<aclTensor> inputs;
+    std::vector<aclTensor> outputs;
+    for (auto *tensor : executor->inputs) {
+        inputs.push_back(tensor != nullptr ? *tensor : aclTensor());
+    }
+    for (auto *tensor : executor->outputs) {
+        outputs.push_back(*tensor);
+    }
+    HostLaunchDelay();
+    Launch(stream, [kernel = executor->kernel, inputs = std::move(inputs), outputs = std::move(outputs)] {
+        kernel(inputs, outputs);
+    });
+    if (!executor->repeatable) {
+        delete executor;
+    }
+    return ACL_SUCCESS;
+}
+} // namespace sim
+
+aclTensor *aclCreateTensor(const int64_t *viewDims, uint64_t viewDimsNum, aclDataType dataType, const int64_t *stride,
+                           int64_t offset, aclFormat format, const int64_t *storageDims, uint64_t storageDimsNum,
+                           void *tensorData)
+{
+    auto *tensor = new aclTensor();
+    tensor->viewDims.assign(viewDims, viewDims + viewDimsNum);
+    if (stride != nullptr) {
+        tensor->strides.assign(stride, stride + viewDimsNum);
+    } else {
+        tensor->strides = sim::ContiguousStrides(tensor->viewDims);
+    }
+    tensor->offset = offset;
+    tensor->dtype = dataType;
+    tensor->format = format;
+    tensor->storageDims.assign(storageDims, storageDims + storageDimsNum);
+    tensor->data = tensorData;
+    return tensor;
+}
+
+aclnnStatus aclDestroyTensor(const aclTensor *tensor)
+{
+    delete tensor;
+    return ACL_SUCCESS;
+}
+
+aclScalar *aclCreateScalar(void *value, aclDataType dataType)
+{
+    auto *scalar = new aclScalar();
+    scalar->dtype = dataType;
+    switch (dataType) {
+        case ACL_DOUBLE:
+            scalar->value = *static_cast<double *>(value);
+            break;
+        case ACL_INT64:
+            scalar->value = static_cast<double>(*static_cast<int64_t *>(value));
+            break;
+        default:
+            scalar->value = sim::LoadElement(value, dataType, 0);
+            break;
+    }
+    return scalar;
+}
+
+aclnnStatus aclDestroyScalar(const aclScalar *scalar)
+{
+    delete scalar;
+    return ACL_SUCCESS;
+}
+
+aclIntArray *aclCreateIntArray(const int64_t *value, uint64_t size)
+{
+    auto *array = new aclIntArray();
+    array->values.assign(value, value + size);
+    return array;
+}
+
+aclnnStatus aclDestroyIntArray(const aclIntArray *array)
+{
+    delete array;
+    return ACL_SUCCESS;
+}
+
+aclnnStatus aclSetInputTensorAddr(aclOpExecutor *executor, const size_t index, aclTensor *tensor, void *addr)
+{
+    if (executor == nullptr || index >= executor->inputs.size()) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    aclTensor *target = tensor != nullptr ? tensor : executor->inputs[index];
+    if (target == nullptr) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    target->data = addr;
+    return ACL_SUCCESS;
+}
+
+aclnnStatus aclSetOutputTensorAddr(aclOpExecutor *executor, const size_t index, aclTensor *tensor, void *addr)
+{
+    if (executor == nullptr || index >= executor->outputs.size()) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    (tensor != nullptr ? tensor : executor->outputs[index])->data = addr;
+    return ACL_SUCCESS;
+}
+
+aclnnStatus aclSetAclOpExecutorRepeatable(aclOpExecutor *executor)
+{
+    if (executor == nullptr) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    executor->repeatable = true;
+    return ACL_SUCCESS;
+}
+
+aclnnStatus aclDestroyAclOpExecutor(aclOpExecutor *executor)
+{
+    delete executor;
+    return ACL_SUCCESS;
+}
+
+namespace {
+SimAclnnKernel MakeGeluKernel(int64_t approximate)
+{
+    return [approximate](const std::vector<aclTensor> &inputs, const std::vector<aclTensor> &outputs) {
+        std::vector<float> values = sim::Gather(sim::ToView(inputs[0]));
+        for (auto &value : values) {
+            value = sim::Gelu(value, approximate);
+        }
+        sim::Scatter(sim::ToView(outputs[0]), values);
+    };
+}
+} // namespace
+
+aclnnStatus aclnnGeluGetWorkspaceSize(
+    const aclTensor *self, aclTensor *out, uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    return sim::CreateExecutor({const_cast<aclTensor *>(self)}, {out}, MakeGeluKernel(0), workspaceSize, executor);
+}
+
+aclnnStatus aclnnGelu(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+aclnnStatus aclnnGeluV2GetWorkspaceSize(
+    const aclTensor *x, int64_t approximate, aclTensor *y, uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    if (approximate != 0 && approximate != 1) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    return sim::CreateExecutor(
+        {const_cast<aclTensor *>(x)}, {y}, MakeGeluKernel(approximate), workspaceSize, executor);
+}
+
+aclnnStatus aclnnGeluV2(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+aclnnStatus aclnnWeightQuantBatchMatmulV2GetWorkspaceSize(const aclTensor *x, const aclTensor *weight,
+    const aclTensor *antiquantScale, const aclTensor *antiquantOffsetOptional, const aclTensor *quantScaleOptional,
+    const aclTensor *quantOffsetOptional, const aclTensor *biasOptional, int antiquantGroupSize, const aclTensor *y,
+    uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    // 仿真只支持per-channel/per-tensor反量化，不支持输出量化
+    if (x == nullptr || weight == nullptr || antiquantScale == nullptr || y == nullptr ||
+        quantScaleOptional != nullptr || quantOffsetOptional != nullptr || antiquantGroupSize != 0 ||
+        weight->dtype != ACL_INT8 || weight->viewDims.size() != 2 || x->viewDims.empty() ||
+        x->viewDims.back() != weight->viewDims[0]) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    bool hasOffset = antiquantOffsetOptional != nullptr;
+    bool hasBias = biasOptional != nullptr;
+    auto kernel = [hasOffset, hasBias](const std::vector<aclTensor> &inputs, const std::vector<aclTensor> &outputs) {
+        std::vector<float> input = sim::Gather(sim::ToView(inputs[0]));
+        std::vector<float> weightValues = sim::Gather(sim::ToView(inputs[1]));
+        std::vector<float> scale = sim::Gather(sim::ToView(inputs[2]));
+        int64_t k = inputs[1].viewDims[0];
+        int64_t n = inputs[1].viewDims[1];
+        int64_t m = static_cast<int64_t>(input.size()) / k;
+        std::vector<float> offset;
+        if (hasOffset) {
+            offset = sim::Gather(sim::ToView(inputs[3]));
+        }
+        for (int64_t row = 0; row < k; row++) {
+            for (int64_t col = 0; col < n; col++) {
+                float &value = weightValues[row * n + col];
+                size_t channel = scale.size() == 1 ? 0 : col;
+                value = (value + (hasOffset ? offset[offset.size() == 1 ? 0 : col] : 0.0f)) * scale[channel];
+            }
+        }
+        std::vector<float> bias;
+        if (hasBias) {
+            bias = sim::Gather(sim::ToView(inputs[6]));
+        }
+        std::vector<float> output(m * n);
+        sim::Matmul(input.data(), weightValues.data(), hasBias ? bias.data() : nullptr, output.data(), m, k, n, false);
+        sim::Scatter(sim::ToView(outputs[0]), output);
+    };
+    // 下标3~6为可选输入
+    constexpr uint64_t OPTIONAL_MASK = (1 << 3) | (1 << 4) | (1 << 5) | (1 << 6);
+    return sim::CreateExecutor({const_cast<aclTensor *>(x), const_cast<aclTensor *>(weight),
+                                   const_cast<aclTensor *>(antiquantScale),
+                                   const_cast<aclTensor *>(antiquantOffsetOptional),
+                                   const_cast<aclTensor *>(quantScaleOptional),
+                                   const_cast<aclTensor *>(quantOffsetOptional), const_cast<aclTensor *>(biasOptional)},
+        {const_cast<aclTensor *>(y)}, kernel, workspaceSize, executor, OPTIONAL_MASK);
+}
+
+aclnnStatus aclnnWeightQuantBatchMatmulV2(
+    void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+namespace {
+// dim为空表示规约全部维度，输出元素个数需与规约结果一致
+aclnnStatus CreateReduceExecutor(const aclTensor *self, const aclIntArray *dim, aclTensor *out, sim::ReduceMode mode,
+                                 uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    if (self == nullptr || out == nullptr) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    int64_t rank = static_cast<int64_t>(self->viewDims.size());
+    std::vector<bool> reduced(rank, dim == nullptr || dim->values.empty());
+    if (dim != nullptr) {
+        for (int64_t axis : dim->values) {
+            axis = axis < 0 ? axis + rank : axis;
+            if (axis < 0 || axis >= rank) {
+                return ACL_ERROR_INVALID_PARAM;
+            }
+            reduced[axis] = true;
+        }
+    }
+    int64_t outCount = 1;
+    for (int64_t d = 0; d < rank; d++) {
+        outCount *= reduced[d] ? 1 : self->viewDims[d];
+    }
+    if (sim::ToView(*out).Numel() != outCount) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    auto kernel = [reduced, mode](const std::vector<aclTensor> &inputs, const std::vector<aclTensor> &outputs) {
+        std::vector<float> values = sim::Gather(sim::ToView(inputs[0]));
+        std::vector<float> result;
+        sim::Reduce(values.data(), inputs[0].viewDims, reduced, mode, result);
+        sim::Scatter(sim::ToView(outputs[0]), result);
+    };
+    return sim::CreateExecutor({const_cast<aclTensor *>(self)}, {out}, kernel, workspaceSize, executor);
+}
+} // namespace
+
+aclnnStatus aclnnAmaxGetWorkspaceSize(const aclTensor *self, const aclIntArray *dim, bool keepDim, aclTensor *out,
+                                      uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    (void)keepDim;
+    return CreateReduceExecutor(self, dim, out, sim::ReduceMode::MAX, workspaceSize, executor);
+}
+
+aclnnStatus aclnnAmax(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+aclnnStatus aclnnAminGetWorkspaceSize(const aclTensor *self, const aclIntArray *dim, bool keepDim, aclTensor *out,
+                                      uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    (void)keepDim;
+    return CreateReduceExecutor(self, dim, out, sim::ReduceMode::MIN, workspaceSize, executor);
+}
+
+aclnnStatus aclnnAmin(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+aclnnStatus aclnnMeanGetWorkspaceSize(const aclTensor *self, const aclIntArray *dim, bool keepDim, aclDataType dtype,
+                                      aclTensor *out, uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    (void)keepDim;
+    if (out == nullptr || out->dtype != dtype) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    return CreateReduceExecutor(self, dim, out, sim::ReduceMode::MEAN, workspaceSize, executor);
+}
+
+aclnnStatus aclnnMean(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+aclnnStatus aclnnReduceSumGetWorkspaceSize(const aclTensor *self, const aclIntArray *dims, bool keepDims,
+                                           aclDataType dtype, aclTensor *out, uint64_t *workspaceSize,
+                                           aclOpExecutor **executor)
+{
+    (void)keepDims;
+    if (out == nullptr || out->dtype != dtype) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    return CreateReduceExecutor(self, dims, out, sim::ReduceMode::SUM, workspaceSize, executor);
+}
+
+aclnnStatus aclnnReduceSum(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+aclnnStatus aclnnNeTensorGetWorkspaceSize(const aclTensor *self, const aclTensor *other, aclTensor *out,
+                                          uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    if (self == nullptr || other == nullptr || out == nullptr || out->dtype != ACL_BOOL) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    int64_t count = sim::ToView(*self).Numel();
+    int64_t otherCount = sim::ToView(*other).Numel();
+    if ((otherCount != count && otherCount != 1) || sim::ToView(*out).Numel() != count) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    auto kernel = [](const std::vector<aclTensor> &inputs, const std::vector<aclTensor> &outputs) {
+        std::vector<float> values = sim::Gather(sim::ToView(inputs[0]));
+        std::vector<float> others = sim::Gather(sim::ToView(inputs[1]));
+        for (size_t i = 0; i < values.size(); i++) {
+            // 与nan比较恒不相等，self与自身比较即可得到nan掩码
+            values[i] = values[i] != others[others.size() == 1 ? 0 : i] ? 1.0f : 0.0f;
+        }
+        sim::Scatter(sim::ToView(outputs[0]), values);
+    };
+    return sim::CreateExecutor(
+        {const_cast<aclTensor *>(self), const_cast<aclTensor *>(other)}, {out}, kernel, workspaceSize, executor);
+}
+
+aclnnStatus aclnnNeTensor(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+namespace {
+// other的形状需与self的尾部维度一致（忽略other前面的1），用于bias等按最后几维广播的输入
+bool IsTrailingBroadcast(const aclTensor *self, const aclTensor *other)
+{
+    size_t first = 0;
+    while (first + 1 < other->viewDims.size() && other->viewDims[first] == 1) {
+        first++;
+    }
+    size_t rank = other->viewDims.size() - first;
+    if (rank > self->viewDims.size()) {
+        return false;
+    }
+    return std::equal(other->viewDims.begin() + first, other->viewDims.end(), self->viewDims.end() - rank);
+}
+} // namespace
+
+aclnnStatus aclnnAddLayerNormGetWorkspaceSize(const aclTensor *x1, const aclTensor *x2, const aclTensor *gamma,
+                                              const aclTensor *beta, const aclTensor *biasOptional, double epsilon,
+                                              bool additionalOutput, const aclTensor *yOut, const aclTensor *meanOut,
+                                              const aclTensor *rstdOut, const aclTensor *xOut, uint64_t *workspaceSize,
+                                              aclOpExecutor **executor)
+{
+    if (x1 == nullptr || x2 == nullptr || gamma == nullptr || beta == nullptr || yOut == nullptr ||
+        meanOut == nullptr || rstdOut == nullptr || xOut == nullptr || x1->viewDims != x2->viewDims ||
+        !IsTrailingBroadcast(x1, gamma) || sim::ToView(*gamma).Numel() != sim::ToView(*beta).Numel() ||
+        (biasOptional != nullptr && !IsTrailingBroadcast(x1, biasOptional))) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    int64_t cols = sim::ToView(*gamma).Numel();
+    int64_t rows = sim::ToView(*x1).Numel() / cols;
+    if (sim::ToView(*meanOut).Numel() != rows || sim::ToView(*rstdOut).Numel() != rows) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    bool hasBias = biasOptional != nullptr;
+    auto kernel = [rows, cols, epsilon, hasBias, additionalOutput](const std::vector<aclTensor> &inputs,
+                                                                    const std::vector<aclTensor> &outputs) {
+        std::vector<float> x = sim::Gather(sim::ToView(inputs[0]));
+        std::vector<float> other = sim::Gather(sim::ToView(inputs[1]));
+        std::vector<float> gammaValues = sim::Gather(sim::ToView(inputs[2]));
+        std::vector<float> betaValues = sim::Gather(sim::ToView(inputs[3]));
+        std::vector<float> bias;
+        if (hasBias) {
+            bias = sim::Gather(sim::ToView(inputs[4]));
+        }
+        for (size_t i = 0; i < x.size(); i++) {
+            x[i] += other[i] + (hasBias ? bias[i % bias.size()] : 0.0f);
+        }
+        std::vector<float> y(x.size());
+        std::vector<float> mean(rows);
+        std::vector<float> rstd(rows);
+        sim::LayerNorm(x.data(), gammaValues.data(), betaValues.data(), y.data(), rows, cols,
+                       static_cast<float>(epsilon), mean.data(), rstd.data());
+        sim::Scatter(sim::ToView(outputs[0]), y);
+        sim::Scatter(sim::ToView(outputs[1]), mean);
+        sim::Scatter(sim::ToView(outputs[2]), rstd);
+        if (additionalOutput) {
+            sim::Scatter(sim::ToView(outputs[3]), x);
+        }
+    };
+    // 下标4的bias为可选输入
+    constexpr uint64_t OPTIONAL_MASK = 1 << 4;
+    return sim::CreateExecutor({const_cast<aclTensor *>(x1), const_cast<aclTensor *>(x2),
+                                   const_cast<aclTensor *>(gamma), const_cast<aclTensor *>(beta),
+                                   const_cast<aclTensor *>(biasOptional)},
+        {const_cast<aclTensor *>(yOut), const_cast<aclTensor *>(meanOut), const_cast<aclTensor *>(rstdOut),
+            const_cast<aclTensor *>(xOut)},
+        kernel, workspaceSize, executor, OPTIONAL_MASK);
+}
+
+aclnnStatus aclnnAddLayerNorm(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+aclnnStatus aclnnSoftmaxGetWorkspaceSize(
+    const aclTensor *self, int64_t dim, aclTensor *out, uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    if (self == nullptr || out == nullptr || self->viewDims != out->viewDims) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    int64_t rank = static_cast<int64_t>(self->viewDims.size());
+    dim = dim < 0 ? dim + rank : dim;
+    if (dim < 0 || dim >= rank) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    int64_t outer = 1;
+    int64_t inner = 1;
+    for (int64_t d = 0; d < rank; d++) {
+        outer *= d < dim ? self->viewDims[d] : 1;
+        inner *= d > dim ? self->viewDims[d] : 1;
+    }
+    int64_t axis = self->viewDims[dim];
+    auto kernel = [outer, axis, inner](const std::vector<aclTensor> &inputs, const std::vector<aclTensor> &outputs) {
+        std::vector<float> values = sim::Gather(sim::ToView(inputs[0]));
+        std::vector<float> result(values.size());
+        sim::Softmax(values.data(), result.data(), outer, axis, inner);
+        sim::Scatter(sim::ToView(outputs[0]), result);
+    };
+    return sim::CreateExecutor({const_cast<aclTensor *>(self)}, {out}, kernel, workspaceSize, executor);
+}
+
+aclnnStatus aclnnSoftmax(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+aclnnStatus aclnnFusedMatmulGetWorkspaceSize(const aclTensor *x, const aclTensor *x2, const aclTensor *bias,
+                                             const aclTensor *x3, const char *fusedOpType, int8_t cubeMathType,
+                                             const aclTensor *y, uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    (void)cubeMathType;
+    std::string opType = fusedOpType != nullptr ? fusedOpType : "";
+    if (x == nullptr || x2 == nullptr || y == nullptr || x3 != nullptr ||
+        (opType != "" && opType != "gelu_erf" && opType != "gelu_tanh") || x->viewDims.size() < 2 ||
+        x2->viewDims.size() != 2 || x->viewDims.back() != x2->viewDims[0] ||
+        (bias != nullptr && sim::ToView(*bias).Numel() != x2->viewDims[1])) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    int64_t k = x2->viewDims[0];
+    int64_t n = x2->viewDims[1];
+    int64_t m = sim::ToView(*x).Numel() / k;
+    if (sim::ToView(*y).Numel() != m * n) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    bool hasBias = bias != nullptr;
+    int64_t approximate = opType == "gelu_tanh" ? 1 : 0;
+    bool hasGelu = !opType.empty();
+    auto kernel = [m, k, n, hasBias, hasGelu, approximate](const std::vector<aclTensor> &inputs,
+                                                            const std::vector<aclTensor> &outputs) {
+        std::vector<float> input = sim::Gather(sim::ToView(inputs[0]));
+        std::vector<float> weight = sim::Gather(sim::ToView(inputs[1]));
+        std::vector<float> biasValues;
+        if (hasBias) {
+            biasValues = sim::Gather(sim::ToView(inputs[2]));
+        }
+        std::vector<float> output(m * n);
+        sim::Matmul(input.data(), weight.data(), hasBias ? biasValues.data() : nullptr, output.data(), m, k, n, false);
+        if (hasGelu) {
+            for (auto &value : output) {
+                value = sim::Gelu(value, approximate);
+            }
+        }
+        sim::Scatter(sim::ToView(outputs[0]), output);
+    };
+    // 下标2、3为可选输入
+    constexpr uint64_t OPTIONAL_MASK = (1 << 2) | (1 << 3);
+    return sim::CreateExecutor({const_cast<aclTensor *>(x), const_cast<aclTensor *>(x2), const_cast<aclTensor *>(bias),
+                                   const_cast<aclTensor *>(x3)},
+        {const_cast<aclTensor *>(y)}, kernel, workspaceSize, executor, OPTIONAL_MASK);
+}
+
+aclnnStatus aclnnFusedMatmul(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+aclnnStatus aclnnAddGetWorkspaceSize(const aclTensor *self, const aclTensor *other, const aclScalar *alpha,
+                                     aclTensor *out, uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    if (self == nullptr || other == nullptr || alpha == nullptr || out == nullptr ||
+        self->viewDims != out->viewDims || !IsTrailingBroadcast(self, other)) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    // alpha在创建executor时取值，之后可以销毁
+    float alphaValue = static_cast<float>(alpha->value);
+    auto kernel = [alphaValue](const std::vector<aclTensor> &inputs, const std::vector<aclTensor> &outputs) {
+        std::vector<float> values = sim::Gather(sim::ToView(inputs[0]));
+        std::vector<float> others = sim::Gather(sim::ToView(inputs[1]));
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] += alphaValue * others[i % others.size()];
+        }
+        sim::Scatter(sim::ToView(outputs[0]), values);
+    };
+    return sim::CreateExecutor(
+        {const_cast<aclTensor *>(self), const_cast<aclTensor *>(other)}, {out}, kernel, workspaceSize, executor);
+}
+
+aclnnStatus aclnnAdd(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+aclnnStatus aclnnMulGetWorkspaceSize(const aclTensor *self, const aclTensor *other, aclTensor *out,
+                                     uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    if (self == nullptr || other == nullptr || out == nullptr || self->viewDims != out->viewDims ||
+        !IsTrailingBroadcast(self, other)) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    auto kernel = [](const std::vector<aclTensor> &inputs, const std::vector<aclTensor> &outputs) {
+        std::vector<float> values = sim::Gather(sim::ToView(inputs[0]));
+        std::vector<float> others = sim::Gather(sim::ToView(inputs[1]));
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] *= others[i % others.size()];
+        }
+        sim::Scatter(sim::ToView(outputs[0]), values);
+    };
+    return sim::CreateExecutor(
+        {const_cast<aclTensor *>(self), const_cast<aclTensor *>(other)}, {out}, kernel, workspaceSize, executor);
+}
+
+aclnnStatus aclnnMul(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
+
+aclnnStatus aclnnBatchMatMulGetWorkspaceSize(const aclTensor *self, const aclTensor *mat2, aclTensor *out,
+                                             int8_t cubeMathType, uint64_t *workspaceSize, aclOpExecutor **executor)
+{
+    (void)cubeMathType;
+    if (self == nullptr || mat2 == nullptr || out == nullptr || self->viewDims.size() < 2 ||
+        self->viewDims.size() != mat2->viewDims.size() || self->viewDims.size() != out->viewDims.size()) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    size_t rank = self->viewDims.size();
+    int64_t m = self->viewDims[rank - 2];
+    int64_t k = self->viewDims[rank - 1];
+    int64_t n = mat2->viewDims[rank - 1];
+    if (mat2->viewDims[rank - 2] != k || out->viewDims[rank - 2] != m || out->viewDims[rank - 1] != n ||
+        !std::equal(self->viewDims.begin(), self->viewDims.end() - 2, mat2->viewDims.begin()) ||
+        !std::equal(self->viewDims.begin(), self->viewDims.end() - 2, out->viewDims.begin())) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    auto kernel = [m, k, n](const std::vector<aclTensor> &inputs, const std::vector<aclTensor> &outputs) {
+        // Gather按view的stride读取，输入为切片或转置时也不需要先拷贝成连续内存
+        std::vector<float> lhs = sim::Gather(sim::ToView(inputs[0]));
+        std::vector<float> rhs = sim::Gather(sim::ToView(inputs[1]));
+        int64_t batch = static_cast<int64_t>(lhs.size()) / (m * k);
+        std::vector<float> output(batch * m * n);
+        for (int64_t b = 0; b < batch; b++) {
+            sim::Matmul(lhs.data() + b * m * k, rhs.data() + b * k * n, nullptr, output.data() + b * m * n, m, k, n,
+                        false);
+        }
+        sim::Scatter(sim::ToView(outputs[0]), output);
+    };
+    return sim::CreateExecutor(
+        {const_cast<aclTensor *>(self), const_cast<aclTensor *>(mat2)}, {out}, kernel, workspaceSize, executor);
+}
+
+aclnnStatus aclnnBatchMatMul(void *workspace, uint64_t workspaceSize, aclOpExecutor *executor, aclrtStream stream)
+{
+    (void)workspace;
+    (void)workspaceSize;
+    return sim::LaunchExecutor(executor, stream);
+}
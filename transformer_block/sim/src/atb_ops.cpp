@@ -0,0 +1,570 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "atb/atb_infer.h"
+#include "sim_kernels.h"
+#include "sim_runtime.h"
+
+namespace atb {
+Status Context::SetExecuteStream(aclrtStream stream)
+{
+    executeStream_ = stream;
+    return NO_ERROR;
+}
+
+aclrtStream Context::GetExecuteStream() const
+{
+    return executeStream_;
+}
+
+Status CreateContext(Context **context)
+{
+    if (context == nullptr) {
+        return ERROR_INVALID_PARAM;
+    }
+    *context = new Context();
+    return NO_ERROR;
+}
+
+Status DestroyContext(Context *context)
+{
+    delete context;
+    return NO_ERROR;
+}
+
+Status DestroyOperation(Operation *operation)
+{
+    delete operation;
+    return NO_ERROR;
+}
+
+uint64_t Utils::GetTensorNumel(const TensorDesc &tensorDesc)
+{
+    if (tensorDesc.shape.dimNum == 0) {
+        return 0;
+    }
+    uint64_t numel = 1;
+    for (uint64_t i = 0; i < tensorDesc.shape.dimNum; ++i) {
+        numel *= static_cast<uint64_t>(tensorDesc.shape.dims[i]);
+    }
+    return numel;
+}
+
+uint64_t Utils::GetTensorNumel(const Tensor &tensor)
+{
+    return GetTensorNumel(tensor.desc);
+}
+
+uint64_t Utils::GetTensorSize(const TensorDesc &tensorDesc)
+{
+    return GetTensorNumel(tensorDesc) * sim::DtypeSize(tensorDesc.dtype);
+}
+
+uint64_t Utils::GetTensorSize(const Tensor &tensor)
+{
+    return GetTensorSize(tensor.desc);
+}
+} // namespace atb
+
+namespace {
+using atb::SVector;
+using atb::Status;
+using atb::Tensor;
+using atb::TensorDesc;
+using atb::VariantPack;
+
+constexpr uint64_t WORKSPACE_ALIGN = 512;
+
+std::vector<int64_t> ShapeOf(const TensorDesc &desc)
+{
+    return std::vector<int64_t>(desc.shape.dims, desc.shape.dims + desc.shape.dimNum);
+}
+
+sim::StridedView ContiguousView(const Tensor &tensor)
+{
+    sim::StridedView view;
+    view.data = tensor.deviceData;
+    view.dtype = tensor.desc.dtype;
+    view.shape = ShapeOf(tensor.desc);
+    view.strides = sim::ContiguousStrides(view.shape);
+    return view;
+}
+
+std::vector<float> Read(const Tensor &tensor)
+{
+    return sim::Gather(ContiguousView(tensor));
+}
+
+void Write(const Tensor &tensor, const std::vector<float> &values)
+{
+    sim::Scatter(ContiguousView(tensor), values);
+}
+
+// 仿真单算子：InferShape与kernel均由具体参数决定，kernel在context的stream上异步执行
+class SimOperation : public atb::Operation {
+public:
+    using InferFunc = std::function<Status(const SVector<TensorDesc> &, SVector<TensorDesc> &)>;
+    using KernelFunc = std::function<void(const VariantPack &)>;
+
+    SimOperation(std::string name, uint32_t inputNum, uint32_t outputNum, InferFunc infer, KernelFunc kernel)
+        : name_(std::move(name)), inputNum_(inputNum), outputNum_(outputNum), infer_(std::move(infer)),
+          kernel_(std::move(kernel))
+    {
+    }
+
+    std::string GetName() const override { return name_; }
+    uint32_t GetInputNum() const override { return inputNum_; }
+    uint32_t GetOutputNum() const override { return outputNum_; }
+
+    Status InferShape(const SVector<TensorDesc> &inTensorDescs, SVector<TensorDesc> &outTensorDescs) const override
+    {
+        if (inTensorDescs.size() != inputNum_) {
+            return atb::ERROR_INVALID_IN_TENSOR_NUM;
+        }
+        outTensorDescs.resize(outputNum_);
+        return infer_(inTensorDescs, outTensorDescs);
+    }
+
+    Status Setup(const VariantPack &variantPack, uint64_t &workspaceSize, atb::Context *context) override
+    {
+        (void)context;
+        if (variantPack.inTensors.size() != inputNum_ || variantPack.outTensors.size() != outputNum_) {
+            return atb::ERROR_INVALID_IN_TENSOR_NUM;
+        }
+        sim::HostSetupDelay();
+        workspaceSize = 0;
+        return atb::NO_ERROR;
+    }
+
+    Status Execute(const VariantPack &variantPack, uint8_t *workspace, uint64_t workspaceSize,
+                   atb::Context *context) override
+    {
+        (void)workspace;
+        (void)workspaceSize;
+        if (context == nullptr) {
+            return atb::ERROR_INVALID_PARAM;
+        }
+        for (const auto &tensor : variantPack.inTensors) {
+            if (tensor.deviceData == nullptr) {
+                return atb::ERROR_INVALID_PARAM;
+            }
+        }
+        sim::HostLaunchDelay();
+        sim::Launch(context->GetExecuteStream(), [kernel = kernel_, variantPack] { kernel(variantPack); });
+        return atb::NO_ERROR;
+    }
+
+private:
+    std::string name_;
+    uint32_t inputNum_ = 0;
+    uint32_t outputNum_ = 0;
+    InferFunc infer_;
+    KernelFunc kernel_;
+};
+
+// 按numpy规则把右对齐的输入广播到输出shape
+std::vector<float> BroadcastTo(const Tensor &tensor, const std::vector<int64_t> &outShape)
+{
+    std::vector<float> values = Read(tensor);
+    std::vector<int64_t> shape = ShapeOf(tensor.desc);
+    if (shape == outShape) {
+        return values;
+    }
+    std::vector<int64_t> aligned(outShape.size(), 1);
+    std::copy(shape.begin(), shape.end(), aligned.end() - shape.size());
+    std::vector<int64_t> strides = sim::ContiguousStrides(aligned);
+    int64_t numel = 1;
+    for (auto dim : outShape) {
+        numel *= dim;
+    }
+    std::vector<float> result(numel);
+    for (int64_t i = 0; i < numel; ++i) {
+        int64_t remain = i;
+        int64_t srcIndex = 0;
+        for (int64_t d = static_cast<int64_t>(outShape.size()) - 1; d >= 0; --d) {
+            int64_t coord = remain % outShape[d];
+            remain /= outShape[d];
+            srcIndex += (aligned[d] == 1 ? 0 : coord) * strides[d];
+        }
+        result[i] = values[srcIndex];
+    }
+    return result;
+}
+
+Status BroadcastInfer(const SVector<TensorDesc> &inTensorDescs, SVector<TensorDesc> &outTensorDescs)
+{
+    const TensorDesc &a = inTensorDescs.at(0);
+    const TensorDesc &b = inTensorDescs.at(1);
+    const TensorDesc &longer = a.shape.dimNum >= b.shape.dimNum ? a : b;
+    const TensorDesc &shorter = a.shape.dimNum >= b.shape.dimNum ? b : a;
+    TensorDesc out = longer;
+    out.dtype = a.dtype;
+    uint64_t shift = longer.shape.dimNum - shorter.shape.dimNum;
+    for (uint64_t i = 0; i < shorter.shape.dimNum; ++i) {
+        int64_t lhs = longer.shape.dims[i + shift];
+        int64_t rhs = shorter.shape.dims[i];
+        if (lhs != rhs && lhs != 1 && rhs != 1) {
+            return atb::ERROR_INVALID_TENSOR_DIM;
+        }
+        out.shape.dims[i + shift] = std::max(lhs, rhs);
+    }
+    outTensorDescs.at(0) = out;
+    return atb::NO_ERROR;
+}
+
+Status SameAsFirstInfer(const SVector<TensorDesc> &inTensorDescs, SVector<TensorDesc> &outTensorDescs)
+{
+    outTensorDescs.at(0) = inTensorDescs.at(0);
+    return atb::NO_ERROR;
+}
+
+atb::Operation *CreateBinaryOp(const std::string &name, std::function<float(float, float)> func)
+{
+    return new SimOperation(name, 2, 1, BroadcastInfer, [func](const VariantPack &pack) {
+        const Tensor &out = pack.outTensors.at(0);
+        std::vector<int64_t> outShape = ShapeOf(out.desc);
+        std::vector<float> lhs = BroadcastTo(pack.inTensors.at(0), outShape);
+        std::vector<float> rhs = BroadcastTo(pack.inTensors.at(1), outShape);
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            lhs[i] = func(lhs[i], rhs[i]);
+        }
+        Write(out, lhs);
+    });
+}
+
+atb::Operation *CreateUnaryOp(const std::string &name, aclDataType outType, std::function<float(float)> func)
+{
+    auto infer = [outType](const SVector<TensorDesc> &inTensorDescs, SVector<TensorDesc> &outTensorDescs) {
+        outTensorDescs.at(0) = inTensorDescs.at(0);
+        if (outType != ACL_DT_UNDEFINED) {
+            outTensorDescs.at(0).dtype = outType;
+        }
+        return atb::NO_ERROR;
+    };
+    return new SimOperation(name, 1, 1, infer, [func](const VariantPack &pack) {
+        std::vector<float> values = Read(pack.inTensors.at(0));
+        for (auto &value : values) {
+            value = func(value);
+        }
+        Write(pack.outTensors.at(0), values);
+    });
+}
+
+// 图算子：按节点顺序推导中间tensor，中间tensor从workspace中切分
+class SimGraphOperation : public atb::Operation {
+public:
+    explicit SimGraphOperation(const atb::GraphParam &param) : param_(param) {}
+
+    ~SimGraphOperation() override
+    {
+        for (auto &node : param_.nodes) {
+            delete node.operation;
+        }
+    }
+
+    std::string GetName() const override { return param_.name.empty() ? "GraphOperation" : param_.name; }
+    uint32_t GetInputNum() const override { return param_.inTensorNum; }
+    uint32_t GetOutputNum() const override { return param_.outTensorNum; }
+
+    Status InferShape(const SVector<TensorDesc> &inTensorDescs, SVector<TensorDesc> &outTensorDescs) const override
+    {
+        outTensorDescs.resize(param_.outTensorNum);
+        if (param_.inferShapeFunc) {
+            return param_.inferShapeFunc(inTensorDescs, outTensorDescs);
+        }
+        std::vector<TensorDesc> allDescs;
+        Status status = InferAll(inTensorDescs, allDescs);
+        if (status != atb::NO_ERROR) {
+            return status;
+        }
+        for (uint32_t i = 0; i < param_.outTensorNum; ++i) {
+            outTensorDescs.at(i) = allDescs.at(param_.inTensorNum + i);
+        }
+        return atb::NO_ERROR;
+    }
+
+    Status Setup(const VariantPack &variantPack, uint64_t &workspaceSize, atb::Context *context) override
+    {
+        (void)context;
+        SVector<TensorDesc> inTensorDescs;
+        for (const auto &tensor : variantPack.inTensors) {
+            inTensorDescs.push_back(tensor.desc);
+        }
+        Status status = InferAll(inTensorDescs, allDescs_);
+        if (status != atb::NO_ERROR) {
+            return status;
+        }
+        internalOffsets_.clear();
+        uint64_t offset = 0;
+        uint32_t internalBegin = param_.inTensorNum + param_.outTensorNum;
+        for (uint32_t i = internalBegin; i < allDescs_.size(); ++i) {
+            internalOffsets_.push_back(offset);
+            uint64_t size = atb::Utils::GetTensorSize(allDescs_.at(i));
+            offset += (size + WORKSPACE_ALIGN - 1) / WORKSPACE_ALIGN * WORKSPACE_ALIGN;
+        }
+        workspaceSize = offset;
+        for (size_t i = 0; i < param_.nodes.size(); ++i) {
+            sim::HostSetupDelay();
+        }
+        return atb::NO_ERROR;
+    }
+
+    Status Execute(const VariantPack &variantPack, uint8_t *workspace, uint64_t workspaceSize,
+                   atb::Context *context) override
+    {
+        (void)workspaceSize;
+        std::vector<Tensor> allTensors(allDescs_.size());
+        for (uint32_t i = 0; i < param_.inTensorNum; ++i) {
+            allTensors.at(i) = variantPack.inTensors.at(i);
+        }
+        for (uint32_t i = 0; i < param_.outTensorNum; ++i) {
+            allTensors.at(param_.inTensorNum + i) = variantPack.outTensors.at(i);
+        }
+        uint32_t internalBegin = param_.inTensorNum + param_.outTensorNum;
+        for (uint32_t i = internalBegin; i < allDescs_.size(); ++i) {
+            Tensor &tensor = allTensors.at(i);
+            tensor.desc = allDescs_.at(i);
+            tensor.dataSize = atb::Utils::GetTensorSize(tensor.desc);
+            tensor.deviceData = workspace + internalOffsets_.at(i - internalBegin);
+        }
+        for (auto &node : param_.nodes) {
+            VariantPack nodePack;
+            for (auto id : node.inTensorIds) {
+                nodePack.inTensors.push_back(allTensors.at(id));
+            }
+            for (auto id : node.outTensorIds) {
+                nodePack.outTensors.push_back(allTensors.at(id));
+            }
+            uint64_t nodeWorkspaceSize = 0;
+            Status status = atb::NO_ERROR;
+            {
+                sim::ScopedSetupDelaySuppress suppress;
+                status = node.operation->Setup(nodePack, nodeWorkspaceSize, context);
+            }
+            if (status != atb::NO_ERROR) {
+                return status;
+            }
+            status = node.operation->Execute(nodePack, nullptr, 0, context);
+            if (status != atb::NO_ERROR) {
+                return status;
+            }
+        }
+        return atb::NO_ERROR;
+    }
+
+private:
+    Status InferAll(const SVector<TensorDesc> &inTensorDescs, std::vector<TensorDesc> &allDescs) const
+    {
+        if (inTensorDescs.size() != param_.inTensorNum) {
+            return atb::ERROR_INVALID_IN_TENSOR_NUM;
+        }
+        allDescs.assign(param_.inTensorNum + param_.outTensorNum + param_.internalTensorNum, TensorDesc());
+        std::copy(inTensorDescs.begin(), inTensorDescs.end(), allDescs.begin());
+        for (const auto &node : param_.nodes) {
+            if (node.operation == nullptr) {
+                return atb::ERROR_INVALID_GRAPH;
+            }
+            SVector<TensorDesc> nodeIn;
+            SVector<TensorDesc> nodeOut(node.outTensorIds.size());
+            for (auto id : node.inTensorIds) {
+                nodeIn.push_back(allDescs.at(id));
+            }
+            Status status = node.operation->InferShape(nodeIn, nodeOut);
+            if (status != atb::NO_ERROR) {
+                return atb::ERROR_GRAPH_INFERSHAPE_FUNC_FAIL;
+            }
+            for (size_t i = 0; i < node.outTensorIds.size(); ++i) {
+                allDescs.at(node.outTensorIds.at(i)) = nodeOut.at(i);
+            }
+        }
+        return atb::NO_ERROR;
+    }
+
+    atb::GraphParam param_;
+    std::vector<TensorDesc> allDescs_;
+    std::vector<uint64_t> internalOffsets_;
+};
+} // namespace
+
+namespace atb {
+template <> Status CreateOperation(const infer::ElewiseParam &opParam, Operation **operation)
+{
+    using ElewiseType = infer::ElewiseParam::ElewiseType;
+    if (operation == nullptr) {
+        return ERROR_INVALID_PARAM;
+    }
+    switch (opParam.elewiseType) {
+        case ElewiseType::ELEWISE_ADD:
+            *operation = CreateBinaryOp("ElewiseAdd", [](float a, float b) { return a + b; });
+            return NO_ERROR;
+        case ElewiseType::ELEWISE_SUB:
+            *operation = CreateBinaryOp("ElewiseSub", [](float a, float b) { return a - b; });
+            return NO_ERROR;
+        case ElewiseType::ELEWISE_MUL:
+            *operation = CreateBinaryOp("ElewiseMul", [](float a, float b) { return a * b; });
+            return NO_ERROR;
+        case ElewiseType::ELEWISE_REALDIV:
+            *operation = CreateBinaryOp("ElewiseRealDiv", [](float a, float b) { return a / b; });
+            return NO_ERROR;
+        case ElewiseType::ELEWISE_MULS: {
+            float factor = opParam.mulsParam.varAttr;
+            *operation = CreateUnaryOp("ElewiseMuls", ACL_DT_UNDEFINED, [factor](float a) { return a * factor; });
+            return NO_ERROR;
+        }
+        case ElewiseType::ELEWISE_NEG:
+            *operation = CreateUnaryOp("ElewiseNeg", ACL_DT_UNDEFINED, [](float a) { return -a; });
+            return NO_ERROR;
+        case ElewiseType::ELEWISE_TANH:
+            *operation = CreateUnaryOp("ElewiseTanh", ACL_DT_UNDEFINED, [](float a) { return std::tanh(a); });
+            return NO_ERROR;
+        case ElewiseType::ELEWISE_CAST:
+            *operation = CreateUnaryOp("ElewiseCast", opParam.outTensorType, [](float a) { return a; });
+            return NO_ERROR;
+        case ElewiseType::ELEWISE_QUANT_PER_CHANNEL: {
+            // 输入x、scale、offset，y = round(x / scale + offset)，scale/offset按最后一维广播
+            auto infer = [](const SVector<TensorDesc> &inTensorDescs, SVector<TensorDesc> &outTensorDescs) {
+                outTensorDescs.at(0) = inTensorDescs.at(0);
+                outTensorDescs.at(0).dtype = ACL_INT8;
+                return NO_ERROR;
+            };
+            *operation = new SimOperation("ElewiseQuantPerChannel", 3, 1, infer, [](const VariantPack &pack) {
+                const Tensor &out = pack.outTensors.at(0);
+                std::vector<int64_t> outShape = ShapeOf(out.desc);
+                std::vector<float> values = Read(pack.inTensors.at(0));
+                std::vector<float> scale = BroadcastTo(pack.inTensors.at(1), outShape);
+                std::vector<float> offset = BroadcastTo(pack.inTensors.at(2), outShape);
+                for (size_t i = 0; i < values.size(); ++i) {
+                    values[i] = values[i] / scale[i] + offset[i];
+                }
+                Write(out, values);
+            });
+            return NO_ERROR;
+        }
+        default:
+            return ERROR_INVALID_PARAM;
+    }
+}
+
+template <> Status CreateOperation(const infer::LayerNormParam &opParam, Operation **operation)
+{
+    if (operation == nullptr || opParam.layerType != infer::LayerNormParam::LAYER_NORM_NORM) {
+        return ERROR_INVALID_PARAM;
+    }
+    infer::LayerNormParam::NormParam normParam = opParam.normParam;
+    *operation = new SimOperation("LayerNorm", 3, 1, SameAsFirstInfer, [normParam](const VariantPack &pack) {
+        const Tensor &x = pack.inTensors.at(0);
+        int64_t axis = normParam.beginNormAxis;
+        if (axis < 0) {
+            axis += static_cast<int64_t>(x.desc.shape.dimNum);
+        }
+        int64_t rows = 1;
+        int64_t cols = 1;
+        for (int64_t i = 0; i < static_cast<int64_t>(x.desc.shape.dimNum); ++i) {
+            (i < axis ? rows : cols) *= x.desc.shape.dims[i];
+        }
+        std::vector<float> input = Read(x);
+        std::vector<float> gamma = Read(pack.inTensors.at(1));
+        std::vector<float> beta = Read(pack.inTensors.at(2));
+        std::vector<float> output(input.size());
+        sim::LayerNorm(input.data(), gamma.data(), beta.data(), output.data(), rows, cols, normParam.epsilon);
+        Write(pack.outTensors.at(0), output);
+    });
+    return NO_ERROR;
+}
+
+// Linear权重的逻辑[rows, cols]，FRACTAL_NZ权重为[1, cols/16, rows, 16]
+static bool GetLinearWeightDims(const TensorDesc &weight, int64_t &rows, int64_t &cols)
+{
+    if (weight.format == ACL_FORMAT_FRACTAL_NZ) {
+        if (weight.shape.dimNum != 4 || weight.shape.dims[0] != 1) {
+            return false;
+        }
+        rows = weight.shape.dims[2];
+        cols = weight.shape.dims[1] * weight.shape.dims[3];
+        return true;
+    }
+    if (weight.shape.dimNum != 2) {
+        return false;
+    }
+    rows = weight.shape.dims[0];
+    cols = weight.shape.dims[1];
+    return true;
+}
+
+template <> Status CreateOperation(const infer::LinearParam &opParam, Operation **operation)
+{
+    if (operation == nullptr || opParam.transposeA || opParam.quantMode == infer::LinearParam::PER_TOKEN) {
+        return ERROR_INVALID_PARAM;
+    }
+    // per-channel量化时输入为x(int8)、weight(int8)、bias(int32)、deqScale(float)，输出按outDataType
+    bool perChannel = opParam.quantMode == infer::LinearParam::PER_CHANNEL;
+    if (perChannel && opParam.outDataType == ACL_DT_UNDEFINED) {
+        return ERROR_INVALID_PARAM;
+    }
+    infer::LinearParam param = opParam;
+    auto infer = [param](const SVector<TensorDesc> &inTensorDescs, SVector<TensorDesc> &outTensorDescs) {
+        const TensorDesc &x = inTensorDescs.at(0);
+        const TensorDesc &weight = inTensorDescs.at(1);
+        int64_t rows = 0;
+        int64_t cols = 0;
+        if (x.shape.dimNum < 2 || !GetLinearWeightDims(weight, rows, cols)) {
+            return ERROR_INVALID_TENSOR_DIM;
+        }
+        int64_t k = x.shape.dims[x.shape.dimNum - 1];
+        if (k != (param.transposeB ? cols : rows)) {
+            return ERROR_INVALID_TENSOR_DIM;
+        }
+        TensorDesc out = x;
+        out.shape.dims[x.shape.dimNum - 1] = param.transposeB ? rows : cols;
+        if (param.outDataType != ACL_DT_UNDEFINED) {
+            out.dtype = param.outDataType;
+        }
+        outTensorDescs.at(0) = out;
+        return NO_ERROR;
+    };
+    uint32_t inputNum = (param.hasBias ? 3 : 2) + (perChannel ? 1 : 0);
+    *operation = new SimOperation(
+        "Linear", inputNum, 1, infer, [param, perChannel](const VariantPack &pack) {
+            const Tensor &x = pack.inTensors.at(0);
+            const Tensor &weight = pack.inTensors.at(1);
+            int64_t k = x.desc.shape.dims[x.desc.shape.dimNum - 1];
+            int64_t m = static_cast<int64_t>(Utils::GetTensorNumel(x)) / k;
+            int64_t rows = 0;
+            int64_t cols = 0;
+            GetLinearWeightDims(weight.desc, rows, cols);
+            int64_t n = param.transposeB ? rows : cols;
+            std::vector<float> input = Read(x);
+            std::vector<float> weightValues = Read(weight);
+            if (weight.desc.format == ACL_FORMAT_FRACTAL_NZ) {
+                std::vector<float> ndWeight(weightValues.size());
+                sim::NzToNd(weightValues.data(), ndWeight.data(), rows, cols);
+                weightValues.swap(ndWeight);
+            }
+            std::vector<float> bias;
+            if (param.hasBias) {
+                bias = Read(pack.inTensors.at(2));
+            }
+            std::vector<float> output(m * n);
+            sim::Matmul(input.data(), weightValues.data(), param.hasBias ? bias.data() : nullptr, output.data(), m, k,
+                        n, param.transposeB);
+            if (perChannel) {
+                // int32累加结果按输出通道反量化
+                std::vector<float> deqScale = Read(pack.inTensors.at(param.hasBias ? 3 : 2));
+                for (int64_t i = 0; i < m * n; ++i) {
+                    output[i] *= deqScale[deqScale.size() == 1 ? 0 : i % n];
+                }
+            }
+            Write(pack.outTensors.at(0), output);
+        });
+    return NO_ERROR;
+}
+
+template <> Status CreateOperation(const GraphParam &opParam, Operation **operation)
+{
+    if (operation == nullptr || opParam.nodes.empty()) {
+        return ERROR_INVALID_PARAM;
+    }
+    *operation = new SimGraphOperation(opParam);
+    return NO_ERROR;
+}
+} // namespace atb
@@ -0,0 +1,50 @@
+#ifndef SIM_ACLNN_H
+#define SIM_ACLNN_H
+
+#include <functional>
+#include <vector>
+#include "aclnn/acl_meta.h"
+#include "sim_kernels.h"
+
+struct aclTensor {
+    std::vector<int64_t> viewDims;
+    std::vector<int64_t> strides;
+    int64_t offset = 0;
+    aclDataType dtype = ACL_DT_UNDEFINED;
+    aclFormat format = ACL_FORMAT_ND;
+    std::vector<int64_t> storageDims;
+    void *data = nullptr;
+};
+
+struct aclScalar {
+    double value = 0.0;
+    aclDataType dtype = ACL_DT_UNDEFINED;
+};
+
+struct aclIntArray {
+    std::vector<int64_t> values;
+};
+
+// 下发时对参与计算的tensor做快照，kernel在stream线程上只访问快照
+using SimAclnnKernel = std::function<void(const std::vector<aclTensor> &inputs, const std::vector<aclTensor> &outputs)>;
+
+struct aclOpExecutor {
+    std::vector<aclTensor *> inputs;
+    std::vector<aclTensor *> outputs;
+    SimAclnnKernel kernel;
+    bool repeatable = false;
+};
+
+namespace sim {
+sim::StridedView ToView(const aclTensor &tensor);
+
+// 创建executor，workspace统一为0
+// optionalMask中第i位为1表示第i个输入可以为空，为空的输入在快照中data为nullptr
+aclnnStatus CreateExecutor(std::vector<aclTensor *> inputs, std::vector<aclTensor *> outputs, SimAclnnKernel kernel,
+                           uint64_t *workspaceSize, aclOpExecutor **executor, uint64_t optionalMask = 0);
+
+// 将executor提交到stream，非repeatable的executor下发后即释放
+aclnnStatus LaunchExecutor(aclOpExecutor *executor, aclrtStream stream);
+} // namespace sim
+
+#endif
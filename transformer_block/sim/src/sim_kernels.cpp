@@ -0,0 +1,382 @@
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include "sim_kernels.h"
+
+namespace sim {
+size_t DtypeSize(aclDataType dtype)
+{
+    switch (dtype) {
+        case ACL_INT8:
+        case ACL_UINT8:
+        case ACL_BOOL:
+            return 1;
+        case ACL_FLOAT16:
+        case ACL_BF16:
+        case ACL_INT16:
+        case ACL_UINT16:
+            return 2;
+        case ACL_FLOAT:
+        case ACL_INT32:
+        case ACL_UINT32:
+            return 4;
+        case ACL_INT64:
+        case ACL_UINT64:
+        case ACL_DOUBLE:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+float HalfToFloat(uint16_t value)
+{
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    uint32_t exponent = (value >> 10) & 0x1f;
+    uint32_t mantissa = value & 0x3ff;
+    uint32_t bits = 0;
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // 非规格化数，规格化后再组装
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400) == 0) {
+                mantissa <<= 1;
+                exponent--;
+            }
+            mantissa &= 0x3ff;
+            bits = sign | (exponent << 23) | (mantissa << 13);
+        }
+    } else if (exponent == 0x1f) {
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    uint32_t absBits = bits & 0x7fffffff;
+    if (absBits >= 0x7f800000) {
+        // inf / nan
+        return sign | 0x7c00 | (absBits > 0x7f800000 ? 0x200 : 0);
+    }
+    if (absBits >= 0x477ff000) {
+        // 超出fp16表示范围
+        return sign | 0x7c00;
+    }
+    if (absBits < 0x38800000) {
+        // 非规格化数或0，按最近偶数舍入
+        if (absBits < 0x33000000) {
+            return sign;
+        }
+        uint32_t exponent = absBits >> 23;
+        uint32_t mantissa = (absBits & 0x7fffff) | 0x800000;
+        uint32_t shift = 126 - exponent;
+        uint32_t halfMantissa = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (halfMantissa & 1))) {
+            halfMantissa++;
+        }
+        return sign | static_cast<uint16_t>(halfMantissa);
+    }
+    uint32_t rounded = absBits + 0xfff + ((absBits >> 13) & 1);
+    return sign | static_cast<uint16_t>((rounded - 0x38000000) >> 13);
+}
+
+float Bf16ToFloat(uint16_t value)
+{
+    uint32_t bits = static_cast<uint32_t>(value) << 16;
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+uint16_t FloatToBf16(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if ((bits & 0x7fffffff) > 0x7f800000) {
+        return static_cast<uint16_t>((bits >> 16) | 0x40);
+    }
+    bits += 0x7fff + ((bits >> 16) & 1);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+float LoadElement(const void *data, aclDataType dtype, int64_t index)
+{
+    switch (dtype) {
+        case ACL_FLOAT16:
+            return HalfToFloat(static_cast<const uint16_t *>(data)[index]);
+        case ACL_BF16:
+            return Bf16ToFloat(static_cast<const uint16_t *>(data)[index]);
+        case ACL_FLOAT:
+            return static_cast<const float *>(data)[index];
+        case ACL_INT8:
+            return static_cast<const int8_t *>(data)[index];
+        case ACL_UINT8:
+        case ACL_BOOL:
+            return static_cast<const uint8_t *>(data)[index];
+        case ACL_INT32:
+            return static_cast<float>(static_cast<const int32_t *>(data)[index]);
+        case ACL_INT64:
+            return static_cast<float>(static_cast<const int64_t *>(data)[index]);
+        default:
+            return 0.0f;
+    }
+}
+
+void StoreElement(void *data, aclDataType dtype, int64_t index, float value)
+{
+    switch (dtype) {
+        case ACL_FLOAT16:
+            static_cast<uint16_t *>(data)[index] = FloatToHalf(value);
+            break;
+        case ACL_BF16:
+            static_cast<uint16_t *>(data)[index] = FloatToBf16(value);
+            break;
+        case ACL_FLOAT:
+            static_cast<float *>(data)[index] = value;
+            break;
+        case ACL_INT8:
+            static_cast<int8_t *>(data)[index] =
+                static_cast<int8_t>(std::fmax(-128.0f, std::fmin(127.0f, std::nearbyint(value))));
+            break;
+        case ACL_UINT8:
+        case ACL_BOOL:
+            static_cast<uint8_t *>(data)[index] = static_cast<uint8_t>(value);
+            break;
+        case ACL_INT32:
+            static_cast<int32_t *>(data)[index] = static_cast<int32_t>(value);
+            break;
+        case ACL_INT64:
+            static_cast<int64_t *>(data)[index] = static_cast<int64_t>(value);
+            break;
+        default:
+            break;
+    }
+}
+
+int64_t StridedView::Numel() const
+{
+    int64_t numel = 1;
+    for (auto dim : shape) {
+        numel *= dim;
+    }
+    return numel;
+}
+
+bool StridedView::IsContiguous() const
+{
+    return strides == ContiguousStrides(shape);
+}
+
+int64_t StridedView::StorageIndex(int64_t linearIndex) const
+{
+    int64_t storageIndex = offset;
+    for (int64_t i = static_cast<int64_t>(shape.size()) - 1; i >= 0; --i) {
+        storageIndex += (linearIndex % shape[i]) * strides[i];
+        linearIndex /= shape[i];
+    }
+    return storageIndex;
+}
+
+std::vector<int64_t> ContiguousStrides(const std::vector<int64_t> &shape)
+{
+    std::vector<int64_t> strides(shape.size(), 1);
+    for (int64_t i = static_cast<int64_t>(shape.size()) - 2; i >= 0; --i) {
+        strides[i] = strides[i + 1] * shape[i + 1];
+    }
+    return strides;
+}
+
+std::vector<float> Gather(const StridedView &view)
+{
+    int64_t numel = view.Numel();
+    std::vector<float> values(numel);
+    if (view.IsContiguous()) {
+        for (int64_t i = 0; i < numel; ++i) {
+            values[i] = LoadElement(view.data, view.dtype, view.offset + i);
+        }
+        return values;
+    }
+    for (int64_t i = 0; i < numel; ++i) {
+        values[i] = LoadElement(view.data, view.dtype, view.StorageIndex(i));
+    }
+    return values;
+}
+
+void Scatter(const StridedView &view, const std::vector<float> &values)
+{
+    int64_t numel = view.Numel();
+    if (view.IsContiguous()) {
+        for (int64_t i = 0; i < numel; ++i) {
+            StoreElement(view.data, view.dtype, view.offset + i, values[i]);
+        }
+        return;
+    }
+    for (int64_t i = 0; i < numel; ++i) {
+        StoreElement(view.data, view.dtype, view.StorageIndex(i), values[i]);
+    }
+}
+
+float Gelu(float x, int64_t approximate)
+{
+    if (approximate == 1) {
+        const float kBeta = 0.7978845608028654f; // sqrt(2/pi)
+        const float kKappa = 0.044715f;
+        return 0.5f * x * (1.0f + std::tanh(kBeta * (x + kKappa * x * x * x)));
+    }
+    return 0.5f * x * (1.0f + std::erf(x * 0.7071067811865476f));
+}
+
+void LayerNorm(const float *x, const float *gamma, const float *beta, float *out, int64_t rows, int64_t cols,
+               float epsilon, float *meanOut, float *rstdOut)
+{
+    for (int64_t r = 0; r < rows; ++r) {
+        const float *row = x + r * cols;
+        double mean = 0.0;
+        for (int64_t c = 0; c < cols; ++c) {
+            mean += row[c];
+        }
+        mean /= cols;
+        double var = 0.0;
+        for (int64_t c = 0; c < cols; ++c) {
+            double diff = row[c] - mean;
+            var += diff * diff;
+        }
+        var /= cols;
+        float rstd = static_cast<float>(1.0 / std::sqrt(var + epsilon));
+        for (int64_t c = 0; c < cols; ++c) {
+            out[r * cols + c] = (row[c] - static_cast<float>(mean)) * rstd * gamma[c] + beta[c];
+        }
+        if (meanOut != nullptr) {
+            meanOut[r] = static_cast<float>(mean);
+        }
+        if (rstdOut != nullptr) {
+            rstdOut[r] = rstd;
+        }
+    }
+}
+
+void Softmax(const float *x, float *out, int64_t outer, int64_t axis, int64_t inner)
+{
+    for (int64_t o = 0; o < outer; ++o) {
+        for (int64_t i = 0; i < inner; ++i) {
+            const float *in = x + o * axis * inner + i;
+            float *dst = out + o * axis * inner + i;
+            float maxValue = -INFINITY;
+            for (int64_t a = 0; a < axis; ++a) {
+                maxValue = std::max(maxValue, in[a * inner]);
+            }
+            double sum = 0.0;
+            for (int64_t a = 0; a < axis; ++a) {
+                dst[a * inner] = std::exp(in[a * inner] - maxValue);
+                sum += dst[a * inner];
+            }
+            for (int64_t a = 0; a < axis; ++a) {
+                dst[a * inner] = static_cast<float>(dst[a * inner] / sum);
+            }
+        }
+    }
+}
+
+void Matmul(const float *x, const float *weight, const float *bias, float *out, int64_t m, int64_t k, int64_t n,
+            bool transposeB)
+{
+    for (int64_t i = 0; i < m; ++i) {
+        float *outRow = out + i * n;
+        for (int64_t j = 0; j < n; ++j) {
+            outRow[j] = bias == nullptr ? 0.0f : bias[j];
+        }
+        if (transposeB) {
+            // weight为[n, k]，按行做点积
+            for (int64_t j = 0; j < n; ++j) {
+                const float *weightRow = weight + j * k;
+                float sum = 0.0f;
+                for (int64_t p = 0; p < k; ++p) {
+                    sum += x[i * k + p] * weightRow[p];
+                }
+                outRow[j] += sum;
+            }
+            continue;
+        }
+        for (int64_t p = 0; p < k; ++p) {
+            float a = x[i * k + p];
+            const float *weightRow = weight + p * n;
+            for (int64_t j = 0; j < n; ++j) {
+                outRow[j] += a * weightRow[j];
+            }
+        }
+    }
+}
+
+void NzToNd(const float *nz, float *nd, int64_t rows, int64_t cols)
+{
+    constexpr int64_t block = 16;
+    for (int64_t c1 = 0; c1 < cols / block; ++c1) {
+        for (int64_t r = 0; r < rows; ++r) {
+            const float *src = nz + (c1 * rows + r) * block;
+            std::copy(src, src + block, nd + r * cols + c1 * block);
+        }
+    }
+}
+
+void Reduce(const float *x, const std::vector<int64_t> &shape, const std::vector<bool> &reduced, ReduceMode mode,
+            std::vector<float> &out)
+{
+    int64_t rank = static_cast<int64_t>(shape.size());
+    std::vector<int64_t> outStrides(rank, 0);
+    int64_t outCount = 1;
+    int64_t count = 1;
+    for (int64_t d = rank - 1; d >= 0; --d) {
+        if (!reduced[d]) {
+            outStrides[d] = outCount;
+            outCount *= shape[d];
+        }
+        count *= shape[d];
+    }
+    double init = 0.0;
+    if (mode == ReduceMode::MAX) {
+        init = -INFINITY;
+    } else if (mode == ReduceMode::MIN) {
+        init = INFINITY;
+    }
+    std::vector<double> acc(outCount, init);
+    std::vector<int64_t> index(rank, 0);
+    for (int64_t i = 0; i < count; ++i) {
+        int64_t outIndex = 0;
+        for (int64_t d = 0; d < rank; ++d) {
+            outIndex += index[d] * outStrides[d];
+        }
+        double value = x[i];
+        double &target = acc[outIndex];
+        if (mode == ReduceMode::MAX) {
+            target = (std::isnan(value) || value > target) ? value : target;
+        } else if (mode == ReduceMode::MIN) {
+            target = (std::isnan(value) || value < target) ? value : target;
+        } else {
+            target += value;
+        }
+        for (int64_t d = rank - 1; d >= 0; --d) {
+            if (++index[d] < shape[d]) {
+                break;
+            }
+            index[d] = 0;
+        }
+    }
+    int64_t reduceCount = outCount == 0 ? 0 : count / outCount;
+    out.resize(outCount);
+    for (int64_t i = 0; i < outCount; ++i) {
+        out[i] = static_cast<float>(mode == ReduceMode::MEAN ? acc[i] / reduceCount : acc[i]);
+    }
+}
+} // namespace sim
@@ -0,0 +1,67 @@
+#ifndef SIM_KERNELS_H
+#define SIM_KERNELS_H
+
+#include <cstdint>
+#include <vector>
+#include "acl/acl.h"
+
+namespace sim {
+// 数据类型的字节数
+size_t DtypeSize(aclDataType dtype);
+
+float HalfToFloat(uint16_t value);
+uint16_t FloatToHalf(float value);
+float Bf16ToFloat(uint16_t value);
+uint16_t FloatToBf16(float value);
+
+// 按dtype读写单个元素，统一以float参与计算
+float LoadElement(const void *data, aclDataType dtype, int64_t index);
+void StoreElement(void *data, aclDataType dtype, int64_t index, float value);
+
+// 描述一段内存上的逻辑张量：shape + stride(元素为单位) + offset
+struct StridedView {
+    void *data = nullptr;
+    aclDataType dtype = ACL_DT_UNDEFINED;
+    std::vector<int64_t> shape;
+    std::vector<int64_t> strides;
+    int64_t offset = 0;
+
+    int64_t Numel() const;
+    bool IsContiguous() const;
+    // 逻辑上第linearIndex个元素在storage中的元素下标
+    int64_t StorageIndex(int64_t linearIndex) const;
+};
+
+// 读取为连续的float数组 / 从连续float数组写回
+std::vector<float> Gather(const StridedView &view);
+void Scatter(const StridedView &view, const std::vector<float> &values);
+
+std::vector<int64_t> ContiguousStrides(const std::vector<int64_t> &shape);
+
+// ---- CPU参考实现，全部以float计算 ----
+// approximate: 0 erf，1 tanh
+float Gelu(float x, int64_t approximate);
+
+// x: [rows, cols]，gamma/beta: [cols]；mean/rstd非空时输出每行的均值和1/sqrt(var + epsilon)
+void LayerNorm(const float *x, const float *gamma, const float *beta, float *out, int64_t rows, int64_t cols,
+               float epsilon, float *mean = nullptr, float *rstd = nullptr);
+
+// x为[outer, axis, inner]的连续数据，沿axis做softmax
+void Softmax(const float *x, float *out, int64_t outer, int64_t axis, int64_t inner);
+
+// out[m,n] = sum_k x[m,k] * w(k,n) + bias[n]，w(k,n)由transposeB决定取值方式
+void Matmul(const float *x, const float *weight, const float *bias, float *out, int64_t m, int64_t k, int64_t n,
+            bool transposeB);
+
+// FRACTAL_NZ [1, cols/16, rows, 16] 转为 ND [rows, cols]，rows和cols为16对齐后的大小
+void NzToNd(const float *nz, float *nd, int64_t rows, int64_t cols);
+
+enum class ReduceMode { MAX, MIN, SUM, MEAN };
+
+// 沿reduced中为true的维度规约，x为shape的连续数据，out按未规约维度的行主序排列
+// 求和以double累加；MAX/MIN遇到nan时结果为nan
+void Reduce(const float *x, const std::vector<int64_t> &shape, const std::vector<bool> &reduced, ReduceMode mode,
+            std::vector<float> &out);
+} // namespace sim
+
+#endif
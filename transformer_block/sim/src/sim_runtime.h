@@ -0,0 +1,69 @@
+#ifndef SIM_RUNTIME_H
+#define SIM_RUNTIME_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "acl/acl.h"
+
+namespace sim {
+using Clock = std::chrono::steady_clock;
+
+// 仿真stream：一个host线程按提交顺序串行执行任务，语义与device stream一致
+class SimStream {
+public:
+    explicit SimStream(int32_t deviceId);
+    ~SimStream();
+
+    void Enqueue(std::function<void()> task);
+    void Synchronize();
+    int32_t DeviceId() const { return deviceId_; }
+
+private:
+    void WorkerLoop();
+
+    int32_t deviceId_ = 0;
+    std::mutex mutex_;
+    std::condition_variable taskCv_;
+    std::condition_variable idleCv_;
+    std::deque<std::function<void()>> tasks_;
+    bool busy_ = false;
+    bool stop_ = false;
+    std::thread worker_;
+};
+
+// 仿真event：记录在stream上执行到该位置时的时间戳
+struct SimEvent {
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint64_t recordSeq = 0;   // 已提交的record次数
+    uint64_t completeSeq = 0; // 已完成的record次数
+    Clock::time_point timestamp;
+};
+
+// 当前线程绑定的device
+int32_t CurrentDevice();
+
+// 将任务提交到stream，stream为空时在调用线程同步执行
+void Launch(aclrtStream stream, std::function<void()> task);
+
+// 模拟host侧的开销，在调用线程上sleep，不占用仿真device的计算
+// SIM_SETUP_LATENCY_US：每次算子Setup（atb算子Setup、aclnn创建executor）附加的时延，对应tiling等准备工作
+// SIM_LAUNCH_LATENCY_US：每次下发kernel附加的时延
+void HostSetupDelay();
+void HostLaunchDelay();
+
+// 作用域内当前线程的HostSetupDelay不附加时延
+// 图算子在Execute中才为各节点Setup，这部分开销在图的Setup中按节点数计入
+class ScopedSetupDelaySuppress {
+public:
+    ScopedSetupDelaySuppress();
+    ~ScopedSetupDelaySuppress();
+};
+} // namespace sim
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef ARG_PARSE_H
+#define ARG_PARSE_H
+
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include "utils/log.h"
+
+/**
+ * 解析命令行中的非负整数参数，整个字符串都是十进制数字且不超过uint32_t时返回true，
+ * 否则输出错误并返回false，value不变
+ * @param name 参数名，用于错误信息
+ */
+inline bool ParseUint32Arg(const std::string &name, const std::string &text, uint32_t &value)
+{
+    bool digits = !text.empty() && text.find_first_not_of("0123456789") == std::string::npos;
+    errno = 0;
+    unsigned long long parsed = digits ? std::strtoull(text.c_str(), nullptr, 10) : 0;
+    if (!digits || errno == ERANGE || parsed > std::numeric_limits<uint32_t>::max()) {
+        LOG_ERROR("invalid value for " + name + ": " + text);
+        return false;
+    }
+    value = static_cast<uint32_t>(parsed);
+    return true;
+}
+
+#endif
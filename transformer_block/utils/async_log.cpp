@@ -0,0 +1,330 @@
+#include "utils/async_log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+constexpr size_t RING_CAPACITY = 256 * 1024; // 每个线程的缓冲区大小
+constexpr uint32_t PADDING_MARK = 0xffffffffu;
+constexpr size_t RECORD_HEADER_SIZE = sizeof(uint32_t);
+constexpr auto WRITER_INTERVAL = std::chrono::milliseconds(1); // 后台线程空闲时的轮询间隔
+
+size_t AlignRecord(size_t size)
+{
+    return (size + 3) & ~static_cast<size_t>(3);
+}
+
+// 线程退出时关闭本线程的缓冲区；关闭后该线程的日志改为同步写入
+thread_local SpscLogRing *t_ring = nullptr;
+thread_local bool t_ringReleased = false;
+
+struct ThreadRingGuard
+{
+    ~ThreadRingGuard()
+    {
+        if (t_ring != nullptr)
+        {
+            t_ring->closed.store(true, std::memory_order_release);
+            t_ring = nullptr;
+        }
+        t_ringReleased = true;
+    }
+};
+thread_local ThreadRingGuard t_ringGuard;
+} // namespace
+
+SpscLogRing::SpscLogRing(size_t capacity) : buffer_(capacity), mask_(capacity - 1)
+{
+}
+
+size_t SpscLogRing::MaxRecordSize() const
+{
+    return buffer_.size() / 4;
+}
+
+bool SpscLogRing::TryPush(const char *data, uint32_t size)
+{
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    size_t need = RECORD_HEADER_SIZE + AlignRecord(size);
+    size_t index = head & mask_;
+    size_t toEnd = buffer_.size() - index;
+    size_t padding = toEnd < need ? toEnd : 0;
+    if (head + padding + need - tail > buffer_.size())
+    {
+        return false;
+    }
+    if (padding != 0)
+    {
+        std::memcpy(&buffer_[index], &PADDING_MARK, RECORD_HEADER_SIZE);
+        head += padding;
+        index = 0;
+    }
+    std::memcpy(&buffer_[index], &size, RECORD_HEADER_SIZE);
+    std::memcpy(&buffer_[index + RECORD_HEADER_SIZE], data, size);
+    head_.store(head + need, std::memory_order_release);
+    return true;
+}
+
+size_t SpscLogRing::PopAll(std::string &out)
+{
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    size_t count = 0;
+    while (tail < head)
+    {
+        size_t index = tail & mask_;
+        uint32_t size = 0;
+        std::memcpy(&size, &buffer_[index], RECORD_HEADER_SIZE);
+        if (size == PADDING_MARK)
+        {
+            tail += buffer_.size() - index;
+            continue;
+        }
+        out.append(&buffer_[index + RECORD_HEADER_SIZE], size);
+        out.push_back('\n');
+        tail += RECORD_HEADER_SIZE + AlignRecord(size);
+        count++;
+    }
+    tail_.store(tail, std::memory_order_release);
+    return count;
+}
+
+AsyncLogWriter &AsyncLogWriter::GetInstance()
+{
+    // 有意不释放：静态对象析构和atexit回调中仍可能写日志
+    static AsyncLogWriter *instance = new AsyncLogWriter();
+    return *instance;
+}
+
+AsyncLogWriter::AsyncLogWriter()
+{
+    writer_ = std::thread(&AsyncLogWriter::Run, this);
+    std::atexit([]() { AsyncLogWriter::GetInstance().Shutdown(); });
+}
+
+SpscLogRing *AsyncLogWriter::GetThreadRing()
+{
+    if (t_ring != nullptr || t_ringReleased)
+    {
+        return t_ring;
+    }
+    (void)&t_ringGuard; // 首次使用时构造，线程退出时析构
+    auto ring = std::make_unique<SpscLogRing>(RING_CAPACITY);
+    t_ring = ring.get();
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    rings_.push_back(std::move(ring));
+    return t_ring;
+}
+
+void AsyncLogWriter::Write(const std::string &record)
+{
+    SpscLogRing *ring = async_.load(std::memory_order_relaxed) ? GetThreadRing() : nullptr;
+    if (ring != nullptr)
+    {
+        // 先置位writing再确认仍为异步模式，与Shutdown先清除async_再检查writing配对：
+        // 两者都用seq_cst，要么这里看到同步模式，要么后台线程看到writing并等待本次写入完成
+        ring->writing.store(true);
+        if (!async_.load())
+        {
+            ring->writing.store(false, std::memory_order_release);
+            ring = nullptr;
+        }
+    }
+    if (ring == nullptr)
+    {
+        std::string line = record + "\n";
+        WriteToSinks(line.data(), line.size());
+        return;
+    }
+    uint32_t size = static_cast<uint32_t>(std::min(record.size(), ring->MaxRecordSize()));
+    while (!ring->TryPush(record.data(), size))
+    {
+        // 缓冲区写满时唤醒后台线程并等待，不丢弃日志
+        fullWaitCount_.fetch_add(1, std::memory_order_relaxed);
+        if (!wakeRequested_.exchange(true, std::memory_order_relaxed))
+        {
+            stateCv_.notify_one();
+        }
+        std::this_thread::yield();
+    }
+    ring->writing.store(false, std::memory_order_release);
+}
+
+void AsyncLogWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    if (stopped_)
+    {
+        return;
+    }
+    uint64_t target = ++flushRequested_;
+    stateCv_.notify_one();
+    flushCv_.wait(lock, [this, target]() { return flushDone_ >= target || stopped_; });
+}
+
+void AsyncLogWriter::AddFileSink(const std::string &filename)
+{
+    std::lock_guard<std::mutex> lock(sinkMutex_);
+    for (const auto &file : files_)
+    {
+        if (file.first == filename)
+        {
+            return;
+        }
+    }
+    FILE *file = std::fopen(filename.c_str(), "a");
+    if (file == nullptr)
+    {
+        std::fprintf(stderr, "Failed to open log file: %s\n", filename.c_str());
+        return;
+    }
+    files_.emplace_back(filename, file);
+}
+
+void AsyncLogWriter::ClearFileSinks()
+{
+    Flush();
+    std::lock_guard<std::mutex> lock(sinkMutex_);
+    for (const auto &file : files_)
+    {
+        std::fclose(file.second);
+    }
+    files_.clear();
+}
+
+void AsyncLogWriter::SetConsoleSink(bool enable)
+{
+    Flush();
+    consoleEnabled_.store(enable, std::memory_order_relaxed);
+}
+
+void AsyncLogWriter::SetAsync(bool async)
+{
+    Flush();
+    async_.store(async, std::memory_order_relaxed);
+}
+
+uint64_t AsyncLogWriter::GetFullWaitCount() const
+{
+    return fullWaitCount_.load(std::memory_order_relaxed);
+}
+
+void AsyncLogWriter::Run()
+{
+    std::string batch;
+    while (true)
+    {
+        uint64_t flushTarget = 0;
+        bool stop = false;
+        {
+            std::unique_lock<std::mutex> lock(stateMutex_);
+            stateCv_.wait_for(lock, WRITER_INTERVAL, [this]() {
+                return stop_ || flushRequested_ > flushDone_ || wakeRequested_.load(std::memory_order_relaxed);
+            });
+            flushTarget = flushRequested_;
+            stop = stop_;
+        }
+        wakeRequested_.store(false, std::memory_order_relaxed);
+        batch.clear();
+        Drain(batch);
+        if (!batch.empty())
+        {
+            WriteToSinks(batch.data(), batch.size());
+        }
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            flushDone_ = flushTarget;
+        }
+        flushCv_.notify_all();
+        if (stop)
+        {
+            // async_已清除，之后的生产者都同步写入；继续取记录直到正在写入的生产者完成，
+            // 缓冲区写满而等待的生产者也因此能够写完。先检查writing再取记录，最后一轮取到全部已写入的记录
+            bool writing = true;
+            while (writing)
+            {
+                writing = HasWritingProducer();
+                batch.clear();
+                Drain(batch);
+                if (!batch.empty())
+                {
+                    WriteToSinks(batch.data(), batch.size());
+                }
+                if (writing)
+                {
+                    std::this_thread::yield();
+                }
+            }
+            return;
+        }
+    }
+}
+
+bool AsyncLogWriter::HasWritingProducer()
+{
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    for (const auto &ring : rings_)
+    {
+        if (ring->writing.load())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AsyncLogWriter::Drain(std::string &batch)
+{
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    for (size_t i = 0; i < rings_.size();)
+    {
+        // 先读closed再取记录，保证线程退出前写入的记录都被取出
+        bool closed = rings_[i]->closed.load(std::memory_order_acquire);
+        rings_[i]->PopAll(batch);
+        if (closed)
+        {
+            rings_[i] = std::move(rings_.back());
+            rings_.pop_back();
+            continue;
+        }
+        i++;
+    }
+}
+
+void AsyncLogWriter::WriteToSinks(const char *data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(sinkMutex_);
+    if (consoleEnabled_.load(std::memory_order_relaxed))
+    {
+        std::fwrite(data, 1, size, stdout);
+        std::fflush(stdout);
+    }
+    for (const auto &file : files_)
+    {
+        std::fwrite(data, 1, size, file.second);
+        std::fflush(file.second);
+    }
+}
+
+void AsyncLogWriter::Shutdown()
+{
+    // 先切换为同步写入，后台线程等待正在写入的生产者完成并取完缓冲区中剩余的记录后退出
+    async_.store(false);
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (stop_)
+        {
+            return;
+        }
+        stop_ = true;
+    }
+    stateCv_.notify_one();
+    writer_.join();
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stopped_ = true;
+    }
+    flushCv_.notify_all();
+}
@@ -0,0 +1,111 @@
+#ifndef ASYNC_LOG_H
+#define ASYNC_LOG_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 单生产者单消费者的无锁字节环形缓冲区
+// 每条记录为[uint32长度][内容]，按4字节对齐且不跨越缓冲区末尾，末尾放不下时写入填充标记后从头开始
+class SpscLogRing
+{
+public:
+    // capacity需为2的幂
+    explicit SpscLogRing(size_t capacity);
+
+    // 生产者线程调用，空间不足时返回false
+    bool TryPush(const char *data, uint32_t size);
+
+    // 消费者线程调用，取出全部记录，每条后追加换行；返回取出的记录数
+    size_t PopAll(std::string &out);
+
+    // 单条记录的最大长度，超出的部分由调用方截断
+    size_t MaxRecordSize() const;
+
+    // 所属线程退出后置位，消费者取完剩余记录后释放
+    std::atomic<bool> closed{false};
+
+    // 所属线程判定为异步写入后到写入完成前置位，Shutdown据此等待正在写入的生产者
+    std::atomic<bool> writing{false};
+
+private:
+    std::vector<char> buffer_;
+    size_t mask_;
+    alignas(64) std::atomic<uint64_t> head_{0}; // 生产者写位置
+    alignas(64) std::atomic<uint64_t> tail_{0}; // 消费者读位置
+};
+
+// 进程内唯一的日志写入器
+// 异步模式下调用线程只把格式化好的记录写入本线程的SpscLogRing，后台线程批量写入控制台和日志文件
+// 同步模式下在调用线程上加锁写入并逐条刷新
+// 进程退出时（exit/main返回）先改为同步写入，后台线程等待已判定为异步的生产者写完并取完剩余记录后退出；
+// 被信号终止时未写出的记录会丢失
+class AsyncLogWriter
+{
+public:
+    static AsyncLogWriter &GetInstance();
+
+    // 写入一条不含换行的记录
+    void Write(const std::string &record);
+
+    // 等待调用前已写入的记录全部写到sink并刷新
+    void Flush();
+
+    // 追加日志文件，同名文件只打开一次
+    void AddFileSink(const std::string &filename);
+
+    // 关闭全部日志文件
+    void ClearFileSinks();
+
+    // 是否输出到控制台，默认输出
+    void SetConsoleSink(bool enable);
+
+    // 切换同步/异步模式，切换前先Flush
+    void SetAsync(bool async);
+
+    // 写满时生产者等待的次数
+    uint64_t GetFullWaitCount() const;
+
+private:
+    AsyncLogWriter();
+    AsyncLogWriter(const AsyncLogWriter &) = delete;
+    AsyncLogWriter &operator=(const AsyncLogWriter &) = delete;
+
+    SpscLogRing *GetThreadRing();
+    void Run();
+    // 取出全部线程缓冲区中的记录，释放已退出线程的缓冲区
+    void Drain(std::string &batch);
+    // 是否有生产者正在向缓冲区写入
+    bool HasWritingProducer();
+    void WriteToSinks(const char *data, size_t size);
+    void Shutdown();
+
+    std::atomic<bool> async_{true};
+    std::atomic<bool> consoleEnabled_{true};
+    std::atomic<uint64_t> fullWaitCount_{0};
+    std::atomic<bool> wakeRequested_{false}; // 有线程的缓冲区已写满，需要后台线程立即取走
+
+    std::mutex ringsMutex_;
+    std::vector<std::unique_ptr<SpscLogRing>> rings_;
+
+    std::mutex sinkMutex_;
+    std::vector<std::pair<std::string, FILE *>> files_;
+
+    // 后台线程的唤醒、停止和Flush请求
+    std::mutex stateMutex_;
+    std::condition_variable stateCv_;
+    std::condition_variable flushCv_;
+    bool stop_ = false;
+    bool stopped_ = false;
+    uint64_t flushRequested_ = 0;
+    uint64_t flushDone_ = 0;
+    std::thread writer_;
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "utils/log.h"
+#include <ctime>
 
 const char *logLevelToString(LogLevel level)
 {
@@ -17,12 +18,26 @@ const char *logLevelToString(LogLevel level)
     }
 }
 
-std::string getCurrentTime()
+Logger &GetLogger()
 {
-    auto now = std::chrono::system_clock::now();
-    auto in_time_t = std::chrono::system_clock::to_time_t(now);
+    // 有意不释放：静态对象析构和atexit回调中仍可能写日志
+    // static Logger *logger = new Logger("app.log", LogLevel::DEBUG);
+    static Logger *logger = new Logger("app.log", LogLevel::ERROR);
+    return *logger;
+}
 
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d %X");
-    return ss.str();
-}
\ No newline at end of file
+const char *getCurrentTime()
+{
+    // localtime_r只在秒数变化时调用
+    thread_local time_t cachedSecond = -1;
+    thread_local char cachedTime[32] = {};
+    time_t now = std::time(nullptr);
+    if (now != cachedSecond)
+    {
+        struct tm localTime;
+        localtime_r(&now, &localTime);
+        std::strftime(cachedTime, sizeof(cachedTime), "%Y-%m-%d %X", &localTime);
+        cachedSecond = now;
+    }
+    return cachedTime;
+}
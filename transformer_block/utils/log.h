@@ -1,13 +1,17 @@
 #ifndef LOG_H
 #define LOG_H
 
-#include <iostream>
-#include <fstream>
-#include <sstream>
+#include <atomic>
 #include <string>
-#include <chrono>
-#include <iomanip>
-#include <cstring> 
+#include <cstring>
+#include <type_traits>
+#include "utils/async_log.h"
+// 编译期最低日志级别，低于该级别的LOG_*调用连同参数构造一起不参与编译
+// 取值与LogLevel一致：0 DEBUG，1 INFO，2 WARNING，3 ERROR，由CMake选项LOG_MIN_LEVEL传入
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
 // 定义日志级别
 enum class LogLevel
 {
@@ -20,70 +24,88 @@ enum class LogLevel
 // 将日志级别转换为字符串
 const char *logLevelToString(LogLevel level);
 
-// 获取当前时间的字符串表示
-std::string getCurrentTime();
+// 获取当前时间的字符串表示，每个线程按秒缓存格式化结果，返回值在本线程下次调用前有效
+const char *getCurrentTime();
+
+// 追加一个日志参数，数值按std::to_string格式化
+template <typename T>
+void appendLogArg(std::string &out, const T &value)
+{
+    if constexpr (std::is_arithmetic_v<T>)
+    {
+        out += std::to_string(value);
+    }
+    else
+    {
+        out += value;
+    }
+}
 
 // 日志类
 class Logger
 {
 public:
-    // 构造函数
-    Logger(const std::string &filename, LogLevel minLevel = LogLevel::INFO) : logFile(filename), minLogLevel(minLevel)
+    // 构造函数，日志文件由AsyncLogWriter统一打开，同名文件只打开一次
+    Logger(const std::string &filename, LogLevel minLevel = LogLevel::INFO) : minLogLevel(minLevel)
     {
-        logFile.open(filename, std::ios::out | std::ios::app);
-        if (!logFile.is_open())
-        {
-            std::cerr << "Failed to open log file: " << filename << std::endl;
-        }
+        AsyncLogWriter::GetInstance().AddFileSink(filename);
     }
 
-    // 析构函数
-    ~Logger()
+    // 设置运行时最小日志级别
+    void setMinLogLevel(LogLevel level)
     {
-        if (logFile.is_open())
-        {
-            logFile.close();
-        }
+        minLogLevel.store(level, std::memory_order_relaxed);
     }
 
-    // 设置最小日志级别
-    void setMinLogLevel(LogLevel level)
+    // LOG_*宏先判断级别，未开启时不构造日志参数
+    bool isEnabled(LogLevel level) const
     {
-        minLogLevel = level;
+        return level >= minLogLevel.load(std::memory_order_relaxed);
     }
 
-    // 打印日志
+    // 打印日志：在调用线程上格式化为一条记录，交给AsyncLogWriter写入控制台和日志文件
     template <typename... Args>
-    void log(LogLevel level, const char *file, int line, const char *format, Args... args)
+    void log(LogLevel level, const char *file, int line, const char *format, const Args &...args)
     {
-        if (level >= minLogLevel)
+        if (isEnabled(level))
         {
-            std::stringstream ss;
-            ss << "[" << getCurrentTime() << "] [" << logLevelToString(level) << "] [" << file << ":" << line << "] ";
-            (ss << ... << args);
-
-            std::string logMessage = ss.str();
-            std::cout << logMessage << std::endl;
-            if (logFile.is_open())
-            {
-                logFile << logMessage << std::endl;
-            }
+            thread_local std::string record;
+            record.clear();
+            record += "[";
+            record += getCurrentTime();
+            record += "] [";
+            record += logLevelToString(level);
+            record += "] [";
+            record += file;
+            record += ":";
+            record += std::to_string(line);
+            record += "] ";
+            (appendLogArg(record, args), ...);
+            AsyncLogWriter::GetInstance().Write(record);
         }
     }
 
 private:
-    std::ofstream logFile;
-    LogLevel minLogLevel;
+    std::atomic<LogLevel> minLogLevel;
 };
 
-// 全局 logger 对象
-// static Logger g_logger("app.log", LogLevel::DEBUG);
-static Logger g_logger("app.log", LogLevel::ERROR);
+// 进程内唯一的logger，写入app.log，运行时默认级别为ERROR
+Logger &GetLogger();
 
 // 辅助宏，用于处理可变参数列表
 #define __FILENAME__ (strrchr(__FILE__, '/') ? strrchr(__FILE__, '/') + 1 : (strrchr(__FILE__, '\\') ? strrchr(__FILE__, '\\') + 1 : __FILE__))
-// #define LOG_HELPER(level, ...) g_logger.log(level, __FILE__, __LINE__, "%s", ##__VA_ARGS__)
-#define LOG_HELPER(level, ...) g_logger.log(level, __FILENAME__, __LINE__, "%s", ##__VA_ARGS__)
+// 低于LOG_MIN_LEVEL的调用在编译期丢弃，低于运行时级别的调用不对参数求值
+#define LOG_HELPER(level, ...)                                                           \
+    do                                                                                   \
+    {                                                                                    \
+        if constexpr (static_cast<int>(level) >= LOG_MIN_LEVEL)                          \
+        {                                                                                \
+            if (GetLogger().isEnabled(level))                                            \
+            {                                                                            \
+                GetLogger().log(level, __FILENAME__, __LINE__, "%s", ##__VA_ARGS__);     \
+            }                                                                            \
+        }                                                                                \
+    } while (0)
 
 // 使用宏定义简化日志调用
 #define LOG_DEBUG(...) LOG_HELPER(LogLevel::DEBUG, ##__VA_ARGS__)
@@ -0,0 +1,231 @@
+#include "utils/metrics.h"
+#include <algorithm>
+#include <sstream>
+
+size_t GetMetricShardIndex()
+{
+    static std::atomic<size_t> nextShard{0};
+    thread_local size_t shardIndex = nextShard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARD_COUNT;
+    return shardIndex;
+}
+
+uint64_t Counter::Value() const
+{
+    uint64_t value = 0;
+    for (const auto &shard : shards_) {
+        value += shard.value.load(std::memory_order_relaxed);
+    }
+    return value;
+}
+
+LatencyHistogram::LatencyHistogram() : shards_(std::make_unique<Shard[]>(METRIC_SHARD_COUNT))
+{
+}
+
+size_t LatencyHistogram::BucketIndex(uint64_t ns)
+{
+    if (ns < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(ns);
+    }
+    uint32_t exponent = 63 - static_cast<uint32_t>(__builtin_clzll(ns));
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    uint64_t subBucket = (ns >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + subBucket;
+}
+
+uint64_t LatencyHistogram::BucketUpperNs(size_t index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return index + 1;
+    }
+    uint32_t exponent = static_cast<uint32_t>(index / SUB_BUCKET_COUNT) + SUB_BUCKET_BITS - 1;
+    uint64_t subBucket = index % SUB_BUCKET_COUNT;
+    uint64_t width = 1ULL << (exponent - SUB_BUCKET_BITS);
+    return (SUB_BUCKET_COUNT + subBucket) * width + width;
+}
+
+size_t LatencyHistogram::ExportBucketIndex(uint64_t ns)
+{
+    return std::lower_bound(EXPORT_UPPER_NS, EXPORT_UPPER_NS + EXPORT_BUCKET_COUNT, ns) - EXPORT_UPPER_NS;
+}
+
+void LatencyHistogram::RecordNs(uint64_t ns)
+{
+    Shard &shard = shards_[GetMetricShardIndex()];
+    shard.buckets[BucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+    shard.exportBuckets[ExportBucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+    shard.sumNs.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t maxNs = shard.maxNs.load(std::memory_order_relaxed);
+    while (ns > maxNs && !shard.maxNs.compare_exchange_weak(maxNs, ns, std::memory_order_relaxed)) {
+    }
+}
+
+HistogramSnapshot LatencyHistogram::Snapshot() const
+{
+    HistogramSnapshot snapshot;
+    snapshot.buckets.assign(BUCKET_COUNT, 0);
+    snapshot.exportBuckets.assign(EXPORT_BUCKET_COUNT + 1, 0);
+    for (size_t i = 0; i < METRIC_SHARD_COUNT; i++) {
+        const Shard &shard = shards_[i];
+        for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+            snapshot.buckets[bucket] += shard.buckets[bucket].load(std::memory_order_relaxed);
+        }
+        for (size_t bucket = 0; bucket <= EXPORT_BUCKET_COUNT; bucket++) {
+            snapshot.exportBuckets[bucket] += shard.exportBuckets[bucket].load(std::memory_order_relaxed);
+        }
+        snapshot.sumNs += shard.sumNs.load(std::memory_order_relaxed);
+        snapshot.maxNs = std::max(snapshot.maxNs, shard.maxNs.load(std::memory_order_relaxed));
+    }
+    // count由桶求和得到，抓取与记录并发时也与各桶一致
+    for (uint64_t bucketCount : snapshot.buckets) {
+        snapshot.count += bucketCount;
+    }
+    return snapshot;
+}
+
+uint64_t HistogramSnapshot::PercentileNs(double ratio) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(ratio * count);
+    rank = rank == 0 ? 1 : std::min(rank, count);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(LatencyHistogram::BucketUpperNs(i), maxNs);
+        }
+    }
+    return maxNs;
+}
+
+void MetricsRegistry::Enable()
+{
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Disable()
+{
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+MetricsRegistry::Series &MetricsRegistry::GetSeriesLocked(const std::string &name, const std::string &help,
+                                                          MetricType type, const std::string &labels)
+{
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+        it = families_.emplace(name, Family()).first;
+        it->second.help = help;
+        it->second.type = type;
+    }
+    return it->second.series[labels];
+}
+
+Counter &MetricsRegistry::GetCounter(const std::string &name, const std::string &help, const std::string &labels)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    Series &series = GetSeriesLocked(name, help, MetricType::COUNTER, labels);
+    if (series.counter == nullptr) {
+        series.counter = std::make_unique<Counter>();
+    }
+    return *series.counter;
+}
+
+Gauge &MetricsRegistry::GetGauge(const std::string &name, const std::string &help, const std::string &labels)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    Series &series = GetSeriesLocked(name, help, MetricType::GAUGE, labels);
+    if (series.gauge == nullptr) {
+        series.gauge = std::make_unique<Gauge>();
+    }
+    return *series.gauge;
+}
+
+LatencyHistogram &MetricsRegistry::GetHistogram(const std::string &name, const std::string &help,
+                                                const std::string &labels)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    Series &series = GetSeriesLocked(name, help, MetricType::HISTOGRAM, labels);
+    if (series.histogram == nullptr) {
+        series.histogram = std::make_unique<LatencyHistogram>();
+    }
+    return *series.histogram;
+}
+
+void MetricsRegistry::RegisterCallback(const std::string &name, const std::string &help, MetricType type,
+                                       const std::string &labels, ValueFunc func)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    GetSeriesLocked(name, help, type, labels).func = std::move(func);
+}
+
+void MetricsRegistry::UnregisterCallback(const std::string &name, const std::string &labels)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+        return;
+    }
+    auto series = it->second.series.find(labels);
+    if (series != it->second.series.end()) {
+        series->second.func = nullptr;
+    }
+}
+
+static std::string SeriesName(const std::string &name, const std::string &labels, const std::string &extraLabel = "")
+{
+    std::string allLabels = labels;
+    if (!extraLabel.empty()) {
+        allLabels += allLabels.empty() ? extraLabel : "," + extraLabel;
+    }
+    return allLabels.empty() ? name : name + "{" + allLabels + "}";
+}
+
+std::string MetricsRegistry::RenderPrometheus() const
+{
+    static const char *TYPE_NAMES[] = {"counter", "gauge", "histogram"};
+    std::ostringstream text;
+    // 回调在持锁时求值，UnregisterCallback返回后不会再调用；回调中不能再访问注册表
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (const auto &family : families_) {
+        const std::string &name = family.first;
+        text << "# HELP " << name << " " << family.second.help << "\n";
+        text << "# TYPE " << name << " " << TYPE_NAMES[static_cast<int>(family.second.type)] << "\n";
+        for (const auto &item : family.second.series) {
+            const std::string &labels = item.first;
+            const Series &series = item.second;
+            if (series.counter != nullptr) {
+                text << SeriesName(name, labels) << " " << series.counter->Value() << "\n";
+            } else if (series.gauge != nullptr) {
+                text << SeriesName(name, labels) << " " << series.gauge->Value() << "\n";
+            } else if (series.func != nullptr) {
+                text << SeriesName(name, labels) << " " << series.func() << "\n";
+            } else if (series.histogram != nullptr) {
+                // 输出的桶和count都取自exportBuckets，抓取与记录并发时累计值也不超过+Inf
+                HistogramSnapshot snapshot = series.histogram->Snapshot();
+                uint64_t cumulative = 0;
+                for (size_t bucket = 0; bucket < LatencyHistogram::EXPORT_BUCKET_COUNT; bucket++) {
+                    cumulative += snapshot.exportBuckets[bucket];
+                    std::ostringstream le;
+                    le << "le=\"" << LatencyHistogram::EXPORT_UPPER_NS[bucket] / 1e9 << "\"";
+                    text << SeriesName(name + "_bucket", labels, le.str()) << " " << cumulative << "\n";
+                }
+                cumulative += snapshot.exportBuckets[LatencyHistogram::EXPORT_BUCKET_COUNT];
+                text << SeriesName(name + "_bucket", labels, "le=\"+Inf\"") << " " << cumulative << "\n";
+                text << SeriesName(name + "_sum", labels) << " " << snapshot.sumNs / 1e9 << "\n";
+                text << SeriesName(name + "_count", labels) << " " << cumulative << "\n";
+            }
+        }
+    }
+    return text.str();
+}
+
+MetricsRegistry &GetMetrics()
+{
+    // 有意不释放：其他静态对象析构和atexit回调中仍可能打点或抓取
+    static MetricsRegistry *registry = new MetricsRegistry;
+    return *registry;
+}
@@ -0,0 +1,240 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * 运行时指标
+ * 计数器、gauge和延迟直方图按线程分片，记录时只对本线程分片做一次relaxed原子加，不加锁；
+ * 抓取时把各分片相加后按Prometheus文本格式输出，见MetricsExporter。
+ * 各打点处先检查IsEnabled，未开启时每个打点只有一次原子变量读取。
+ */
+
+// 每个指标的分片数，线程按首次使用的顺序轮流分配分片，线程数不超过分片数时每个线程独占一个分片
+constexpr size_t METRIC_SHARD_COUNT = 8;
+
+// 当前线程使用的分片下标
+size_t GetMetricShardIndex();
+
+// 单调递增的计数器
+class Counter
+{
+public:
+    void Add(uint64_t value = 1)
+    {
+        shards_[GetMetricShardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t Value() const;
+
+private:
+    struct alignas(64) Shard
+    {
+        std::atomic<uint64_t> value{0};
+    };
+
+    Shard shards_[METRIC_SHARD_COUNT];
+};
+
+// 可增可减的整数gauge，如执行中的请求数
+class Gauge
+{
+public:
+    void Set(int64_t value)
+    {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    void Add(int64_t delta)
+    {
+        value_.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    int64_t Value() const
+    {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int64_t> value_{0};
+};
+
+// 直方图各分片相加后的结果
+struct HistogramSnapshot
+{
+    std::vector<uint64_t> buckets;
+    // 按LatencyHistogram::EXPORT_UPPER_NS划分的非累计计数，最后一个为超过最大上界的部分
+    std::vector<uint64_t> exportBuckets;
+    uint64_t count = 0;
+    uint64_t sumNs = 0;
+    uint64_t maxNs = 0;
+
+    /**
+     * 分位数（纳秒），返回所在桶的上界，相对误差不超过1/16
+     * @param ratio 0~1
+     */
+    uint64_t PercentileNs(double ratio) const;
+};
+
+/**
+ * HDR风格的延迟直方图，单位纳秒
+ * 桶按2的幂分段，每段再线性分为16个子桶，任意值所在桶的宽度不超过该值的1/16；
+ * 小于16ns的值各占一个桶，超过2^41ns（约37分钟）的值计入最后一个桶。
+ * 内部桶的边界与Prometheus输出的上界不对齐，输出用的桶在记录时按"观测值 <= le"另行计数
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 4;
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1U << SUB_BUCKET_BITS;
+    static constexpr uint32_t MAX_EXPONENT = 40;
+    static constexpr size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKET_COUNT;
+    // Prometheus输出的桶上界（纳秒，含上界）
+    static constexpr size_t EXPORT_BUCKET_COUNT = 19;
+    static constexpr uint64_t EXPORT_UPPER_NS[EXPORT_BUCKET_COUNT] = {
+        10000, 25000, 50000, 100000, 250000, 500000,                                       // 10us ~ 500us
+        1000000, 2500000, 5000000, 10000000, 25000000, 50000000,                           // 1ms ~ 50ms
+        100000000, 250000000, 500000000, 1000000000, 2500000000, 5000000000, 10000000000, // 100ms ~ 10s
+    };
+
+    LatencyHistogram();
+
+    void RecordNs(uint64_t ns);
+
+    void Record(std::chrono::steady_clock::duration duration)
+    {
+        int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        RecordNs(ns < 0 ? 0 : static_cast<uint64_t>(ns));
+    }
+
+    HistogramSnapshot Snapshot() const;
+
+    static size_t BucketIndex(uint64_t ns);
+
+    // 桶的上界（不含），纳秒
+    static uint64_t BucketUpperNs(size_t index);
+
+    // 第一个不小于ns的输出上界的下标，超过全部上界时为EXPORT_BUCKET_COUNT
+    static size_t ExportBucketIndex(uint64_t ns);
+
+private:
+    struct alignas(64) Shard
+    {
+        std::atomic<uint64_t> buckets[BUCKET_COUNT];
+        std::atomic<uint64_t> exportBuckets[EXPORT_BUCKET_COUNT + 1];
+        std::atomic<uint64_t> sumNs{0};
+        std::atomic<uint64_t> maxNs{0};
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+};
+
+/**
+ * 作用域计时，析构时把经过的时间记入直方图，histogram为空时不计时
+ */
+class ScopedLatency
+{
+public:
+    explicit ScopedLatency(LatencyHistogram *histogram) : histogram_(histogram)
+    {
+        if (histogram_ != nullptr) {
+            begin_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedLatency()
+    {
+        if (histogram_ != nullptr) {
+            histogram_->Record(std::chrono::steady_clock::now() - begin_);
+        }
+    }
+
+    ScopedLatency(const ScopedLatency &) = delete;
+    ScopedLatency &operator=(const ScopedLatency &) = delete;
+
+private:
+    LatencyHistogram *histogram_;
+    std::chrono::steady_clock::time_point begin_;
+};
+
+enum class MetricType
+{
+    COUNTER = 0,
+    GAUGE,
+    HISTOGRAM,
+};
+
+/**
+ * 指标注册表
+ * 同名指标组成一个family，family内按标签区分，标签为Prometheus格式的字符串，如 device="0",node="1"。
+ * Get*返回的引用在进程内一直有效，打点处应缓存引用而不是每次查找
+ */
+class MetricsRegistry
+{
+public:
+    // 抓取时求值的指标，用于池占用、利用率等已有统计
+    using ValueFunc = std::function<double()>;
+
+    void Enable();
+    void Disable();
+
+    bool IsEnabled() const
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    Counter &GetCounter(const std::string &name, const std::string &help, const std::string &labels = "");
+
+    Gauge &GetGauge(const std::string &name, const std::string &help, const std::string &labels = "");
+
+    LatencyHistogram &GetHistogram(const std::string &name, const std::string &help, const std::string &labels = "");
+
+    /**
+     * 注册抓取时求值的计数器或gauge，同名同标签时替换原来的函数
+     * func引用的对象销毁前需要调用UnregisterCallback
+     */
+    void RegisterCallback(const std::string &name, const std::string &help, MetricType type,
+                          const std::string &labels, ValueFunc func);
+
+    void UnregisterCallback(const std::string &name, const std::string &labels);
+
+    /**
+     * 按Prometheus文本格式（0.0.4）输出所有指标，直方图单位为秒
+     */
+    std::string RenderPrometheus() const;
+
+private:
+    struct Series
+    {
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<LatencyHistogram> histogram;
+        ValueFunc func;
+    };
+
+    struct Family
+    {
+        std::string help;
+        MetricType type = MetricType::COUNTER;
+        std::map<std::string, Series> series; // 标签 -> 指标
+    };
+
+    Series &GetSeriesLocked(const std::string &name, const std::string &help, MetricType type,
+                            const std::string &labels);
+
+    std::atomic<bool> enabled_{false};
+    mutable std::mutex mutex_; // 保护families_的结构，不保护指标的值
+    std::map<std::string, Family> families_;
+};
+
+MetricsRegistry &GetMetrics();
+
+#endif
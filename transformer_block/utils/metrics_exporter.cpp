@@ -0,0 +1,176 @@
+#include "utils/metrics_exporter.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "utils/log.h"
+#include "utils/metrics.h"
+
+// accept线程检查stop_的间隔
+constexpr int HTTP_POLL_INTERVAL_MS = 100;
+// 请求头的长度上限和读取超时，抓取方只发一个很短的GET
+constexpr size_t HTTP_MAX_REQUEST_BYTES = 8192;
+constexpr int HTTP_RECV_TIMEOUT_MS = 1000;
+
+MetricsExporter::~MetricsExporter()
+{
+    Stop();
+}
+
+bool MetricsExporter::StartHttp(uint16_t port)
+{
+    listenFd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        LOG_ERROR("metrics socket failed, errno " + std::to_string(errno));
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    socklen_t addressLen = sizeof(address);
+    if (bind(listenFd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(listenFd_, 16) != 0 ||
+        getsockname(listenFd_, reinterpret_cast<sockaddr *>(&address), &addressLen) != 0) {
+        LOG_ERROR("metrics bind/listen port " + std::to_string(port) + " failed, errno " + std::to_string(errno));
+        close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+    httpPort_ = ntohs(address.sin_port);
+    httpThread_ = std::thread([this] { HttpLoop(); });
+    return true;
+}
+
+bool MetricsExporter::StartDump(const std::string &path, uint32_t intervalMs)
+{
+    dumpPath_ = path;
+    dumpIntervalMs_ = intervalMs;
+    if (!WriteDump()) {
+        return false;
+    }
+    dumpThread_ = std::thread([this] { DumpLoop(); });
+    return true;
+}
+
+void MetricsExporter::Stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(dumpMutex_);
+        stop_ = true;
+    }
+    dumpCv_.notify_all();
+    if (httpThread_.joinable()) {
+        httpThread_.join();
+    }
+    if (listenFd_ >= 0) {
+        close(listenFd_);
+        listenFd_ = -1;
+    }
+    if (dumpThread_.joinable()) {
+        dumpThread_.join();
+        WriteDump();
+    }
+}
+
+void MetricsExporter::HttpLoop()
+{
+    while (!stop_) {
+        pollfd pollFd = {listenFd_, POLLIN, 0};
+        int ready = poll(&pollFd, 1, HTTP_POLL_INTERVAL_MS);
+        if (ready <= 0) {
+            continue;
+        }
+        int fd = accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        ServeConnection(fd);
+        close(fd);
+    }
+}
+
+static void SendAll(int fd, const std::string &data)
+{
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t ret = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            return;
+        }
+        sent += static_cast<size_t>(ret);
+    }
+}
+
+void MetricsExporter::ServeConnection(int fd)
+{
+    timeval timeout = {HTTP_RECV_TIMEOUT_MS / 1000, (HTTP_RECV_TIMEOUT_MS % 1000) * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    // 只需要请求行，读到头部结束即可
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < HTTP_MAX_REQUEST_BYTES) {
+        ssize_t ret = recv(fd, buffer, sizeof(buffer), 0);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<size_t>(ret));
+    }
+    std::string requestLine = request.substr(0, request.find("\r\n"));
+    std::string status;
+    std::string contentType;
+    std::string body;
+    if (requestLine.rfind("GET /metrics ", 0) == 0 || requestLine.rfind("GET /metrics?", 0) == 0) {
+        status = "200 OK";
+        contentType = "text/plain; version=0.0.4";
+        body = GetMetrics().RenderPrometheus();
+    } else {
+        status = "404 Not Found";
+        contentType = "text/plain";
+        body = "not found\n";
+    }
+    SendAll(fd, "HTTP/1.1 " + status + "\r\nContent-Type: " + contentType + "\r\nContent-Length: " +
+                    std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+}
+
+void MetricsExporter::DumpLoop()
+{
+    std::unique_lock<std::mutex> lock(dumpMutex_);
+    while (!stop_) {
+        dumpCv_.wait_for(lock, std::chrono::milliseconds(dumpIntervalMs_), [this] { return stop_.load(); });
+        if (!stop_) {
+            WriteDump();
+        }
+    }
+}
+
+bool MetricsExporter::WriteDump()
+{
+    std::string tmpPath = dumpPath_ + ".tmp";
+    FILE *file = fopen(tmpPath.c_str(), "w");
+    if (file == nullptr) {
+        LOG_ERROR("open metrics file " + tmpPath + " failed, errno " + std::to_string(errno));
+        return false;
+    }
+    std::string text = GetMetrics().RenderPrometheus();
+    bool written = fwrite(text.data(), 1, text.size(), file) == text.size();
+    written = fclose(file) == 0 && written;
+    if (!written || rename(tmpPath.c_str(), dumpPath_.c_str()) != 0) {
+        LOG_ERROR("write metrics file " + dumpPath_ + " failed");
+        return false;
+    }
+    return true;
+}
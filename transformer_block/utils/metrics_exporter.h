@@ -0,0 +1,69 @@
+#ifndef METRICS_EXPORTER_H
+#define METRICS_EXPORTER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * 指标导出
+ * HTTP：在127.0.0.1上监听，GET /metrics返回GetMetrics()的Prometheus文本，其余路径返回404，
+ * 每次只处理一个连接，抓取不经过请求路径上的任何锁。
+ * 文件：每隔intervalMs把指标写入临时文件后rename到目标路径，读取方不会看到写了一半的文件，Stop时再写一次。
+ * 两种方式可以同时使用。
+ */
+class MetricsExporter
+{
+public:
+    MetricsExporter() = default;
+
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter &) = delete;
+    MetricsExporter &operator=(const MetricsExporter &) = delete;
+
+    /**
+     * 启动HTTP导出线程
+     * @param port 0时由系统分配，实际端口见GetHttpPort
+     * @return 监听失败时返回false
+     */
+    bool StartHttp(uint16_t port);
+
+    uint16_t GetHttpPort() const
+    {
+        return httpPort_;
+    }
+
+    /**
+     * 启动定期写文件的线程
+     */
+    bool StartDump(const std::string &path, uint32_t intervalMs);
+
+    /**
+     * 停止导出线程，启动过文件导出时最后写一次文件
+     */
+    void Stop();
+
+private:
+    void HttpLoop();
+    void ServeConnection(int fd);
+    void DumpLoop();
+    bool WriteDump();
+
+    std::atomic<bool> stop_{false};
+
+    int listenFd_ = -1;
+    uint16_t httpPort_ = 0;
+    std::thread httpThread_;
+
+    std::string dumpPath_;
+    uint32_t dumpIntervalMs_ = 0;
+    std::thread dumpThread_;
+    std::mutex dumpMutex_;               // 配合dumpCv_在Stop时唤醒写文件线程
+    std::condition_variable dumpCv_;
+};
+
+#endif
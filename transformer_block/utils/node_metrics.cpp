@@ -0,0 +1,104 @@
+#include "utils/node_metrics.h"
+#include "utils/log.h"
+
+NodeMetrics::~NodeMetrics()
+{
+    Release();
+}
+
+void NodeMetrics::Prepare(const std::string &modelLabel, size_t nodeCount)
+{
+    active_ = GetMetrics().IsEnabled();
+    if (!active_ || (execute_ != nullptr && nodes_.size() == nodeCount)) {
+        return;
+    }
+    Release();
+    active_ = true;
+    MetricsRegistry &metrics = GetMetrics();
+    std::string modelTag = "model=\"" + modelLabel + "\"";
+    execute_ = &metrics.GetHistogram("model_execute_seconds", "End-to-end time of one model Execute", modelTag);
+    deviceIdle_ = &metrics.GetHistogram("model_device_idle_seconds",
+                                        "Device idle time between consecutive nodes of one model Execute", modelTag);
+    nodes_.resize(nodeCount);
+    for (size_t nodeId = 0; nodeId < nodeCount; nodeId++) {
+        std::string labels = modelTag + ",node=\"" + std::to_string(nodeId) + "\"";
+        NodeState &node = nodes_[nodeId];
+        node.setup = &metrics.GetHistogram("node_setup_seconds", "Host time of operation Setup per node", labels);
+        node.device = &metrics.GetHistogram("node_device_seconds", "Device execution time per node", labels);
+        if (aclrtCreateEvent(&node.start) != ACL_SUCCESS || aclrtCreateEvent(&node.end) != ACL_SUCCESS) {
+            LOG_WARNING("create node metrics event failed, device time of node " + std::to_string(nodeId) +
+                        " is not recorded");
+        }
+    }
+}
+
+LatencyHistogram *NodeMetrics::GetExecuteHistogram() const
+{
+    return active_ ? execute_ : nullptr;
+}
+
+LatencyHistogram *NodeMetrics::GetSetupHistogram(size_t nodeId) const
+{
+    return active_ && nodeId < nodes_.size() ? nodes_[nodeId].setup : nullptr;
+}
+
+void NodeMetrics::BeginDevice(size_t nodeId, aclrtStream stream)
+{
+    if (!active_ || nodeId >= nodes_.size() || nodes_[nodeId].start == nullptr) {
+        return;
+    }
+    aclrtRecordEvent(nodes_[nodeId].start, stream);
+}
+
+void NodeMetrics::EndDevice(size_t nodeId, aclrtStream stream)
+{
+    if (!active_ || nodeId >= nodes_.size() || nodes_[nodeId].end == nullptr) {
+        return;
+    }
+    aclrtRecordEvent(nodes_[nodeId].end, stream);
+    nodes_[nodeId].recorded = true;
+}
+
+void NodeMetrics::CollectDevice()
+{
+    if (!active_) {
+        return;
+    }
+    // 上一个节点结束到下一个节点开始之间device没有任务，即在等待host准备和下发
+    const NodeState *previous = nullptr;
+    double idleMs = 0;
+    for (auto &node : nodes_) {
+        if (!node.recorded) {
+            continue;
+        }
+        node.recorded = false;
+        float elapsedMs = 0;
+        if (aclrtEventElapsedTime(&elapsedMs, node.start, node.end) == ACL_SUCCESS) {
+            node.device->RecordNs(static_cast<uint64_t>(elapsedMs * 1e6));
+        }
+        if (previous != nullptr && aclrtEventElapsedTime(&elapsedMs, previous->end, node.start) == ACL_SUCCESS &&
+            elapsedMs > 0) {
+            idleMs += elapsedMs;
+        }
+        previous = &node;
+    }
+    if (previous != nullptr) {
+        deviceIdle_->RecordNs(static_cast<uint64_t>(idleMs * 1e6));
+    }
+}
+
+void NodeMetrics::Release()
+{
+    for (auto &node : nodes_) {
+        if (node.start != nullptr) {
+            aclrtDestroyEvent(node.start);
+        }
+        if (node.end != nullptr) {
+            aclrtDestroyEvent(node.end);
+        }
+    }
+    nodes_.clear();
+    execute_ = nullptr;
+    deviceIdle_ = nullptr;
+    active_ = false;
+}
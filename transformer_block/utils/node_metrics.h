@@ -0,0 +1,66 @@
+#ifndef NODE_METRICS_H
+#define NODE_METRICS_H
+
+#include <string>
+#include <vector>
+#include <acl/acl.h>
+#include "utils/metrics.h"
+
+/**
+ * 模型的执行指标：整次Execute的耗时、每个节点Setup的host耗时、在device上的执行时间，
+ * 以及相邻节点之间device等待host下发的空闲时间
+ * device时间由节点前后在stream上插入的event得到，stream同步后换算，event按节点缓存复用。
+ * 每次Execute开始时调用Prepare，指标未开启时其余接口都直接返回。
+ * GetSetupHistogram可以在准备节点的线程上调用，其余接口需要在模型的执行线程上调用。
+ */
+class NodeMetrics
+{
+public:
+    NodeMetrics() = default;
+
+    ~NodeMetrics();
+
+    NodeMetrics(const NodeMetrics &) = delete;
+    NodeMetrics &operator=(const NodeMetrics &) = delete;
+
+    /**
+     * 开始一次Execute，首次开启时按节点数注册直方图并创建event
+     * @param modelLabel 模型名，作为指标的model标签
+     */
+    void Prepare(const std::string &modelLabel, size_t nodeCount);
+
+    // 未开启时返回nullptr，配合ScopedLatency使用
+    LatencyHistogram *GetExecuteHistogram() const;
+    LatencyHistogram *GetSetupHistogram(size_t nodeId) const;
+
+    // 在节点的任务下发前后调用
+    void BeginDevice(size_t nodeId, aclrtStream stream);
+    void EndDevice(size_t nodeId, aclrtStream stream);
+
+    /**
+     * stream同步之后调用，把本次执行各节点的device时间和节点之间的空闲时间之和记入直方图
+     */
+    void CollectDevice();
+
+    /**
+     * 销毁event，stream销毁前调用
+     */
+    void Release();
+
+private:
+    struct NodeState
+    {
+        LatencyHistogram *setup = nullptr;
+        LatencyHistogram *device = nullptr;
+        aclrtEvent start = nullptr;
+        aclrtEvent end = nullptr;
+        bool recorded = false; // 本次执行是否已在stream上记录了起止event
+    };
+
+    bool active_ = false; // 本次执行是否记录指标
+    LatencyHistogram *execute_ = nullptr;
+    LatencyHistogram *deviceIdle_ = nullptr;
+    std::vector<NodeState> nodes_;
+};
+
+#endif
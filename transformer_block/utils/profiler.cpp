@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include "utils/profiler.h"
+#include "utils/log.h"
+
+static Profiler g_profiler;
+
+// device轨道在trace中的pid，host轨道为0
+constexpr int DEVICE_TRACE_PID = 1;
+
+static double Percentile(const std::vector<double> &sorted, double ratio)
+{
+    size_t rank = static_cast<size_t>(std::ceil(ratio * sorted.size()));
+    return sorted.at(rank == 0 ? 0 : rank - 1);
+}
+
+static std::string SpanKey(const char *name, int64_t nodeId)
+{
+    return nodeId < 0 ? std::string(name) : "node" + std::to_string(nodeId) + "." + name;
+}
+
+void Profiler::Enable()
+{
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::Disable()
+{
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+double Profiler::NowUs() const
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch_).count();
+}
+
+uint32_t Profiler::GetHostTrackId()
+{
+    auto it = hostTracks_.find(std::this_thread::get_id());
+    if (it == hostTracks_.end()) {
+        it = hostTracks_.emplace(std::this_thread::get_id(), static_cast<uint32_t>(hostTracks_.size())).first;
+    }
+    return it->second;
+}
+
+void Profiler::RecordHostSpan(const char *name, int64_t nodeId, double beginUs, double endUs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    hostSpans_.push_back({name, nodeId, GetHostTrackId(), beginUs, endUs});
+}
+
+aclrtEvent Profiler::AcquireEvent(StreamTrack &track)
+{
+    if (!track.freeEvents.empty()) {
+        aclrtEvent event = track.freeEvents.back();
+        track.freeEvents.pop_back();
+        return event;
+    }
+    aclrtEvent event = nullptr;
+    auto ret = aclrtCreateEvent(&event);
+    if (ret != ACL_SUCCESS) {
+        LOG_ERROR("profiler aclrtCreateEvent failed. ret: " + std::to_string(ret));
+        return nullptr;
+    }
+    return event;
+}
+
+void Profiler::ReleaseEvent(StreamTrack &track, aclrtEvent event)
+{
+    if (event != nullptr) {
+        track.freeEvents.push_back(event);
+    }
+}
+
+size_t Profiler::BeginDeviceSpan(aclrtStream stream)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    // 无法记录时返回的ID不在pendingSpans_中，EndDeviceSpan直接忽略，该样本被跳过
+    size_t spanId = nextSpanId_++;
+    auto it = streamTracks_.find(stream);
+    if (it == streamTracks_.end()) {
+        // 首次使用的stream先同步一个anchor event，之后的device时间都相对anchor换算
+        StreamTrack track;
+        track.trackId = nextStreamTrackId_;
+        track.anchor = AcquireEvent(track);
+        if (track.anchor == nullptr) {
+            return spanId;
+        }
+        auto ret = aclrtRecordEvent(track.anchor, stream);
+        if (ret == ACL_SUCCESS) {
+            ret = aclrtSynchronizeEvent(track.anchor);
+        }
+        if (ret != ACL_SUCCESS) {
+            LOG_ERROR("profiler record anchor event failed. ret: " + std::to_string(ret));
+            aclrtDestroyEvent(track.anchor);
+            return spanId;
+        }
+        track.anchorUs = NowUs();
+        nextStreamTrackId_++;
+        it = streamTracks_.emplace(stream, track).first;
+    }
+    PendingDeviceSpan span;
+    span.stream = stream;
+    span.start = AcquireEvent(it->second);
+    span.end = AcquireEvent(it->second);
+    if (span.start == nullptr || span.end == nullptr) {
+        ReleaseEvent(it->second, span.start);
+        ReleaseEvent(it->second, span.end);
+        return spanId;
+    }
+    auto ret = aclrtRecordEvent(span.start, stream);
+    if (ret != ACL_SUCCESS) {
+        LOG_ERROR("profiler aclrtRecordEvent failed. ret: " + std::to_string(ret));
+        ReleaseEvent(it->second, span.start);
+        ReleaseEvent(it->second, span.end);
+        return spanId;
+    }
+    pendingSpans_.emplace(spanId, span);
+    return spanId;
+}
+
+void Profiler::EndDeviceSpan(size_t spanId, const char *name, int64_t nodeId)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = pendingSpans_.find(spanId);
+    if (it == pendingSpans_.end()) {
+        return;
+    }
+    PendingDeviceSpan &span = it->second;
+    auto ret = aclrtRecordEvent(span.end, span.stream);
+    if (ret != ACL_SUCCESS) {
+        LOG_ERROR("profiler aclrtRecordEvent failed. ret: " + std::to_string(ret));
+        // 丢弃该样本，event之后重新记录即可复用
+        StreamTrack &track = streamTracks_.at(span.stream);
+        ReleaseEvent(track, span.start);
+        ReleaseEvent(track, span.end);
+        pendingSpans_.erase(it);
+        return;
+    }
+    span.name = name;
+    span.nodeId = nodeId;
+    span.ended = true;
+}
+
+void Profiler::CollectLocked(aclrtStream stream)
+{
+    auto trackIt = streamTracks_.find(stream);
+    if (trackIt == streamTracks_.end()) {
+        return;
+    }
+    StreamTrack &track = trackIt->second;
+    for (auto it = pendingSpans_.begin(); it != pendingSpans_.end();) {
+        PendingDeviceSpan &span = it->second;
+        if (span.stream != stream || !span.ended) {
+            ++it;
+            continue;
+        }
+        float startMs = 0;
+        float endMs = 0;
+        auto ret = aclrtSynchronizeEvent(span.end);
+        if (ret == ACL_SUCCESS) {
+            ret = aclrtEventElapsedTime(&startMs, track.anchor, span.start);
+        }
+        if (ret == ACL_SUCCESS) {
+            ret = aclrtEventElapsedTime(&endMs, track.anchor, span.end);
+        }
+        if (ret == ACL_SUCCESS) {
+            deviceSpans_.push_back({span.name, span.nodeId, track.trackId, track.anchorUs + startMs * 1000.0,
+                                    track.anchorUs + endMs * 1000.0});
+        } else {
+            LOG_ERROR("profiler read device span " + SpanKey(span.name, span.nodeId) + " failed. ret: " +
+                      std::to_string(ret));
+        }
+        ReleaseEvent(track, span.start);
+        ReleaseEvent(track, span.end);
+        it = pendingSpans_.erase(it);
+    }
+}
+
+void Profiler::CollectDeviceSpans(aclrtStream stream)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    CollectLocked(stream);
+}
+
+void Profiler::ReleaseStream(aclrtStream stream)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto trackIt = streamTracks_.find(stream);
+    if (trackIt == streamTracks_.end()) {
+        return;
+    }
+    auto ret = aclrtSynchronizeStream(stream);
+    if (ret != ACL_SUCCESS) {
+        LOG_ERROR("profiler aclrtSynchronizeStream failed. ret: " + std::to_string(ret));
+    }
+    CollectLocked(stream);
+    // 未结束的区间直接丢弃
+    for (auto it = pendingSpans_.begin(); it != pendingSpans_.end();) {
+        if (it->second.stream == stream) {
+            trackIt->second.freeEvents.push_back(it->second.start);
+            trackIt->second.freeEvents.push_back(it->second.end);
+            it = pendingSpans_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (aclrtEvent event : trackIt->second.freeEvents) {
+        aclrtDestroyEvent(event);
+    }
+    aclrtDestroyEvent(trackIt->second.anchor);
+    streamTracks_.erase(trackIt);
+}
+
+std::vector<ProfileSummary> Profiler::Summarize()
+{
+    std::map<std::string, std::vector<double>> durations;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (const auto &span : hostSpans_) {
+            durations[SpanKey(span.name, span.nodeId)].push_back(span.endUs - span.beginUs);
+        }
+        for (const auto &span : deviceSpans_) {
+            durations[SpanKey(span.name, span.nodeId)].push_back(span.endUs - span.beginUs);
+        }
+    }
+
+    std::vector<ProfileSummary> summaries;
+    for (auto &item : durations) {
+        std::vector<double> &values = item.second;
+        std::sort(values.begin(), values.end());
+        ProfileSummary summary;
+        summary.name = item.first;
+        summary.count = values.size();
+        for (double value : values) {
+            summary.meanUs += value;
+        }
+        summary.meanUs /= values.size();
+        summary.p50Us = Percentile(values, 0.5);
+        summary.p99Us = Percentile(values, 0.99);
+        summaries.push_back(summary);
+    }
+    return summaries;
+}
+
+void Profiler::LogSummary()
+{
+    for (const auto &summary : Summarize()) {
+        LOG_ERROR("profile " + summary.name + " count " + std::to_string(summary.count) + ", mean " +
+                  std::to_string(summary.meanUs) + " us, p50 " + std::to_string(summary.p50Us) + " us, p99 " +
+                  std::to_string(summary.p99Us) + " us");
+    }
+}
+
+bool Profiler::WriteChromeTrace(const std::string &path)
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open trace file: " + path);
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    auto writeSeparator = [&file, &first]() {
+        if (!first) {
+            file << ",\n";
+        }
+        first = false;
+    };
+    auto writeMeta = [&file, &writeSeparator](const char *metaName, int pid, uint32_t tid, const std::string &name) {
+        writeSeparator();
+        file << "{\"name\":\"" << metaName << "\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << tid
+             << ",\"args\":{\"name\":\"" << name << "\"}}";
+    };
+    auto writeSpan = [&file, &writeSeparator](const Span &span, int pid) {
+        writeSeparator();
+        file << "{\"name\":\"" << SpanKey(span.name, span.nodeId) << "\",\"cat\":\"" << span.name
+             << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << span.trackId << ",\"ts\":" << span.beginUs
+             << ",\"dur\":" << (span.endUs - span.beginUs) << "}";
+    };
+
+    writeMeta("process_name", 0, 0, "host");
+    writeMeta("process_name", DEVICE_TRACE_PID, 0, "device");
+    for (const auto &track : hostTracks_) {
+        writeMeta("thread_name", 0, track.second, "thread " + std::to_string(track.second));
+    }
+    // stream可能已经销毁，device轨道按记录到的区间命名
+    std::set<uint32_t> streamTrackIds;
+    for (const auto &span : deviceSpans_) {
+        streamTrackIds.insert(span.trackId);
+    }
+    for (uint32_t trackId : streamTrackIds) {
+        writeMeta("thread_name", DEVICE_TRACE_PID, trackId, "stream " + std::to_string(trackId));
+    }
+    for (const auto &span : hostSpans_) {
+        writeSpan(span, 0);
+    }
+    for (const auto &span : deviceSpans_) {
+        writeSpan(span, DEVICE_TRACE_PID);
+    }
+    file << "\n]}\n";
+    return file.good();
+}
+
+void Profiler::Clear()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    hostSpans_.clear();
+    deviceSpans_.clear();
+}
+
+Profiler &GetProfiler()
+{
+    return g_profiler;
+}
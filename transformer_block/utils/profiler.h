@@ -0,0 +1,206 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <acl/acl.h>
+
+// 同名区间的耗时统计，单位us
+struct ProfileSummary
+{
+    std::string name;
+    size_t count = 0;
+    double meanUs = 0;
+    double p50Us = 0;
+    double p99Us = 0;
+};
+
+/**
+ * 节点级性能分析器
+ * host侧记录每个节点InferShape、Setup、workspace分配和下发的时间，device侧在stream上
+ * 插入event记录节点在device上的起止时间，导出为Chrome trace（chrome://tracing或Perfetto打开）。
+ * 未开启时每个打点只有一次原子变量读取。
+ */
+class Profiler
+{
+public:
+    void Enable();
+    void Disable();
+
+    bool IsEnabled() const
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * 当前时间，相对于分析器创建时刻，单位us
+     */
+    double NowUs() const;
+
+    /**
+     * 记录一段host区间，所在线程为调用线程
+     * @param name 区间名称，必须是静态字符串
+     * @param nodeId 节点ID，与节点无关时为-1
+     */
+    void RecordHostSpan(const char *name, int64_t nodeId, double beginUs, double endUs);
+
+    /**
+     * 在stream上记录device区间的起点，没有可用event或记录失败时跳过该区间
+     * @return 区间ID，传给EndDeviceSpan
+     */
+    size_t BeginDeviceSpan(aclrtStream stream);
+
+    /**
+     * 在stream上记录device区间的终点
+     */
+    void EndDeviceSpan(size_t spanId, const char *name, int64_t nodeId);
+
+    /**
+     * stream同步之后调用，把该stream上已完成的device区间换算为时间
+     */
+    void CollectDeviceSpans(aclrtStream stream);
+
+    /**
+     * stream销毁前调用，收集剩余区间并释放该stream上的event
+     */
+    void ReleaseStream(aclrtStream stream);
+
+    /**
+     * 按"node<id>.<name>"汇总各区间的mean/p50/p99
+     */
+    std::vector<ProfileSummary> Summarize();
+
+    /**
+     * 打印汇总结果
+     */
+    void LogSummary();
+
+    /**
+     * 导出Chrome trace JSON，host每个线程一条轨道，device每个stream一条轨道
+     * @return 写文件是否成功
+     */
+    bool WriteChromeTrace(const std::string &path);
+
+    /**
+     * 清空已记录的区间
+     */
+    void Clear();
+
+private:
+    struct Span
+    {
+        const char *name = nullptr;
+        int64_t nodeId = -1;
+        uint32_t trackId = 0;
+        double beginUs = 0;
+        double endUs = 0;
+    };
+
+    // 一个stream对应的device轨道，device时间以anchor event为基准换算到host时间轴
+    struct StreamTrack
+    {
+        uint32_t trackId = 0;
+        aclrtEvent anchor = nullptr;
+        double anchorUs = 0;
+        std::vector<aclrtEvent> freeEvents;
+    };
+
+    struct PendingDeviceSpan
+    {
+        aclrtStream stream = nullptr;
+        aclrtEvent start = nullptr;
+        aclrtEvent end = nullptr;
+        const char *name = nullptr;
+        int64_t nodeId = -1;
+        bool ended = false;
+    };
+
+    uint32_t GetHostTrackId();
+    aclrtEvent AcquireEvent(StreamTrack &track);
+    void ReleaseEvent(StreamTrack &track, aclrtEvent event);
+    void CollectLocked(aclrtStream stream);
+
+    std::atomic<bool> enabled_{false};
+    std::chrono::steady_clock::time_point epoch_ = std::chrono::steady_clock::now();
+    std::mutex mutex_; // 保护以下成员
+    std::vector<Span> hostSpans_;
+    std::vector<Span> deviceSpans_;
+    std::map<std::thread::id, uint32_t> hostTracks_;
+    std::map<aclrtStream, StreamTrack> streamTracks_;
+    uint32_t nextStreamTrackId_ = 0;
+    std::map<size_t, PendingDeviceSpan> pendingSpans_; // 区间ID -> 未换算的device区间
+    size_t nextSpanId_ = 0;
+};
+
+Profiler &GetProfiler();
+
+/**
+ * host区间打点，构造时记录起点，析构时记录终点
+ */
+class ProfileScope
+{
+public:
+    ProfileScope(const char *name, int64_t nodeId) : enabled_(GetProfiler().IsEnabled())
+    {
+        if (enabled_) {
+            name_ = name;
+            nodeId_ = nodeId;
+            beginUs_ = GetProfiler().NowUs();
+        }
+    }
+
+    ~ProfileScope()
+    {
+        if (enabled_) {
+            GetProfiler().RecordHostSpan(name_, nodeId_, beginUs_, GetProfiler().NowUs());
+        }
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    bool enabled_;
+    const char *name_ = nullptr;
+    int64_t nodeId_ = -1;
+    double beginUs_ = 0;
+};
+
+/**
+ * device区间打点，构造和析构时分别在stream上插入起止event
+ */
+class DeviceProfileScope
+{
+public:
+    DeviceProfileScope(aclrtStream stream, const char *name, int64_t nodeId) : enabled_(GetProfiler().IsEnabled())
+    {
+        if (enabled_) {
+            name_ = name;
+            nodeId_ = nodeId;
+            spanId_ = GetProfiler().BeginDeviceSpan(stream);
+        }
+    }
+
+    ~DeviceProfileScope()
+    {
+        if (enabled_) {
+            GetProfiler().EndDeviceSpan(spanId_, name_, nodeId_);
+        }
+    }
+
+    DeviceProfileScope(const DeviceProfileScope &) = delete;
+    DeviceProfileScope &operator=(const DeviceProfileScope &) = delete;
+
+private:
+    bool enabled_;
+    const char *name_ = nullptr;
+    int64_t nodeId_ = -1;
+    size_t spanId_ = 0;
+};
+
+#endif
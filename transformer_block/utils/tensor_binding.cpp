@@ -0,0 +1,63 @@
+#include "utils/tensor_binding.h"
+#include <string>
+#include "utils/log.h"
+
+bool BindTensorBuffer(atb::Tensor &tensor, TensorBinding &binding, void *data, uint64_t dataSize,
+                      BufferLocation location)
+{
+    if (data == nullptr || dataSize < tensor.dataSize)
+    {
+        LOG_ERROR("bind buffer invalid, size " + std::to_string(dataSize) + " need " +
+                  std::to_string(tensor.dataSize));
+        return false;
+    }
+    if (location == BufferLocation::HOST && binding.ownedData == nullptr)
+    {
+        // 之前绑定过device缓冲区，需要重新分配一块中转用的device内存
+        auto ret = aclrtMalloc(&binding.ownedData, tensor.dataSize, ACL_MEM_MALLOC_HUGE_FIRST);
+        if (ret != ACL_SUCCESS)
+        {
+            LOG_ERROR("bind host buffer aclrtMalloc failed. ret: " + std::to_string(ret));
+            binding.ownedData = nullptr;
+            return false;
+        }
+    }
+    if (location == BufferLocation::DEVICE)
+    {
+        // 之后的执行都直接使用调用方的device内存
+        FreeTensorBinding(binding);
+    }
+    binding.data = data;
+    binding.location = location;
+    tensor.deviceData = location == BufferLocation::DEVICE ? data : binding.ownedData;
+    return true;
+}
+
+aclError CopyBoundInput(const atb::Tensor &tensor, const TensorBinding &binding, aclrtStream stream)
+{
+    if (binding.data == nullptr || binding.location != BufferLocation::HOST)
+    {
+        return ACL_SUCCESS;
+    }
+    return aclrtMemcpyAsync(tensor.deviceData, tensor.dataSize, binding.data, tensor.dataSize,
+                            ACL_MEMCPY_HOST_TO_DEVICE, stream);
+}
+
+aclError CopyBoundOutput(const atb::Tensor &tensor, const TensorBinding &binding, aclrtStream stream)
+{
+    if (binding.data == nullptr || binding.location != BufferLocation::HOST)
+    {
+        return ACL_SUCCESS;
+    }
+    return aclrtMemcpyAsync(binding.data, tensor.dataSize, tensor.deviceData, tensor.dataSize,
+                            ACL_MEMCPY_DEVICE_TO_HOST, stream);
+}
+
+void FreeTensorBinding(TensorBinding &binding)
+{
+    if (binding.ownedData != nullptr)
+    {
+        aclrtFree(binding.ownedData);
+        binding.ownedData = nullptr;
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef TENSOR_BINDING_H
+#define TENSOR_BINDING_H
+
+#include <acl/acl.h>
+#include <atb/types.h>
+
+/**
+ * 模型输入/输出与调用方缓冲区的绑定
+ * 模型在CreateModelInput/CreateModelOutput中为每个输入输出分配一块device内存（ownedData），
+ * 绑定后按缓冲区位置决定tensor.deviceData使用哪块内存：
+ * DEVICE：直接使用调用方的device内存，ownedData在首次绑定时释放，换请求时只更新地址
+ * HOST：仍使用ownedData，执行时与调用方的host内存异步拷贝，host内存需为aclrtMallocHost申请的锁页内存
+ */
+enum class BufferLocation
+{
+    DEVICE = 0,
+    HOST,
+};
+
+struct TensorBinding
+{
+    void *data = nullptr;                             // 调用方缓冲区，为空表示未绑定
+    BufferLocation location = BufferLocation::DEVICE; // 调用方缓冲区的位置
+    void *ownedData = nullptr;                        // 模型自己分配的device内存，为空表示没有
+};
+
+/**
+ * 把tensor绑定到调用方缓冲区，HOST绑定在没有ownedData时分配一次
+ * @param dataSize 缓冲区字节数，不能小于tensor.dataSize
+ * @return 缓冲区为空、大小不够或分配失败时返回false，tensor和binding不变
+ */
+bool BindTensorBuffer(atb::Tensor &tensor, TensorBinding &binding, void *data, uint64_t dataSize,
+                      BufferLocation location);
+
+/**
+ * HOST绑定的输入：在stream上把调用方host内存异步拷贝到tensor，其他情况不做任何事
+ */
+aclError CopyBoundInput(const atb::Tensor &tensor, const TensorBinding &binding, aclrtStream stream);
+
+/**
+ * HOST绑定的输出：在stream上把tensor异步拷贝到调用方host内存，其他情况不做任何事
+ */
+aclError CopyBoundOutput(const atb::Tensor &tensor, const TensorBinding &binding, aclrtStream stream);
+
+/**
+ * 释放模型自己分配的device内存，调用方缓冲区不释放
+ */
+void FreeTensorBinding(TensorBinding &binding);
+
+#endif
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "utils/tensor_convert.h"
+#include "utils/tensor_convert_internal.h"
+#include "utils/dtype_convert.h"
+
+// 每个线程至少处理的元素数，小张量在调用线程上直接完成，避免创建线程的开销
+constexpr int64_t MIN_ELEMENTS_PER_THREAD = 1 << 18;
+
+static void ScalarFp16ToFloat(const uint16_t *src, float *dst, int64_t count)
+{
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = Fp16ToFloat(src[i]);
+    }
+}
+
+static void ScalarFloatToFp16(const float *src, uint16_t *dst, int64_t count)
+{
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = FloatToFp16(src[i]);
+    }
+}
+
+static void ScalarBf16ToFloat(const uint16_t *src, float *dst, int64_t count)
+{
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = Bf16ToFloat(src[i]);
+    }
+}
+
+static void ScalarFloatToBf16(const float *src, uint16_t *dst, int64_t count)
+{
+    for (int64_t i = 0; i < count; i++) {
+        dst[i] = FloatToBf16(src[i]);
+    }
+}
+
+static const ConvertKernelTable &SelectKernels()
+{
+    static const ConvertKernelTable scalarTable = {ScalarFp16ToFloat, ScalarFloatToFp16, ScalarBf16ToFloat,
+                                                   ScalarFloatToBf16};
+#ifdef TENSOR_CONVERT_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return GetAvx512ConvertKernels();
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c")) {
+        return GetF16cConvertKernels();
+    }
+#endif
+    return scalarTable;
+}
+
+static const ConvertKernelTable &GetKernels()
+{
+    static const ConvertKernelTable &table = SelectKernels();
+    return table;
+}
+
+const char *GetTensorConvertIsaName()
+{
+#ifdef TENSOR_CONVERT_X86
+    if (&GetKernels() == &GetAvx512ConvertKernels()) {
+        return "avx512";
+    }
+    if (&GetKernels() == &GetF16cConvertKernels()) {
+        return "f16c";
+    }
+#endif
+    return "scalar";
+}
+
+// 把[0, count)切成连续的区间并行处理，最后一段在调用线程上执行
+template <typename Func>
+static void ParallelFor(int64_t count, Func func)
+{
+    int64_t maxThreads = std::max<int64_t>(1, std::thread::hardware_concurrency());
+    int64_t threadNum = std::min(maxThreads, count / MIN_ELEMENTS_PER_THREAD);
+    if (threadNum <= 1) {
+        func(0, count);
+        return;
+    }
+    int64_t chunk = (count + threadNum - 1) / threadNum;
+    std::vector<std::thread> threads;
+    for (int64_t begin = 0; begin + chunk < count; begin += chunk) {
+        threads.emplace_back([&func, begin, chunk]() { func(begin, begin + chunk); });
+    }
+    func(static_cast<int64_t>(threads.size()) * chunk, count);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+void ConvertFp16ToFloat(const uint16_t *src, float *dst, int64_t count)
+{
+    auto convert = GetKernels().fp16ToFloat;
+    ParallelFor(count, [=](int64_t begin, int64_t end) { convert(src + begin, dst + begin, end - begin); });
+}
+
+void ConvertFloatToFp16(const float *src, uint16_t *dst, int64_t count)
+{
+    auto convert = GetKernels().floatToFp16;
+    ParallelFor(count, [=](int64_t begin, int64_t end) { convert(src + begin, dst + begin, end - begin); });
+}
+
+void ConvertBf16ToFloat(const uint16_t *src, float *dst, int64_t count)
+{
+    auto convert = GetKernels().bf16ToFloat;
+    ParallelFor(count, [=](int64_t begin, int64_t end) { convert(src + begin, dst + begin, end - begin); });
+}
+
+void ConvertFloatToBf16(const float *src, uint16_t *dst, int64_t count)
+{
+    auto convert = GetKernels().floatToBf16;
+    ParallelFor(count, [=](int64_t begin, int64_t end) { convert(src + begin, dst + begin, end - begin); });
+}
+
+bool IsConvertibleDtype(aclDataType dtype)
+{
+    return GetConvertibleDtypeSize(dtype) != 0;
+}
+
+size_t GetConvertibleDtypeSize(aclDataType dtype)
+{
+    switch (dtype) {
+        case ACL_FLOAT:
+            return sizeof(float);
+        case ACL_FLOAT16:
+        case ACL_BF16:
+            return sizeof(uint16_t);
+        default:
+            return 0;
+    }
+}
+
+void ConvertFromFloat(const float *src, void *dst, aclDataType dtype, int64_t count)
+{
+    if (dtype == ACL_FLOAT16) {
+        ConvertFloatToFp16(src, static_cast<uint16_t *>(dst), count);
+    } else if (dtype == ACL_BF16) {
+        ConvertFloatToBf16(src, static_cast<uint16_t *>(dst), count);
+    } else if (dtype == ACL_FLOAT) {
+        std::copy_n(src, count, static_cast<float *>(dst));
+    }
+}
+
+void ConvertToFloat(const void *src, aclDataType dtype, float *dst, int64_t count)
+{
+    if (dtype == ACL_FLOAT16) {
+        ConvertFp16ToFloat(static_cast<const uint16_t *>(src), dst, count);
+    } else if (dtype == ACL_BF16) {
+        ConvertBf16ToFloat(static_cast<const uint16_t *>(src), dst, count);
+    } else if (dtype == ACL_FLOAT) {
+        std::copy_n(static_cast<const float *>(src), count, dst);
+    }
+}
+
+void FillTyped(void *dst, aclDataType dtype, float value, int64_t count)
+{
+    // 只转换一次，之后按元素宽度填充
+    if (dtype == ACL_FLOAT) {
+        float *data = static_cast<float *>(dst);
+        ParallelFor(count, [=](int64_t begin, int64_t end) { std::fill(data + begin, data + end, value); });
+        return;
+    }
+    if (dtype == ACL_FLOAT16 || dtype == ACL_BF16) {
+        uint16_t bits = dtype == ACL_FLOAT16 ? FloatToFp16(value) : FloatToBf16(value);
+        uint16_t *data = static_cast<uint16_t *>(dst);
+        ParallelFor(count, [=](int64_t begin, int64_t end) { std::fill(data + begin, data + end, bits); });
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef TENSOR_CONVERT_H
+#define TENSOR_CONVERT_H
+
+#include <cstdint>
+#include <acl/acl.h>
+
+/**
+ * host侧张量数据的批量转换和填充
+ * x86上按CPU支持情况使用AVX-512/F16C(AVX2)实现，其他平台为标量实现；元素数较多时切分到多个线程
+ * float转fp16/bf16均按最近偶数舍入，与dtype_convert.h中的标量转换结果一致
+ */
+
+void ConvertFp16ToFloat(const uint16_t *src, float *dst, int64_t count);
+void ConvertFloatToFp16(const float *src, uint16_t *dst, int64_t count);
+void ConvertBf16ToFloat(const uint16_t *src, float *dst, int64_t count);
+void ConvertFloatToBf16(const float *src, uint16_t *dst, int64_t count);
+
+/**
+ * 是否支持按dtype转换，支持ACL_FLOAT、ACL_FLOAT16和ACL_BF16
+ */
+bool IsConvertibleDtype(aclDataType dtype);
+
+/**
+ * 支持转换的dtype的元素字节数，不支持时返回0
+ */
+size_t GetConvertibleDtypeSize(aclDataType dtype);
+
+/**
+ * 把float数据转换为dtype
+ * @param dst count个dtype元素
+ */
+void ConvertFromFloat(const float *src, void *dst, aclDataType dtype, int64_t count);
+
+/**
+ * 把dtype数据转换为float
+ * @param src count个dtype元素
+ */
+void ConvertToFloat(const void *src, aclDataType dtype, float *dst, int64_t count);
+
+/**
+ * 用转换为dtype后的value填充count个元素
+ */
+void FillTyped(void *dst, aclDataType dtype, float value, int64_t count);
+
+/**
+ * 获取转换使用的指令集名称：avx512/f16c/scalar
+ */
+const char *GetTensorConvertIsaName();
+
+#endif
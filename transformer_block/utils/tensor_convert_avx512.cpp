@@ -0,0 +1,94 @@
+// GCC 12的非掩码AVX-512 intrinsic（_mm512_srli_epi32、_mm512_cvtepi32_epi16等）在头文件内部用自赋值的
+// _mm512_undefined_*作为直通源，内联后误报'__Y' may be used uninitialized；该源不参与结果，
+// 本文件的掩码加载均为maskz形式，不存在未初始化的读取，因此只在本文件关闭该警告
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+#include "utils/tensor_convert_internal.h"
+
+// AVX-512F实现，本文件单独以-mavx512f编译，只在CPU支持时经由转换函数表调用，尾部用掩码处理
+constexpr int64_t AVX512_LANES = 16;
+
+static inline __mmask16 TailMask(int64_t remain)
+{
+    return remain >= AVX512_LANES ? static_cast<__mmask16>(0xffff) : static_cast<__mmask16>((1u << remain) - 1);
+}
+
+// AVX-512F没有16位粒度的掩码访存，16位元素的尾部经由临时缓冲读写
+static inline __m256i LoadU16(const uint16_t *src, __mmask16 mask)
+{
+    if (mask == 0xffff) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+    }
+    alignas(32) uint16_t buffer[AVX512_LANES] = {};
+    for (int64_t i = 0; i < AVX512_LANES && ((mask >> i) & 1); i++) {
+        buffer[i] = src[i];
+    }
+    return _mm256_load_si256(reinterpret_cast<const __m256i *>(buffer));
+}
+
+static inline void StoreU16(uint16_t *dst, __mmask16 mask, __m256i value)
+{
+    if (mask == 0xffff) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), value);
+        return;
+    }
+    alignas(32) uint16_t buffer[AVX512_LANES];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(buffer), value);
+    for (int64_t i = 0; i < AVX512_LANES && ((mask >> i) & 1); i++) {
+        dst[i] = buffer[i];
+    }
+}
+
+static void Avx512Fp16ToFloat(const uint16_t *src, float *dst, int64_t count)
+{
+    for (int64_t i = 0; i < count; i += AVX512_LANES) {
+        __mmask16 mask = TailMask(count - i);
+        _mm512_mask_storeu_ps(dst + i, mask, _mm512_cvtph_ps(LoadU16(src + i, mask)));
+    }
+}
+
+static void Avx512FloatToFp16(const float *src, uint16_t *dst, int64_t count)
+{
+    for (int64_t i = 0; i < count; i += AVX512_LANES) {
+        __mmask16 mask = TailMask(count - i);
+        __m512 v = _mm512_maskz_loadu_ps(mask, src + i);
+        StoreU16(dst + i, mask, _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    }
+}
+
+static void Avx512Bf16ToFloat(const uint16_t *src, float *dst, int64_t count)
+{
+    for (int64_t i = 0; i < count; i += AVX512_LANES) {
+        __mmask16 mask = TailMask(count - i);
+        __m512i bits = _mm512_slli_epi32(_mm512_cvtepu16_epi32(LoadU16(src + i, mask)), 16);
+        _mm512_mask_storeu_ps(dst + i, mask, _mm512_castsi512_ps(bits));
+    }
+}
+
+// 最近偶数舍入：bits + 0x7fff + 低位的奇偶，nan单独置为quiet nan
+static void Avx512FloatToBf16(const float *src, uint16_t *dst, int64_t count)
+{
+    __m512i one = _mm512_set1_epi32(1);
+    __m512i bias = _mm512_set1_epi32(0x7fff);
+    __m512i quietBit = _mm512_set1_epi32(0x40);
+    for (int64_t i = 0; i < count; i += AVX512_LANES) {
+        __mmask16 mask = TailMask(count - i);
+        __m512 v = _mm512_maskz_loadu_ps(mask, src + i);
+        __m512i bits = _mm512_castps_si512(v);
+        __m512i high = _mm512_srli_epi32(bits, 16);
+        __m512i lsb = _mm512_and_si512(high, one);
+        __m512i rounded = _mm512_srli_epi32(_mm512_add_epi32(bits, _mm512_add_epi32(lsb, bias)), 16);
+        __mmask16 isNan = _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q);
+        rounded = _mm512_mask_or_epi32(rounded, isNan, high, quietBit);
+        StoreU16(dst + i, mask, _mm512_cvtepi32_epi16(rounded));
+    }
+}
+
+const ConvertKernelTable &GetAvx512ConvertKernels()
+{
+    static const ConvertKernelTable table = {Avx512Fp16ToFloat, Avx512FloatToFp16, Avx512Bf16ToFloat,
+                                             Avx512FloatToBf16};
+    return table;
+}
@@ -0,0 +1,92 @@
+#include <immintrin.h>
+#include <cstring>
+#include "utils/tensor_convert_internal.h"
+
+// AVX2 + F16C实现，本文件单独以-mavx2 -mf16c编译，只在CPU支持时经由转换函数表调用
+constexpr int64_t F16C_LANES = 8;
+
+// 一次转换8个元素，不足8个的尾部经由补0的临时缓冲
+template <typename SrcT, typename DstT, typename Func>
+static inline void ConvertTail(const SrcT *src, DstT *dst, int64_t remain, Func convert8)
+{
+    SrcT srcBuffer[F16C_LANES] = {};
+    DstT dstBuffer[F16C_LANES];
+    std::memcpy(srcBuffer, src, remain * sizeof(SrcT));
+    convert8(srcBuffer, dstBuffer);
+    std::memcpy(dst, dstBuffer, remain * sizeof(DstT));
+}
+
+static inline void Fp16ToFloat8(const uint16_t *src, float *dst)
+{
+    _mm256_storeu_ps(dst, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src))));
+}
+
+static inline void FloatToFp16x8(const float *src, uint16_t *dst)
+{
+    __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), half);
+}
+
+static inline void Bf16ToFloat8(const uint16_t *src, float *dst)
+{
+    __m256i wide = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), _mm256_slli_epi32(wide, 16));
+}
+
+// 最近偶数舍入：bits + 0x7fff + 低位的奇偶，nan单独置为quiet nan
+static inline __m256i FloatToBf16Bits(__m256 v)
+{
+    __m256i bits = _mm256_castps_si256(v);
+    __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+    __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7fff))), 16);
+    __m256i nan = _mm256_or_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(0x40));
+    __m256 isNan = _mm256_cmp_ps(v, v, _CMP_UNORD_Q);
+    return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(rounded), _mm256_castsi256_ps(nan), isNan));
+}
+
+static inline void FloatToBf16x8(const float *src, uint16_t *dst)
+{
+    __m256i bits = FloatToBf16Bits(_mm256_loadu_ps(src));
+    // 32位结果压缩为16位，packus在128位内交错，两半分别取低64位
+    __m256i packed = _mm256_packus_epi32(bits, bits);
+    __m128i result = _mm_unpacklo_epi64(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), result);
+}
+
+template <typename SrcT, typename DstT, typename Func>
+static inline void ConvertAll(const SrcT *src, DstT *dst, int64_t count, Func convert8)
+{
+    int64_t i = 0;
+    for (; i + F16C_LANES <= count; i += F16C_LANES) {
+        convert8(src + i, dst + i);
+    }
+    if (i < count) {
+        ConvertTail(src + i, dst + i, count - i, convert8);
+    }
+}
+
+static void F16cFp16ToFloat(const uint16_t *src, float *dst, int64_t count)
+{
+    ConvertAll(src, dst, count, Fp16ToFloat8);
+}
+
+static void F16cFloatToFp16(const float *src, uint16_t *dst, int64_t count)
+{
+    ConvertAll(src, dst, count, FloatToFp16x8);
+}
+
+static void F16cBf16ToFloat(const uint16_t *src, float *dst, int64_t count)
+{
+    ConvertAll(src, dst, count, Bf16ToFloat8);
+}
+
+static void F16cFloatToBf16(const float *src, uint16_t *dst, int64_t count)
+{
+    ConvertAll(src, dst, count, FloatToBf16x8);
+}
+
+const ConvertKernelTable &GetF16cConvertKernels()
+{
+    static const ConvertKernelTable table = {F16cFp16ToFloat, F16cFloatToFp16, F16cBf16ToFloat, F16cFloatToBf16};
+    return table;
+}
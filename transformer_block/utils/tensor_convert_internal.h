@@ -0,0 +1,22 @@
+#ifndef TENSOR_CONVERT_INTERNAL_H
+#define TENSOR_CONVERT_INTERNAL_H
+
+#include <cstdint>
+
+// 各指令集实现的转换函数表，由tensor_convert.cpp在运行时选择
+// 向量实现的尾部先拷贝到补齐的临时缓冲再转换，不调用dtype_convert.h中的inline函数，
+// 避免以特定指令集编译的inline函数副本被其他编译单元链接
+struct ConvertKernelTable
+{
+    void (*fp16ToFloat)(const uint16_t *src, float *dst, int64_t count);
+    void (*floatToFp16)(const float *src, uint16_t *dst, int64_t count);
+    void (*bf16ToFloat)(const uint16_t *src, float *dst, int64_t count);
+    void (*floatToBf16)(const float *src, uint16_t *dst, int64_t count);
+};
+
+#ifdef TENSOR_CONVERT_X86
+const ConvertKernelTable &GetF16cConvertKernels();
+const ConvertKernelTable &GetAvx512ConvertKernels();
+#endif
+
+#endif
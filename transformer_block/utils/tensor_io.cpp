@@ -0,0 +1,85 @@
+#include "utils/tensor_io.h"
+#include "utils/tensor_convert.h"
+#include "utils/utils.h"
+
+static void CheckTensorDtype(const atb::Tensor &tensor)
+{
+    CHECK_RET(!IsConvertibleDtype(tensor.desc.dtype),
+              "unsupported tensor dtype: " + std::to_string(static_cast<int>(tensor.desc.dtype)));
+}
+
+static void CopyToDevice(atb::Tensor &tensor, const void *hostData, uint64_t dataSize)
+{
+    auto ret = aclrtMemcpy(tensor.deviceData, tensor.dataSize, hostData, dataSize, ACL_MEMCPY_HOST_TO_DEVICE);
+    CHECK_RET(ret, "aclrtMemcpy H2D failed. ret: " + std::to_string(ret));
+}
+
+void UploadTensor(atb::Tensor &tensor, const float *hostData)
+{
+    CheckTensorDtype(tensor);
+    int64_t count = atb::Utils::GetTensorNumel(tensor);
+    if (tensor.desc.dtype == ACL_FLOAT) {
+        CopyToDevice(tensor, hostData, count * sizeof(float));
+        return;
+    }
+    std::vector<uint8_t> converted(count * GetConvertibleDtypeSize(tensor.desc.dtype));
+    ConvertFromFloat(hostData, converted.data(), tensor.desc.dtype, count);
+    CopyToDevice(tensor, converted.data(), converted.size());
+}
+
+void FillTensor(atb::Tensor &tensor, float value)
+{
+    CheckTensorDtype(tensor);
+    int64_t count = atb::Utils::GetTensorNumel(tensor);
+    std::vector<uint8_t> hostData(count * GetConvertibleDtypeSize(tensor.desc.dtype));
+    FillTyped(hostData.data(), tensor.desc.dtype, value, count);
+    CopyToDevice(tensor, hostData.data(), hostData.size());
+}
+
+std::vector<float> DownloadTensor(const atb::Tensor &tensor)
+{
+    CheckTensorDtype(tensor);
+    int64_t count = atb::Utils::GetTensorNumel(tensor);
+    std::vector<float> result(count);
+    if (tensor.desc.dtype == ACL_FLOAT) {
+        auto ret = aclrtMemcpy(result.data(), count * sizeof(float), tensor.deviceData, tensor.dataSize,
+                               ACL_MEMCPY_DEVICE_TO_HOST);
+        CHECK_RET(ret, "aclrtMemcpy D2H failed. ret: " + std::to_string(ret));
+        return result;
+    }
+    std::vector<uint8_t> hostData(count * GetConvertibleDtypeSize(tensor.desc.dtype));
+    auto ret = aclrtMemcpy(hostData.data(), hostData.size(), tensor.deviceData, tensor.dataSize,
+                           ACL_MEMCPY_DEVICE_TO_HOST);
+    CHECK_RET(ret, "aclrtMemcpy D2H failed. ret: " + std::to_string(ret));
+    ConvertToFloat(hostData.data(), tensor.desc.dtype, result.data(), count);
+    return result;
+}
+
+std::vector<float> DownloadTensorRange(const atb::Tensor &tensor, int64_t offset, int64_t count)
+{
+    return DownloadTensorStrided(tensor, offset, count, count, 1);
+}
+
+std::vector<float> DownloadTensorStrided(const atb::Tensor &tensor, int64_t offset, int64_t rowLength,
+                                         int64_t rowStride, int64_t rowCount)
+{
+    CheckTensorDtype(tensor);
+    int64_t numel = atb::Utils::GetTensorNumel(tensor);
+    bool valid = offset >= 0 && rowLength >= 0 && rowCount >= 0 && rowLength <= rowStride;
+    CHECK_RET(!valid || (rowCount > 0 && offset + (rowCount - 1) * rowStride + rowLength > numel),
+              "invalid readback range, offset: " + std::to_string(offset) + ", rowLength: " +
+                  std::to_string(rowLength) + ", rowStride: " + std::to_string(rowStride) + ", rowCount: " +
+                  std::to_string(rowCount) + ", numel: " + std::to_string(numel));
+    std::vector<float> result(rowLength * rowCount);
+    if (result.empty()) {
+        return result;
+    }
+    size_t elementSize = GetConvertibleDtypeSize(tensor.desc.dtype);
+    std::vector<uint8_t> hostData(result.size() * elementSize);
+    const uint8_t *src = static_cast<const uint8_t *>(tensor.deviceData) + offset * elementSize;
+    auto ret = aclrtMemcpy2d(hostData.data(), rowLength * elementSize, src, rowStride * elementSize,
+                             rowLength * elementSize, rowCount, ACL_MEMCPY_DEVICE_TO_HOST);
+    CHECK_RET(ret, "aclrtMemcpy2d D2H failed. ret: " + std::to_string(ret));
+    ConvertToFloat(hostData.data(), tensor.desc.dtype, result.data(), static_cast<int64_t>(result.size()));
+    return result;
+}
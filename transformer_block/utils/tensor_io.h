@@ -0,0 +1,40 @@
+#ifndef TENSOR_IO_H
+#define TENSOR_IO_H
+
+#include <vector>
+#include <atb/types.h>
+
+/**
+ * 按tensor.desc.dtype在host侧完成类型转换后上传/下载device数据，支持ACL_FLOAT、ACL_FLOAT16和ACL_BF16
+ * tensor.deviceData需已分配，dataSize与desc一致；不支持的dtype或拷贝失败时退出
+ */
+
+/**
+ * 上传float数据
+ * @param hostData GetTensorNumel(tensor)个float
+ */
+void UploadTensor(atb::Tensor &tensor, const float *hostData);
+
+/**
+ * 用常数填充整个tensor
+ */
+void FillTensor(atb::Tensor &tensor, float value);
+
+/**
+ * 下载全部数据并转换为float
+ */
+std::vector<float> DownloadTensor(const atb::Tensor &tensor);
+
+/**
+ * 只下载按行主序展开后[offset, offset + count)区间的元素，越界时退出
+ */
+std::vector<float> DownloadTensorRange(const atb::Tensor &tensor, int64_t offset, int64_t count);
+
+/**
+ * 以一次二维拷贝下载rowCount段数据：第i段为从offset + i * rowStride开始的rowLength个连续元素，结果按段依次拼接
+ * 例如rowLength = 1时每隔rowStride个元素采样一个，rowStride为最后一维大小时读取列切片
+ */
+std::vector<float> DownloadTensorStrided(const atb::Tensor &tensor, int64_t offset, int64_t rowLength,
+                                         int64_t rowStride, int64_t rowCount);
+
+#endif
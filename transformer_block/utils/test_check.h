@@ -0,0 +1,17 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <string>
+#include "utils/log.h"
+
+/**
+ * 测试程序的检查项：输出"[PASS] "或"[FAIL] "加说明，返回condition
+ * 用法：passed = Check(condition, "message") && passed;
+ */
+inline bool Check(bool condition, const std::string &message)
+{
+    LOG_ERROR(std::string(condition ? "[PASS] " : "[FAIL] ") + message);
+    return condition;
+}
+
+#endif
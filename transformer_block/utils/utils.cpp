@@ -1,5 +1,11 @@
+#include <algorithm>
 #include "utils/log.h"
 #include "utils/utils.h"
+#include "utils/tensor_io.h"
+
+// 输入和权重的填充值
+constexpr float INPUT_FILL_VALUE = 2.0f;
+constexpr int64_t PRINT_VALUE_COUNT = 11;
 
 void CreateInTensorDescs(atb::SVector<atb::TensorDesc> &intensorDescs)
 {
@@ -28,24 +34,23 @@ void CreateInTensorDescs(atb::SVector<atb::TensorDesc> &intensorDescs)
     }
 }
 
+void CreateInTensor(atb::Tensor &inTensor, const atb::TensorDesc &intensorDesc)
+{
+    inTensor.desc = intensorDesc;
+    inTensor.dataSize = atb::Utils::GetTensorSize(inTensor);
+    int ret = aclrtMalloc(&inTensor.deviceData, inTensor.dataSize, ACL_MEM_MALLOC_HUGE_FIRST); // 分配NPU内存
+    LOG_ERROR("input ret ",ret," datasize ",inTensor.dataSize);
+    CHECK_RET(ret, "alloc error!");
+
+    // 按dtype把2.0转换后填满整个tensor并拷贝到NPU侧
+    FillTensor(inTensor, INPUT_FILL_VALUE);
+}
+
 void CreateInTensors(atb::SVector<atb::Tensor> &inTensors, atb::SVector<atb::TensorDesc> &intensorDescs)
 {
     for (size_t i = 0; i < inTensors.size(); i++)
     {
-        inTensors.at(i).desc = intensorDescs.at(i);
-        inTensors.at(i).dataSize = atb::Utils::GetTensorSize(inTensors.at(i));
-        std::vector<uint16_t> hostData(atb::Utils::GetTensorNumel(inTensors.at(i)), 2); // 一段全2的hostBuffer
-        int ret = aclrtMalloc(
-            &inTensors.at(i).deviceData, inTensors.at(i).dataSize, ACL_MEM_MALLOC_HUGE_FIRST); // 分配NPU内存
-        LOG_ERROR("input ret ",ret," datasize ",inTensors.at(i).dataSize);
-        CHECK_RET(ret, "alloc error!");
-
-        ret = aclrtMemcpy(inTensors.at(i).deviceData,
-                          inTensors.at(i).dataSize,
-                          hostData.data(),
-                          hostData.size() * sizeof(uint16_t),
-                          ACL_MEMCPY_HOST_TO_DEVICE); // 拷贝CPU内存到NPU侧
-        CHECK_RET(ret, "aclrtMemcpy error!");
+        CreateInTensor(inTensors.at(i), intensorDescs.at(i));
     }
 }
 
@@ -71,20 +76,12 @@ void CreateTensorFromDesc(atb::Tensor &tensor, atb::TensorDesc &tensorDescs)
 
 void PrintOutTensorValue(atb::Tensor &outTensor)
 {
-    // 输出Tensor拷贝回host侧并打印
-    std::vector<uint16_t> outBuffer(atb::Utils::GetTensorNumel(outTensor));
-    int ret = aclrtMemcpy(outBuffer.data(),
-                          outBuffer.size() * sizeof(uint16_t),
-                          outTensor.deviceData,
-                          outTensor.dataSize,
-                          ACL_MEMCPY_DEVICE_TO_HOST);
-    CHECK_RET(ret, "copy error!");
+    // 只把需要打印的前11个元素拷贝回host侧，按dtype转换为float后打印
+    int64_t printCount = std::min<int64_t>(atb::Utils::GetTensorNumel(outTensor), PRINT_VALUE_COUNT);
+    std::vector<float> outBuffer = DownloadTensorRange(outTensor, 0, printCount);
 
     for (size_t i = 0; i < outBuffer.size(); i = i + 1)
     {
-        LOG_ERROR("out[" + std::to_string(i) + "] = " + std::to_string((uint32_t)outBuffer.at(i)));
-        if(i == 10){
-            break;
-        }
+        LOG_ERROR("out[" + std::to_string(i) + "] = " + std::to_string(outBuffer.at(i)));
     }
 }
@@ -22,6 +22,9 @@
 // 设置各个intensor的属性
 void CreateInTensorDescs(atb::SVector<atb::TensorDesc> &intensorDescs);
 
+// 设置单个intensor并分配内存空间，按dtype填入全2.0的数据
+void CreateInTensor(atb::Tensor &inTensor, const atb::TensorDesc &intensorDesc);
+
 // 设置各个intensor并且为各个intensor分配内存空间，此处的intensor为手动设置，工程实现上可以使用torchTensor转换或者其他简单数据结构转换的方式
 void CreateInTensors(atb::SVector<atb::Tensor> &inTensors, atb::SVector<atb::TensorDesc> &intensorDescs);
 
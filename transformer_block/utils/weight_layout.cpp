@@ -0,0 +1,73 @@
+#include <algorithm>
+#include "utils/weight_layout.h"
+
+// 转置按块进行，减少跨行访问的cache缺失
+constexpr int64_t TRANSPOSE_TILE = 32;
+
+int64_t AlignToNzBlock(int64_t size)
+{
+    return (size + NZ_BLOCK_SIZE - 1) / NZ_BLOCK_SIZE * NZ_BLOCK_SIZE;
+}
+
+void TransposeMatrix(const uint16_t *src, int64_t rows, int64_t cols, uint16_t *dst)
+{
+    for (int64_t r0 = 0; r0 < rows; r0 += TRANSPOSE_TILE) {
+        for (int64_t c0 = 0; c0 < cols; c0 += TRANSPOSE_TILE) {
+            int64_t rEnd = std::min(r0 + TRANSPOSE_TILE, rows);
+            int64_t cEnd = std::min(c0 + TRANSPOSE_TILE, cols);
+            for (int64_t r = r0; r < rEnd; r++) {
+                for (int64_t c = c0; c < cEnd; c++) {
+                    dst[c * rows + r] = src[r * cols + c];
+                }
+            }
+        }
+    }
+}
+
+void NdToNz(const uint16_t *src, int64_t rows, int64_t cols, uint16_t *dst)
+{
+    int64_t alignedRows = AlignToNzBlock(rows);
+    int64_t alignedCols = AlignToNzBlock(cols);
+    std::fill_n(dst, alignedRows * alignedCols, 0);
+    for (int64_t c1 = 0; c1 < alignedCols / NZ_BLOCK_SIZE; c1++) {
+        int64_t colBegin = c1 * NZ_BLOCK_SIZE;
+        int64_t colCount = std::min(NZ_BLOCK_SIZE, cols - colBegin);
+        for (int64_t r = 0; r < rows; r++) {
+            const uint16_t *srcRow = src + r * cols + colBegin;
+            std::copy(srcRow, srcRow + colCount, dst + (c1 * alignedRows + r) * NZ_BLOCK_SIZE);
+        }
+    }
+}
+
+void NzToNd(const uint16_t *src, int64_t rows, int64_t cols, uint16_t *dst)
+{
+    int64_t alignedRows = AlignToNzBlock(rows);
+    int64_t alignedCols = AlignToNzBlock(cols);
+    for (int64_t c1 = 0; c1 < alignedCols / NZ_BLOCK_SIZE; c1++) {
+        int64_t colBegin = c1 * NZ_BLOCK_SIZE;
+        int64_t colCount = std::min(NZ_BLOCK_SIZE, cols - colBegin);
+        for (int64_t r = 0; r < rows; r++) {
+            const uint16_t *srcRow = src + (c1 * alignedRows + r) * NZ_BLOCK_SIZE;
+            std::copy(srcRow, srcRow + colCount, dst + r * cols + colBegin);
+        }
+    }
+}
+
+int64_t GetPreparedWeightNumel(int64_t k, int64_t n, WeightLayout layout)
+{
+    if (layout == WeightLayout::FRACTAL_NZ) {
+        return AlignToNzBlock(k) * AlignToNzBlock(n);
+    }
+    return k * n;
+}
+
+void PrepareWeight(const uint16_t *ndWeight, int64_t k, int64_t n, WeightLayout layout, uint16_t *dst)
+{
+    if (layout == WeightLayout::ND_TRANSPOSED) {
+        TransposeMatrix(ndWeight, k, n, dst);
+    } else if (layout == WeightLayout::FRACTAL_NZ) {
+        NdToNz(ndWeight, k, n, dst);
+    } else {
+        std::copy(ndWeight, ndWeight + k * n, dst);
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef WEIGHT_LAYOUT_H
+#define WEIGHT_LAYOUT_H
+
+#include <cstdint>
+
+// Linear权重在device上的存储布局，在加载权重时由host侧一次性转换
+enum class WeightLayout
+{
+    ND = 0,        // [k, n]，transposeB = false
+    ND_TRANSPOSED, // [n, k]，transposeB = true
+    FRACTAL_NZ,    // [1, n/16, k, 16]，transposeB = false
+};
+
+// fp16 FRACTAL_NZ的分形边长
+constexpr int64_t NZ_BLOCK_SIZE = 16;
+
+/**
+ * 按NZ分形对齐
+ */
+int64_t AlignToNzBlock(int64_t size);
+
+/**
+ * 矩阵转置
+ * @param src [rows, cols]
+ * @param dst [cols, rows]
+ */
+void TransposeMatrix(const uint16_t *src, int64_t rows, int64_t cols, uint16_t *dst);
+
+/**
+ * ND转FRACTAL_NZ，不足分形的部分补0
+ * NZ按列方向切成cols/16个分形列，每个分形列内按行连续存放，元素(r, c)位于
+ * ((c / 16) * alignedRows + r) * 16 + c % 16
+ * @param src [rows, cols]
+ * @param dst AlignToNzBlock(rows) * AlignToNzBlock(cols)个元素
+ */
+void NdToNz(const uint16_t *src, int64_t rows, int64_t cols, uint16_t *dst);
+
+/**
+ * FRACTAL_NZ转ND，丢弃补齐的部分
+ */
+void NzToNd(const uint16_t *src, int64_t rows, int64_t cols, uint16_t *dst);
+
+/**
+ * 转换后的元素个数
+ * @param k 权重的输入维
+ * @param n 权重的输出维
+ */
+int64_t GetPreparedWeightNumel(int64_t k, int64_t n, WeightLayout layout);
+
+/**
+ * 把ND [k, n]的fp16权重转换为目标布局
+ * @param dst GetPreparedWeightNumel个元素
+ */
+void PrepareWeight(const uint16_t *ndWeight, int64_t k, int64_t n, WeightLayout layout, uint16_t *dst);
+
+#endif
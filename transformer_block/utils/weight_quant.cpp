@@ -0,0 +1,133 @@
+#include "utils/weight_quant.h"
+#include <algorithm>
+#include <cmath>
+#include "utils/dtype_convert.h"
+#include "utils/tensor_convert.h"
+
+constexpr float INT8_MAX_VALUE = 127.0f;
+
+static int8_t QuantizeValue(float value, float scale)
+{
+    float q = std::nearbyint(value / scale);
+    return static_cast<int8_t>(std::max(-INT8_MAX_VALUE, std::min(INT8_MAX_VALUE, q)));
+}
+
+QuantizedWeight QuantizePerChannel(const uint16_t *fp16Weight, int64_t k, int64_t n)
+{
+    QuantizedWeight weight;
+    weight.k = k;
+    weight.n = n;
+    weight.data.resize(k * n);
+    weight.scales.assign(n, 0.0f);
+    for (int64_t row = 0; row < k; row++) {
+        for (int64_t col = 0; col < n; col++) {
+            float value = std::fabs(Fp16ToFloat(fp16Weight[row * n + col]));
+            weight.scales[col] = std::max(weight.scales[col], value);
+        }
+    }
+    for (auto &scale : weight.scales) {
+        // 全0通道保持scale为1，避免除0
+        scale = scale > 0 ? scale / INT8_MAX_VALUE : 1.0f;
+    }
+    for (int64_t row = 0; row < k; row++) {
+        for (int64_t col = 0; col < n; col++) {
+            weight.data[row * n + col] = QuantizeValue(Fp16ToFloat(fp16Weight[row * n + col]), weight.scales[col]);
+        }
+    }
+    return weight;
+}
+
+float ActivationScale(float absMax)
+{
+    return absMax > 0 ? absMax / INT8_MAX_VALUE : 1.0f;
+}
+
+void ReferenceLinearFp16(const uint16_t *x, const uint16_t *weight, const uint16_t *bias, float *y, int64_t m,
+                         int64_t k, int64_t n)
+{
+    std::vector<float> weightValues(k * n);
+    ConvertFp16ToFloat(weight, weightValues.data(), k * n);
+    for (int64_t row = 0; row < m; row++) {
+        float *out = y + row * n;
+        for (int64_t col = 0; col < n; col++) {
+            out[col] = bias == nullptr ? 0.0f : Fp16ToFloat(bias[col]);
+        }
+        for (int64_t p = 0; p < k; p++) {
+            float a = Fp16ToFloat(x[row * k + p]);
+            const float *w = weightValues.data() + p * n;
+            for (int64_t col = 0; col < n; col++) {
+                out[col] += a * w[col];
+            }
+        }
+    }
+}
+
+void ReferenceLinearW8A16(const uint16_t *x, const QuantizedWeight &weight, const uint16_t *bias, float *y,
+                          int64_t m)
+{
+    int64_t k = weight.k;
+    int64_t n = weight.n;
+    for (int64_t row = 0; row < m; row++) {
+        float *out = y + row * n;
+        std::fill_n(out, n, 0.0f);
+        for (int64_t p = 0; p < k; p++) {
+            float a = Fp16ToFloat(x[row * k + p]);
+            const int8_t *w = weight.data.data() + p * n;
+            for (int64_t col = 0; col < n; col++) {
+                out[col] += a * w[col];
+            }
+        }
+        for (int64_t col = 0; col < n; col++) {
+            out[col] = out[col] * weight.scales[col] + (bias == nullptr ? 0.0f : Fp16ToFloat(bias[col]));
+        }
+    }
+}
+
+void ReferenceLinearW8A8(const uint16_t *x, float actScale, const QuantizedWeight &weight, const uint16_t *bias,
+                         float *y, int64_t m)
+{
+    int64_t k = weight.k;
+    int64_t n = weight.n;
+    std::vector<int32_t> acc(n);
+    std::vector<int8_t> xq(k);
+    for (int64_t row = 0; row < m; row++) {
+        for (int64_t p = 0; p < k; p++) {
+            xq[p] = QuantizeValue(Fp16ToFloat(x[row * k + p]), actScale);
+        }
+        std::fill(acc.begin(), acc.end(), 0);
+        for (int64_t p = 0; p < k; p++) {
+            const int8_t *w = weight.data.data() + p * n;
+            for (int64_t col = 0; col < n; col++) {
+                acc[col] += static_cast<int32_t>(xq[p]) * w[col];
+            }
+        }
+        float *out = y + row * n;
+        for (int64_t col = 0; col < n; col++) {
+            out[col] = acc[col] * actScale * weight.scales[col] + (bias == nullptr ? 0.0f : Fp16ToFloat(bias[col]));
+        }
+    }
+}
+
+QuantAccuracy CompareOutputs(const float *reference, const float *actual, int64_t count)
+{
+    QuantAccuracy accuracy;
+    double dot = 0;
+    double refNorm = 0;
+    double actNorm = 0;
+    double absSum = 0;
+    for (int64_t i = 0; i < count; i++) {
+        double diff = std::fabs(static_cast<double>(reference[i]) - actual[i]);
+        accuracy.maxAbsError = std::max(accuracy.maxAbsError, diff);
+        absSum += diff;
+        dot += static_cast<double>(reference[i]) * actual[i];
+        refNorm += static_cast<double>(reference[i]) * reference[i];
+        actNorm += static_cast<double>(actual[i]) * actual[i];
+    }
+    accuracy.meanAbsError = count > 0 ? absSum / count : 0;
+    if (refNorm > 0 && actNorm > 0) {
+        accuracy.cosineSimilarity = dot / std::sqrt(refNorm * actNorm);
+    } else {
+        accuracy.cosineSimilarity = refNorm == actNorm ? 1.0 : 0.0;
+    }
+    return accuracy;
+}
@@ -0,0 +1,63 @@
+#ifndef WEIGHT_QUANT_H
+#define WEIGHT_QUANT_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * per-channel对称量化后的权重
+ * 原始权重布局为[k, n]（与LinearParam的transposeB=false一致），每个输出通道n一个scale
+ * 反量化：w[k][n] ≈ data[k][n] * scales[n]
+ */
+struct QuantizedWeight
+{
+    int64_t k = 0;
+    int64_t n = 0;
+    std::vector<int8_t> data;
+    std::vector<float> scales;
+};
+
+// 量化结果与fp16参考结果的误差
+struct QuantAccuracy
+{
+    double maxAbsError = 0;
+    double meanAbsError = 0;
+    double cosineSimilarity = 0;
+};
+
+/**
+ * 按输出通道对fp16权重做int8对称量化，scale = max|w[:, n]| / 127
+ * @param fp16Weight [k, n]的fp16权重
+ */
+QuantizedWeight QuantizePerChannel(const uint16_t *fp16Weight, int64_t k, int64_t n);
+
+/**
+ * 按绝对值上限计算激活的per-tensor对称量化scale
+ */
+float ActivationScale(float absMax);
+
+/**
+ * fp16参考实现：y[m, n] = x[m, k] @ w[k, n] + bias[n]，float累加
+ * @param bias 可以为空
+ */
+void ReferenceLinearFp16(const uint16_t *x, const uint16_t *weight, const uint16_t *bias, float *y, int64_t m,
+                         int64_t k, int64_t n);
+
+/**
+ * W8A16参考实现：权重按scale反量化后与fp16激活相乘
+ */
+void ReferenceLinearW8A16(const uint16_t *x, const QuantizedWeight &weight, const uint16_t *bias, float *y,
+                          int64_t m);
+
+/**
+ * W8A8参考实现：激活按actScale量化为int8，int32累加后乘以actScale * scales[n]
+ */
+void ReferenceLinearW8A8(const uint16_t *x, float actScale, const QuantizedWeight &weight, const uint16_t *bias,
+                         float *y, int64_t m);
+
+/**
+ * 比较两组输出
+ */
+QuantAccuracy CompareOutputs(const float *reference, const float *actual, int64_t count);
+
+#endif